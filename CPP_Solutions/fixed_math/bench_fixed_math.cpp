@@ -0,0 +1,243 @@
+/* 定点三角/代数函数: 编译期查找表 + 插值 vs CORDIC 循环 vs libm (float), 每次调用耗时与精度
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c ../../Templates/benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -I../../Templates bench_fixed_math.cpp benchmark.o -o bench_fixed_math -lm
+ * 在 x86 上加 -DBENCH_TIMER=BENCH_TIMER_TSC (Cortex-M 上默认 DWT) 可直接得到 cycles/op.
+ * libm 一栏是 "Q15 -> float -> sinf/atan2f/sqrtf -> Q15" 的整条路径; 无 FPU 的目标上它走软件浮点.
+ *
+ * 开始计时前先对每个变体做一遍精度扫描 (sin/cos 全部 65536 个角度, 其余为随机输入), 与 double 参考值比较,
+ * 以 "# accuracy" 开头打印最大/均方根误差; 误差超过头文件里写明的界限时报 MISMATCH 并返回 1.
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "cordic.hpp"
+#include "fixed_lut.hpp"
+
+namespace {
+
+constexpr int N_CALLS = 256;  // 每次迭代的调用次数, 相当于一批电流环采样
+constexpr int N_CHECK = 200000;
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+uint32_t g_rng = 1;
+
+uint32_t rng_next() {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+uint16_t g_angle[N_CALLS];
+int16_t g_x[N_CALLS], g_y[N_CALLS];
+uint32_t g_d[N_CALLS];
+int16_t g_s[N_CALLS], g_c[N_CALLS];
+uint16_t g_phi[N_CALLS];
+uint32_t g_u[N_CALLS];
+
+void setup() {
+    for (int i = 0; i < N_CALLS; i++) {
+        g_angle[i] = static_cast<uint16_t>(rng_next());
+        g_x[i] = static_cast<int16_t>(rng_next());
+        g_y[i] = static_cast<int16_t>(rng_next());
+        g_d[i] = rng_next() | 2u;
+    }
+    // 让数组地址逃逸: 否则编译器知道 BENCH_CLOBBER 碰不到这些内部链接的数组, 会把不变的计算提到循环外
+    BENCH_DO_NOT_OPTIMIZE(g_angle);
+    BENCH_DO_NOT_OPTIMIZE(g_x);
+    BENCH_DO_NOT_OPTIMIZE(g_y);
+    BENCH_DO_NOT_OPTIMIZE(g_d);
+    BENCH_DO_NOT_OPTIMIZE(g_s);
+    BENCH_DO_NOT_OPTIMIZE(g_c);
+    BENCH_DO_NOT_OPTIMIZE(g_phi);
+    BENCH_DO_NOT_OPTIMIZE(g_u);
+}
+
+int16_t to_q15(float v) {
+    long r = std::lrintf(v * 32768.0f);
+    return static_cast<int16_t>(r > 32767 ? 32767 : (r < -32768 ? -32768 : r));
+}
+
+/* 逐位试商的整数平方根: 没有表, 16 次循环 */
+uint32_t isqrt_loop(uint32_t x) {
+    uint32_t r = 0;
+    for (uint32_t bit = 1u << 30; bit; bit >>= 2) {
+        if (x >= r + bit) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+
+uint32_t mag2(int16_t x, int16_t y) {
+    return static_cast<uint32_t>(int32_t{x} * x) + static_cast<uint32_t>(int32_t{y} * y);
+}
+
+/* ---------------- 精度 ---------------- */
+
+struct err_stats {
+    double max = 0, sq = 0;
+    long n = 0;
+    void add(double e) {
+        e = std::fabs(e);
+        if (e > max) max = e;
+        sq += e * e;
+        n++;
+    }
+    double rms() const { return n ? std::sqrt(sq / static_cast<double>(n)) : 0.0; }
+};
+
+bool g_ok = true;
+
+void report(const char* what, const char* unit, const err_stats& e, double limit) {
+    std::fprintf(stderr, "# accuracy %-22s max %9.3g %s, rms %9.3g %s\n", what, e.max, unit, e.rms(), unit);
+    if (e.max > limit) {
+        std::fprintf(stderr, "MISMATCH: %s error %.3g %s exceeds %.3g\n", what, e.max, unit, limit);
+        g_ok = false;
+    }
+}
+
+template <class F>
+void check_sincos(const char* what, double limit, F f) {
+    err_stats e;
+    for (uint32_t a = 0; a < 65536; a++) {
+        int16_t s, c;
+        f(static_cast<uint16_t>(a), s, c);
+        double t = TWO_PI * a / 65536.0;
+        e.add(s - std::fmin(32767.0, std::sin(t) * 32768.0));
+        e.add(c - std::fmin(32767.0, std::cos(t) * 32768.0));
+    }
+    report(what, "LSB", e, limit);
+}
+
+/* 角度误差 (二进制角单位, 按整圈取最近) */
+template <class F>
+void check_atan2(const char* what, double limit, F f) {
+    err_stats e;
+    for (int i = 0; i < N_CHECK; i++) {
+        int16_t x = static_cast<int16_t>(rng_next()), y = static_cast<int16_t>(rng_next());
+        double want = std::atan2(y, x) * (65536.0 / TWO_PI);
+        double d = std::remainder(f(y, x) - want, 65536.0);
+        e.add(d);
+    }
+    report(what, "BAM", e, limit);
+}
+
+template <class F>
+void check_mag(const char* what, double limit, F f) {
+    err_stats e;
+    for (int i = 0; i < N_CHECK; i++) {
+        int16_t x = static_cast<int16_t>(rng_next()), y = static_cast<int16_t>(rng_next());
+        e.add(f(y, x) - std::sqrt(static_cast<double>(mag2(x, y))));
+    }
+    report(what, "LSB", e, limit);
+}
+
+/* 相对误差; d <= 2^16, 使结果至少有 16 位整数部分, 量到的是算法误差而不是结果取整 */
+template <class F>
+void check_recip(const char* what, double limit, F f) {
+    err_stats e;
+    for (int i = 0; i < N_CHECK; i++) {
+        uint32_t d = rng_next() >> (16 + rng_next() % 16);  // 各个数量级都覆盖到
+        if (d < 2) d = 2;
+        double want = 4294967296.0 / d;
+        e.add((f(d) - want) / want);
+    }
+    report(what, "rel", e, limit);
+}
+
+/* ---------------- 测试 ---------------- */
+
+template <class F>
+void bench_calls(const char* name, F f) {
+    bench_t b;
+    BENCH(b, name, {
+        for (int k = 0; k < N_CALLS; k++) f(k);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, N_CALLS, 0);
+    bench_report(&b);
+}
+
+auto libm_sincos = [](uint16_t a, int16_t& s, int16_t& c) {
+    float t = static_cast<float>(a) * static_cast<float>(TWO_PI / 65536.0);
+    s = to_q15(std::sin(t));
+    c = to_q15(std::cos(t));
+};
+template <unsigned Bits>
+void lut_sincos(uint16_t a, int16_t& s, int16_t& c) {
+    s = sin_q15<Bits>(a);
+    c = cos_q15<Bits>(a);
+}
+auto libm_atan2 = [](int16_t y, int16_t x) {
+    float t = std::atan2(static_cast<float>(y), static_cast<float>(x)) * static_cast<float>(65536.0 / TWO_PI);
+    return static_cast<uint16_t>(static_cast<int32_t>(std::lrintf(t)));
+};
+auto libm_mag = [](int16_t y, int16_t x) {
+    return static_cast<uint32_t>(std::lrintf(std::sqrt(static_cast<float>(mag2(x, y)))));
+};
+auto cordic_mag = [](int16_t y, int16_t x) {
+    uint16_t m;
+    cordic_atan2_q15<16>(y, x, &m);
+    return uint32_t{m};
+};
+auto float_recip = [](uint32_t d) {
+    return static_cast<uint32_t>(std::fmin(4294967295.0f, 4294967296.0f / static_cast<float>(d) + 0.5f));
+};
+auto udiv_recip = [](uint32_t d) { return UINT32_MAX / d; };  // Cortex-M3 及以上是一条 UDIV
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    setup();
+
+    check_sincos("sincos libm", 1.0, libm_sincos);
+    check_sincos("sincos lut<6>", 5.0, lut_sincos<6>);
+    check_sincos("sincos lut<8>", 1.5, lut_sincos<8>);
+    check_sincos("sincos lut<10>", 1.5, lut_sincos<10>);
+    check_sincos("sincos cordic<12>", 24.0, cordic_sincos_q15<12>);
+    check_sincos("sincos cordic<16>", 2.0, cordic_sincos_q15<16>);
+    check_atan2("atan2 libm", 1.0, libm_atan2);
+    check_atan2("atan2 lut<8>", 1.5, atan2_q15<8>);
+    check_atan2("atan2 lut<10>", 1.5, atan2_q15<10>);
+    check_atan2("atan2 cordic<16>", 1.5, [](int16_t y, int16_t x) { return cordic_atan2_q15<16>(y, x); });
+    check_mag("mag libm sqrtf", 1.0, libm_mag);
+    check_mag("mag lut sqrt<8>", 1.5, [](int16_t y, int16_t x) { return sqrt_u32<8>(mag2(x, y)); });
+    check_mag("mag isqrt loop", 1.0, [](int16_t y, int16_t x) { return isqrt_loop(mag2(x, y)); });
+    check_mag("mag cordic<16>", 3.0, cordic_mag);
+    check_recip("recip float", 1e-5, float_recip);
+    check_recip("recip udiv", 2e-5, udiv_recip);
+    check_recip("recip lut<8>", 4e-5, recip_u32<8>);
+    check_recip("recip lut<10>", 4e-5, recip_u32<10>);
+    if (!g_ok) return 1;
+
+    bench_calls("sincos libm sinf/cosf", [](int k) { libm_sincos(g_angle[k], g_s[k], g_c[k]); });
+    bench_calls("sincos lut<6>", [](int k) { lut_sincos<6>(g_angle[k], g_s[k], g_c[k]); });
+    bench_calls("sincos lut<8>", [](int k) { lut_sincos<8>(g_angle[k], g_s[k], g_c[k]); });
+    bench_calls("sincos lut<10>", [](int k) { lut_sincos<10>(g_angle[k], g_s[k], g_c[k]); });
+    bench_calls("sincos cordic<12>", [](int k) { cordic_sincos_q15<12>(g_angle[k], g_s[k], g_c[k]); });
+    bench_calls("sincos cordic<16>", [](int k) { cordic_sincos_q15<16>(g_angle[k], g_s[k], g_c[k]); });
+
+    bench_calls("atan2 libm atan2f", [](int k) { g_phi[k] = libm_atan2(g_y[k], g_x[k]); });
+    bench_calls("atan2 lut<8>", [](int k) { g_phi[k] = atan2_q15<8>(g_y[k], g_x[k]); });
+    bench_calls("atan2 lut<10>", [](int k) { g_phi[k] = atan2_q15<10>(g_y[k], g_x[k]); });
+    bench_calls("atan2 cordic<16>", [](int k) { g_phi[k] = cordic_atan2_q15<16>(g_y[k], g_x[k]); });
+
+    bench_calls("mag libm sqrtf", [](int k) { g_u[k] = libm_mag(g_y[k], g_x[k]); });
+    bench_calls("mag lut sqrt<8>", [](int k) { g_u[k] = sqrt_u32<8>(mag2(g_x[k], g_y[k])); });
+    bench_calls("mag isqrt loop", [](int k) { g_u[k] = isqrt_loop(mag2(g_x[k], g_y[k])); });
+    bench_calls("mag cordic<16>", [](int k) { g_u[k] = cordic_mag(g_y[k], g_x[k]); });
+
+    bench_calls("recip float", [](int k) { g_u[k] = float_recip(g_d[k]); });
+    bench_calls("recip udiv", [](int k) { g_u[k] = udiv_recip(g_d[k]); });
+    bench_calls("recip lut<8>", [](int k) { g_u[k] = recip_u32<8>(g_d[k]); });
+
+    return bench_summary();
+}
@@ -0,0 +1,68 @@
+/* 编译期数学函数 (C++17 constexpr, double) - 只用来在编译期生成查找表
+ *
+ * C++17 的 std::sin / std::atan / std::sqrt 不是 constexpr, 这里用级数 / 牛顿迭代自己算.
+ * 精度到 double 的最后一两位即可: 结果最终舍入成 16 位定点, 这点误差看不见.
+ * 不追求运行期速度, 目标机代码里不应出现对它们的运行期调用 (表都是 constexpr 变量).
+ */
+#ifndef CONSTEXPR_MATH_HPP
+#define CONSTEXPR_MATH_HPP
+
+namespace cx {
+
+constexpr double pi = 3.14159265358979323846264338327950288;
+
+constexpr double abs(double x) { return x < 0 ? -x : x; }
+
+/* 最接近的整数, 0.5 远离 0 舍入 (std::round 同样不是 constexpr) */
+constexpr long long round(double x) {
+    return x < 0 ? -static_cast<long long>(-x + 0.5) : static_cast<long long>(x + 0.5);
+}
+
+/* 先把 x 归约到 [-pi, pi], 再在 [-pi/2, pi/2] 上用 Taylor 级数: 项数随精度自动截止 */
+constexpr double sin(double x) {
+    long long k = round(x / (2 * pi));
+    x -= static_cast<double>(k) * 2 * pi;
+    if (x > pi / 2) x = pi - x;
+    if (x < -pi / 2) x = -pi - x;
+    double term = x, sum = x;
+    for (int n = 1; n < 30 && abs(term) > 1e-18; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(double x) { return sin(x + pi / 2); }
+
+/* x >= 0; 牛顿迭代, 初值取 x 与 1 中较大者保证从上方单调收敛 */
+constexpr double sqrt(double x) {
+    if (x <= 0) return 0;
+    double r = x > 1 ? x : 1;
+    for (int i = 0; i < 200; i++) {
+        double next = 0.5 * (r + x / r);
+        if (next >= r) break;
+        r = next;
+    }
+    return r;
+}
+
+/* 两次半角公式 atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))) 把 |x| 压到 0.2 以下, 级数很快收敛 */
+constexpr double atan(double x) {
+    if (x < 0) return -atan(-x);
+    if (x > 1) return pi / 2 - atan(1 / x);
+    double scale = 1;
+    while (x > 0.2) {
+        x = x / (1 + sqrt(1 + x * x));
+        scale *= 2;
+    }
+    double term = x, sum = x;
+    for (int n = 1; n < 60 && abs(term) > 1e-18; n++) {
+        term *= -x * x;
+        sum += term / (2 * n + 1);
+    }
+    return scale * sum;
+}
+
+}  // namespace cx
+
+#endif /* CONSTEXPR_MATH_HPP */
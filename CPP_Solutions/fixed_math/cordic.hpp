@@ -0,0 +1,106 @@
+/* CORDIC (C++17, 无 FPU 目标): 旋转模式算 sin/cos, 向量模式算 atan2 + 幅值
+ *
+ * 每次迭代只有移位、加减和一次查表: atan(2^-i) 角度表与增益 K = prod 1/sqrt(1 + 2^-2i) 都在编译期生成.
+ * 内部用 32 位: 角度 2^32 = 一整圈, 坐标 Q29/Q30, 输入输出与 fixed_lut.hpp 一致 (Q15 + 16 位二进制角).
+ * 迭代次数 Iter 决定精度, 每次迭代约多 1 位; Q15 结果用 16 次即可, 更多只是白费周期.
+ * 与查表法相比不占 flash (表只有 Iter 项), 但每次调用是 Iter 次带分支的循环.
+ *
+ *   int16_t s, c;
+ *   cordic_sincos_q15(theta, s, c);
+ *   uint16_t mag;
+ *   uint16_t phi = cordic_atan2_q15(beta, alpha, &mag);
+ */
+#ifndef CORDIC_HPP
+#define CORDIC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "constexpr_math.hpp"
+
+/* t[i] = atan(2^-i), 单位 2^-32 圈: t[0] = pi/4 = 2^29 */
+template <unsigned Iter>
+inline constexpr std::array<int32_t, Iter> cordic_atan_table = [] {
+    std::array<int32_t, Iter> t{};
+    double p = 1;
+    for (unsigned i = 0; i < Iter; i++, p /= 2)
+        t[i] = static_cast<int32_t>(cx::round(cx::atan(p) * (4294967296.0 / (2 * cx::pi))));
+    return t;
+}();
+
+/* K = prod_{i < Iter} 1/sqrt(1 + 2^-2i), Q30 (约 0.60725 * 2^30) */
+template <unsigned Iter>
+inline constexpr int32_t cordic_gain_q30 = [] {
+    double k = 1, p = 1;
+    for (unsigned i = 0; i < Iter; i++, p /= 4) k /= cx::sqrt(1 + p);
+    return static_cast<int32_t>(cx::round(k * 1073741824.0));
+}();
+
+static_assert(cordic_atan_table<16>[0] == (int32_t{1} << 29), "atan(1) must be 1/8 turn");
+
+/* 旋转模式: 向量 (K, 0) 转过 angle. 先把角度折到 [-pi/2, pi/2] (收敛范围约 +-99.9 度), 折过的结果取负 */
+template <unsigned Iter = 16>
+constexpr void cordic_sincos_q15(uint16_t angle, int16_t& s, int16_t& c) {
+    static_assert(Iter >= 1 && Iter <= 30, "CORDIC needs 1..30 iterations");
+    uint32_t a = uint32_t{angle} << 16;
+    bool flip = ((a + 0x40000000u) & 0x80000000u) != 0;  // 角度在 [pi/2, 3pi/2)
+    if (flip) a += 0x80000000u;
+    int32_t z = static_cast<int32_t>(a);
+    int32_t x = cordic_gain_q30<Iter>, y = 0;
+    for (unsigned i = 0; i < Iter; i++) {
+        int32_t dx = y >> i, dy = x >> i;
+        if (z >= 0) {
+            x -= dx;
+            y += dy;
+            z -= cordic_atan_table<Iter>[i];
+        } else {
+            x += dx;
+            y -= dy;
+            z += cordic_atan_table<Iter>[i];
+        }
+    }
+    // Q30 -> Q15, 四舍五入并把 1.0 饱和到 32767
+    auto q15 = [flip](int32_t v) {
+        int32_t r = (v + (1 << 14)) >> 15;
+        r = r > 32767 ? 32767 : (r < -32767 ? -32767 : r);
+        return static_cast<int16_t>(flip ? -r : r);
+    };
+    s = q15(y);
+    c = q15(x);
+}
+
+/* 向量模式: 把 (x, y) 转到 x 轴上, 累计转过的角度就是 atan2(y, x). x < 0 时先整体转 pi.
+ * 输入移到 Q29 (留出增益 1.647 与 sqrt(2) 的余量); mag 非空时写入幅值 sqrt(x^2 + y^2), Q15, 饱和到 65535 */
+template <unsigned Iter = 16>
+constexpr uint16_t cordic_atan2_q15(int16_t yq, int16_t xq, uint16_t* mag = nullptr) {
+    static_assert(Iter >= 1 && Iter <= 30, "CORDIC needs 1..30 iterations");
+    int32_t x = int32_t{xq} * (1 << 14), y = int32_t{yq} * (1 << 14);
+    uint32_t z = 0;
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        z = 0x80000000u;
+    }
+    for (unsigned i = 0; i < Iter; i++) {
+        int32_t dx = y >> i, dy = x >> i;
+        if (y < 0) {
+            x -= dx;
+            y += dy;
+            z -= static_cast<uint32_t>(cordic_atan_table<Iter>[i]);
+        } else {
+            x += dx;
+            y -= dy;
+            z += static_cast<uint32_t>(cordic_atan_table<Iter>[i]);
+        }
+    }
+    if (mag) {
+        // x 是 Q29 的 |v| / K: 先降到 Q15 再乘 Q15 的 K, 仍在 32 位内
+        int32_t k15 = (cordic_gain_q30<Iter> + (1 << 14)) >> 15;
+        int32_t m = ((x >> 14) * k15 + (1 << 14)) >> 15;
+        *mag = static_cast<uint16_t>(m > 65535 ? 65535 : m);
+    }
+    return static_cast<uint16_t>((z + 0x8000u) >> 16);
+}
+
+#endif /* CORDIC_HPP */
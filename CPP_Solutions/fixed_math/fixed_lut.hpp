@@ -0,0 +1,184 @@
+/* 编译期生成的定点查找表 + 线性插值: sin/cos, atan2, 倒数, 平方根 (C++17, 无 FPU 目标)
+ *
+ * 所有表都是 constexpr 变量模板, 由 constexpr_math.hpp 在编译期算好: 进 .rodata (MCU 上即 flash),
+ * 没有运行期初始化, 也没有静态构造函数. 模板参数 Bits 是表的段数 2^Bits, 在表大小和精度之间取舍;
+ * 查表只用整数移位、一次乘法做插值, Cortex-M0 上也不需要除法或 64 位乘法.
+ *
+ * 角度统一用 16 位二进制角 (BAM): 65536 = 一整圈, 加减自然按整圈回绕, 编码器计数可以直接移位得到.
+ *
+ *   int16_t s = sin_q15(theta), c = cos_q15(theta);          // Park 变换: d = a*c + b*s, q = b*c - a*s
+ *   uint16_t phi = atan2_q15(beta, alpha);                     // 电压矢量角 (SVPWM 扇区 = phi / 10923)
+ *   uint32_t r = sqrt_u32(uint32_t(alpha * alpha + beta * beta));  // 矢量幅值, Q15
+ *
+ * 各变体 (Bits 取默认值时) 的误差上限, 即 bench_fixed_math 自检强制的界 (括号内是 "# accuracy" 的实测最大值):
+ *   sin_q15<8>    四分之一周期 256 段 (516 字节), sin/cos 误差 <= 1.5 LSB (实测 1 LSB)
+ *   atan2_q15<8>  [0, 1] 上 256 段 atan 表 + 倒数表求比值, 误差 <= 1.5 BAM, 即 0.008° (实测 1.12 BAM)
+ *   recip_u32<8>  [1, 2) 上 256 段 1/x 表, 相对误差 <= 4e-5 (实测 3e-5, 约 2^-15)
+ *   sqrt_u32<8>   [1, 4) 上 768 段 sqrt 表; 上面的矢量幅值 sqrt_u32(a*a + b*b) 误差 <= 1.5 LSB (实测 1.41 LSB)
+ */
+#ifndef FIXED_LUT_HPP
+#define FIXED_LUT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "constexpr_math.hpp"
+
+namespace lut_detail {
+
+template <class T, size_t N, class F>
+constexpr std::array<T, N> make_table(F f) {
+    std::array<T, N> t{};
+    for (size_t i = 0; i < N; i++) t[i] = static_cast<T>(f(i));
+    return t;
+}
+
+constexpr long long clamp(long long x, long long lo, long long hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+/* t[i] 与 t[i + 1] 之间按 frac / 2^F 线性插值, 四舍五入; F == 0 时就是直接查表 */
+template <unsigned F, class T, size_t N>
+constexpr int32_t interp(const std::array<T, N>& t, uint32_t i, uint32_t frac) {
+    int32_t y0 = t[i];
+    if constexpr (F == 0) {
+        return y0;
+    } else {
+        int32_t d = static_cast<int32_t>(t[i + 1]) - y0;
+        return y0 + ((d * static_cast<int32_t>(frac) + (int32_t{1} << (F - 1))) >> F);
+    }
+}
+
+constexpr unsigned clz32(uint32_t x) {
+#if defined(__GNUC__)
+    return x ? static_cast<unsigned>(__builtin_clz(x)) : 32u;
+#else
+    unsigned n = 0;
+    for (uint32_t bit = 0x80000000u; bit && !(x & bit); bit >>= 1) n++;
+    return n;
+#endif
+}
+
+}  // namespace lut_detail
+
+/* ---------------- 表 ---------------- */
+
+/* sin 四分之一周期: t[i] = sin(pi/2 * i / 2^Bits), Q15 (1.0 饱和为 32767). 共 2^Bits + 2 项:
+ * 含终点 sin(pi/2), 再重复一次, 让角度正好落在 pi/2 时插值的 t[i + 1] 不越界 */
+template <unsigned Bits>
+inline constexpr auto sine_quarter_table = lut_detail::make_table<int16_t, (size_t{1} << Bits) + 2>([](size_t i) {
+    constexpr size_t n = size_t{1} << Bits;
+    size_t k = i < n ? i : n;
+    return lut_detail::clamp(cx::round(32768.0 * cx::sin(cx::pi / 2 * static_cast<double>(k) / n)), 0, 32767);
+});
+
+/* atan(r), r = i / 2^Bits 属于 [0, 1], 单位是二进制角 (atan(1) = 8192); 同样多一项 */
+template <unsigned Bits>
+inline constexpr auto atan_table = lut_detail::make_table<uint16_t, (size_t{1} << Bits) + 2>([](size_t i) {
+    constexpr size_t n = size_t{1} << Bits;
+    size_t k = i < n ? i : n;
+    return cx::round(cx::atan(static_cast<double>(k) / n) * (65536.0 / (2 * cx::pi)));
+});
+
+/* 1/x - 0.5, x = 1 + i / 2^Bits 属于 [1, 2], Q16 (值在 [0, 32768]); 同 sqrt 表, 存差值多换一位精度 */
+template <unsigned Bits>
+inline constexpr auto reciprocal_table = lut_detail::make_table<uint16_t, (size_t{1} << Bits) + 1>([](size_t i) {
+    constexpr size_t n = size_t{1} << Bits;
+    return cx::round(65536.0 / (1.0 + static_cast<double>(i) / n)) - 32768;
+});
+
+/* sqrt(x) - 1, x = 1 + i / 2^Bits 属于 [1, 4], Q15 (值在 [0, 32768]): 偶数次移位归一化后尾数落在 [1, 4).
+ * 存与 1 的差而不是 sqrt 本身, uint16 里就能放下 Q15, 比存 Q14 多一位精度 */
+template <unsigned Bits>
+inline constexpr auto sqrt_table = lut_detail::make_table<uint16_t, 3 * (size_t{1} << Bits) + 1>([](size_t i) {
+    constexpr size_t n = size_t{1} << Bits;
+    return cx::round(32768.0 * cx::sqrt(1.0 + static_cast<double>(i) / n)) - 32768;
+});
+
+static_assert(sine_quarter_table<8>[0] == 0 && sine_quarter_table<8>[256] == 32767, "sine table endpoints");
+static_assert(atan_table<8>[256] == 8192, "atan(1) must be 1/8 turn");
+static_assert(reciprocal_table<8>[0] == 32768 && reciprocal_table<8>[256] == 0, "reciprocal table endpoints");
+static_assert(sqrt_table<8>[0] == 0 && sqrt_table<8>[768] == 32768, "sqrt table endpoints");
+
+/* ---------------- 查表 ---------------- */
+
+/* sin(angle), angle 为二进制角; 结果 Q15. 象限 1/3 把角度镜像到四分之一周期内, 象限 2/3 取负 */
+template <unsigned Bits = 8>
+constexpr int16_t sin_q15(uint16_t angle) {
+    static_assert(Bits >= 2 && Bits <= 14, "quarter-wave table needs 2..14 index bits");
+    constexpr unsigned F = 14 - Bits;
+    uint32_t x = angle & 0x3FFFu;
+    if (angle & 0x4000u) x = 0x4000u - x;
+    int32_t y = lut_detail::interp<F>(sine_quarter_table<Bits>, x >> F, x & ((1u << F) - 1));
+    return static_cast<int16_t>((angle & 0x8000u) ? -y : y);
+}
+
+template <unsigned Bits = 8>
+constexpr int16_t cos_q15(uint16_t angle) {
+    return sin_q15<Bits>(static_cast<uint16_t>(angle + 0x4000u));
+}
+
+/* 0 <= num <= den < 2^16, den > 0: 返回 num / den 的 Q15 (值在 [0, 32768]).
+ * den 左移到 [2^15, 2^16) 后查倒数表: num 同样左移仍小于 2^16, 与 Q16 倒数 (<= 2^16) 的乘积在 32 位内 */
+template <unsigned Bits = 8>
+constexpr uint32_t div_q15(uint32_t num, uint32_t den) {
+    static_assert(Bits >= 1 && Bits <= 15, "reciprocal table needs 1..15 index bits");
+    constexpr unsigned F = 15 - Bits;
+    unsigned s = lut_detail::clz32(den) - 16;
+    uint32_t m = den << s;
+    uint32_t idx = (m >> F) & ((1u << Bits) - 1);
+    uint32_t frac = m & ((1u << F) - 1);
+    uint32_t r = static_cast<uint32_t>(lut_detail::interp<F>(reciprocal_table<Bits>, idx, frac)) + 32768u;
+    return ((num << s) * r + (1u << 15)) >> 16;
+}
+
+/* 约等于 2^32 / d (d >= 2; d == 1 饱和为 UINT32_MAX, d == 0 同样返回 UINT32_MAX). 有效位约 16 位 */
+template <unsigned Bits = 8>
+constexpr uint32_t recip_u32(uint32_t d) {
+    static_assert(Bits >= 1 && Bits <= 15, "reciprocal table needs 1..15 index bits");
+    constexpr unsigned F = 15 - Bits;
+    if (d <= 1) return UINT32_MAX;
+    unsigned s = lut_detail::clz32(d);
+    uint32_t m = d << s;  // [2^31, 2^32): 尾数 m / 2^31 属于 [1, 2)
+    uint32_t idx = (m >> (31 - Bits)) & ((1u << Bits) - 1);
+    uint32_t frac = (m >> 16) & ((1u << F) - 1);
+    uint32_t r = static_cast<uint32_t>(lut_detail::interp<F>(reciprocal_table<Bits>, idx, frac)) + 32768u;
+    // 2^32 / d = 2^(s + 1) / (m / 2^31) = r * 2^(s + 1 - 16)
+    if (s >= 15) return r << (s - 15);  // s <= 30, 不会溢出
+    return (r + (1u << (14 - s))) >> (15 - s);
+}
+
+/* 约等于 sqrt(x) 的四舍五入 (结果 <= 2^16). x 左移偶数位归一到 [2^30, 2^32) */
+template <unsigned Bits = 8>
+constexpr uint32_t sqrt_u32(uint32_t x) {
+    static_assert(Bits >= 1 && Bits <= 14, "sqrt table needs 1..14 index bits");
+    constexpr unsigned F = 15 - Bits;
+    if (x == 0) return 0;
+    unsigned s = lut_detail::clz32(x) & ~1u;
+    uint32_t m = x << s;
+    uint32_t idx = (m >> (30 - Bits)) - (1u << Bits);
+    uint32_t frac = (m >> 15) & ((1u << F) - 1);
+    // sqrt(m) = sqrt(m / 2^30) * 2^15, 正好是表值加回 1.0 的 Q15
+    uint32_t y = static_cast<uint32_t>(lut_detail::interp<F>(sqrt_table<Bits>, idx, frac)) + 32768u;
+    unsigned h = s >> 1;  // sqrt(x) = sqrt(m) / 2^h
+    return h ? (y + (1u << (h - 1))) >> h : y;
+}
+
+/* atan2(y, x), 结果为二进制角 [0, 65536); (0, 0) 返回 0.
+ * 先折到第一象限的下半个八分之一 (0 <= 比值 <= 1), 比值用倒数表算, 再查 atan 表, 最后按对称展开 */
+template <unsigned Bits = 8>
+constexpr uint16_t atan2_q15(int16_t y, int16_t x) {
+    static_assert(Bits >= 1 && Bits <= 15, "atan table needs 1..15 index bits");
+    constexpr unsigned F = 15 - Bits;
+    uint32_t ax = static_cast<uint32_t>(x < 0 ? -int32_t{x} : x);
+    uint32_t ay = static_cast<uint32_t>(y < 0 ? -int32_t{y} : y);
+    if ((ax | ay) == 0) return 0;
+    bool steep = ay > ax;
+    uint32_t r = steep ? div_q15<Bits>(ax, ay) : div_q15<Bits>(ay, ax);  // Q15, [0, 32768]
+    uint32_t t = static_cast<uint32_t>(lut_detail::interp<F>(atan_table<Bits>, r >> F, r & ((1u << F) - 1)));
+    if (steep) t = 0x4000u - t;
+    if (x < 0) t = 0x8000u - t;
+    if (y < 0) t = 0u - t;
+    return static_cast<uint16_t>(t);
+}
+
+#endif /* FIXED_LUT_HPP */
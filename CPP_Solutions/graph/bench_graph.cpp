@@ -0,0 +1,355 @@
+/* 图的装载与遍历: cin 式 vector<vector<int>> 对比 FastReader 两遍建 CSR / mmap 二进制, 以及重排前后的 BFS
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c ../../Templates/benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -mavx2 -I../../Templates bench_graph.cpp benchmark.o -o bench_graph
+ * --sizes 给出边数 m. 测试图是打乱编号的二维网格 (边长 sqrt(m / 2), 约 m 条边, 像道路网一样有几何局部性
+ * 但输入编号随机), 每个规模先写一份文本边表和一份二进制 CSR 到 $TMPDIR (默认 /tmp), 测完删除.
+ * 文件刚写过, 都在页缓存里: 装载测的是解析/建图开销, 不含磁盘.
+ * 遍历测两种: 从随机顶点出发的 BFS, 以及 sweep (每个顶点把邻居的值加起来, 相当于一步 PageRank/SpMV),
+ * 后者与起点无关, 最能看出重排带来的局部性. 重排前后的边跨度 (带宽 / 平均 |u - v|) 以 "# " 开头打印到 stderr.
+ * 计时前先在大量随机小图 (有向与无向, 含孤立点和多个分量) 上检查两种重排都给出排列, 且保持 BFS 距离.
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "acm_io.hpp"
+#include "csr_graph.hpp"
+#include "csr_io.hpp"
+#include "csr_reorder.hpp"
+
+namespace {
+
+constexpr size_t LARGE_M = 1000000;
+constexpr size_t LARGE_SAMPLES = 3;
+
+uint64_t g_rng = 1;
+
+uint32_t rng_next() {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return static_cast<uint32_t>(g_rng >> 32);
+}
+
+using edge_list = std::vector<std::pair<uint32_t, uint32_t>>;
+
+/* side x side 网格的右/下边, 不足 m 条用随机位置的对角边补齐 (不引入长程捷径, 保持几何局部性);
+ * 顶点编号整体随机置换 */
+edge_list shuffled_grid(size_t m, uint32_t& n) {
+    uint32_t side = 2;
+    while (size_t{side + 1} * (side + 1) * 2 <= m) side++;
+    n = side * side;
+    std::vector<uint32_t> label(n);
+    for (uint32_t i = 0; i < n; i++) label[i] = i;
+    for (uint32_t i = n - 1; i > 0; i--) std::swap(label[i], label[rng_next() % (i + 1)]);
+    edge_list e;
+    e.reserve(m);
+    for (uint32_t y = 0; y < side && e.size() < m; y++)
+        for (uint32_t x = 0; x < side && e.size() < m; x++) {
+            uint32_t v = y * side + x;
+            if (x + 1 < side) e.push_back({label[v], label[v + 1]});
+            if (y + 1 < side && e.size() < m) e.push_back({label[v], label[v + side]});
+        }
+    while (e.size() < m) {
+        uint32_t v = (rng_next() % (side - 1)) * side + rng_next() % (side - 1);
+        e.push_back({label[v], label[v + side + 1]});
+    }
+    return e;
+}
+
+bool write_text(const char* path, uint32_t n, const edge_list& e) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    {
+        FastWriter out(fd);
+        out << n << ' ' << e.size() << '\n';
+        for (const auto& x : e) out << x.first << ' ' << x.second << '\n';
+    }
+    return ::close(fd) == 0;
+}
+
+size_t file_size(const char* path) {
+    struct stat st;
+    return ::stat(path, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+/* 基线: 刷题代码最常见的写法 */
+std::vector<std::vector<int>> read_adjlist(const char* path) {
+    std::ifstream f(path);
+    int n = 0;
+    long long m = 0;
+    f >> n >> m;
+    std::vector<std::vector<int>> adj(static_cast<size_t>(n));
+    for (long long i = 0; i < m; i++) {
+        int u, v;
+        f >> u >> v;
+        adj[static_cast<size_t>(u)].push_back(v);
+        adj[static_cast<size_t>(v)].push_back(u);
+    }
+    return adj;
+}
+
+std::vector<uint32_t> bfs_adjlist(const std::vector<std::vector<int>>& adj, uint32_t src) {
+    std::vector<uint32_t> dist(adj.size(), CSR_UNREACHED);
+    std::vector<uint32_t> queue;
+    queue.reserve(adj.size());
+    dist[src] = 0;
+    queue.push_back(src);
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t u = queue[head];
+        for (int w : adj[u]) {
+            if (dist[static_cast<size_t>(w)] == CSR_UNREACHED) {
+                dist[static_cast<size_t>(w)] = dist[u] + 1;
+                queue.push_back(static_cast<uint32_t>(w));
+            }
+        }
+    }
+    return dist;
+}
+
+bool same_graph(const csr_view& a, const csr_view& b) {
+    return a.n == b.n && std::memcmp(a.offsets, b.offsets, (size_t{a.n} + 1) * sizeof(uint64_t)) == 0 &&
+           std::memcmp(a.adj, b.adj, static_cast<size_t>(a.arcs()) * sizeof(uint32_t)) == 0;
+}
+
+bool load_text(const char* path, csr_graph& g, bool two_pass) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    bool ok;
+    if (two_pass) {
+        ok = csr_read_text_file(fd, g);
+    } else {
+        FastReader in(fd);
+        ok = csr_read_text(in, g);
+    }
+    ::close(fd);
+    return ok;
+}
+
+void print_span(const char* what, const csr_view& g) {
+    csr_span_stats s = csr_span(g);
+    std::fprintf(stderr, "# span %-6s n=%u: bandwidth %llu, mean |u-v| %.1f\n", what, g.n,
+                 static_cast<unsigned long long>(s.bandwidth), s.mean);
+}
+
+/* 一步 PageRank / SpMV 式的全图扫描: y[v] = sum x[w], 对每个顶点都访问一遍邻居的数据.
+ * x[v] 取度数, 和编号无关, 所以不同编号下的总和应当相同 */
+uint64_t sweep(const csr_view& g, std::vector<uint32_t>& x, std::vector<uint64_t>& y) {
+    x.resize(g.n);
+    y.resize(g.n);
+    for (uint32_t v = 0; v < g.n; v++) x[v] = static_cast<uint32_t>(g.degree(v));
+    uint64_t total = 0;
+    for (uint32_t v = 0; v < g.n; v++) {
+        uint64_t s = 0;
+        for (uint32_t w : g.neighbors(v)) s += x[w];
+        y[v] = s;
+        total += s;
+    }
+    return total;
+}
+
+/* 重排后的距离应当就是原距离按 order 换位 */
+bool permuted_dist_ok(const std::vector<uint32_t>& order, const std::vector<uint32_t>& old_dist,
+                      const std::vector<uint32_t>& new_dist) {
+    for (size_t i = 0; i < order.size(); i++)
+        if (new_dist[i] != old_dist[order[i]]) return false;
+    return true;
+}
+
+/* 重排的正确性不依赖图的形状: 随机小图覆盖有向边、自环、重边、孤立点和许多分量 */
+bool check_orders() {
+    constexpr int kGraphs = 20000;
+    static const struct {
+        const char* name;
+        std::vector<uint32_t> (*order)(const csr_view&);
+    } orders[] = {{"bfs", bfs_order}, {"rcm", rcm_order}};
+    for (int t = 0; t < kGraphs; t++) {
+        const uint32_t n = 1 + rng_next() % 40;
+        const bool undirected = (t & 1) != 0;
+        edge_list e(rng_next() % (3 * n));
+        for (auto& x : e) x = {rng_next() % n, rng_next() % n};
+        const csr_graph g = csr_graph::from_edges(n, e, undirected);
+        const uint32_t src = rng_next() % n;
+        const std::vector<uint32_t> dist = bfs_distances(g, src);
+        for (const auto& o : orders) {
+            const std::vector<uint32_t> order = o.order(g);
+            std::vector<uint8_t> hit(n, 0);
+            bool perm = order.size() == n;
+            for (size_t i = 0; perm && i < order.size(); i++) {
+                perm = order[i] < n && !hit[order[i]];
+                if (perm) hit[order[i]] = 1;
+            }
+            if (!perm) {
+                std::fprintf(stderr, "MISMATCH: %s order of a %s graph (n=%u, %zu edges) is not a permutation\n",
+                             o.name, undirected ? "undirected" : "directed", n, e.size());
+                return false;
+            }
+            const csr_graph h = csr_permute(g, order);
+            if (!csr_validate(h) || h.arcs() != g.arcs() ||
+                !permuted_dist_ok(order, dist, bfs_distances(h, inverse_order(order)[src]))) {
+                std::fprintf(stderr, "MISMATCH: %s reordering of a %s graph (n=%u, %zu edges) changed BFS distances\n",
+                             o.name, undirected ? "undirected" : "directed", n, e.size());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool bench_size(size_t m, const std::string& dir) {
+    uint32_t n;
+    edge_list e = shuffled_grid(m, n);
+    const csr_graph want = csr_graph::from_edges(n, e, true);
+    std::string txt = dir + "/bench_graph_" + std::to_string(::getpid()) + ".txt";
+    std::string bin = dir + "/bench_graph_" + std::to_string(::getpid()) + ".csr";
+    if (!write_text(txt.c_str(), n, e) || !csr_write_binary(want, bin.c_str())) {
+        std::fprintf(stderr, "# skip size %zu: cannot write fixtures to %s\n", m, dir.c_str());
+        ::unlink(txt.c_str());
+        ::unlink(bin.c_str());
+        return true;
+    }
+    edge_list().swap(e);
+    const size_t txt_bytes = file_size(txt.c_str()), bin_bytes = file_size(bin.c_str());
+    const size_t arc_bytes = static_cast<size_t>(want.arcs()) * sizeof(uint32_t);
+
+    bool ok = true;
+    bench_t b;
+    std::vector<std::vector<int>> adjlist;
+    csr_graph g1, g2;
+    csr_mapped mapped;
+
+    BENCH(b, "ifstream >> vector<vector<int>>", adjlist = read_adjlist(txt.c_str()));
+    bench_set_size(&b, m, txt_bytes);
+    bench_report(&b);
+
+    BENCH(b, "FastReader -> csr (edge buffer)", ok &= load_text(txt.c_str(), g1, false));
+    bench_set_size(&b, m, txt_bytes);
+    bench_report(&b);
+
+    BENCH(b, "FastReader -> csr (2-pass file)", ok &= load_text(txt.c_str(), g2, true));
+    bench_set_size(&b, m, txt_bytes);
+    bench_report(&b);
+
+    BENCH(b, "mmap binary csr (open)", ok &= mapped.open(bin.c_str()));
+    bench_set_size(&b, m, bin_bytes);
+    bench_report(&b);
+
+    BENCH(b, "mmap binary csr + validate", ok &= mapped.open(bin.c_str()) && csr_validate(mapped.view()));
+    bench_set_size(&b, m, bin_bytes);
+    bench_report(&b);
+
+    if (!ok || !same_graph(g1, want) || !same_graph(g2, want) || !same_graph(mapped.view(), want)) {
+        std::fprintf(stderr, "MISMATCH: loaded graph differs from the generated one (m=%zu)\n", m);
+        ok = false;
+    }
+
+    // 起点取编号 n / 2: 输入编号是随机置换, 它就是一个随机顶点, 也不是 bfs_order 的根
+    const uint32_t src = n / 2;
+    const std::vector<uint32_t> dist = bfs_distances(want, src);
+    std::vector<uint32_t> d, x;
+    std::vector<uint64_t> y;
+    uint64_t sum = 0;
+    const uint64_t want_sum = sweep(want, x, y);
+    if (ok) {
+        BENCH(b, "bfs vector<vector<int>>", d = bfs_adjlist(adjlist, src));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+        ok = d == dist;
+
+        BENCH(b, "bfs csr input order", d = bfs_distances(g1, src));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+        ok = ok && d == dist;
+
+        BENCH(b, "bfs csr mmap", d = bfs_distances(mapped.view(), src));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+        ok = ok && d == dist;
+
+        BENCH(b, "sweep csr input order", sum = sweep(g1, x, y); BENCH_DO_NOT_OPTIMIZE(sum));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+        ok = ok && sum == want_sum;
+        if (!ok) std::fprintf(stderr, "MISMATCH: BFS/sweep results differ between representations (m=%zu)\n", m);
+    }
+    adjlist.clear();
+    adjlist.shrink_to_fit();
+
+    static const struct {
+        const char* name;
+        std::vector<uint32_t> (*order)(const csr_view&);
+    } orders[] = {{"bfs", bfs_order}, {"rcm", rcm_order}};
+    if (ok) print_span("input", want);
+    for (const auto& o : orders) {
+        if (!ok) break;
+        char name[64];
+        std::vector<uint32_t> order;
+        csr_graph h;
+        std::snprintf(name, sizeof name, "reorder %s + permute", o.name);
+        BENCH(b, name, {
+            order = o.order(want);
+            h = csr_permute(want, order);
+        });
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+
+        uint32_t new_src = inverse_order(order)[src];
+        std::snprintf(name, sizeof name, "bfs csr %s order", o.name);
+        BENCH(b, name, d = bfs_distances(h, new_src));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+
+        std::snprintf(name, sizeof name, "sweep csr %s order", o.name);
+        BENCH(b, name, sum = sweep(h, x, y); BENCH_DO_NOT_OPTIMIZE(sum));
+        bench_set_size(&b, n, arc_bytes);
+        bench_report(&b);
+        print_span(o.name, h);
+        if (order.size() != n || !csr_validate(h) || !permuted_dist_ok(order, dist, d) || sum != want_sum) {
+            std::fprintf(stderr, "MISMATCH: %s reordering changed BFS/sweep results (m=%zu)\n", o.name, m);
+            ok = false;
+        }
+    }
+
+    mapped.close();
+    ::unlink(txt.c_str());
+    ::unlink(bin.c_str());
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    const char* tmp = std::getenv("TMPDIR");
+    std::string dir = tmp && *tmp ? tmp : "/tmp";
+    if (!check_orders()) return 1;
+
+    static const size_t defaults[] = {100000, 1000000, 10000000};
+    const size_t* sizes;
+    size_t n_sizes = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    bench_config_t saved = bench_config;
+    for (size_t i = 0; i < n_sizes; i++) {
+        if (sizes[i] < 16 || sizes[i] > (size_t{1} << 31)) {
+            std::fprintf(stderr, "# skip size %zu: must be 16..2^31\n", sizes[i]);
+            continue;
+        }
+        bench_config = saved;
+        if (sizes[i] >= LARGE_M) {
+            bench_config.samples = LARGE_SAMPLES;
+            bench_config.warmup = 1;
+        }
+        if (!bench_size(sizes[i], dir)) return 1;
+    }
+    bench_config = saved;
+    return bench_summary();
+}
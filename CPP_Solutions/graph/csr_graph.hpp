@@ -0,0 +1,104 @@
+/* CSR (压缩稀疏行) 图 + 串行 BFS (C++17)
+ *
+ * 顶点 v 的邻居是 adj[offsets[v] .. offsets[v + 1]), 全部邻接表连续存放在一个数组里:
+ * 遍历时顺序读内存, 比 vector<vector<int>> 少一次间接寻址, 也没有 n 次小块分配.
+ * 顶点编号 uint32_t, 偏移 uint64_t (边数可以超过 2^32).
+ *
+ *   std::vector<std::pair<uint32_t, uint32_t>> e = {{0, 1}, {1, 2}};
+ *   csr_graph g = csr_graph::from_edges(3, e, true);     // 无向: 每条边存两个方向
+ *   for (uint32_t w : g.neighbors(1)) ...
+ *   std::vector<uint32_t> d = bfs_distances(g, 0);        // 不可达为 CSR_UNREACHED
+ *
+ * csr_view 是不拥有内存的只读视图 (两个指针), csr_graph 可隐式转换成它; 图算法都接受视图,
+ * 所以同一份代码也能直接跑在 mmap 进来的二进制图上 (csr_io.hpp).
+ */
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+constexpr uint32_t CSR_UNREACHED = UINT32_MAX;
+
+struct csr_range {
+    const uint32_t* b;
+    const uint32_t* e;
+    const uint32_t* begin() const { return b; }
+    const uint32_t* end() const { return e; }
+    size_t size() const { return static_cast<size_t>(e - b); }
+};
+
+struct csr_graph {
+    uint32_t n = 0;
+    std::vector<uint64_t> offsets;  // n + 1 项
+    std::vector<uint32_t> adj;
+
+    using range = csr_range;
+
+    range neighbors(uint32_t v) const { return {adj.data() + offsets[v], adj.data() + offsets[v + 1]}; }
+    uint64_t degree(uint32_t v) const { return offsets[v + 1] - offsets[v]; }
+    uint64_t arcs() const { return adj.size(); }
+
+    /* 计数排序: 一遍数出度, 前缀和得到偏移, 再一遍填邻接表; 每个顶点的邻居保持边表中的顺序.
+     * 端点 >= n 的边视为调用方错误 (不检查) */
+    static csr_graph from_edges(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>>& edges,
+                                bool undirected) {
+        csr_graph g;
+        g.n = n;
+        g.offsets.assign(size_t{n} + 1, 0);
+        for (const auto& e : edges) {
+            g.offsets[e.first + 1]++;
+            if (undirected) g.offsets[e.second + 1]++;
+        }
+        for (uint32_t v = 0; v < n; v++) g.offsets[v + 1] += g.offsets[v];
+        g.adj.resize(g.offsets[n]);
+        std::vector<uint64_t> pos(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) {
+            g.adj[pos[e.first]++] = e.second;
+            if (undirected) g.adj[pos[e.second]++] = e.first;
+        }
+        return g;
+    }
+};
+
+struct csr_view {
+    uint32_t n = 0;
+    const uint64_t* offsets = nullptr;  // n + 1 项
+    const uint32_t* adj = nullptr;
+
+    using range = csr_range;
+
+    csr_view() = default;
+    csr_view(uint32_t n_, const uint64_t* off, const uint32_t* a) : n(n_), offsets(off), adj(a) {}
+    // 有意不加 explicit: 接受视图的算法可以直接传 csr_graph
+    csr_view(const csr_graph& g) : n(g.n), offsets(g.offsets.data()), adj(g.adj.data()) {}
+
+    range neighbors(uint32_t v) const { return {adj + offsets[v], adj + offsets[v + 1]}; }
+    uint64_t degree(uint32_t v) const { return offsets[v + 1] - offsets[v]; }
+    uint64_t arcs() const { return offsets ? offsets[n] : 0; }
+};
+
+/* 队列就是输出顺序数组本身: 访问过的顶点依次追加, 头指针往后扫 */
+inline std::vector<uint32_t> bfs_distances(const csr_view& g, uint32_t src) {
+    std::vector<uint32_t> dist(g.n, CSR_UNREACHED);
+    if (src >= g.n) return dist;
+    std::vector<uint32_t> queue;
+    queue.reserve(g.n);
+    dist[src] = 0;
+    queue.push_back(src);
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t u = queue[head];
+        uint32_t du = dist[u] + 1;
+        for (uint32_t w : g.neighbors(u)) {
+            if (dist[w] == CSR_UNREACHED) {
+                dist[w] = du;
+                queue.push_back(w);
+            }
+        }
+    }
+    return dist;
+}
+
+#endif /* CSR_GRAPH_HPP */
@@ -0,0 +1,185 @@
+/* CSR 图的顶点重排: BFS 序 / RCM (Reverse Cuthill-McKee), 让相邻顶点的编号也相邻 (C++17)
+ *
+ * 输入文件里的顶点编号往往是随意的 (哈希、抓取顺序), BFS 访问邻居时 dist[w] / offsets[w] 散落在
+ * 整个数组里, 几乎每次都是缓存缺失. 按遍历顺序重新编号后, 同一层、相邻层的顶点落在相邻的缓存行,
+ * 对道路网、规则网格、有限元网格这类有几何结构的图效果明显; 纯随机图没有局部性可挖.
+ *
+ *   bfs_order  每个连通分量从编号最小的未访问顶点开始 BFS, 按出队顺序编号. O(n + m).
+ *   rcm_order  每个分量从伪外围点 (George-Liu: 反复取 BFS 最后一层里度数最小的点, 直到离心率不再增大)
+ *              出发做 BFS, 新发现的邻居按度数升序入队, 最后整体反转. 目标是减小带宽 max|u - v|,
+ *              多了每个顶点一次邻居排序和几遍找起点的 BFS, 约是 bfs_order 的几倍.
+ * 有向图也可以重排: 两者都只沿出边走, 从一个起点到不了的顶点留给后面的起点, 结果仍是一个排列;
+ * 找伪外围点的 BFS 同样跳过已编号的顶点, 否则可能选中别的分量里已经编过号的点.
+ *
+ * order[i] 是新编号 i 对应的旧顶点; csr_permute 据此生成重编号的新图 (每个邻接表按新编号升序).
+ * 由旧图的结果换到新图: new_dist[i] == old_dist[order[i]], 起点为 inverse_order(order)[old_src].
+ *
+ *   std::vector<uint32_t> order = rcm_order(g);
+ *   csr_graph h = csr_permute(g, order);
+ *   csr_span_stats s = csr_span(h);                // 带宽 / 平均边跨度, 衡量重排效果
+ */
+#ifndef CSR_REORDER_HPP
+#define CSR_REORDER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+namespace csr_detail {
+
+/* 从 s 出发在 seen[] != stamp 且未编号 (placed[] == 0) 的顶点上做 BFS, 顶点依次写入 queue;
+ * 返回最后一层在 queue 里的起点 */
+inline size_t bfs_levels(const csr_view& g, uint32_t s, const std::vector<uint8_t>& placed,
+                         std::vector<uint32_t>& seen, uint32_t stamp, std::vector<uint32_t>& queue, uint32_t& ecc) {
+    queue.clear();
+    queue.push_back(s);
+    seen[s] = stamp;
+    size_t level_begin = 0;
+    ecc = 0;
+    for (size_t head = 0, level_end = 1; head < queue.size();) {
+        for (; head < level_end; head++)
+            for (uint32_t w : g.neighbors(queue[head]))
+                if (seen[w] != stamp && !placed[w]) {
+                    seen[w] = stamp;
+                    queue.push_back(w);
+                }
+        if (queue.size() == level_end) break;
+        level_begin = level_end;
+        level_end = queue.size();
+        ecc++;
+    }
+    return level_begin;
+}
+
+/* George-Liu 伪外围点; 迭代次数设上限, 病态图上最多多做几遍 BFS. s 必须未编号, 返回的点也未编号 */
+inline uint32_t pseudo_peripheral(const csr_view& g, uint32_t s, const std::vector<uint8_t>& placed,
+                                  std::vector<uint32_t>& seen, uint32_t& stamp, std::vector<uint32_t>& queue) {
+    uint32_t ecc;
+    size_t last = bfs_levels(g, s, placed, seen, ++stamp, queue, ecc);
+    for (int iter = 0; iter < 8; iter++) {
+        uint32_t best = queue[last];
+        for (size_t i = last + 1; i < queue.size(); i++)
+            if (g.degree(queue[i]) < g.degree(best)) best = queue[i];
+        uint32_t e2;
+        size_t l2 = bfs_levels(g, best, placed, seen, ++stamp, queue, e2);
+        if (e2 <= ecc) return s;
+        s = best;
+        ecc = e2;
+        last = l2;
+    }
+    return s;
+}
+
+}  // namespace csr_detail
+
+inline std::vector<uint32_t> bfs_order(const csr_view& g) {
+    std::vector<uint32_t> order;
+    order.reserve(g.n);
+    std::vector<uint8_t> placed(g.n, 0);
+    for (uint32_t s = 0; s < g.n; s++) {
+        if (placed[s]) continue;
+        placed[s] = 1;
+        order.push_back(s);
+        for (size_t head = order.size() - 1; head < order.size(); head++)
+            for (uint32_t w : g.neighbors(order[head]))
+                if (!placed[w]) {
+                    placed[w] = 1;
+                    order.push_back(w);
+                }
+    }
+    return order;
+}
+
+inline std::vector<uint32_t> rcm_order(const csr_view& g) {
+    const uint32_t n = g.n;
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    if (n == 0) return order;
+
+    // 候选起点按度数升序 (计数排序): 每个分量从度数最小的点开始找伪外围点
+    uint64_t max_deg = 0;
+    for (uint32_t v = 0; v < n; v++) max_deg = std::max(max_deg, g.degree(v));
+    std::vector<uint32_t> cnt(static_cast<size_t>(max_deg) + 2, 0), by_degree(n);
+    for (uint32_t v = 0; v < n; v++) cnt[g.degree(v) + 1]++;
+    for (size_t d = 1; d < cnt.size(); d++) cnt[d] += cnt[d - 1];
+    for (uint32_t v = 0; v < n; v++) by_degree[cnt[g.degree(v)]++] = v;
+
+    std::vector<uint8_t> placed(n, 0);
+    std::vector<uint32_t> seen(n, 0), queue;
+    uint32_t stamp = 0;
+    auto by_deg = [&](uint32_t a, uint32_t b) {
+        uint64_t da = g.degree(a), db = g.degree(b);
+        return da != db ? da < db : a < b;
+    };
+    for (uint32_t cand : by_degree) {
+        // 有向图上伪外围点 s 未必能反过来到达 cand, 所以一直做到 cand 本身被编号为止 (每轮至少编号 s)
+        while (!placed[cand]) {
+            if (stamp > UINT32_MAX - 16) {  // 分量极多时 stamp 会绕回, 清零重来
+                std::fill(seen.begin(), seen.end(), 0);
+                stamp = 0;
+            }
+            uint32_t s = csr_detail::pseudo_peripheral(g, cand, placed, seen, stamp, queue);
+            placed[s] = 1;
+            order.push_back(s);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                size_t first = order.size();
+                for (uint32_t w : g.neighbors(order[head]))
+                    if (!placed[w]) {
+                        placed[w] = 1;
+                        order.push_back(w);
+                    }
+                std::sort(order.begin() + static_cast<std::ptrdiff_t>(first), order.end(), by_deg);
+            }
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/* inverse[old] = new */
+inline std::vector<uint32_t> inverse_order(const std::vector<uint32_t>& order) {
+    std::vector<uint32_t> inv(order.size());
+    for (size_t i = 0; i < order.size(); i++) inv[order[i]] = static_cast<uint32_t>(i);
+    return inv;
+}
+
+/* order 必须是 0..n-1 的一个排列 (不检查) */
+inline csr_graph csr_permute(const csr_view& g, const std::vector<uint32_t>& order) {
+    const std::vector<uint32_t> inv = inverse_order(order);
+    csr_graph h;
+    h.n = g.n;
+    h.offsets.resize(size_t{g.n} + 1);
+    h.offsets[0] = 0;
+    for (uint32_t i = 0; i < g.n; i++) h.offsets[i + 1] = h.offsets[i] + g.degree(order[i]);
+    h.adj.resize(h.offsets[g.n]);
+    for (uint32_t i = 0; i < g.n; i++) {
+        uint32_t* out = h.adj.data() + h.offsets[i];
+        uint32_t* p = out;
+        for (uint32_t w : g.neighbors(order[i])) *p++ = inv[w];
+        std::sort(out, p);
+    }
+    return h;
+}
+
+struct csr_span_stats {
+    uint64_t bandwidth;  // max |u - v|
+    double mean;         // 所有弧的平均 |u - v|
+};
+
+inline csr_span_stats csr_span(const csr_view& g) {
+    uint64_t mx = 0;
+    double sum = 0;
+    for (uint32_t u = 0; u < g.n; u++)
+        for (uint32_t w : g.neighbors(u)) {
+            uint64_t d = u > w ? u - w : w - u;
+            mx = std::max(mx, d);
+            sum += static_cast<double>(d);
+        }
+    uint64_t m = g.arcs();
+    return {mx, m ? sum / static_cast<double>(m) : 0.0};
+}
+
+#endif /* CSR_REORDER_HPP */
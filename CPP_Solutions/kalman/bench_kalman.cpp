@@ -0,0 +1,258 @@
+/* 卡尔曼滤波 predict()+update() 耗时: 编译期维度 vs 特化 vs 动态矩阵 (std::vector) 朴素实现
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c ../../Templates/benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -I../../Templates bench_kalman.cpp benchmark.o -o bench_kalman
+ * 在 x86 上加 -DBENCH_TIMER=BENCH_TIMER_TSC 可直接得到 cycles/op.
+ * 计时前先让各实现跑同一段观测序列, 状态 x 与协方差 P 与动态矩阵版的差超出容差就报 MISMATCH.
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "kalman.hpp"
+
+namespace {
+
+// 朴素动态矩阵: 每次运算都在堆上分配结果, 逆矩阵用带主元的 Gauss-Jordan
+struct DynMat {
+    size_t r, c;
+    std::vector<float> a;
+    DynMat(size_t rows, size_t cols) : r(rows), c(cols), a(rows * cols, 0.0f) {}
+    float& operator()(size_t i, size_t j) { return a[i * c + j]; }
+    float operator()(size_t i, size_t j) const { return a[i * c + j]; }
+    static DynMat eye(size_t n) {
+        DynMat m(n, n);
+        for (size_t i = 0; i < n; ++i) m(i, i) = 1.0f;
+        return m;
+    }
+};
+
+DynMat operator*(const DynMat& A, const DynMat& B) {
+    DynMat out(A.r, B.c);
+    for (size_t i = 0; i < A.r; ++i)
+        for (size_t j = 0; j < B.c; ++j)
+            for (size_t k = 0; k < A.c; ++k) out(i, j) += A(i, k) * B(k, j);
+    return out;
+}
+
+DynMat operator+(const DynMat& A, const DynMat& B) {
+    DynMat out = A;
+    for (size_t i = 0; i < out.a.size(); ++i) out.a[i] += B.a[i];
+    return out;
+}
+
+DynMat operator-(const DynMat& A, const DynMat& B) {
+    DynMat out = A;
+    for (size_t i = 0; i < out.a.size(); ++i) out.a[i] -= B.a[i];
+    return out;
+}
+
+DynMat trans(const DynMat& A) {
+    DynMat out(A.c, A.r);
+    for (size_t i = 0; i < A.r; ++i)
+        for (size_t j = 0; j < A.c; ++j) out(j, i) = A(i, j);
+    return out;
+}
+
+DynMat inverse(DynMat A) {
+    size_t n = A.r;
+    DynMat inv = DynMat::eye(n);
+    for (size_t col = 0; col < n; ++col) {
+        size_t piv = col;
+        for (size_t i = col + 1; i < n; ++i)
+            if (__builtin_fabsf(A(i, col)) > __builtin_fabsf(A(piv, col))) piv = i;
+        for (size_t j = 0; j < n; ++j) {
+            std::swap(A(col, j), A(piv, j));
+            std::swap(inv(col, j), inv(piv, j));
+        }
+        float d = 1.0f / A(col, col);
+        for (size_t j = 0; j < n; ++j) {
+            A(col, j) *= d;
+            inv(col, j) *= d;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (i == col) continue;
+            float f = A(i, col);
+            for (size_t j = 0; j < n; ++j) {
+                A(i, j) -= f * A(col, j);
+                inv(i, j) -= f * inv(col, j);
+            }
+        }
+    }
+    return inv;
+}
+
+struct DynKalman {
+    DynMat x, P, F, Q, H, R;
+    DynKalman(size_t n, size_t m)
+        : x(n, 1), P(DynMat::eye(n)), F(DynMat::eye(n)), Q(n, n), H(m, n), R(DynMat::eye(m)) {}
+    void predict() {
+        x = F * x;
+        P = F * P * trans(F) + Q;
+    }
+    void update(const DynMat& z) {
+        DynMat y = z - H * x;
+        DynMat S = H * P * trans(H) + R;
+        DynMat K = P * trans(H) * inverse(S);
+        x = x + K * y;
+        P = (DynMat::eye(P.r) - K * H) * P;
+    }
+};
+
+// 匀速模型: 前 N/2 维是位置, 后 N/2 维是速度, 观测前 M 维位置
+template <size_t N, size_t M, class KF>
+void setup_cv(KF& kf, float dt) {
+    for (size_t i = 0; i < N / 2; ++i) {
+        kf.F(i, i + N / 2) = dt;
+        kf.Q(i, i) = 1e-4f;
+        kf.Q(i + N / 2, i + N / 2) = 1e-3f;
+    }
+    for (size_t i = 0; i < M; ++i) {
+        kf.H(i, i) = 1.0f;
+        kf.R(i, i) = 0.05f;
+    }
+}
+
+constexpr float kDt = 1e-3f;
+constexpr size_t kSteps = 64;  // 每次迭代跑的 predict+update 步数
+float g_z[kSteps];
+constexpr size_t kCheckSteps = 4 * kSteps;  // 自检步数: P 从初值收敛到稳态要几十步
+constexpr float kTol = 1e-4f;               // 相对误差上限, 绝对值很小时按 max(|ref|, 1) 计
+
+// 误差 / max(|ref|, 1): 两个实现的运算顺序不同, float 结果不会逐位相同
+float rel_err(float got, float ref) {
+    return std::fabs(got - ref) / std::fmax(std::fabs(ref), 1.0f);
+}
+
+// 同一观测序列下 kf (编译期维度) 与 DynKalman 逐步比较 x 和 P; 返回 x / P 的最大误差, 超出容差时返回 -1
+template <size_t N, size_t M, class KF>
+float check_static(const char* name) {
+    KF kf;
+    DynKalman ref(N, M);
+    setup_cv<N, M>(kf, kDt);
+    setup_cv<N, M>(ref, kDt);
+    DynMat zr(M, 1);
+    float worst = 0.0f;
+    for (size_t k = 0; k < kCheckSteps; ++k) {
+        Vec<M> z{};
+        for (size_t m = 0; m < M; ++m) z[m] = zr(m, 0) = g_z[k % kSteps];
+        kf.predict();
+        kf.update(z);
+        ref.predict();
+        ref.update(zr);
+        for (size_t i = 0; i < N; ++i) {
+            worst = std::fmax(worst, rel_err(kf.x[i], ref.x(i, 0)));
+            for (size_t j = 0; j < N; ++j) worst = std::fmax(worst, rel_err(kf.P(i, j), ref.P(i, j)));
+        }
+        if (worst > kTol) {
+            std::fprintf(stderr, "MISMATCH: %s step %zu: error %.3g vs dynamic\n", name, k, static_cast<double>(worst));
+            return -1.0f;
+        }
+    }
+    std::fprintf(stderr, "# %s vs dynamic over %zu steps: max error %.3g\n", name, kCheckSteps,
+                 static_cast<double>(worst));
+    return worst;
+}
+
+float check_scalar() {
+    Kalman<1, 1> kf;
+    kf.Q = 1e-4f;
+    kf.R = 0.05f;
+    DynKalman ref(1, 1);
+    ref.Q(0, 0) = 1e-4f;
+    ref.H(0, 0) = 1.0f;
+    ref.R(0, 0) = 0.05f;
+    DynMat zr(1, 1);
+    float worst = 0.0f;
+    for (size_t k = 0; k < kCheckSteps; ++k) {
+        zr(0, 0) = g_z[k % kSteps];
+        kf.predict();
+        kf.update(g_z[k % kSteps]);
+        ref.predict();
+        ref.update(zr);
+        worst = std::fmax(worst, std::fmax(rel_err(kf.x, ref.x(0, 0)), rel_err(kf.P, ref.P(0, 0))));
+        if (worst > kTol) {
+            std::fprintf(stderr, "MISMATCH: kalman<1,1> step %zu: error %.3g vs dynamic\n", k,
+                         static_cast<double>(worst));
+            return -1.0f;
+        }
+    }
+    std::fprintf(stderr, "# kalman<1,1> vs dynamic over %zu steps: max error %.3g\n", kCheckSteps,
+                 static_cast<double>(worst));
+    return worst;
+}
+
+template <size_t N, size_t M, class KF>
+void bench_static(const char* name) {
+    KF kf;
+    setup_cv<N, M>(kf, kDt);
+    bench_t b;
+    BENCH(b, name, {
+        for (size_t k = 0; k < kSteps; ++k) {
+            Vec<M> z{};
+            for (size_t m = 0; m < M; ++m) z[m] = g_z[k];
+            kf.predict();
+            kf.update(z);
+        }
+        BENCH_DO_NOT_OPTIMIZE(kf.x[0]);
+    });
+    bench_set_size(&b, kSteps, 0);
+    bench_report(&b);
+}
+
+template <size_t N, size_t M>
+void bench_dynamic(const char* name) {
+    DynKalman kf(N, M);
+    setup_cv<N, M>(kf, kDt);
+    DynMat z(M, 1);
+    bench_t b;
+    BENCH(b, name, {
+        for (size_t k = 0; k < kSteps; ++k) {
+            for (size_t m = 0; m < M; ++m) z(m, 0) = g_z[k];
+            kf.predict();
+            kf.update(z);
+        }
+        BENCH_DO_NOT_OPTIMIZE(kf.x(0, 0));
+    });
+    bench_set_size(&b, kSteps, 0);
+    bench_report(&b);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    for (size_t k = 0; k < kSteps; ++k) g_z[k] = 0.002f * static_cast<float>(k) + 0.01f * static_cast<float>(k % 7);
+
+    if (check_scalar() < 0.0f || check_static<2, 1, Kalman<2, 1>>("kalman<2,1> specialized") < 0.0f ||
+        check_static<2, 1, KalmanGeneric<2, 1>>("kalman<2,1> generic") < 0.0f ||
+        check_static<4, 2, Kalman<4, 2>>("kalman<4,2> generic") < 0.0f ||
+        check_static<6, 3, Kalman<6, 3>>("kalman<6,3> generic") < 0.0f)
+        return 1;
+
+    {
+        Kalman<1, 1> kf;
+        kf.Q = 1e-4f;
+        kf.R = 0.05f;
+        bench_t b;
+        BENCH(b, "kalman<1,1> scalar", {
+            for (size_t k = 0; k < kSteps; ++k) {
+                kf.predict();
+                kf.update(g_z[k]);
+            }
+            BENCH_DO_NOT_OPTIMIZE(kf.x);
+        });
+        bench_set_size(&b, kSteps, 0);
+        bench_report(&b);
+    }
+    bench_static<2, 1, Kalman<2, 1>>("kalman<2,1> specialized");
+    bench_static<2, 1, KalmanGeneric<2, 1>>("kalman<2,1> generic");
+    bench_dynamic<2, 1>("kalman<2,1> dynamic");
+    bench_static<4, 2, Kalman<4, 2>>("kalman<4,2> generic");
+    bench_dynamic<4, 2>("kalman<4,2> dynamic");
+    bench_static<6, 3, Kalman<6, 3>>("kalman<6,3> generic");
+    bench_dynamic<6, 3>("kalman<6,3> dynamic");
+    return bench_summary();
+}
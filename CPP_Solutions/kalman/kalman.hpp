@@ -0,0 +1,256 @@
+/* 简化卡尔曼滤波器 - 编译期维度, 零堆内存 (C++17)
+ *
+ * Kalman<N, M>: N 维状态, M 维观测. 所有矩阵都是 std::array 上的 Mat<R, C>, 尺寸在编译期确定;
+ * 乘法用 index_sequence 折叠表达式完全展开, 求逆/分解只有固定次数的循环,
+ * 没有数据相关的分支, 所以每次 predict()/update() 的指令数是确定的.
+ *
+ *   Kalman<4, 2> kf;                  // 平面匀速模型: 状态 (px, py, vx, vy), 观测 (px, py)
+ *   kf.F = ...; kf.H = ...; kf.Q = ...; kf.R = ...;
+ *   kf.predict();
+ *   kf.update({zx, zy});
+ *
+ * 1 维 (Kalman<1, 1>) 与 2 维状态标量观测 (Kalman<2, 1>, 位置 + 速度) 有专门的特化,
+ * 公式手工展开并利用 P 的对称性, 完全不走通用矩阵路径. KalmanGeneric<N, M> 始终是通用实现.
+ */
+#ifndef KALMAN_HPP
+#define KALMAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+template <size_t R, size_t C, class T = float>
+struct Mat {
+    std::array<T, R * C> a{};  // 行主序
+
+    constexpr T& operator()(size_t r, size_t c) { return a[r * C + c]; }
+    constexpr const T& operator()(size_t r, size_t c) const { return a[r * C + c]; }
+    constexpr T& operator[](size_t i) { return a[i]; }  // 向量 (C == 1) 按下标访问
+    constexpr const T& operator[](size_t i) const { return a[i]; }
+
+    static constexpr Mat identity() {
+        static_assert(R == C, "identity() needs a square matrix");
+        Mat m{};
+        for (size_t i = 0; i < R; ++i) m.a[i * C + i] = T(1);
+        return m;
+    }
+};
+
+template <size_t N, class T = float>
+using Vec = Mat<N, 1, T>;
+
+namespace kalman_detail {
+
+template <class F, size_t... I>
+constexpr void unroll(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+// 对 I = 0..N-1 依次调用 f(integral_constant<I>), 在编译期完全展开
+template <size_t N, class F>
+constexpr void static_for(F&& f) {
+    unroll(f, std::make_index_sequence<N>{});
+}
+
+// A 的第 i 行与 B 的第 j 列的点积 (B 按 B^T 存储时取第 j 行), 折叠成固定顺序的乘加
+template <size_t I, size_t J, size_t K, size_t CB, bool BT, class T, size_t RA, size_t RB, size_t... k>
+constexpr T dot(const std::array<T, RA>& a, const std::array<T, RB>& b, std::index_sequence<k...>) {
+    if constexpr (BT)
+        return ((a[I * K + k] * b[J * K + k]) + ...);
+    else
+        return ((a[I * K + k] * b[k * CB + J]) + ...);
+}
+
+}  // namespace kalman_detail
+
+// ---------------- 矩阵运算 (全部展开) ----------------
+
+template <size_t R, size_t K, size_t C, class T>
+constexpr Mat<R, C, T> operator*(const Mat<R, K, T>& A, const Mat<K, C, T>& B) {
+    Mat<R, C, T> out{};
+    kalman_detail::static_for<R * C>([&](auto idx) {
+        constexpr size_t i = decltype(idx)::value / C, j = decltype(idx)::value % C;
+        out.a[idx] = kalman_detail::dot<i, j, K, C, false>(A.a, B.a, std::make_index_sequence<K>{});
+    });
+    return out;
+}
+
+// A * B^T, 不生成转置副本: F P F^T 与 P H^T 都用它
+template <size_t R, size_t K, size_t C, class T>
+constexpr Mat<R, C, T> mul_bt(const Mat<R, K, T>& A, const Mat<C, K, T>& B) {
+    Mat<R, C, T> out{};
+    kalman_detail::static_for<R * C>([&](auto idx) {
+        constexpr size_t i = decltype(idx)::value / C, j = decltype(idx)::value % C;
+        out.a[idx] = kalman_detail::dot<i, j, K, C, true>(A.a, B.a, std::make_index_sequence<K>{});
+    });
+    return out;
+}
+
+template <size_t R, size_t C, class T>
+constexpr Mat<C, R, T> transpose(const Mat<R, C, T>& A) {
+    Mat<C, R, T> out{};
+    kalman_detail::static_for<R * C>([&](auto idx) {
+        constexpr size_t i = decltype(idx)::value / C, j = decltype(idx)::value % C;
+        out.a[j * R + i] = A.a[idx];
+    });
+    return out;
+}
+
+template <size_t R, size_t C, class T>
+constexpr Mat<R, C, T> operator+(const Mat<R, C, T>& A, const Mat<R, C, T>& B) {
+    Mat<R, C, T> out{};
+    kalman_detail::static_for<R * C>([&](auto i) { out.a[i] = A.a[i] + B.a[i]; });
+    return out;
+}
+
+template <size_t R, size_t C, class T>
+constexpr Mat<R, C, T> operator-(const Mat<R, C, T>& A, const Mat<R, C, T>& B) {
+    Mat<R, C, T> out{};
+    kalman_detail::static_for<R * C>([&](auto i) { out.a[i] = A.a[i] - B.a[i]; });
+    return out;
+}
+
+// 对称正定矩阵求逆 (新息协方差 S = H P H^T + R 总是对称正定).
+// 1x1 / 2x2 用闭式解; 更大的用 LDL^T 分解, 不开方、不选主元, 循环次数固定.
+template <size_t M, class T>
+constexpr Mat<M, M, T> inverse_spd(const Mat<M, M, T>& S) {
+    Mat<M, M, T> inv{};
+    if constexpr (M == 1) {
+        inv.a[0] = T(1) / S.a[0];
+    } else if constexpr (M == 2) {
+        T d = T(1) / (S.a[0] * S.a[3] - S.a[1] * S.a[2]);
+        inv.a[0] = S.a[3] * d;
+        inv.a[1] = -S.a[1] * d;
+        inv.a[2] = -S.a[2] * d;
+        inv.a[3] = S.a[0] * d;
+    } else {
+        Mat<M, M, T> L = Mat<M, M, T>::identity();  // 单位下三角
+        std::array<T, M> d{}, inv_d{};
+        for (size_t j = 0; j < M; ++j) {
+            d[j] = S(j, j);
+            for (size_t k = 0; k < j; ++k) d[j] -= L(j, k) * L(j, k) * d[k];
+            inv_d[j] = T(1) / d[j];
+            for (size_t i = j + 1; i < M; ++i) {
+                T s = S(i, j);
+                for (size_t k = 0; k < j; ++k) s -= L(i, k) * L(j, k) * d[k];
+                L(i, j) = s * inv_d[j];
+            }
+        }
+        // L^-1 (仍是单位下三角), 前代求出
+        Mat<M, M, T> Li = Mat<M, M, T>::identity();
+        for (size_t i = 1; i < M; ++i)
+            for (size_t j = 0; j < i; ++j) {
+                T s = T(0);
+                for (size_t k = j; k < i; ++k) s -= L(i, k) * Li(k, j);
+                Li(i, j) = s;
+            }
+        // S^-1 = L^-T D^-1 L^-1, 只算下三角再镜像
+        for (size_t i = 0; i < M; ++i)
+            for (size_t j = 0; j <= i; ++j) {
+                T s = T(0);
+                for (size_t k = i; k < M; ++k) s += Li(k, i) * Li(k, j) * inv_d[k];
+                inv(i, j) = s;
+                inv(j, i) = s;
+            }
+    }
+    return inv;
+}
+
+// ---------------- 通用实现 ----------------
+
+template <size_t N, size_t M, class T = float>
+class KalmanGeneric {
+    static_assert(N > 0 && M > 0, "Kalman dimensions must be positive");
+    static_assert(std::is_floating_point_v<T>, "Kalman needs a floating-point scalar");
+
+public:
+    Vec<N, T> x{};                                      // 状态估计
+    Mat<N, N, T> P = Mat<N, N, T>::identity();          // 估计协方差
+    Mat<N, N, T> F = Mat<N, N, T>::identity();          // 状态转移
+    Mat<N, N, T> Q{};                                   // 过程噪声
+    Mat<M, N, T> H{};                                   // 观测矩阵
+    Mat<M, M, T> R = Mat<M, M, T>::identity();          // 观测噪声
+
+    // x = F x;  P = F P F^T + Q
+    constexpr void predict() {
+        x = F * x;
+        P = mul_bt(F * P, F) + Q;
+    }
+
+    // K = P H^T (H P H^T + R)^-1;  x += K (z - H x);  P -= K H P
+    constexpr void update(const Vec<M, T>& z) {
+        Vec<M, T> y = z - H * x;
+        Mat<N, M, T> PHt = mul_bt(P, H);
+        Mat<M, M, T> S = H * PHt + R;
+        Mat<N, M, T> K = PHt * inverse_spd(S);
+        x = x + K * y;
+        P = P - mul_bt(K, PHt);  // P 对称, 所以 H P = (P H^T)^T
+    }
+};
+
+template <size_t N, size_t M, class T = float>
+class Kalman : public KalmanGeneric<N, M, T> {};
+
+// ---------------- 1 维特化: 全部是标量 ----------------
+
+template <class T>
+class Kalman<1, 1, T> {
+public:
+    T x = T(0), P = T(1), F = T(1), Q = T(0), H = T(1), R = T(1);
+
+    constexpr void predict() {
+        x = F * x;
+        P = F * F * P + Q;
+    }
+
+    constexpr void update(T z) {
+        T ph = P * H;
+        T k = ph / (H * ph + R);
+        x += k * (z - H * x);
+        P -= k * ph;
+    }
+};
+
+// ---------------- 2 维状态 + 标量观测 (位置/速度跟踪) ----------------
+// 与通用版接口相同, 但只计算 P 的 3 个独立元素, S 是标量, 无需求逆.
+
+template <class T>
+class Kalman<2, 1, T> {
+public:
+    Vec<2, T> x{};
+    Mat<2, 2, T> P = Mat<2, 2, T>::identity();
+    Mat<2, 2, T> F = Mat<2, 2, T>::identity();
+    Mat<2, 2, T> Q{};
+    Mat<1, 2, T> H{};
+    Mat<1, 1, T> R = Mat<1, 1, T>::identity();
+
+    constexpr void predict() {
+        const auto& f = F.a;
+        const auto& p = P.a;
+        T x0 = f[0] * x.a[0] + f[1] * x.a[1];
+        T x1 = f[2] * x.a[0] + f[3] * x.a[1];
+        x.a = {x0, x1};
+        T fp00 = f[0] * p[0] + f[1] * p[2], fp01 = f[0] * p[1] + f[1] * p[3];
+        T fp10 = f[2] * p[0] + f[3] * p[2], fp11 = f[2] * p[1] + f[3] * p[3];
+        T p00 = fp00 * f[0] + fp01 * f[1] + Q.a[0];
+        T p01 = fp00 * f[2] + fp01 * f[3] + Q.a[1];
+        T p11 = fp10 * f[2] + fp11 * f[3] + Q.a[3];
+        P.a = {p00, p01, p01, p11};
+    }
+
+    constexpr void update(const Vec<1, T>& z) {
+        const T h0 = H.a[0], h1 = H.a[1];
+        T pht0 = P.a[0] * h0 + P.a[1] * h1;
+        T pht1 = P.a[2] * h0 + P.a[3] * h1;
+        T inv_s = T(1) / (h0 * pht0 + h1 * pht1 + R.a[0]);
+        T k0 = pht0 * inv_s, k1 = pht1 * inv_s;
+        T y = z.a[0] - (h0 * x.a[0] + h1 * x.a[1]);
+        x.a[0] += k0 * y;
+        x.a[1] += k1 * y;
+        T p01 = P.a[1] - k0 * pht1;
+        P.a = {P.a[0] - k0 * pht0, p01, p01, P.a[3] - k1 * pht1};
+    }
+};
+
+#endif  // KALMAN_HPP
@@ -0,0 +1,195 @@
+/* 静态容器 vs 标准库: 插入 / 查找耗时, 结果按单次操作给出
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c ../../Templates/benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -I../../Templates bench_static_containers.cpp benchmark.o -o bench_static_containers
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "static_hash_map.hpp"
+#include "static_priority_queue.hpp"
+#include "static_string.hpp"
+#include "static_vector.hpp"
+
+namespace {
+
+constexpr size_t kVecN = 256;
+constexpr size_t kMapSlots = 4096;
+constexpr size_t kMapKeys = 3000;  // 装载因子约 0.73
+constexpr size_t kHeapN = 1024;
+
+std::vector<uint32_t> g_keys;    // 插入的键 (随机, 互不相同)
+std::vector<uint32_t> g_probe;   // 命中查找: 打乱顺序后的 g_keys
+std::vector<uint32_t> g_miss;    // 不存在的键
+std::vector<uint32_t> g_heap_in;
+
+void report(bench_t& b, size_t n) {
+    bench_set_size(&b, n, 0);
+    bench_report(&b);
+}
+
+template <class Vec>
+void bench_vector(const char* name) {
+    bench_t b;
+    BENCH(b, name, {
+        Vec v;
+        for (size_t k = 0; k < kVecN; ++k) v.push_back(static_cast<int>(k));
+        BENCH_DO_NOT_OPTIMIZE(v.data());
+    });
+    report(b, kVecN);
+}
+
+template <class Str>
+void bench_string(const char* name) {
+    static const char* const parts[] = {"motor", "_left", "_phase", "_current", "=", "1234"};
+    bench_t b;
+    BENCH(b, name, {
+        Str s;
+        for (const char* p : parts) s += p;
+        BENCH_DO_NOT_OPTIMIZE(s.data());
+    });
+    report(b, sizeof(parts) / sizeof(parts[0]));
+}
+
+// 每个样本从空表开始插入全部键; clear() 也计入 (std 容器在这里释放节点)
+template <class Map>
+void bench_map_insert(const char* name) {
+    static Map m;
+    bench_t b;
+    BENCH(b, name, {
+        m.clear();
+        for (uint32_t k : g_keys) m.emplace(k, k);
+        BENCH_DO_NOT_OPTIMIZE(m.size());
+    });
+    report(b, kMapKeys);
+}
+
+template <class Map>
+void bench_map_find(const char* name_hit, const char* name_miss) {
+    static Map m;
+    m.clear();
+    for (uint32_t k : g_keys) m.emplace(k, k);
+    bench_t b;
+    BENCH(b, name_hit, {
+        uint32_t acc = 0;
+        for (uint32_t k : g_probe) acc += m.find(k)->second;
+        BENCH_DO_NOT_OPTIMIZE(acc);
+    });
+    report(b, kMapKeys);
+    BENCH(b, name_miss, {
+        size_t hits = 0;
+        for (uint32_t k : g_miss) hits += m.count(k);
+        BENCH_DO_NOT_OPTIMIZE(hits);
+    });
+    report(b, kMapKeys);
+}
+
+// 全部 push 再全部 pop, 两种操作各 kHeapN 次
+template <class PQ>
+void bench_heap(const char* name) {
+    static PQ q;
+    bench_t b;
+    BENCH(b, name, {
+        for (uint32_t x : g_heap_in) q.push(x);
+        uint32_t acc = 0;
+        while (!q.empty()) {
+            acc += q.top();
+            q.pop();
+        }
+        BENCH_DO_NOT_OPTIMIZE(acc);
+    });
+    report(b, 2 * kHeapN);
+}
+
+// 与 std 容器逐项比对, 保证测的是同样的结果
+bool self_check() {
+    static static_hash_map<uint32_t, uint32_t, kMapSlots> sm;
+    std::unordered_map<uint32_t, uint32_t> um;
+    for (uint32_t k : g_keys) {
+        sm.emplace(k, k * 3u);
+        um.emplace(k, k * 3u);
+    }
+    for (uint32_t k : g_probe)
+        if (sm.at(k) != um.at(k)) return false;
+    for (uint32_t k : g_miss)
+        if (sm.count(k) != um.count(k)) return false;
+    for (size_t i = 0; i < kMapKeys / 2; ++i) {
+        sm.erase(g_keys[i]);
+        um.erase(g_keys[i]);
+    }
+    for (uint32_t k : g_keys)
+        if (sm.count(k) != um.count(k)) return false;
+
+    static static_priority_queue<uint32_t, kHeapN> sq;
+    std::priority_queue<uint32_t> sp;
+    for (uint32_t x : g_heap_in) {
+        sq.push(x);
+        sp.push(x);
+    }
+    while (!sp.empty()) {
+        if (sq.empty() || sq.top() != sp.top()) return false;
+        sq.pop();
+        sp.pop();
+    }
+
+    static_string<64> ss;
+    std::string s;
+    for (const char* p : {"motor", "_left", "_phase"}) {
+        ss += p;
+        s += p;
+    }
+    return ss == s && sq.empty();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+
+    std::mt19937 rng(12345);
+    static_hash_map<uint32_t, char, 8192> seen;  // 生成互不相同的键
+    while (g_keys.size() < kMapKeys) {
+        uint32_t k = rng();
+        if (seen.try_emplace(k).second) g_keys.push_back(k);
+    }
+    while (g_miss.size() < kMapKeys) {
+        uint32_t k = rng();
+        if (!seen.contains(k)) g_miss.push_back(k);
+    }
+    g_probe = g_keys;
+    std::shuffle(g_probe.begin(), g_probe.end(), rng);
+    for (size_t i = 0; i < kHeapN; ++i) g_heap_in.push_back(rng());
+
+    if (!self_check()) {
+        std::fprintf(stderr, "MISMATCH: static containers disagree with std\n");
+        return 1;
+    }
+
+    bench_vector<static_vector<int, kVecN>>("vector push_back: static_vector");
+    bench_vector<std::vector<int>>("vector push_back: std::vector");
+
+    bench_string<static_string<64>>("string append: static_string");
+    bench_string<std::string>("string append: std::string");
+
+    using SMap = static_hash_map<uint32_t, uint32_t, kMapSlots>;
+    using UMap = std::unordered_map<uint32_t, uint32_t>;
+    using OMap = std::map<uint32_t, uint32_t>;
+    bench_map_insert<SMap>("map insert: static_hash_map");
+    bench_map_insert<UMap>("map insert: std::unordered_map");
+    bench_map_insert<OMap>("map insert: std::map");
+    bench_map_find<SMap>("map find hit: static_hash_map", "map find miss: static_hash_map");
+    bench_map_find<UMap>("map find hit: std::unordered_map", "map find miss: std::unordered_map");
+    bench_map_find<OMap>("map find hit: std::map", "map find miss: std::map");
+
+    bench_heap<static_priority_queue<uint32_t, kHeapN>>("heap push+pop: static_priority_queue");
+    bench_heap<std::priority_queue<uint32_t>>("heap push+pop: std::priority_queue");
+
+    return bench_summary();
+}
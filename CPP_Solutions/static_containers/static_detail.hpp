@@ -0,0 +1,39 @@
+/* 静态容器公用部分 - 按容量选择最小的下标类型, 以及未初始化的元素存储 (C++17) */
+#ifndef STATIC_DETAIL_HPP
+#define STATIC_DETAIL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace static_detail {
+
+// 能表示 0..N 的最小无符号类型: static_vector<uint8_t, 32> 的长度只占 1 字节
+template <size_t N>
+using size_type_for = std::conditional_t<
+    N <= UINT8_MAX, uint8_t,
+    std::conditional_t<N <= UINT16_MAX, uint16_t, std::conditional_t<N <= UINT32_MAX, uint32_t, size_t>>>;
+
+// N 个 T 的未构造存储: 元素按需 placement-new, 所以 T 不需要默认构造函数, 空容器也不调用构造函数
+template <class T, size_t N>
+struct uninit_array {
+    alignas(T) unsigned char bytes[sizeof(T) * (N > 0 ? N : 1)];
+
+    T* data() { return std::launder(reinterpret_cast<T*>(bytes)); }
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(bytes)); }
+    T* slot(size_t i) { return reinterpret_cast<T*>(bytes) + i; }
+
+    template <class... Args>
+    T* construct(size_t i, Args&&... args) {
+        return ::new (static_cast<void*>(slot(i))) T(std::forward<Args>(args)...);
+    }
+    void destroy(size_t i) {
+        if constexpr (!std::is_trivially_destructible_v<T>) data()[i].~T();
+    }
+};
+
+}  // namespace static_detail
+
+#endif /* STATIC_DETAIL_HPP */
@@ -0,0 +1,253 @@
+/* 定长开放寻址哈希表 - 线性探测, 2 的幂掩码取模, 不分配堆内存 (C++17)
+ *
+ * static_hash_map<K, V, N>: N 个槽位 (必须是 2 的幂), 元素与占用标记都在对象内部.
+ * - 线性探测: 冲突时顺序看下一个槽位, 探测序列是连续内存, 对缓存最友好.
+ * - 最多存 max_size() = N - N/8 个元素 (装载因子 7/8), 保证查找失败时的探测链有界.
+ *   表满时 insert/emplace 返回 {end(), false}, operator[] 在调试构建中 assert.
+ * - 删除用反向移位 (Knuth 6.4 算法 R): 把后续同一探测链上的元素前移填洞, 没有墓碑,
+ *   长期增删也不会退化 (固定容量的表无法靠 rehash 清理墓碑).
+ * - 默认哈希 static_hash<K>: 整数键用乘法散列取高位 (std::hash 对整数是恒等映射,
+ *   配合掩码只用到低位, 连续或等步长的键会全部聚在一起), 其他类型在 std::hash 之后再混合一次.
+ * 接口与 std::unordered_map 的常用部分一致: find/count/contains/at/operator[]/insert/emplace/
+ * try_emplace/erase/clear 与前向迭代器 (value_type 为 std::pair<const K, V>).
+ * 删除会移动其他元素, 所以 erase 之后除返回值外的迭代器与引用都失效.
+ *
+ *   static static_hash_map<uint32_t, int, 256> ids;
+ *   ids[42] = 7;
+ *   if (auto it = ids.find(42); it != ids.end()) use(it->second);
+ */
+#ifndef STATIC_HASH_MAP_HPP
+#define STATIC_HASH_MAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "static_detail.hpp"
+
+template <class K>
+struct static_hash {
+    size_t operator()(const K& k) const noexcept {
+        uint64_t h;
+        if constexpr (std::is_integral_v<K> || std::is_enum_v<K>)
+            h = static_cast<uint64_t>(k);
+        else
+            h = static_cast<uint64_t>(std::hash<K>{}(k));
+        // Fibonacci 散列: 乘 2^64/phi, 高位混合了所有输入位; 再把高 32 位折到低位供掩码使用
+        h *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+template <class K, class V, size_t N, class Hash = static_hash<K>, class KeyEqual = std::equal_to<K>>
+class static_hash_map {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "static_hash_map slot count must be a power of two");
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    template <bool Const>
+    class basic_iterator {
+        using map_t = std::conditional_t<Const, const static_hash_map, static_hash_map>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = static_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        basic_iterator() = default;
+        basic_iterator(map_t* m, size_t i) : m_(m), i_(i) { skip(); }
+        operator basic_iterator<true>() const { return basic_iterator<true>(m_, i_); }
+
+        reference operator*() const { return m_->slots_.data()[i_]; }
+        pointer operator->() const { return &m_->slots_.data()[i_]; }
+        basic_iterator& operator++() {
+            ++i_;
+            skip();
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator t = *this;
+            ++*this;
+            return t;
+        }
+        bool operator==(const basic_iterator& o) const { return i_ == o.i_; }
+        bool operator!=(const basic_iterator& o) const { return i_ != o.i_; }
+
+    private:
+        friend class static_hash_map;
+        void skip() {
+            while (i_ < N && !m_->used_[i_]) ++i_;
+        }
+        map_t* m_ = nullptr;
+        size_t i_ = N;
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    static_hash_map() noexcept : size_(0), used_() {}
+    static_hash_map(std::initializer_list<value_type> init) : static_hash_map() {
+        for (const value_type& kv : init) insert(kv);
+    }
+    static_hash_map(const static_hash_map& o) : static_hash_map() {
+        for (const value_type& kv : o) insert(kv);
+    }
+    static_hash_map& operator=(const static_hash_map& o) {
+        if (this != &o) {
+            clear();
+            for (const value_type& kv : o) insert(kv);
+        }
+        return *this;
+    }
+    ~static_hash_map() { clear(); }
+
+    // ---------------- 迭代 / 容量 ----------------
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, N); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, N); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == max_size(); }
+    size_t size() const noexcept { return size_; }
+    static constexpr size_t max_size() noexcept { return N - N / 8; }
+    static constexpr size_t bucket_count() noexcept { return N; }
+    float load_factor() const noexcept { return static_cast<float>(size_) / static_cast<float>(N); }
+
+    // ---------------- 查找 ----------------
+
+    iterator find(const K& k) { return iterator(this, find_slot(k)); }
+    const_iterator find(const K& k) const { return const_iterator(this, find_slot(k)); }
+    size_t count(const K& k) const { return find_slot(k) != N; }
+    bool contains(const K& k) const { return find_slot(k) != N; }
+
+    V& at(const K& k) {
+        size_t i = find_slot(k);
+        assert(i != N && "static_hash_map::at: key not found");
+        return slots_.data()[i].second;
+    }
+    const V& at(const K& k) const {
+        size_t i = find_slot(k);
+        assert(i != N && "static_hash_map::at: key not found");
+        return slots_.data()[i].second;
+    }
+
+    // 键不存在时插入默认值; 表满且键不存在是调用方的错误
+    V& operator[](const K& k) {
+        auto r = try_emplace(k);
+        assert(r.second || r.first != end());
+        return r.first->second;
+    }
+
+    // ---------------- 插入 ----------------
+
+    // 键已存在时不覆盖, 返回 {已有元素, false}; 表满返回 {end(), false}
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const K& k, Args&&... args) {
+        size_t i = index_of(k);
+        for (;; i = (i + 1) & kMask) {
+            if (!used_[i]) break;
+            if (eq_(slots_.data()[i].first, k)) return {iterator(this, i), false};
+        }
+        if (size_ == max_size()) return {end(), false};
+        slots_.construct(i, std::piecewise_construct, std::forward_as_tuple(k),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+        used_[i] = 1;
+        ++size_;
+        return {iterator(this, i), true};
+    }
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const K& k, Args&&... args) {
+        return try_emplace(k, std::forward<Args>(args)...);
+    }
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const K& k, M&& v) {
+        auto r = try_emplace(k, std::forward<M>(v));
+        if (!r.second && r.first != end()) r.first->second = std::forward<M>(v);
+        return r;
+    }
+
+    // ---------------- 删除 ----------------
+
+    size_t erase(const K& k) {
+        size_t i = find_slot(k);
+        if (i == N) return 0;
+        erase_slot(i);
+        return 1;
+    }
+    // 返回下一个元素的迭代器: 后面被前移到洞里的元素从返回位置继续访问, 不会漏掉.
+    // 但探测链从表尾绕回表头时, 表头已遍历过的元素也可能被前移到洞里, 遍历中删除时会再访问它一次.
+    iterator erase(const_iterator pos) {
+        size_t i = pos.i_;
+        erase_slot(i);
+        return iterator(this, i);
+    }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < N; i++) {
+            if (used_[i]) {
+                slots_.destroy(i);
+                used_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    static constexpr size_t kMask = N - 1;
+
+    size_t index_of(const K& k) const { return hash_(k) & kMask; }
+
+    // 命中返回槽位下标, 否则返回 N. 装载因子 < 1 保证一定遇到空槽而终止.
+    size_t find_slot(const K& k) const {
+        for (size_t i = index_of(k);; i = (i + 1) & kMask) {
+            if (!used_[i]) return N;
+            if (eq_(slots_.data()[i].first, k)) return i;
+        }
+    }
+
+    void erase_slot(size_t hole) {
+        slots_.destroy(hole);
+        used_[hole] = 0;
+        --size_;
+        // 向后扫描直到空槽: 若元素 j 的理想位置不在 (hole, j] 区间内 (按环形计), 它可以前移到 hole
+        for (size_t j = (hole + 1) & kMask; used_[j]; j = (j + 1) & kMask) {
+            size_t home = index_of(slots_.data()[j].first);
+            if (((j - home) & kMask) >= ((j - hole) & kMask)) {
+                value_type* src = &slots_.data()[j];
+                slots_.construct(hole, std::move(*src));  // const K 只能复制, V 移动
+                slots_.destroy(j);
+                used_[hole] = 1;
+                used_[j] = 0;
+                hole = j;
+            }
+        }
+    }
+
+    size_t size_;
+    uint8_t used_[N];
+    static_detail::uninit_array<value_type, N> slots_;
+    Hash hash_;
+    KeyEqual eq_;
+};
+
+#endif /* STATIC_HASH_MAP_HPP */
@@ -0,0 +1,107 @@
+/* 定长容量优先队列 - static_vector 上的二叉堆, 不分配堆内存 (C++17)
+ *
+ * 接口与 std::priority_queue 相同 (默认 std::less, 即大顶堆; std::greater 得到小顶堆),
+ * 另有 full()/try_push() 与 clear(). 上浮/下沉用"挖洞"法: 只移动元素, 最后写一次, 不做 swap.
+ *
+ *   static_priority_queue<timer_event, 32, std::greater<>> timers;  // 最早到期的在堆顶
+ *   timers.push({now + 10, cb});
+ *   while (!timers.empty() && timers.top().deadline <= now) { timers.top().cb(); timers.pop(); }
+ */
+#ifndef STATIC_PRIORITY_QUEUE_HPP
+#define STATIC_PRIORITY_QUEUE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "static_vector.hpp"
+
+template <class T, size_t N, class Compare = std::less<T>>
+class static_priority_queue {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using container_type = static_vector<T, N>;
+    using value_compare = Compare;
+
+    static_priority_queue() = default;
+    explicit static_priority_queue(const Compare& cmp) : cmp_(cmp) {}
+
+    bool empty() const noexcept { return c_.empty(); }
+    bool full() const noexcept { return c_.full(); }
+    size_t size() const noexcept { return c_.size(); }
+    static constexpr size_t capacity() noexcept { return N; }
+
+    const T& top() const {
+        assert(!c_.empty());
+        return c_.front();
+    }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        c_.emplace_back(std::forward<Args>(args)...);
+        sift_up(c_.size() - 1);
+    }
+    void push(const T& x) { emplace(x); }
+    void push(T&& x) { emplace(std::move(x)); }
+
+    // 满了返回 false, 队列不变
+    bool try_push(const T& x) {
+        if (c_.full()) return false;
+        push(x);
+        return true;
+    }
+    bool try_push(T&& x) {
+        if (c_.full()) return false;
+        push(std::move(x));
+        return true;
+    }
+
+    void pop() {
+        assert(!c_.empty());
+        if (c_.size() > 1) {
+            T last = std::move(c_.back());
+            c_.pop_back();
+            sift_down(std::move(last));
+        } else {
+            c_.pop_back();
+        }
+    }
+
+    void clear() noexcept { c_.clear(); }
+
+private:
+    // 新元素从 i 开始往上走, 比它"小"的父节点依次下移
+    void sift_up(size_t i) {
+        T x = std::move(c_[i]);
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!cmp_(c_[parent], x)) break;
+            c_[i] = std::move(c_[parent]);
+            i = parent;
+        }
+        c_[i] = std::move(x);
+    }
+
+    // 堆顶出现空洞: 较大的孩子依次上移, 直到 x 可以放下
+    void sift_down(T x) {
+        size_t n = c_.size(), i = 0;
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && cmp_(c_[child], c_[child + 1])) ++child;
+            if (!cmp_(x, c_[child])) break;
+            c_[i] = std::move(c_[child]);
+            i = child;
+        }
+        c_[i] = std::move(x);
+    }
+
+    container_type c_;
+    Compare cmp_;
+};
+
+#endif /* STATIC_PRIORITY_QUEUE_HPP */
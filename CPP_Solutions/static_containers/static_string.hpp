@@ -0,0 +1,189 @@
+/* 定长容量字符串 - 最多 N 个字符加结尾 '\0', 存放在对象内部 (C++17)
+ *
+ * 常用的 std::string 接口 (append/+=/push_back/find/substr/compare/c_str) 都有,
+ * 可以隐式转换成 std::string_view, 与 string_view 互相比较.
+ * 超出容量时截断到 N 个字符 (与 strlcpy 相同), 不 assert: 日志/协议字段被截短通常比停机好,
+ * 需要知道是否截断时检查 append 之前的 size() + 追加长度 <= capacity(), 或调用 try_append.
+ *
+ *   static_string<32> name = "motor";
+ *   name += '_';
+ *   name += std::string_view("left");
+ *   uart_send(name.c_str(), name.size());
+ */
+#ifndef STATIC_STRING_HPP
+#define STATIC_STRING_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#include "static_detail.hpp"
+
+template <size_t N>
+class static_string {
+public:
+    using value_type = char;
+    using size_type = size_t;
+    using iterator = char*;
+    using const_iterator = const char*;
+    static constexpr size_t npos = std::string_view::npos;
+
+    static_string() noexcept : size_(0) { buf_[0] = '\0'; }
+    static_string(std::string_view s) noexcept : size_(0) { assign(s); }
+    static_string(const char* s) noexcept : static_string(std::string_view(s)) {}
+    static_string(const char* s, size_t n) noexcept : static_string(std::string_view(s, n)) {}
+    static_string(size_t n, char c) noexcept : size_(0) {
+        buf_[0] = '\0';
+        append(n, c);
+    }
+
+    static_string& operator=(std::string_view s) noexcept { return assign(s); }
+    static_string& operator=(const char* s) noexcept { return assign(std::string_view(s)); }
+
+    static_string& assign(std::string_view s) noexcept {
+        size_ = 0;
+        return append(s);
+    }
+
+    // ---------------- 访问 ----------------
+
+    const char* c_str() const noexcept { return buf_; }
+    const char* data() const noexcept { return buf_; }
+    char* data() noexcept { return buf_; }
+    char& operator[](size_t i) { return buf_[i]; }
+    const char& operator[](size_t i) const { return buf_[i]; }
+    char& at(size_t i) {
+        assert(i < size_);
+        return buf_[i];
+    }
+    const char& at(size_t i) const {
+        assert(i < size_);
+        return buf_[i];
+    }
+    char& front() { return buf_[0]; }
+    char& back() { return buf_[size_ - 1]; }
+    const char& front() const { return buf_[0]; }
+    const char& back() const { return buf_[size_ - 1]; }
+    operator std::string_view() const noexcept { return std::string_view(buf_, size_); }
+    std::string_view view() const noexcept { return std::string_view(buf_, size_); }
+
+    iterator begin() noexcept { return buf_; }
+    iterator end() noexcept { return buf_ + size_; }
+    const_iterator begin() const noexcept { return buf_; }
+    const_iterator end() const noexcept { return buf_ + size_; }
+    const_iterator cbegin() const noexcept { return buf_; }
+    const_iterator cend() const noexcept { return buf_ + size_; }
+
+    // ---------------- 容量 ----------------
+
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == N; }
+    size_t size() const noexcept { return size_; }
+    size_t length() const noexcept { return size_; }
+    static constexpr size_t capacity() noexcept { return N; }
+    static constexpr size_t max_size() noexcept { return N; }
+
+    // ---------------- 修改 (超出容量的部分被截掉) ----------------
+
+    static_string& append(std::string_view s) noexcept {
+        size_t n = s.size() < N - size_ ? s.size() : N - size_;
+        std::memmove(buf_ + size_, s.data(), n);  // s 可能指向自身
+        set_size(size_ + n);
+        return *this;
+    }
+    static_string& append(size_t n, char c) noexcept {
+        if (n > N - size_) n = N - size_;
+        std::memset(buf_ + size_, c, n);
+        set_size(size_ + n);
+        return *this;
+    }
+    // 放不下时不做任何修改, 返回 false
+    bool try_append(std::string_view s) noexcept {
+        if (s.size() > N - size_) return false;
+        append(s);
+        return true;
+    }
+
+    static_string& operator+=(std::string_view s) noexcept { return append(s); }
+    static_string& operator+=(const char* s) noexcept { return append(std::string_view(s)); }
+    static_string& operator+=(char c) noexcept {
+        push_back(c);
+        return *this;
+    }
+
+    void push_back(char c) noexcept {
+        if (size_ == N) return;
+        buf_[size_] = c;
+        set_size(size_ + 1);
+    }
+    void pop_back() noexcept {
+        assert(size_ > 0);
+        set_size(size_ - 1);
+    }
+    void resize(size_t n, char c = '\0') noexcept {
+        if (n > N) n = N;
+        if (n > size_) std::memset(buf_ + size_, c, n - size_);
+        set_size(n);
+    }
+    void clear() noexcept { set_size(0); }
+
+    static_string& erase(size_t pos = 0, size_t count = npos) noexcept {
+        assert(pos <= size_);
+        if (count > size_ - pos) count = size_ - pos;
+        std::memmove(buf_ + pos, buf_ + pos + count, size_ - pos - count);
+        set_size(size_ - count);
+        return *this;
+    }
+
+    // ---------------- 查找 / 比较 (转给 string_view) ----------------
+
+    size_t find(std::string_view s, size_t pos = 0) const noexcept { return view().find(s, pos); }
+    size_t find(char c, size_t pos = 0) const noexcept { return view().find(c, pos); }
+    size_t rfind(char c, size_t pos = npos) const noexcept { return view().rfind(c, pos); }
+    bool starts_with(std::string_view s) const noexcept { return view().substr(0, s.size()) == s; }
+    bool ends_with(std::string_view s) const noexcept {
+        return s.size() <= size_ && view().substr(size_ - s.size()) == s;
+    }
+    int compare(std::string_view s) const noexcept { return view().compare(s); }
+
+    static_string substr(size_t pos = 0, size_t count = npos) const noexcept {
+        return static_string(view().substr(pos, count));
+    }
+
+private:
+    void set_size(size_t n) noexcept {
+        size_ = static_cast<static_detail::size_type_for<N>>(n);
+        buf_[n] = '\0';
+    }
+
+    static_detail::size_type_for<N> size_;
+    char buf_[N + 1];
+};
+
+// 与 static_string / string_view / const char* 的比较都先转成 string_view
+template <size_t N>
+bool operator==(const static_string<N>& a, std::string_view b) noexcept { return a.view() == b; }
+template <size_t N>
+bool operator==(std::string_view a, const static_string<N>& b) noexcept { return a == b.view(); }
+template <size_t N, size_t M>
+bool operator==(const static_string<N>& a, const static_string<M>& b) noexcept { return a.view() == b.view(); }
+template <size_t N>
+bool operator!=(const static_string<N>& a, std::string_view b) noexcept { return a.view() != b; }
+template <size_t N>
+bool operator!=(std::string_view a, const static_string<N>& b) noexcept { return a != b.view(); }
+template <size_t N, size_t M>
+bool operator!=(const static_string<N>& a, const static_string<M>& b) noexcept { return a.view() != b.view(); }
+template <size_t N, size_t M>
+bool operator<(const static_string<N>& a, const static_string<M>& b) noexcept { return a.view() < b.view(); }
+
+// 可以直接作为 std::unordered_map / static_hash_map 的键
+namespace std {
+template <size_t N>
+struct hash<static_string<N>> {
+    size_t operator()(const static_string<N>& s) const noexcept { return hash<string_view>{}(s.view()); }
+};
+}  // namespace std
+
+#endif /* STATIC_STRING_HPP */
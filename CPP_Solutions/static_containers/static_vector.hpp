@@ -0,0 +1,222 @@
+/* 定长容量向量 - 元素存放在对象内部, 不分配堆内存 (C++17)
+ *
+ * static_vector<T, N> 的接口与 std::vector 相同 (迭代器就是 T*), 区别只在容量固定为 N:
+ *   - 没有 reserve/shrink_to_fit, capacity() 是编译期常量;
+ *   - 超出容量是调用方的错误: push_back/insert/resize 在调试构建中 assert, 发布构建中不检查.
+ *     不确定是否放得下时用 try_push_back / try_emplace_back, 满时返回 false / nullptr;
+ *   - at() 越界同样是 assert, 不抛异常 (目标机上通常用 -fno-exceptions 编译).
+ * 可以放在静态区或栈上; 长度字段按 N 选最小的无符号类型.
+ *
+ *   static static_vector<int, 16> v{1, 2, 3};
+ *   v.push_back(4);
+ *   if (!v.try_push_back(5)) handle_full();
+ *   std::sort(v.begin(), v.end());
+ */
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "static_detail.hpp"
+
+template <class T, size_t N>
+class static_vector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static_vector() noexcept : size_(0) {}
+    explicit static_vector(size_t n) : size_(0) { resize(n); }
+    static_vector(size_t n, const T& value) : size_(0) { resize(n, value); }
+    static_vector(std::initializer_list<T> init) : size_(0) { assign(init.begin(), init.end()); }
+    template <class It, class = typename std::iterator_traits<It>::iterator_category>
+    static_vector(It first, It last) : size_(0) { assign(first, last); }
+
+    static_vector(const static_vector& o) : size_(0) { assign(o.begin(), o.end()); }
+    static_vector(static_vector&& o) noexcept(std::is_nothrow_move_constructible_v<T>) : size_(0) {
+        for (T& x : o) unchecked_emplace_back(std::move(x));
+        o.clear();
+    }
+    static_vector& operator=(const static_vector& o) {
+        if (this != &o) assign(o.begin(), o.end());
+        return *this;
+    }
+    static_vector& operator=(static_vector&& o) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &o) {
+            clear();
+            for (T& x : o) unchecked_emplace_back(std::move(x));
+            o.clear();
+        }
+        return *this;
+    }
+    static_vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+    ~static_vector() { clear(); }
+
+    template <class It>
+    void assign(It first, It last) {
+        clear();
+        for (; first != last; ++first) emplace_back(*first);
+    }
+    void assign(size_t n, const T& value) {
+        clear();
+        resize(n, value);
+    }
+
+    // ---------------- 访问 ----------------
+
+    T* data() noexcept { return store_.data(); }
+    const T* data() const noexcept { return store_.data(); }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& at(size_t i) {
+        assert(i < size_);
+        return data()[i];
+    }
+    const T& at(size_t i) const {
+        assert(i < size_);
+        return data()[i];
+    }
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    iterator begin() noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator cbegin() const noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator end() const noexcept { return data() + size_; }
+    const_iterator cend() const noexcept { return data() + size_; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // ---------------- 容量 ----------------
+
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == N; }
+    size_t size() const noexcept { return size_; }
+    static constexpr size_t capacity() noexcept { return N; }
+    static constexpr size_t max_size() noexcept { return N; }
+
+    // ---------------- 修改 ----------------
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        assert(size_ < N && "static_vector overflow");
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    void push_back(const T& x) { emplace_back(x); }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+
+    // 满了返回 nullptr / false, 容器不变
+    template <class... Args>
+    T* try_emplace_back(Args&&... args) {
+        if (size_ == N) return nullptr;
+        return &unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    bool try_push_back(const T& x) { return try_emplace_back(x) != nullptr; }
+    bool try_push_back(T&& x) { return try_emplace_back(std::move(x)) != nullptr; }
+
+    void pop_back() {
+        assert(size_ > 0);
+        store_.destroy(--size_);
+    }
+
+    // 在 pos 前插入: 先追加到末尾再旋转到位, 元素只移动不复制
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_t i = static_cast<size_t>(pos - begin());
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + i, end() - 1, end());
+        return begin() + i;
+    }
+    iterator insert(const_iterator pos, const T& x) { return emplace(pos, x); }
+    iterator insert(const_iterator pos, T&& x) { return emplace(pos, std::move(x)); }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator f = begin() + (first - cbegin());
+        iterator l = begin() + (last - cbegin());
+        if (f != l) {
+            iterator new_end = std::move(l, end(), f);
+            while (end() != new_end) pop_back();
+        }
+        return f;
+    }
+
+    void resize(size_t n) {
+        assert(n <= N && "static_vector overflow");
+        while (size_ > n) pop_back();
+        while (size_ < n) unchecked_emplace_back();
+    }
+    void resize(size_t n, const T& value) {
+        assert(n <= N && "static_vector overflow");
+        while (size_ > n) pop_back();
+        while (size_ < n) unchecked_emplace_back(value);
+    }
+
+    void clear() noexcept {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            size_ = 0;
+        } else {
+            while (size_ > 0) store_.destroy(--size_);
+        }
+    }
+
+    void swap(static_vector& o) {
+        static_vector tmp(std::move(o));
+        o = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    template <class... Args>
+    T& unchecked_emplace_back(Args&&... args) {
+        T* p = store_.construct(size_, std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    static_detail::size_type_for<N> size_;
+    static_detail::uninit_array<T, N> store_;
+};
+
+template <class T, size_t N>
+bool operator==(const static_vector<T, N>& a, const static_vector<T, N>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+template <class T, size_t N>
+bool operator!=(const static_vector<T, N>& a, const static_vector<T, N>& b) {
+    return !(a == b);
+}
+template <class T, size_t N>
+bool operator<(const static_vector<T, N>& a, const static_vector<T, N>& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <class T, size_t N>
+void swap(static_vector<T, N>& a, static_vector<T, N>& b) {
+    a.swap(b);
+}
+
+#endif /* STATIC_VECTOR_HPP */
@@ -0,0 +1,222 @@
+/* 工作窃取线程池的扩展性: parallel_reduce / 并行归并排序 / 层同步 BFS, 1..N 个线程对比串行基线
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c ../../Templates/benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -pthread -I../../Templates -I../graph bench_work_stealing.cpp benchmark.o \
+ *           -o bench_work_stealing
+ * --sizes 给出元素个数 n: 归约与排序 n 个 uint32_t, BFS 用 n / 4 个顶点、平均度 8 的随机无向图.
+ * 线程数默认 1, 2, 4, ... 直到 hardware_concurrency(), 可用环境变量 WS_THREADS=1,2,8 指定.
+ * 每组测试后以 "# " 开头在 stderr 给出相对串行基线 (中位数) 的加速比.
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "parallel_bfs.hpp"
+#include "parallel_sort.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+constexpr size_t LARGE_N = size_t{1} << 20;
+constexpr size_t LARGE_SAMPLES = 10;
+constexpr unsigned BFS_DEGREE = 8;
+
+uint64_t g_rng = 1;
+
+uint32_t rng_next() {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return static_cast<uint32_t>(g_rng >> 32);
+}
+
+// 归约的每个元素做一点计算 (整数哈希), 否则只是在测内存带宽
+inline uint64_t mix(uint32_t x) {
+    uint64_t h = x * 0x9E3779B97F4A7C15ull;
+    for (int r = 0; r < 4; r++) h = (h ^ (h >> 31)) * 0xBF58476D1CE4E5B9ull;
+    return h;
+}
+
+uint64_t serial_sum(const std::vector<uint32_t>& v) {
+    uint64_t s = 0;
+    for (uint32_t x : v) s += mix(x);
+    return s;
+}
+
+uint64_t parallel_sum(thread_pool& pool, const std::vector<uint32_t>& v) {
+    return pool.parallel_reduce(
+        0, v.size(), 0, uint64_t{0},
+        [&](size_t lo, size_t hi) {
+            uint64_t s = 0;
+            for (size_t i = lo; i < hi; i++) s += mix(v[i]);
+            return s;
+        },
+        [](uint64_t a, uint64_t b) { return a + b; });
+}
+
+csr_graph random_graph(uint32_t n) {
+    std::vector<std::pair<uint32_t, uint32_t>> e(size_t{n} * BFS_DEGREE / 2);
+    for (auto& x : e) x = {rng_next() % n, rng_next() % n};
+    return csr_graph::from_edges(n, e, true);
+}
+
+std::vector<unsigned> thread_counts() {
+    std::vector<unsigned> t;
+    if (const char* env = std::getenv("WS_THREADS")) {
+        for (const char* p = env; *p;) {
+            char* end;
+            unsigned long k = std::strtoul(p, &end, 10);
+            if (end == p) break;
+            if (k > 0 && k <= 1024) t.push_back(static_cast<unsigned>(k));
+            p = *end == ',' ? end + 1 : end;
+        }
+        if (!t.empty()) return t;
+    }
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned k = 1; k < hw; k *= 2) t.push_back(k);
+    t.push_back(hw);
+    return t;
+}
+
+/* ---------------- 正确性: 超额订阅的 4 线程池, 与串行结果逐一比较 ---------------- */
+
+int fib(thread_pool& pool, int k) {
+    if (k < 12) return k < 2 ? k : fib(pool, k - 1) + fib(pool, k - 2);
+    int a = 0, b = 0;
+    pool.join([&] { a = fib(pool, k - 1); }, [&] { b = fib(pool, k - 2); });
+    return a + b;
+}
+
+bool self_check() {
+    thread_pool pool(4);
+    if (fib(pool, 25) != 75025) return false;
+
+    std::vector<uint32_t> v(100003);
+    for (auto& x : v) x = rng_next() % 1000;  // 大量重复键, 顺带检查稳定性
+    if (parallel_sum(pool, v) != serial_sum(v)) return false;
+
+    std::vector<uint64_t> keyed(v.size()), tmp(v.size());
+    for (size_t i = 0; i < v.size(); i++) keyed[i] = (uint64_t{v[i]} << 32) | i;
+    auto by_key = [](uint64_t a, uint64_t b) { return (a >> 32) < (b >> 32); };
+    std::vector<uint64_t> want = keyed;
+    std::stable_sort(want.begin(), want.end(), by_key);
+    parallel_merge_sort(pool, keyed.data(), tmp.data(), keyed.size(), 1000, by_key);
+    if (keyed != want) return false;
+
+    csr_graph g = random_graph(20000);
+    for (uint32_t src : {0u, 777u, 19999u})
+        if (parallel_bfs_distances(pool, g, src) != bfs_distances(g, src)) return false;
+    return true;
+}
+
+/* ---------------- 测试 ---------------- */
+
+double median_ns(const bench_t& b) { return bench_ticks_to_ns(b.median); }
+
+void report_speedup(const char* what, size_t n, double serial_ns, const std::vector<unsigned>& threads,
+                    const std::vector<double>& ns) {
+    std::fprintf(stderr, "# speedup %s n=%zu:", what, n);
+    for (size_t i = 0; i < threads.size(); i++) std::fprintf(stderr, "  %ux %.2f", threads[i], serial_ns / ns[i]);
+    std::fputc('\n', stderr);
+}
+
+bool bench_size(size_t n, const std::vector<unsigned>& threads) {
+    std::vector<uint32_t> in(n), work(n), tmp(n);
+    for (auto& x : in) x = rng_next();
+    csr_graph g = random_graph(static_cast<uint32_t>(std::max<size_t>(n / 4, 1)));
+    std::vector<uint32_t> want_dist = bfs_distances(g, 0);
+    uint64_t want_sum = serial_sum(in);
+    std::vector<uint32_t> sorted = in;
+    std::sort(sorted.begin(), sorted.end());
+
+    char name[64];
+    bench_t b;
+    std::vector<double> ns_sum, ns_sort, ns_bfs;
+
+    BENCH(b, "reduce serial", BENCH_DO_NOT_OPTIMIZE(serial_sum(in)));
+    bench_set_size(&b, n, n * sizeof(uint32_t));
+    bench_report(&b);
+    double base_sum = median_ns(b);
+
+    BENCH(b, "std::stable_sort serial", {
+        std::memcpy(work.data(), in.data(), n * sizeof(uint32_t));
+        std::stable_sort(work.begin(), work.end());
+    });
+    bench_set_size(&b, n, n * sizeof(uint32_t));
+    bench_report(&b);
+    double base_sort = median_ns(b);
+
+    BENCH(b, "bfs serial", BENCH_DO_NOT_OPTIMIZE(bfs_distances(g, 0).size()));
+    bench_set_size(&b, g.n, g.arcs() * sizeof(uint32_t));
+    bench_report(&b);
+    double base_bfs = median_ns(b);
+
+    for (unsigned t : threads) {
+        thread_pool pool(t);
+        uint64_t sum = 0;
+        std::snprintf(name, sizeof name, "parallel_reduce %ut", t);
+        BENCH(b, name, sum = parallel_sum(pool, in); BENCH_DO_NOT_OPTIMIZE(sum));
+        bench_set_size(&b, n, n * sizeof(uint32_t));
+        bench_report(&b);
+        ns_sum.push_back(median_ns(b));
+
+        std::snprintf(name, sizeof name, "parallel_merge_sort %ut", t);
+        BENCH(b, name, {
+            std::memcpy(work.data(), in.data(), n * sizeof(uint32_t));
+            parallel_merge_sort(pool, work.data(), tmp.data(), n);
+        });
+        bench_set_size(&b, n, n * sizeof(uint32_t));
+        bench_report(&b);
+        ns_sort.push_back(median_ns(b));
+
+        std::vector<uint32_t> dist;
+        std::snprintf(name, sizeof name, "parallel_bfs %ut", t);
+        BENCH(b, name, dist = parallel_bfs_distances(pool, g, 0));
+        bench_set_size(&b, g.n, g.arcs() * sizeof(uint32_t));
+        bench_report(&b);
+        ns_bfs.push_back(median_ns(b));
+
+        if (sum != want_sum || work != sorted || dist != want_dist) {
+            std::fprintf(stderr, "MISMATCH: parallel result differs from serial (n=%zu, %u threads)\n", n, t);
+            return false;
+        }
+    }
+    report_speedup("reduce", n, base_sum, threads, ns_sum);
+    report_speedup("merge_sort", n, base_sort, threads, ns_sort);
+    report_speedup("bfs", g.n, base_bfs, threads, ns_bfs);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    if (!self_check()) {
+        std::fprintf(stderr, "MISMATCH: work-stealing pool self-check failed\n");
+        return 1;
+    }
+    std::vector<unsigned> threads = thread_counts();
+    std::fprintf(stderr, "# hardware_concurrency %u, threads:", std::thread::hardware_concurrency());
+    for (unsigned t : threads) std::fprintf(stderr, " %u", t);
+    std::fputc('\n', stderr);
+
+    static const size_t defaults[] = {size_t{1} << 16, size_t{1} << 20, size_t{1} << 22};
+    const size_t* sizes;
+    size_t n_sizes = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    bench_config_t saved = bench_config;
+    for (size_t i = 0; i < n_sizes; i++) {
+        if (sizes[i] < 4 || sizes[i] > (size_t{1} << 30)) {
+            std::fprintf(stderr, "# skip size %zu: must be 4..2^30\n", sizes[i]);
+            continue;
+        }
+        bench_config = saved;
+        if (sizes[i] >= LARGE_N) bench_config.samples = LARGE_SAMPLES;
+        if (!bench_size(sizes[i], threads)) return 1;
+    }
+    bench_config = saved;
+    return bench_summary();
+}
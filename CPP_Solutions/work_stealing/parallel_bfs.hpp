@@ -0,0 +1,65 @@
+/* 层同步并行 BFS (CSR 图) - 建立在 thread_pool::parallel_for 上
+ *
+ * 每一层把当前前沿切块并行展开: 邻居 w 未访问时用一次 CAS 把 dist[w] 从 CSR_UNREACHED
+ * 改成下一层号, 抢到的线程把 w 追加到自己的本地缓冲 (按执行者编号, 无锁), 层结束后
+ * 按前缀和把各线程的缓冲并行拼成下一层前沿. 先做一次普通读再 CAS, 大多数已访问的邻居
+ * 不会产生写流量. 层之间由 parallel_for 返回隐式同步, 所以 CAS 只要求 relaxed.
+ *
+ * 结果与 bfs_distances 完全相同 (距离唯一); 前沿内顶点的顺序依赖调度, 不保证一致.
+ */
+#ifndef PARALLEL_BFS_HPP
+#define PARALLEL_BFS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+inline std::vector<uint32_t> parallel_bfs_distances(thread_pool& pool, const csr_view& g, uint32_t src) {
+    std::vector<uint32_t> out(g.n, CSR_UNREACHED);
+    if (src >= g.n) return out;
+    const size_t n = g.n;
+    const unsigned p = pool.size();
+    std::unique_ptr<std::atomic<uint32_t>[]> dist(new std::atomic<uint32_t>[n]);
+    pool.parallel_for(0, n, 0, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; v++) dist[v].store(CSR_UNREACHED, std::memory_order_relaxed);
+    });
+    dist[src].store(0, std::memory_order_relaxed);
+
+    std::vector<std::vector<uint32_t>> local(p);
+    std::vector<size_t> start(p + 1);
+    std::vector<uint32_t> frontier{src}, next;
+    for (uint32_t level = 1; !frontier.empty(); level++) {
+        for (auto& l : local) l.clear();
+        size_t grain = std::max<size_t>(64, frontier.size() / (size_t{8} * p));
+        pool.parallel_for(0, frontier.size(), grain, [&](size_t lo, size_t hi) {
+            std::vector<uint32_t>& mine = local[static_cast<size_t>(pool.current_worker())];
+            for (size_t i = lo; i < hi; i++) {
+                for (uint32_t w : g.neighbors(frontier[i])) {
+                    if (dist[w].load(std::memory_order_relaxed) != CSR_UNREACHED) continue;
+                    uint32_t expect = CSR_UNREACHED;
+                    if (dist[w].compare_exchange_strong(expect, level, std::memory_order_relaxed))
+                        mine.push_back(w);
+                }
+            }
+        });
+        for (unsigned t = 0; t < p; t++) start[t + 1] = start[t] + local[t].size();
+        next.resize(start[p]);
+        pool.parallel_for(0, p, 1, [&](size_t lo, size_t hi) {
+            for (size_t t = lo; t < hi; t++) std::copy(local[t].begin(), local[t].end(), next.begin() + start[t]);
+        });
+        frontier.swap(next);
+    }
+
+    pool.parallel_for(0, n, 0, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; v++) out[v] = dist[v].load(std::memory_order_relaxed);
+    });
+    return out;
+}
+
+#endif /* PARALLEL_BFS_HPP */
@@ -0,0 +1,65 @@
+/* 并行归并排序 (稳定) - 建立在 thread_pool::join 上
+ *
+ * 两半递归排序并行进行, 合并也并行: 在较长的一段取中点, 另一段二分找到切分位置,
+ * 两对子段各自合并到输出的对应位置. 排序与合并都分治到 grain 个元素以下再串行
+ * (std::sort 无法保证稳定, 叶子用 std::stable_sort). 需要一块与输入等长的临时区,
+ * 两块缓冲区轮流作为输出, 每层只拷贝一次.
+ *
+ *   std::vector<int> tmp(v.size());
+ *   parallel_merge_sort(pool, v.data(), tmp.data(), v.size());
+ */
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+#include "thread_pool.hpp"
+
+namespace ws_detail {
+
+template <class T, class Cmp>
+void merge_rec(thread_pool& pool, const T* a, size_t na, const T* b, size_t nb, T* out, size_t grain, Cmp& cmp) {
+    if (na + nb <= grain) {
+        std::merge(a, a + na, b, b + nb, out, cmp);
+        return;
+    }
+    // 切分保持稳定: 相等元素里 a 的总在 b 的前面
+    size_t ma, mb;
+    if (na >= nb) {
+        ma = na / 2;
+        mb = static_cast<size_t>(std::lower_bound(b, b + nb, a[ma], cmp) - b);
+    } else {
+        mb = nb / 2;
+        ma = static_cast<size_t>(std::upper_bound(a, a + na, b[mb], cmp) - a);
+    }
+    pool.join([&] { merge_rec(pool, a, ma, b, mb, out, grain, cmp); },
+              [&] { merge_rec(pool, a + ma, na - ma, b + mb, nb - mb, out + ma + mb, grain, cmp); });
+}
+
+/* 排好 a[0, n); to_tmp 为真时结果放在 tmp, 否则放回 a */
+template <class T, class Cmp>
+void sort_rec(thread_pool& pool, T* a, T* tmp, size_t n, bool to_tmp, size_t grain, Cmp& cmp) {
+    if (n <= grain) {
+        std::stable_sort(a, a + n, cmp);
+        if (to_tmp) std::copy(a, a + n, tmp);
+        return;
+    }
+    size_t h = n / 2;
+    pool.join([&] { sort_rec(pool, a, tmp, h, !to_tmp, grain, cmp); },
+              [&] { sort_rec(pool, a + h, tmp + h, n - h, !to_tmp, grain, cmp); });
+    const T* src = to_tmp ? a : tmp;
+    merge_rec(pool, src, h, src + h, n - h, to_tmp ? tmp : a, grain, cmp);
+}
+
+}  // namespace ws_detail
+
+/* grain 为 0 时取 max(4096, n / (4 * size())) */
+template <class T, class Cmp = std::less<T>>
+void parallel_merge_sort(thread_pool& pool, T* a, T* tmp, size_t n, size_t grain = 0, Cmp cmp = Cmp()) {
+    if (grain == 0) grain = std::max<size_t>(4096, n / (size_t{4} * pool.size()));
+    ws_detail::sort_rec(pool, a, tmp, n, false, grain, cmp);
+}
+
+#endif /* PARALLEL_SORT_HPP */
@@ -0,0 +1,278 @@
+/* 工作窃取线程池 + fork-join 并行原语 (C++17, 需要操作系统线程)
+ *
+ * 每个工作线程一个 Chase-Lev 队列 (ws_deque.hpp). join(a, b) 把 b 压到自己的队列底部, 自己执行 a,
+ * 回来时若 b 没被偷走就直接弹出执行; 被偷走了就一边去偷别人的任务一边等它完成.
+ * 任务对象就放在 join 的栈帧里 (join 返回前它一定已经执行完), 热路径上没有锁也不分配内存;
+ * 只有线程无事可做、准备睡眠时才会碰互斥量.
+ *
+ *   thread_pool pool(8);                          // 共 8 个执行者: 调用线程 + 7 个后台线程
+ *   pool.parallel_for(0, n, 0, [&](size_t lo, size_t hi) { for (size_t i = lo; i < hi; ++i) y[i] = f(x[i]); });
+ *   double s = pool.parallel_reduce(0, n, 0, 0.0,
+ *                                   [&](size_t lo, size_t hi) { return std::accumulate(x + lo, x + hi, 0.0); },
+ *                                   std::plus<>());
+ *   pool.join([&] { left(); }, [&] { right(); }); // 任意递归分治
+ *
+ * - 调用线程在并行区间内充当 0 号执行者, 所以 thread_pool(1) 不创建线程, 等价于串行执行
+ *   (用来测调度开销). 同一时刻只能有一个池外线程进入同一个池 (0 号队列只有一个所有者);
+ *   任务内部可以任意嵌套调用 join / parallel_for.
+ * - grain 为 0 时自动取 n / (8 * size()), 每个执行者平均分到约 8 块, 兼顾负载均衡与调度开销.
+ * - 任务不能抛异常 (run 是 noexcept, 抛出即 std::terminate).
+ */
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ws_deque.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define WS_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define WS_PAUSE() __asm__ __volatile__("yield")
+#else
+#define WS_PAUSE() ((void)0)
+#endif
+
+namespace ws_detail {
+
+struct task {
+    void (*run)(task*) noexcept;
+    std::atomic<bool> done{false};
+};
+
+template <class F>
+struct fn_task : task {
+    F* f;
+    explicit fn_task(F& fn) : f(&fn) { run = &invoke; }
+    static void invoke(task* t) noexcept { (*static_cast<fn_task*>(t)->f)(); }
+};
+
+}  // namespace ws_detail
+
+class thread_pool {
+public:
+    explicit thread_pool(unsigned n_threads = std::thread::hardware_concurrency())
+        : n_(n_threads ? n_threads : 1), workers_(n_) {
+        for (unsigned i = 0; i < n_; i++) workers_[i].rng = 0x9E3779B97F4A7C15ull * (i + 1);
+        for (unsigned i = 1; i < n_; i++) threads_.emplace_back([this, i] { worker_main(i); });
+    }
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lk(sleep_mu_);
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        sleep_cv_.notify_all();
+        for (std::thread& t : threads_) t.join();
+    }
+
+    /* 执行者个数 (含调用线程) */
+    unsigned size() const { return n_; }
+
+    /* 当前线程在本池中的编号 0..size()-1; 不在本池的并行区间内返回 -1 */
+    int current_worker() const { return tls().pool == this ? static_cast<int>(tls().id) : -1; }
+
+    /* 并行执行 a() 与 b(), 两者都返回后才返回 */
+    template <class A, class B>
+    void join(A&& a, B&& b) {
+        region r(this);
+        fork_join(a, b);
+    }
+
+    /* f(lo, hi) 处理 [lo, hi); 区间被二分到不超过 grain 为止 */
+    template <class F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& f) {
+        if (begin >= end) return;
+        region r(this);
+        for_rec(begin, end, auto_grain(end - begin, grain), f);
+    }
+
+    /* map(lo, hi) 返回 [lo, hi) 的部分结果, reduce(x, y) 合并相邻两段 (只要求结合律) */
+    template <class T, class Map, class Reduce>
+    T parallel_reduce(size_t begin, size_t end, size_t grain, T identity, Map&& map, Reduce&& reduce) {
+        if (begin >= end) return identity;
+        region r(this);
+        return reduce_rec<T>(begin, end, auto_grain(end - begin, grain), map, reduce);
+    }
+
+private:
+    struct alignas(64) worker {
+        ws_deque<ws_detail::task> q;
+        uint64_t rng;
+    };
+    struct tls_state {
+        const thread_pool* pool = nullptr;
+        unsigned id = 0;
+    };
+
+    static tls_state& tls() {
+        static thread_local tls_state s;
+        return s;
+    }
+
+    /* 池外线程进入时占用 0 号执行者, 离开时恢复 (嵌套调用时什么也不做) */
+    struct region {
+        thread_pool* p;
+        tls_state saved;
+        bool outer;
+        explicit region(thread_pool* pool) : p(pool), saved(tls()), outer(tls().pool != pool) {
+            if (outer) {
+                bool busy = p->external_.exchange(true, std::memory_order_acquire);
+                assert(!busy && "thread_pool: only one outside thread may enter at a time");
+                (void)busy;
+                tls().pool = p;
+                tls().id = 0;
+            }
+        }
+        ~region() {
+            if (outer) {
+                tls() = saved;
+                p->external_.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    size_t auto_grain(size_t n, size_t grain) const {
+        if (grain) return grain;
+        size_t g = n / (size_t{8} * n_);
+        return g ? g : 1;
+    }
+
+    template <class A, class B>
+    void fork_join(A& a, B& b) {
+        unsigned me = tls().id;
+        ws_detail::fn_task<B> tb(b);
+        workers_[me].q.push(&tb);
+        wake_one();
+        a();
+        // 队列是 LIFO 且 a 内部的 fork 都已了结: 弹出的要么是 tb, 要么队列已空 (tb 被偷走)
+        ws_detail::task* t = workers_[me].q.pop();
+        if (t == &tb) {
+            b();
+            return;
+        }
+        assert(t == nullptr);
+        unsigned spins = 0;
+        while (!tb.done.load(std::memory_order_acquire)) {
+            if (ws_detail::task* s = steal_any(me)) {
+                execute(s);
+                spins = 0;
+            } else if (++spins < 64) {
+                WS_PAUSE();
+            } else {
+                std::this_thread::yield();  // 超额订阅 (线程数 > 核数) 时把 CPU 让给偷走 tb 的线程
+            }
+        }
+    }
+
+    template <class F>
+    void for_rec(size_t lo, size_t hi, size_t grain, F& f) {
+        if (hi - lo <= grain) {
+            f(lo, hi);
+            return;
+        }
+        size_t mid = lo + (hi - lo) / 2;
+        auto left = [&] { for_rec(lo, mid, grain, f); };
+        auto right = [&] { for_rec(mid, hi, grain, f); };
+        fork_join(left, right);
+    }
+
+    template <class T, class Map, class Reduce>
+    T reduce_rec(size_t lo, size_t hi, size_t grain, Map& map, Reduce& reduce) {
+        if (hi - lo <= grain) return map(lo, hi);
+        size_t mid = lo + (hi - lo) / 2;
+        T l{}, r{};
+        auto left = [&] { l = reduce_rec<T>(lo, mid, grain, map, reduce); };
+        auto right = [&] { r = reduce_rec<T>(mid, hi, grain, map, reduce); };
+        fork_join(left, right);
+        return reduce(std::move(l), std::move(r));
+    }
+
+    static void execute(ws_detail::task* t) {
+        t->run(t);
+        t->done.store(true, std::memory_order_release);
+    }
+
+    ws_detail::task* steal_any(unsigned me) {
+        if (n_ == 1) return nullptr;
+        uint64_t& x = workers_[me].rng;
+        for (unsigned k = 0; k < 2 * n_; k++) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            unsigned v = static_cast<unsigned>(x % n_);
+            if (v == me) continue;
+            if (ws_detail::task* t = workers_[v].q.steal()) return t;
+        }
+        return nullptr;
+    }
+
+    bool any_work() const {
+        for (const worker& w : workers_)
+            if (!w.q.empty()) return true;
+        return false;
+    }
+
+    /* 有线程在睡时才加锁唤醒; 与 idle() 中 "登记睡眠 -> 再检查队列" 构成 Dekker 式握手 */
+    void wake_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+        {
+            std::lock_guard<std::mutex> lk(sleep_mu_);
+            epoch_++;
+        }
+        sleep_cv_.notify_one();
+    }
+
+    void idle() {
+        std::unique_lock<std::mutex> lk(sleep_mu_);
+        uint64_t seen = epoch_;
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!any_work() && !stop_.load(std::memory_order_relaxed))
+            sleep_cv_.wait(lk, [&] { return epoch_ != seen || stop_.load(std::memory_order_relaxed); });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void worker_main(unsigned id) {
+        tls().pool = this;
+        tls().id = id;
+        unsigned fails = 0;
+        while (!stop_.load(std::memory_order_relaxed)) {
+            if (ws_detail::task* t = steal_any(id)) {
+                execute(t);
+                fails = 0;
+            } else if (++fails < 256) {
+                if (fails < 64) WS_PAUSE();
+                else std::this_thread::yield();
+            } else {
+                idle();
+                fails = 0;
+            }
+        }
+    }
+
+    unsigned n_;
+    std::vector<worker> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> external_{false};
+    std::atomic<bool> stop_{false};
+    std::atomic<unsigned> sleepers_{0};
+    std::mutex sleep_mu_;
+    std::condition_variable sleep_cv_;
+    uint64_t epoch_ = 0;  // 受 sleep_mu_ 保护
+};
+
+#endif /* THREAD_POOL_HPP */
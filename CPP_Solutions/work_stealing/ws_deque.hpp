@@ -0,0 +1,110 @@
+/* Chase-Lev 工作窃取双端队列 (C++17) - 按 Lê/Pop/Cohen/Zappa Nardelli (PPoPP'13) 的 C11 内存序版本
+ *
+ * 只有一个所有者线程在底部 push/pop (LIFO, 缓存局部性好), 任意多个窃取者在顶部 steal (FIFO,
+ * 拿走的是最早压入、通常也是最大的那块任务). 所有者的 push/pop 在无竞争时只有普通读写加一次
+ * 内存屏障, 只有 pop 到最后一个元素或者 steal 时才用一次 CAS.
+ *
+ * 元素是 T* (任务对象由调用方管理). 环形数组满时所有者把它扩大一倍; 旧数组可能仍被正在
+ * 读取的窃取者引用, 所以不立即释放, 挂在 retired_ 上直到队列析构 (扩容只在任务数翻倍时发生,
+ * fork-join 用法下队列长度只有递归深度那么多, 实际上不会扩容).
+ *
+ *   ws_deque<task> q;            // 所有者线程
+ *   q.push(&t);
+ *   task* mine = q.pop();        // 所有者, 空时 nullptr
+ *   task* got = q.steal();       // 其他线程, 空或与别人竞争失败时 nullptr
+ */
+#ifndef WS_DEQUE_HPP
+#define WS_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+template <class T>
+class ws_deque {
+public:
+    explicit ws_deque(size_t capacity_log2 = 8) : top_(0), bottom_(0) {
+        retired_.emplace_back(new ring(capacity_log2));
+        array_.store(retired_.back().get(), std::memory_order_relaxed);
+    }
+    ws_deque(const ws_deque&) = delete;
+    ws_deque& operator=(const ws_deque&) = delete;
+
+    /* 仅所有者调用 */
+    void push(T* x) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        ring* a = array_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(a->mask)) a = grow(a, t, b);
+        a->put(b, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /* 仅所有者调用: 取最近压入的那个 */
+    T* pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {  // 已空
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* x = a->get(b);
+        if (t == b) {  // 最后一个元素: 与窃取者抢
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                x = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    /* 任意线程调用: 取最早压入的那个 */
+    T* steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        ring* a = array_.load(std::memory_order_acquire);
+        T* x = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;  // 被别的窃取者或所有者抢走
+        return x;
+    }
+
+    /* 近似值, 只用于空闲判断 */
+    bool empty() const {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ring {
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slot;
+        explicit ring(size_t log2) : mask((size_t{1} << log2) - 1), slot(new std::atomic<T*>[mask + 1]) {}
+        T* get(int64_t i) const { return slot[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* x) { slot[static_cast<size_t>(i) & mask].store(x, std::memory_order_relaxed); }
+    };
+
+    ring* grow(ring* old, int64_t t, int64_t b) {
+        size_t log2 = 0;
+        while ((size_t{1} << log2) <= old->mask) log2++;
+        retired_.emplace_back(new ring(log2 + 1));
+        ring* a = retired_.back().get();
+        for (int64_t i = t; i < b; i++) a->put(i, old->get(i));
+        array_.store(a, std::memory_order_release);
+        return a;
+    }
+
+    /* top_ 与 bottom_ 分处两条缓存行: 窃取者写 top_, 所有者写 bottom_ */
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    std::atomic<ring*> array_;
+    std::vector<std::unique_ptr<ring>> retired_;  // 含当前数组; 只有所有者修改
+};
+
+#endif /* WS_DEQUE_HPP */
@@ -0,0 +1,51 @@
+/* 统一分配器接口的适配函数 */
+#include "allocator.h"
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "pool.h"
+#include "tlsf.h"
+
+static void* pool_alloc_fn(void* ctx, size_t size) {
+    pool_t* p = (pool_t*)ctx;
+    return size <= p->block_size ? pool_alloc(p) : NULL;
+}
+
+static void pool_free_fn(void* ctx, void* ptr) { pool_free((pool_t*)ctx, ptr); }
+
+static void* arena_alloc_fn(void* ctx, size_t size) { return arena_alloc((arena_t*)ctx, size); }
+
+static void* tlsf_alloc_fn(void* ctx, size_t size) { return tlsf_malloc((tlsf_t*)ctx, size); }
+
+static void tlsf_free_fn(void* ctx, void* ptr) { tlsf_free((tlsf_t*)ctx, ptr); }
+
+static void* system_alloc_fn(void* ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void system_free_fn(void* ctx, void* ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+allocator_t allocator_pool(struct pool* p) {
+    allocator_t a = {pool_alloc_fn, pool_free_fn, p};
+    return a;
+}
+
+allocator_t allocator_arena(struct arena* ar) {
+    allocator_t a = {arena_alloc_fn, NULL, ar};
+    return a;
+}
+
+allocator_t allocator_tlsf(struct tlsf* t) {
+    allocator_t a = {tlsf_alloc_fn, tlsf_free_fn, t};
+    return a;
+}
+
+allocator_t allocator_system(void) {
+    allocator_t a = {system_alloc_fn, system_free_fn, NULL};
+    return a;
+}
@@ -0,0 +1,49 @@
+/* 静态内存分配器 - 统一接口
+ *
+ * 量产固件初始化之后禁止 malloc: 这里的三种分配器都只管理调用方给出的一块静态字节数组.
+ *   pool.h   固定大小块内存池, 侵入式空闲链表, alloc/free 严格 O(1)
+ *   arena.h  线性 (bump) 分配, 整体 mark/reset, 不支持单独释放
+ *   tlsf.h   TLSF 两级分离适配, 可变大小, alloc/free O(1), 碎片小
+ *
+ * 数据结构 (链表/树) 只依赖 allocator_t, 可以换成任意一种分配器或系统 malloc:
+ *   static uint8_t heap[8192];
+ *   static tlsf_t tlsf;
+ *   tlsf_init(&tlsf, heap, sizeof heap);
+ *   allocator_t a = allocator_tlsf(&tlsf);
+ *   node_t* n = alloc_new(&a, sizeof *n);
+ *   alloc_delete(&a, n);
+ */
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ALLOC_ALIGN
+#define ALLOC_ALIGN 8u  /* 返回指针的对齐, 必须是 2 的幂且不小于 sizeof(void*) */
+#endif
+
+#define ALLOC_ALIGN_UP(x, a) (((x) + ((a) - 1)) & ~(size_t)((a) - 1))
+
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);  /* 失败返回 NULL */
+    void  (*free)(void* ctx, void* ptr);     /* 可以为 NULL (如 arena), 表示单个释放是空操作 */
+    void* ctx;
+} allocator_t;
+
+static inline void* alloc_new(const allocator_t* a, size_t size) { return a->alloc(a->ctx, size); }
+
+static inline void alloc_delete(const allocator_t* a, void* ptr) {
+    if (ptr != NULL && a->free != NULL) a->free(a->ctx, ptr);
+}
+
+struct pool;
+struct arena;
+struct tlsf;
+
+allocator_t allocator_pool(struct pool* p);    /* 请求大小超过块大小时返回 NULL */
+allocator_t allocator_arena(struct arena* a);
+allocator_t allocator_tlsf(struct tlsf* t);
+allocator_t allocator_system(void);            /* malloc/free, 仅用于主机端对比测试 */
+
+#endif /* ALLOCATOR_H */
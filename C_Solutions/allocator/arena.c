@@ -0,0 +1,9 @@
+/* 线性分配器初始化 (热路径见 arena.h) */
+#include "arena.h"
+
+void arena_init(arena_t* a, void* storage, size_t bytes) {
+    a->base = (uint8_t*)storage;
+    a->size = storage != NULL ? bytes : 0;
+    a->off = 0;
+    a->peak = 0;
+}
@@ -0,0 +1,38 @@
+/* 线性 (bump) 分配器: 分配只是移动偏移量; 用 mark/reset 一次性回收一整段, 适合每帧/每次请求的临时数据 */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "allocator.h"
+
+typedef struct arena {
+    uint8_t* base;
+    size_t   size;
+    size_t   off;    /* 下一次分配的起点 */
+    size_t   peak;   /* 历史最大 off, 用于确定静态数组该开多大 */
+} arena_t;
+
+typedef size_t arena_mark_t;
+
+void arena_init(arena_t* a, void* storage, size_t bytes);
+
+/* align 必须是 2 的幂; 空间不足返回 NULL 且不改变状态 */
+static inline void* arena_alloc_aligned(arena_t* a, size_t size, size_t align) {
+    uintptr_t cur = (uintptr_t)(a->base + a->off);
+    size_t pad = (size_t)(ALLOC_ALIGN_UP(cur, align) - cur);
+    if (size > a->size - a->off || pad > a->size - a->off - size) return NULL;
+    void* p = a->base + a->off + pad;
+    a->off += pad + size;
+    if (a->off > a->peak) a->peak = a->off;
+    return p;
+}
+
+static inline void* arena_alloc(arena_t* a, size_t size) { return arena_alloc_aligned(a, size, ALLOC_ALIGN); }
+
+static inline arena_mark_t arena_mark(const arena_t* a) { return a->off; }
+
+/* 释放 mark 之后分配的全部内存; arena_reset(a, 0) 清空整个 arena */
+static inline void arena_reset(arena_t* a, arena_mark_t mark) {
+    if (mark <= a->off) a->off = mark;
+}
+
+#endif /* ARENA_H */
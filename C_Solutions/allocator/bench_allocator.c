@@ -0,0 +1,232 @@
+/* 分配器延迟与碎片测试: pool / arena / TLSF vs 系统 malloc
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates pool.c arena.c tlsf.c allocator.c \
+ *           bench_allocator.c ../../Templates/benchmark.c -o bench_allocator -lm
+ * 吞吐量按 --format 输出; 单次操作最坏延迟和碎片统计以 "# " 开头写到 stderr.
+ * 主机上的最坏延迟包含被调度/中断打断的时间, 真正的上界要在目标板上 (DWT) 测.
+ * 每个存活块都填满由其句柄决定的字节图案, 释放前校验: 块重叠、越界或被元数据覆盖时报 MISMATCH.
+ * 吞吐量测试在计时前先用同样的分配序列校验一遍; 碎片/延迟测试的填充和校验都在计时区间之外.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HAVE_MALLINFO2 1
+#endif
+
+#include "allocator.h"
+#include "arena.h"
+#include "pool.h"
+#include "tlsf.h"
+
+#define HEAP_BYTES (1u << 20)
+#define BATCH      64u      /* 每次迭代的分配次数 */
+#define SLOTS      4096u    /* 碎片测试中同时存活的槽位 */
+#define CHURN_OPS  200000u
+
+static uint8_t g_heap[HEAP_BYTES];
+static void* g_ptr[SLOTS];
+static size_t g_size[SLOTS];
+static uint32_t g_tag[SLOTS];   /* 槽位当前块的句柄 (分配时的操作序号) */
+static uint32_t g_rand[CHURN_OPS];
+
+/* 16..512 字节, 偏向小块: 典型的链表节点/消息包分布 */
+static size_t rand_size(uint32_t r) { return 16u + ((r >> 8) % ((r & 3u) ? 64u : 496u)); }
+
+/* ---------------- 图案校验 ---------------- */
+
+/* 字节 k 的值由句柄和 k 决定: 相邻块、同一块的不同代 (tag 不同) 图案都不一样 */
+static uint8_t pattern(uint32_t tag, size_t k) { return (uint8_t)((tag * 2654435761u) >> 24) ^ (uint8_t)(k * 7u); }
+
+static void fill(void* p, size_t n, uint32_t tag) {
+    uint8_t* q = (uint8_t*)p;
+    for (size_t k = 0; k < n; k++) q[k] = pattern(tag, k);
+}
+
+/* 图案完好且对齐正确时返回 0 */
+static int verify(const char* name, const void* p, size_t n, uint32_t tag) {
+    const uint8_t* q = (const uint8_t*)p;
+    if ((uintptr_t)p % ALLOC_ALIGN != 0) {
+        fprintf(stderr, "MISMATCH: %s block %u (%zu bytes) at %p is not %u-byte aligned\n", name, (unsigned)tag, n, p,
+                (unsigned)ALLOC_ALIGN);
+        return -1;
+    }
+    for (size_t k = 0; k < n; k++) {
+        if (q[k] != pattern(tag, k)) {
+            fprintf(stderr, "MISMATCH: %s block %u (%zu bytes) overwritten at byte %zu\n", name, (unsigned)tag, n, k);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* 与吞吐量测试相同的分配/释放顺序, 但每块都填图案并在释放前校验; size 为 0 时用随机大小 */
+static int check_batch(const char* name, const allocator_t* a, size_t size, int interleave) {
+    void* ptrs[BATCH];
+    size_t sizes[BATCH];
+    for (uint32_t k = 0; k < BATCH; k++) {
+        sizes[k] = size ? size : rand_size(g_rand[k]);
+        ptrs[k] = alloc_new(a, sizes[k]);
+        if (ptrs[k] == NULL) {
+            fprintf(stderr, "MISMATCH: %s block %u (%zu bytes) allocation failed\n", name, (unsigned)k, sizes[k]);
+            return -1;
+        }
+        fill(ptrs[k], sizes[k], k);
+    }
+    for (uint32_t j = 0; j < BATCH; j++) {
+        /* interleave: 先偶数后奇数 (bench_mixed); 否则逆序 (bench_fixed) */
+        uint32_t k = interleave ? (j < BATCH / 2 ? 2 * j : 2 * (j - BATCH / 2) + 1) : BATCH - 1 - j;
+        if (verify(name, ptrs[k], sizes[k], k) != 0) return -1;
+        alloc_delete(a, ptrs[k]);
+    }
+    return 0;
+}
+
+/* ---------------- 吞吐量: 同一批 alloc 再逆序 free ---------------- */
+
+static int bench_fixed(const char* name, const allocator_t* a, size_t size) {
+    bench_t b;
+    void* ptrs[BATCH];
+    if (check_batch(name, a, size, 0) != 0) return -1;
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BATCH; k++) ptrs[k] = alloc_new(a, size);
+        BENCH_CLOBBER();
+        for (uint32_t k = BATCH; k-- > 0;) alloc_delete(a, ptrs[k]);
+    });
+    bench_set_size(&b, BATCH, 0);
+    bench_report(&b);
+    return 0;
+}
+
+static int bench_mixed(const char* name, const allocator_t* a) {
+    bench_t b;
+    void* ptrs[BATCH];
+    uint32_t r = 0;
+    if (check_batch(name, a, 0, 1) != 0) return -1;
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BATCH; k++) ptrs[k] = alloc_new(a, rand_size(g_rand[(r + k) % CHURN_OPS]));
+        BENCH_CLOBBER();
+        /* 交错释放, 制造需要合并的空洞 */
+        for (uint32_t k = 0; k < BATCH; k += 2) alloc_delete(a, ptrs[k]);
+        for (uint32_t k = 1; k < BATCH; k += 2) alloc_delete(a, ptrs[k]);
+        r += BATCH;
+    });
+    bench_set_size(&b, BATCH, 0);
+    bench_report(&b);
+    return 0;
+}
+
+/* ---------------- 最坏延迟 + 碎片: 长时间随机分配/释放 ---------------- */
+
+/* fixed 非 0 时每次都申请 fixed 字节 (内存池只能分配固定大小) */
+static int churn(const char* name, const allocator_t* a, size_t fixed) {
+    bench_tick_t worst_alloc = 0, worst_free = 0;
+    size_t live = 0, fails = 0;
+    for (uint32_t i = 0; i < SLOTS; i++) g_ptr[i] = NULL;
+    for (uint32_t op = 0; op < CHURN_OPS; op++) {
+        uint32_t r = g_rand[op];
+        uint32_t i = r % SLOTS;
+        bench_tick_t s, e;
+        if (g_ptr[i] != NULL) {
+            if (verify(name, g_ptr[i], g_size[i], g_tag[i]) != 0) return -1;
+            s = bench_start();
+            alloc_delete(a, g_ptr[i]);
+            e = bench_stop();
+            if (bench_net(s, e) > worst_free) worst_free = bench_net(s, e);
+            live -= g_size[i];
+            g_ptr[i] = NULL;
+        } else {
+            size_t n = fixed ? fixed : rand_size(r * 2654435761u);
+            s = bench_start();
+            g_ptr[i] = alloc_new(a, n);
+            e = bench_stop();
+            if (bench_net(s, e) > worst_alloc) worst_alloc = bench_net(s, e);
+            if (g_ptr[i] == NULL) {
+                fails++;
+            } else {
+                g_size[i] = n;
+                g_tag[i] = op;
+                fill(g_ptr[i], n, op);
+                live += n;
+            }
+        }
+    }
+    fprintf(stderr, "# %-8s worst alloc %llu %s, worst free %llu %s, live %zu bytes, failed %zu\n", name,
+            (unsigned long long)worst_alloc, BENCH_TICK_UNIT, (unsigned long long)worst_free, BENCH_TICK_UNIT,
+            live, fails);
+    return 0;
+}
+
+static int release_all(const char* name, const allocator_t* a) {
+    for (uint32_t i = 0; i < SLOTS; i++) {
+        if (g_ptr[i] != NULL && verify(name, g_ptr[i], g_size[i], g_tag[i]) != 0) return -1;
+        alloc_delete(a, g_ptr[i]);
+        g_ptr[i] = NULL;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    srand(1);
+    for (uint32_t k = 0; k < CHURN_OPS; k++) g_rand[k] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    memset(g_heap, 0, sizeof g_heap);  /* 预先触发缺页, 不把首次访问的开销算进最坏延迟 */
+
+    pool_t pool;
+    arena_t arena;
+    tlsf_t tlsf;
+    allocator_t sys = allocator_system();
+
+    pool_init(&pool, g_heap, HEAP_BYTES, 32);
+    allocator_t pa = allocator_pool(&pool);
+    if (bench_fixed("pool 32B", &pa, 32) != 0) return 1;
+    tlsf_init(&tlsf, g_heap, HEAP_BYTES);
+    allocator_t ta = allocator_tlsf(&tlsf);
+    if (bench_fixed("tlsf 32B", &ta, 32) != 0 || bench_fixed("malloc 32B", &sys, 32) != 0) return 1;
+
+    if (bench_mixed("tlsf 16-512B", &ta) != 0 || bench_mixed("malloc 16-512B", &sys) != 0) return 1;
+
+    /* arena: 一批分配后整体 reset, 对比 malloc 逐个 free */
+    arena_init(&arena, g_heap, HEAP_BYTES);
+    {
+        allocator_t aa = allocator_arena(&arena);
+        arena_mark_t m = arena_mark(&arena);
+        for (int pass = 0; pass < 2; pass++) {  /* 第二遍校验 reset 之后能重新分配同一段 */
+            if (check_batch("arena", &aa, 0, 0) != 0) return 1;
+            arena_reset(&arena, m);
+        }
+        bench_t b;
+        BENCH(b, "arena 16-512B +reset", {
+            arena_mark_t m = arena_mark(&arena);
+            for (uint32_t k = 0; k < BATCH; k++) BENCH_DO_NOT_OPTIMIZE(arena_alloc(&arena, rand_size(g_rand[k])));
+            arena_reset(&arena, m);
+        });
+        bench_set_size(&b, BATCH, 0);
+        bench_report(&b);
+    }
+
+    pool_init(&pool, g_heap, HEAP_BYTES, 32);
+    if (churn("pool", &pa, 32) != 0) return 1;
+    fprintf(stderr, "# pool     peak %zu of %zu blocks, no external fragmentation\n", pool.peak,
+            (size_t)(pool.end - pool.base) / pool.block_size);
+    if (release_all("pool", &pa) != 0) return 1;
+
+    tlsf_init(&tlsf, g_heap, HEAP_BYTES);
+    if (churn("tlsf", &ta, 0) != 0) return 1;
+    tlsf_stats_t st;
+    tlsf_stats(&tlsf, &st);
+    fprintf(stderr, "# tlsf     used %zu, free %zu in %zu blocks, largest free %zu, fragmentation %.1f%%\n", tlsf.used,
+            st.free_total, st.free_blocks, st.free_largest,
+            st.free_total ? 100.0 * (1.0 - (double)st.free_largest / (double)st.free_total) : 0.0);
+    if (release_all("tlsf", &ta) != 0) return 1;
+
+    if (churn("malloc", &sys, 0) != 0) return 1;
+#ifdef HAVE_MALLINFO2
+    struct mallinfo2 mi = mallinfo2();
+    fprintf(stderr, "# malloc   in use %zu, heap %zu, free %zu in %zu chunks\n", mi.uordblks, mi.arena, mi.fordblks,
+            mi.ordblks);
+#endif
+    if (release_all("malloc", &sys) != 0) return 1;
+    return bench_summary();
+}
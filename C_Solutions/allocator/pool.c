@@ -0,0 +1,29 @@
+/* 固定大小块内存池实现 */
+#include "pool.h"
+
+size_t pool_init(pool_t* p, void* storage, size_t bytes, size_t block_size) {
+    uintptr_t start = (uintptr_t)storage;
+    uintptr_t aligned = ALLOC_ALIGN_UP(start, ALLOC_ALIGN);
+    if (p == NULL || storage == NULL || block_size == 0 || bytes < aligned - start) return 0;
+    if (block_size < sizeof(void*)) block_size = sizeof(void*);
+    block_size = ALLOC_ALIGN_UP(block_size, ALLOC_ALIGN);
+
+    size_t count = (bytes - (aligned - start)) / block_size;
+    p->base = (uint8_t*)aligned;
+    p->end = p->base + count * block_size;
+    p->block_size = block_size;
+    p->used = p->peak = 0;
+    /* 倒序串起来, 让第一次分配拿到最低地址的块 */
+    p->free_list = NULL;
+    for (size_t i = count; i-- > 0;) {
+        void* b = p->base + i * block_size;
+        *(void**)b = p->free_list;
+        p->free_list = b;
+    }
+    return count;
+}
+
+int pool_owns(const pool_t* p, const void* ptr) {
+    const uint8_t* b = (const uint8_t*)ptr;
+    return b >= p->base && b < p->end && (size_t)(b - p->base) % p->block_size == 0;
+}
@@ -0,0 +1,38 @@
+/* 固定大小块内存池: 空闲块自身存放下一个空闲块的指针 (侵入式链表), 不需要额外的元数据 */
+#ifndef POOL_H
+#define POOL_H
+
+#include "allocator.h"
+
+typedef struct pool {
+    uint8_t* base;        /* 第一个块 (已对齐) */
+    uint8_t* end;
+    size_t   block_size;  /* 已向上取整到 ALLOC_ALIGN */
+    void*    free_list;
+    size_t   used, peak;  /* 当前/峰值已分配块数 */
+} pool_t;
+
+/* 把 storage 切成尽可能多的 block_size 大小的块. 成功返回块数, 空间不足一块返回 0 */
+size_t pool_init(pool_t* p, void* storage, size_t bytes, size_t block_size);
+
+static inline void* pool_alloc(pool_t* p) {
+    void* b = p->free_list;
+    if (b != NULL) {
+        p->free_list = *(void**)b;
+        if (++p->used > p->peak) p->peak = p->used;
+    }
+    return b;
+}
+
+/* ptr 必须来自同一个池; NULL 忽略 */
+static inline void pool_free(pool_t* p, void* ptr) {
+    if (ptr == NULL) return;
+    *(void**)ptr = p->free_list;
+    p->free_list = ptr;
+    p->used--;
+}
+
+/* 指针是否落在池内且对齐到块边界 (调试用, 不在热路径上) */
+int pool_owns(const pool_t* p, const void* ptr);
+
+#endif /* POOL_H */
@@ -0,0 +1,194 @@
+/* TLSF 分配器实现 */
+#include "tlsf.h"
+
+#define BLOCK_FREE      ((size_t)1)
+#define BLOCK_PREV_FREE ((size_t)2)
+#define BLOCK_FLAGS     (BLOCK_FREE | BLOCK_PREV_FREE)
+
+#define HDR_SIZE   offsetof(tlsf_block_t, next_free)                       /* 块头: prev_phys + size */
+#define MIN_BLOCK  ALLOC_ALIGN_UP(sizeof(tlsf_block_t) - HDR_SIZE, ALLOC_ALIGN) /* 空闲块要放下两个链表指针 */
+#define SMALL_SIZE ((size_t)1 << TLSF_FL_SHIFT)
+#define MAX_SIZE   (((size_t)1 << TLSF_FL_MAX) - ALLOC_ALIGN)
+
+/* 块头大小是对齐的整数倍, 负载才能保持对齐 */
+typedef char tlsf_header_check[HDR_SIZE % ALLOC_ALIGN == 0 ? 1 : -1];
+
+static inline size_t block_size(const tlsf_block_t* b) { return b->size & ~BLOCK_FLAGS; }
+static inline void* block_ptr(tlsf_block_t* b) { return (uint8_t*)b + HDR_SIZE; }
+static inline tlsf_block_t* block_from_ptr(const void* p) { return (tlsf_block_t*)((uint8_t*)p - HDR_SIZE); }
+static inline tlsf_block_t* block_next(const tlsf_block_t* b) {
+    return (tlsf_block_t*)((uint8_t*)b + HDR_SIZE + block_size(b));
+}
+
+/* 最高置位的下标, x > 0 */
+static inline int fls_size(size_t x) {
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)x);
+#else
+    int r = 0;
+    while (x >>= 1) r++;
+    return r;
+#endif
+}
+
+static inline int ffs_u32(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int r = 0;
+    while (!(x & 1u)) { x >>= 1; r++; }
+    return r;
+#endif
+}
+
+/* 大小 -> (fl, sl): 向下取整, 用于把空闲块插入链表 */
+static inline void mapping(size_t size, int* fl, int* sl) {
+    if (size < SMALL_SIZE) {
+        *fl = 0;
+        *sl = (int)(size >> TLSF_ALIGN_LOG2);
+    } else {
+        int f = fls_size(size);
+        *sl = (int)((size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT);
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+/* 分配时先向上取整到下一个 SL 区间的起点, 保证该链表里任何一块都够大 (good fit, 不用遍历链表) */
+static inline void mapping_search(size_t size, int* fl, int* sl) {
+    if (size >= SMALL_SIZE) size += ((size_t)1 << (fls_size(size) - TLSF_SL_LOG2)) - 1;
+    mapping(size, fl, sl);
+}
+
+static void insert_free(tlsf_t* t, tlsf_block_t* b) {
+    int fl, sl;
+    mapping(block_size(b), &fl, &sl);
+    tlsf_block_t* head = t->heads[fl][sl];
+    b->prev_free = NULL;
+    b->next_free = head;
+    if (head != NULL) head->prev_free = b;
+    t->heads[fl][sl] = b;
+    t->fl_bitmap |= 1u << fl;
+    t->sl_bitmap[fl] |= 1u << sl;
+}
+
+static void remove_free(tlsf_t* t, tlsf_block_t* b) {
+    int fl, sl;
+    mapping(block_size(b), &fl, &sl);
+    if (b->next_free != NULL) b->next_free->prev_free = b->prev_free;
+    if (b->prev_free != NULL) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        t->heads[fl][sl] = b->next_free;
+        if (b->next_free == NULL) {
+            t->sl_bitmap[fl] &= ~(1u << sl);
+            if (t->sl_bitmap[fl] == 0) t->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+int tlsf_init(tlsf_t* t, void* storage, size_t bytes) {
+    uintptr_t start = (uintptr_t)storage;
+    uintptr_t aligned = ALLOC_ALIGN_UP(start, ALLOC_ALIGN);
+    if (t == NULL || storage == NULL || bytes < aligned - start) return -1;
+    size_t usable = bytes - (size_t)(aligned - start);
+    if (usable < 2 * HDR_SIZE + MIN_BLOCK) return -1;
+
+    for (int i = 0; i < TLSF_FL_COUNT; i++) {
+        t->sl_bitmap[i] = 0;
+        for (int j = 0; j < TLSF_SL_COUNT; j++) t->heads[i][j] = NULL;
+    }
+    t->fl_bitmap = 0;
+    t->used = t->peak = 0;
+
+    /* 一个覆盖全部空间的空闲块, 末尾放一个大小为 0 的 "已分配" 哨兵块, 合并时不会越界 */
+    size_t size = (usable - 2 * HDR_SIZE) & ~(size_t)(ALLOC_ALIGN - 1);
+    if (size > MAX_SIZE) size = MAX_SIZE;
+    tlsf_block_t* b = (tlsf_block_t*)aligned;
+    b->prev_phys = NULL;
+    b->size = size | BLOCK_FREE;
+    tlsf_block_t* sentinel = block_next(b);
+    sentinel->prev_phys = b;
+    sentinel->size = BLOCK_PREV_FREE;
+    t->first = b;
+    insert_free(t, b);
+    return 0;
+}
+
+void* tlsf_malloc(tlsf_t* t, size_t size) {
+    if (size == 0 || size > MAX_SIZE) return NULL;
+    size = ALLOC_ALIGN_UP(size, ALLOC_ALIGN);
+    if (size < MIN_BLOCK) size = MIN_BLOCK;
+
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) return NULL;
+    uint32_t sl_map = t->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        /* 本 FL 没有合适的, 去更大的 FL 里拿最小的非空链表 */
+        uint32_t fl_map = fl + 1 < TLSF_FL_COUNT ? t->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (fl_map == 0) return NULL;
+        fl = ffs_u32(fl_map);
+        sl_map = t->sl_bitmap[fl];
+    }
+    sl = ffs_u32(sl_map);
+    tlsf_block_t* b = t->heads[fl][sl];
+    remove_free(t, b);
+
+    size_t bsize = block_size(b);
+    if (bsize >= size + HDR_SIZE + MIN_BLOCK) {
+        /* 切出剩余部分, 作为新的空闲块放回去 */
+        tlsf_block_t* rem = (tlsf_block_t*)((uint8_t*)b + HDR_SIZE + size);
+        rem->size = (bsize - size - HDR_SIZE) | BLOCK_FREE;
+        rem->prev_phys = b;
+        block_next(rem)->prev_phys = rem;
+        b->size = size | (b->size & BLOCK_PREV_FREE);
+        insert_free(t, rem);
+    } else {
+        block_next(b)->size &= ~BLOCK_PREV_FREE;
+        b->size &= ~BLOCK_FREE;
+    }
+    t->used += block_size(b);
+    if (t->used > t->peak) t->peak = t->used;
+    return block_ptr(b);
+}
+
+void tlsf_free(tlsf_t* t, void* ptr) {
+    if (ptr == NULL) return;
+    tlsf_block_t* b = block_from_ptr(ptr);
+    t->used -= block_size(b);
+    b->size |= BLOCK_FREE;
+
+    if (b->size & BLOCK_PREV_FREE) {  /* 与前一块合并 */
+        tlsf_block_t* prev = b->prev_phys;
+        remove_free(t, prev);
+        prev->size += HDR_SIZE + block_size(b);
+        b = prev;
+    }
+    tlsf_block_t* next = block_next(b);
+    if (next->size & BLOCK_FREE) {    /* 与后一块合并 */
+        remove_free(t, next);
+        b->size += HDR_SIZE + block_size(next);
+        next = block_next(b);
+    }
+    next->prev_phys = b;
+    next->size |= BLOCK_PREV_FREE;
+    insert_free(t, b);
+}
+
+size_t tlsf_usable_size(const void* ptr) {
+    return ptr != NULL ? block_size(block_from_ptr(ptr)) : 0;
+}
+
+void tlsf_stats(const tlsf_t* t, tlsf_stats_t* st) {
+    st->free_total = st->free_largest = st->free_blocks = st->used_blocks = 0;
+    for (const tlsf_block_t* b = t->first; block_size(b) != 0; b = block_next(b)) {
+        size_t s = block_size(b);
+        if (b->size & BLOCK_FREE) {
+            st->free_total += s;
+            st->free_blocks++;
+            if (s > st->free_largest) st->free_largest = s;
+        } else {
+            st->used_blocks++;
+        }
+    }
+}
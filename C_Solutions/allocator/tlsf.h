@@ -0,0 +1,59 @@
+/* TLSF (Two-Level Segregated Fit) 可变大小分配器
+ *
+ * 空闲块按大小分到 FL (2 的幂区间) x SL (区间再 SL_COUNT 等分) 个链表, 两级位图记录哪些链表非空;
+ * 查找 = 两次 ctz, 合并 = 检查物理相邻块, 所以 alloc/free 都是与堆大小无关的 O(1), 适合实时系统.
+ * 每块额外开销 2 个指针宽度的块头.
+ */
+#ifndef TLSF_H
+#define TLSF_H
+
+#include "allocator.h"
+
+#define TLSF_SL_LOG2  4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#if ALLOC_ALIGN == 4
+#define TLSF_ALIGN_LOG2 2
+#elif ALLOC_ALIGN == 8
+#define TLSF_ALIGN_LOG2 3
+#elif ALLOC_ALIGN == 16
+#define TLSF_ALIGN_LOG2 4
+#else
+#error "tlsf.h supports ALLOC_ALIGN of 4, 8 or 16"
+#endif
+#define TLSF_FL_SHIFT (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)  /* 小于 2^FL_SHIFT 的块全部放在 FL 0 线性细分 */
+#ifndef TLSF_FL_MAX
+#define TLSF_FL_MAX 24                                 /* 单块最大 2^24 = 16 MB; 管理更大的堆请调大 (<= 31) */
+#endif
+#define TLSF_FL_COUNT (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+typedef struct tlsf_block {
+    struct tlsf_block* prev_phys;  /* 物理上的前一块, 只在前一块空闲时有效 */
+    size_t             size;       /* 负载字节数, 低 2 位是标志 */
+    struct tlsf_block* next_free;  /* 以下两项只在空闲块中有效, 占用负载区 */
+    struct tlsf_block* prev_free;
+} tlsf_block_t;
+
+typedef struct tlsf {
+    uint32_t      fl_bitmap;
+    uint32_t      sl_bitmap[TLSF_FL_COUNT];
+    tlsf_block_t* heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    tlsf_block_t* first;           /* 物理上的第一块, 遍历统计用 */
+    size_t        used, peak;      /* 已分配的负载字节数 (含对齐填充) */
+} tlsf_t;
+
+typedef struct {
+    size_t free_total;             /* 空闲负载字节数 */
+    size_t free_largest;           /* 最大空闲块: 一次能分配到的上限 */
+    size_t free_blocks;
+    size_t used_blocks;
+} tlsf_stats_t;
+
+/* 成功返回 0; 空间太小返回 -1. 超过 2^TLSF_FL_MAX 的部分不会被使用 */
+int    tlsf_init(tlsf_t* t, void* storage, size_t bytes);
+void*  tlsf_malloc(tlsf_t* t, size_t size);  /* size 为 0 或空间不足返回 NULL */
+void   tlsf_free(tlsf_t* t, void* ptr);      /* NULL 忽略 */
+size_t tlsf_usable_size(const void* ptr);
+/* 遍历所有物理块 (O(块数), 不要在实时路径上调用) */
+void   tlsf_stats(const tlsf_t* t, tlsf_stats_t* st);
+
+#endif /* TLSF_H */
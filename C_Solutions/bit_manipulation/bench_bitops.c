@@ -0,0 +1,191 @@
+/* 位操作原语 vs 逐位循环: popcount / clz / ctz / 位反转 / 字节交换 / pext / pdep / 位图扫描
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates bit_manipulation.c bench_bitops.c \
+ *           ../../Templates/benchmark.c -o bench_bitops -lm
+ * 对比硬件路径: 加 -mpopcnt -mbmi -mbmi2 (或 -march=native); 只测 SWAR 回落: 加 -DBIT_NO_BUILTINS.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+
+#include "bit_manipulation.h"
+
+#define N_WORDS 4096u
+
+static uint32_t data[N_WORDS];
+static uint32_t masks[N_WORDS];
+
+/* ---------------- 逐位循环的参考实现 ---------------- */
+
+static unsigned naive_popcount(uint32_t x) {
+    unsigned c = 0;
+    for (unsigned i = 0; i < 32; i++) c += (x >> i) & 1u;
+    return c;
+}
+
+static unsigned naive_clz(uint32_t x) {
+    unsigned n = 0;
+    while (n < 32 && !(x & (0x80000000u >> n))) n++;
+    return n;
+}
+
+static unsigned naive_ctz(uint32_t x) {
+    unsigned n = 0;
+    while (n < 32 && !(x & (1u << n))) n++;
+    return n;
+}
+
+static uint32_t naive_reverse(uint32_t x) {
+    uint32_t r = 0;
+    for (unsigned i = 0; i < 32; i++) r |= ((x >> i) & 1u) << (31 - i);
+    return r;
+}
+
+static uint32_t naive_bswap(uint32_t x) {
+    uint8_t b[4];
+    for (unsigned i = 0; i < 4; i++) b[i] = (uint8_t)(x >> (8 * i));
+    uint32_t r = 0;
+    for (unsigned i = 0; i < 4; i++) r = (r << 8) | b[i];
+    return r;
+}
+
+static uint32_t naive_pext(uint32_t x, uint32_t m) {
+    uint32_t r = 0;
+    unsigned k = 0;
+    for (unsigned i = 0; i < 32; i++) {
+        if (m & (1u << i)) r |= ((x >> i) & 1u) << k++;
+    }
+    return r;
+}
+
+static uint32_t naive_pdep(uint32_t x, uint32_t m) {
+    uint32_t r = 0;
+    unsigned k = 0;
+    for (unsigned i = 0; i < 32; i++) {
+        if (m & (1u << i)) r |= ((x >> k++) & 1u) << i;
+    }
+    return r;
+}
+
+static long naive_find_first(const uint32_t* w, size_t nwords) {
+    for (size_t i = 0; i < nwords * 32u; i++) {
+        if (w[i / 32u] & (1u << (i % 32u))) return (long)i;
+    }
+    return -1;
+}
+
+/* ---------------- 每个元素一次调用, 结果累加防止被删除 ---------------- */
+
+#define KERNEL1(name, f)                                                     \
+    static uint32_t name(void) {                                             \
+        uint32_t acc = 0;                                                    \
+        for (size_t i = 0; i < N_WORDS; i++) acc += (uint32_t)f(data[i]);    \
+        return acc;                                                          \
+    }
+#define KERNEL2(name, f)                                                             \
+    static uint32_t name(void) {                                                     \
+        uint32_t acc = 0;                                                            \
+        for (size_t i = 0; i < N_WORDS; i++) acc += (uint32_t)f(data[i], masks[i]);  \
+        return acc;                                                                  \
+    }
+
+/* X(名称, 逐位版本, 原语版本, 参数个数) */
+#define BITOPS_KERNELS(X)                              \
+    X(popcount, naive_popcount, bit_popcount32, 1)     \
+    X(clz, naive_clz, bit_clz32, 1)                    \
+    X(ctz, naive_ctz, bit_ctz32, 1)                    \
+    X(reverse, naive_reverse, bit_reverse32, 1)        \
+    X(bswap, naive_bswap, bit_bswap32, 1)              \
+    X(pext, naive_pext, bit_pext32, 2)                 \
+    X(pdep, naive_pdep, bit_pdep32, 2)
+
+#define DEFINE_KERNELS(name, naive, fast, arity) \
+    KERNEL##arity(run_naive_##name, naive)       \
+    KERNEL##arity(run_fast_##name, fast)
+BITOPS_KERNELS(DEFINE_KERNELS)
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+
+    /* 右移随机位数: clz 的分布覆盖 0..31, 逐位循环的耗时才有代表性 */
+    for (size_t i = 0; i < N_WORDS; i++) {
+        data[i] = rng_next() >> (rng_next() % 32u);
+        masks[i] = rng_next() & rng_next();
+    }
+    data[0] = 0;  /* clz/ctz 的 0 输入 */
+
+#define CHECK(name, naive, fast, arity)                                         \
+    if (run_naive_##name() != run_fast_##name()) {                             \
+        fprintf(stderr, "MISMATCH: %s\n", #name);                              \
+        return 1;                                                               \
+    }
+    BITOPS_KERNELS(CHECK)
+
+    endian_t e = endian_detect();
+    if ((e == ENDIAN_LITTLE) != (BIT_HOST_IS_LE() != 0)) {
+        fprintf(stderr, "MISMATCH: endian_detect\n");
+        return 1;
+    }
+    fprintf(stderr, "# %s-endian, hw:", e == ENDIAN_LITTLE ? "little" : "big");
+#ifdef BIT_HW_POPCOUNT
+    fprintf(stderr, " popcount");
+#endif
+#ifdef BIT_HW_CLZ
+    fprintf(stderr, " clz");
+#endif
+#if defined(BIT_HW_RBIT) || defined(BIT_HW_BITREVERSE)
+    fprintf(stderr, " rbit");
+#endif
+#ifdef BIT_HW_BSWAP
+    fprintf(stderr, " bswap");
+#endif
+#ifdef BIT_HW_BMI2
+    fprintf(stderr, " pext/pdep");
+#endif
+    fprintf(stderr, "\n");
+
+    bench_t b;
+#define RUN(name, naive, fast, arity)                                           \
+    BENCH(b, #name "/naive", BENCH_DO_NOT_OPTIMIZE(run_naive_##name()));       \
+    bench_set_size(&b, N_WORDS, N_WORDS * sizeof(uint32_t));                   \
+    bench_report(&b);                                                           \
+    BENCH(b, #name "/bitops", BENCH_DO_NOT_OPTIMIZE(run_fast_##name()));       \
+    bench_set_size(&b, N_WORDS, N_WORDS * sizeof(uint32_t));                   \
+    bench_report(&b);
+    BITOPS_KERNELS(RUN)
+
+    /* 位图: 只有最后一个字里有 1, 扫描整个位图 */
+    static uint32_t bitmap[N_WORDS];
+    bitmap[N_WORDS - 1] = 1u << 17;
+    if (naive_find_first(bitmap, N_WORDS) != bitmap_find_first(bitmap, N_WORDS)) {
+        fprintf(stderr, "MISMATCH: find_first\n");
+        return 1;
+    }
+    BENCH(b, "find_first/naive", BENCH_DO_NOT_OPTIMIZE(naive_find_first(bitmap, N_WORDS)));
+    bench_set_size(&b, N_WORDS * 32u, sizeof bitmap);
+    bench_report(&b);
+    BENCH(b, "find_first/bitops", BENCH_DO_NOT_OPTIMIZE(bitmap_find_first(bitmap, N_WORDS)));
+    bench_set_size(&b, N_WORDS * 32u, sizeof bitmap);
+    bench_report(&b);
+
+    /* 模拟寄存器上的位段 RMW: 每次写 4 个不同字段 */
+    static volatile uint32_t fake_reg;
+    BENCH(b, "reg_field_write", {
+        reg_field_write(&fake_reg, 0x3u << 10, (uint32_t)i_);
+        reg_field_write(&fake_reg, 0xFu << 0, (uint32_t)i_);
+        reg_set(&fake_reg, 1u << 31);
+        reg_clear(&fake_reg, 1u << 31);
+    });
+    bench_set_size(&b, 4, 0);
+    bench_report(&b);
+
+    return bench_summary();
+}
@@ -0,0 +1,39 @@
+/* 位操作练习 - 字节序检测与位图扫描 (寄存器操作都是 bit_manipulation.h 中的 inline 函数) */
+#include "bit_manipulation.h"
+
+endian_t endian_detect(void) {
+    /* volatile: 防止编译器按预定义的字节序把整个函数折叠成常量, 真的去读内存 */
+    volatile uint32_t probe = 0x01020304u;
+    const volatile uint8_t* first = (const volatile uint8_t*)&probe;
+    return *first == 0x04u ? ENDIAN_LITTLE : ENDIAN_BIG;
+}
+
+void bswap32_buf(uint32_t* w, size_t n) {
+    for (size_t i = 0; i < n; i++) w[i] = bit_bswap32(w[i]);
+}
+
+size_t bitmap_popcount(const uint32_t* w, size_t nwords) {
+    size_t count = 0;
+    for (size_t i = 0; i < nwords; i++) count += bit_popcount32(w[i]);
+    return count;
+}
+
+long bitmap_find_first(const uint32_t* w, size_t nwords) {
+    /* 整字跳过全 0, 命中的字里用 ctz 定位, 不逐位扫描 */
+    for (size_t i = 0; i < nwords; i++) {
+        if (w[i] != 0) return (long)(i * 32u + bit_ctz32(w[i]));
+    }
+    return -1;
+}
+
+long bitmap_find_zero(const uint32_t* w, size_t nwords, size_t start) {
+    size_t i = start / 32u;
+    if (i >= nwords) return -1;
+    /* 第一个字把 start 之前的位当作已占用 */
+    uint32_t inv = ~w[i] & (0xFFFFFFFFu << (start % 32u));
+    for (;;) {
+        if (inv != 0) return (long)(i * 32u + bit_ctz32(inv));
+        if (++i >= nwords) return -1;
+        inv = ~w[i];
+    }
+}
@@ -0,0 +1,107 @@
+/* 位操作练习 - 寄存器置位/清零/位段读写, 字节序检测, 位图扫描
+ *
+ * 全部建立在 Templates/bitops.h 之上 (popcount/ctz/bswap/位段原语), 同样只依赖 freestanding 头文件.
+ * 寄存器函数的参数是 volatile 指针, 每次调用恰好产生一次读和/或一次写, 不会被编译器合并或删除.
+ *
+ *   #define GPIOA_MODER  ((volatile uint32_t*)0x48000000u)
+ *   #define MODER_PIN5   (0x3u << 10)             // 2 位宽字段, 用掩码描述
+ *   reg_set(GPIOA_ODR, 1u << 5);                   // 读-改-写: 置位
+ *   reg_field_write(GPIOA_MODER, MODER_PIN5, 1);  // 只改 [11:10], 其余位保持
+ *   mode = reg_field_read(GPIOA_MODER, MODER_PIN5);
+ *
+ * 注意: 读-改-写不是原子的. 若 ISR 也改同一个寄存器, 要么关中断, 要么用硬件提供的
+ * 置位/清零寄存器 (如 STM32 GPIOx_BSRR, reg_write 一次完成) 或 Cortex-M3/M4 的位带别名.
+ */
+#ifndef BIT_MANIPULATION_H
+#define BIT_MANIPULATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitops.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ---------------- 掩码描述的位段 (掩码必须是连续的 1) ---------------- */
+
+/* 掩码是编译期常量时 ctz 被常量折叠, 结果就是一次与 + 一次移位 */
+static inline uint32_t bit_field_by_mask(uint32_t x, uint32_t mask) {
+    return (x & mask) >> bit_ctz32(mask);
+}
+
+/* 把 v 放到 mask 所在的位置 (超出字段宽度的高位被截掉) */
+static inline uint32_t bit_field_prep(uint32_t mask, uint32_t v) {
+    return (v << bit_ctz32(mask)) & mask;
+}
+
+/* ---------------- 内存映射寄存器 ---------------- */
+
+static inline uint32_t reg_read(const volatile uint32_t* r) { return *r; }
+static inline void reg_write(volatile uint32_t* r, uint32_t v) { *r = v; }
+
+static inline void reg_set(volatile uint32_t* r, uint32_t mask) { *r |= mask; }
+static inline void reg_clear(volatile uint32_t* r, uint32_t mask) { *r &= ~mask; }
+static inline void reg_toggle(volatile uint32_t* r, uint32_t mask) { *r ^= mask; }
+
+/* 一次读-改-写同时清除和置位, 比先 clear 再 set 少一次总线访问, 也不会出现中间态 */
+static inline void reg_modify(volatile uint32_t* r, uint32_t clear_mask, uint32_t set_mask) {
+    *r = (*r & ~clear_mask) | set_mask;
+}
+
+/* mask 中所有位都为 1 */
+static inline int reg_test_all(const volatile uint32_t* r, uint32_t mask) { return (*r & mask) == mask; }
+/* mask 中任意一位为 1 */
+static inline int reg_test_any(const volatile uint32_t* r, uint32_t mask) { return (*r & mask) != 0; }
+
+/* 写 1 清零 (W1C) 的状态寄存器: 只能直接写掩码. 用 reg_clear 会把读到的其他挂起标志一起清掉 */
+static inline void reg_w1c(volatile uint32_t* r, uint32_t mask) { *r = mask; }
+
+static inline uint32_t reg_field_read(const volatile uint32_t* r, uint32_t mask) {
+    return bit_field_by_mask(*r, mask);
+}
+
+static inline void reg_field_write(volatile uint32_t* r, uint32_t mask, uint32_t v) {
+    reg_modify(r, mask, bit_field_prep(mask, v));
+}
+
+/* 等待 mask 位全部变为 expect (0 或 1), 最多轮询 max_polls 次; 超时返回 -1 */
+static inline int reg_wait(const volatile uint32_t* r, uint32_t mask, int expect, uint32_t max_polls) {
+    uint32_t want = expect ? mask : 0u;
+    while ((*r & mask) != want) {
+        if (max_polls-- == 0) return -1;
+    }
+    return 0;
+}
+
+/* Cortex-M3/M4 位带: SRAM 0x20000000 与外设 0x40000000 起各 1 MB, 每一位映射成别名区的一个字.
+ * 对别名字写 0/1 就是对该位单次原子地清零/置位, 不需要读-改-写. (M0/M7/M33 没有位带.) */
+#define BITBAND_ADDR(addr, bit) \
+    ((((uintptr_t)(addr)) & 0xF0000000u) + 0x02000000u + ((((uintptr_t)(addr)) & 0x000FFFFFu) << 5) + ((bit) << 2))
+#define BITBAND(addr, bit) (*(volatile uint32_t*)BITBAND_ADDR((addr), (bit)))
+
+/* ---------------- 字节序 ---------------- */
+
+typedef enum { ENDIAN_LITTLE = 0, ENDIAN_BIG = 1 } endian_t;
+
+/* 运行期检测 (不依赖编译器预定义宏), 与 BIT_LITTLE_ENDIAN / BIT_BIG_ENDIAN 应当一致 */
+endian_t endian_detect(void);
+
+/* 原地反转 n 个 32 位字的字节序 (例如把网络序的数据块转成主机序) */
+void bswap32_buf(uint32_t* w, size_t n);
+
+/* ---------------- 位图 ---------------- */
+
+/* 位图中 1 的个数 */
+size_t bitmap_popcount(const uint32_t* w, size_t nwords);
+/* 第一个为 1 的位的下标, 全 0 返回 -1 */
+long bitmap_find_first(const uint32_t* w, size_t nwords);
+/* 从 start 开始第一个为 0 的位 (分配器找空槽), 没有返回 -1 */
+long bitmap_find_zero(const uint32_t* w, size_t nwords, size_t start);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIT_MANIPULATION_H */
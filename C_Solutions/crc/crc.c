@@ -0,0 +1,184 @@
+/* CRC 引擎实现. 多字节读取都按字节拼装, 与端序和对齐无关 (编译器在小端机器上会合并成一次加载) */
+#include "crc.h"
+
+#include <string.h>
+
+#include "crc_tables.h"
+
+#if defined(CRC_HW_CRC32) || (defined(CRC_HW_CRC32C) && defined(__ARM_FEATURE_CRC32))
+#include <arm_acle.h>
+#elif defined(CRC_HW_CRC32C)
+#include <nmmintrin.h>
+#endif
+
+#define POLY8   0x07u
+#define POLY16  0x1021u
+#define POLY32  0xEDB88320u
+#define POLY32C 0x82F63B78u
+
+static inline uint32_t load32le(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* ---------------- CRC8 (MSB first) ---------------- */
+
+uint8_t crc8_bitwise(uint8_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) crc = (uint8_t)((crc & 0x80u) ? ((unsigned)crc << 1) ^ POLY8 : (unsigned)crc << 1);
+    }
+    return crc;
+}
+
+uint8_t crc8_table(uint8_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len--) crc = crc8_lut[0][crc ^ *p++];
+    return crc;
+}
+
+/* 8 位 CRC 的寄存器只和第一个字节异或, 其余字节各查 "后面还跟 k 个字节" 的表 */
+uint8_t crc8_slice4(uint8_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (; len >= 4; len -= 4, p += 4)
+        crc = crc8_lut[3][crc ^ p[0]] ^ crc8_lut[2][p[1]] ^ crc8_lut[1][p[2]] ^ crc8_lut[0][p[3]];
+    return crc8_table(crc, p, len);
+}
+
+uint8_t crc8_slice8(uint8_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (; len >= 8; len -= 8, p += 8)
+        crc = crc8_lut[7][crc ^ p[0]] ^ crc8_lut[6][p[1]] ^ crc8_lut[5][p[2]] ^ crc8_lut[4][p[3]] ^
+              crc8_lut[3][p[4]] ^ crc8_lut[2][p[5]] ^ crc8_lut[1][p[6]] ^ crc8_lut[0][p[7]];
+    return crc8_table(crc, p, len);
+}
+
+/* ---------------- CRC16-CCITT (MSB first) ---------------- */
+
+uint16_t crc16_bitwise(uint16_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++) crc = (uint16_t)((crc & 0x8000u) ? ((unsigned)crc << 1) ^ POLY16 : (unsigned)crc << 1);
+    }
+    return crc;
+}
+
+uint16_t crc16_table(uint16_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len--) crc = (uint16_t)((crc << 8) ^ crc16_lut[0][(crc >> 8) ^ *p++]);
+    return crc;
+}
+
+/* 16 位寄存器的高/低字节分别并入前两个字节 */
+uint16_t crc16_slice4(uint16_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (; len >= 4; len -= 4, p += 4)
+        crc = crc16_lut[3][(crc >> 8) ^ p[0]] ^ crc16_lut[2][(crc & 0xFFu) ^ p[1]] ^ crc16_lut[1][p[2]] ^
+              crc16_lut[0][p[3]];
+    return crc16_table(crc, p, len);
+}
+
+uint16_t crc16_slice8(uint16_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (; len >= 8; len -= 8, p += 8)
+        crc = crc16_lut[7][(crc >> 8) ^ p[0]] ^ crc16_lut[6][(crc & 0xFFu) ^ p[1]] ^ crc16_lut[5][p[2]] ^
+              crc16_lut[4][p[3]] ^ crc16_lut[3][p[4]] ^ crc16_lut[2][p[5]] ^ crc16_lut[1][p[6]] ^
+              crc16_lut[0][p[7]];
+    return crc16_table(crc, p, len);
+}
+
+/* ---------------- CRC32 / CRC32C (反射, 共用实现) ---------------- */
+
+static inline uint32_t refl_bitwise(uint32_t poly, uint32_t crc, const uint8_t* p, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) crc = (crc & 1u) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+    return ~crc;
+}
+
+static inline uint32_t refl_bytes(const uint32_t t[8][256], uint32_t reg, const uint8_t* p, size_t len) {
+    while (len--) reg = (reg >> 8) ^ t[0][(reg ^ *p++) & 0xFFu];
+    return reg;
+}
+
+static inline uint32_t refl_slice4(const uint32_t t[8][256], uint32_t crc, const uint8_t* p, size_t len) {
+    uint32_t reg = ~crc;
+    for (; len >= 4; len -= 4, p += 4) {
+        uint32_t w = load32le(p) ^ reg;
+        reg = t[3][w & 0xFFu] ^ t[2][(w >> 8) & 0xFFu] ^ t[1][(w >> 16) & 0xFFu] ^ t[0][w >> 24];
+    }
+    return ~refl_bytes(t, reg, p, len);
+}
+
+static inline uint32_t refl_slice8(const uint32_t t[8][256], uint32_t crc, const uint8_t* p, size_t len) {
+    uint32_t reg = ~crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t a = load32le(p) ^ reg;
+        uint32_t b = load32le(p + 4);
+        reg = t[7][a & 0xFFu] ^ t[6][(a >> 8) & 0xFFu] ^ t[5][(a >> 16) & 0xFFu] ^ t[4][a >> 24] ^
+              t[3][b & 0xFFu] ^ t[2][(b >> 8) & 0xFFu] ^ t[1][(b >> 16) & 0xFFu] ^ t[0][b >> 24];
+    }
+    return ~refl_bytes(t, reg, p, len);
+}
+
+uint32_t crc32_bitwise(uint32_t crc, const void* data, size_t len) { return refl_bitwise(POLY32, crc, data, len); }
+uint32_t crc32_table(uint32_t crc, const void* data, size_t len) { return ~refl_bytes(crc32_lut, ~crc, data, len); }
+uint32_t crc32_slice4(uint32_t crc, const void* data, size_t len) { return refl_slice4(crc32_lut, crc, data, len); }
+uint32_t crc32_slice8(uint32_t crc, const void* data, size_t len) { return refl_slice8(crc32_lut, crc, data, len); }
+
+uint32_t crc32c_bitwise(uint32_t crc, const void* data, size_t len) { return refl_bitwise(POLY32C, crc, data, len); }
+uint32_t crc32c_table(uint32_t crc, const void* data, size_t len) { return ~refl_bytes(crc32c_lut, ~crc, data, len); }
+uint32_t crc32c_slice4(uint32_t crc, const void* data, size_t len) { return refl_slice4(crc32c_lut, crc, data, len); }
+uint32_t crc32c_slice8(uint32_t crc, const void* data, size_t len) { return refl_slice8(crc32c_lut, crc, data, len); }
+
+/* ---------------- 硬件指令 ---------------- */
+
+/* 先逐字节走到 8 字节对齐, 主循环每条指令处理 8 字节, 再收尾 */
+#define HW_CRC_LOOP(reg, p, len, op8, op64)                                    \
+    do {                                                                       \
+        while ((len) && ((uintptr_t)(p) & 7u)) { (reg) = op8((reg), *(p)++); (len)--; } \
+        for (; (len) >= 8; (len) -= 8, (p) += 8) {                             \
+            uint64_t w_;                                                       \
+            memcpy(&w_, (p), 8);                                               \
+            (reg) = op64((reg), w_);                                           \
+        }                                                                      \
+        while ((len)--) (reg) = op8((reg), *(p)++);                            \
+    } while (0)
+
+uint32_t crc32_hw(uint32_t crc, const void* data, size_t len) {
+#ifdef CRC_HW_CRC32
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t reg = ~crc;
+    HW_CRC_LOOP(reg, p, len, __crc32b, __crc32d);
+    return ~reg;
+#else
+    return crc32_slice8(crc, data, len);
+#endif
+}
+
+#if defined(CRC_HW_CRC32C) && !defined(__ARM_FEATURE_CRC32)
+#if defined(__x86_64__)
+#define X86_CRC32C_U64(r, w) ((uint32_t)_mm_crc32_u64((r), (w)))
+#else
+#define X86_CRC32C_U64(r, w) _mm_crc32_u32(_mm_crc32_u32((r), (uint32_t)(w)), (uint32_t)((w) >> 32))
+#endif
+#define X86_CRC32C_U8(r, b) _mm_crc32_u8((r), (b))
+#endif
+
+uint32_t crc32c_hw(uint32_t crc, const void* data, size_t len) {
+#if defined(CRC_HW_CRC32C)
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t reg = ~crc;
+#if defined(__ARM_FEATURE_CRC32)
+    HW_CRC_LOOP(reg, p, len, __crc32cb, __crc32cd);
+#else
+    HW_CRC_LOOP(reg, p, len, X86_CRC32C_U8, X86_CRC32C_U64);
+#endif
+    return ~reg;
+#else
+    return crc32c_slice8(crc, data, len);
+#endif
+}
@@ -0,0 +1,77 @@
+/* CRC / 校验和引擎: 逐位参考实现, 256 项查表, slicing-by-4/8, 以及硬件 CRC 指令
+ *
+ *   CRC8         CRC-8 (SMBus)        poly 0x07,       init 0x00,       不反射, 无异或输出
+ *   CRC16        CRC-16/CCITT-FALSE   poly 0x1021,     init 0xFFFF,     不反射, 无异或输出
+ *   CRC32        CRC-32 (IEEE/zlib)   poly 0x04C11DB7, init/xorout ~0,  反射
+ *   CRC32C       CRC-32C (Castagnoli) poly 0x1EDC6F41, init/xorout ~0,  反射
+ *
+ * 所有函数形如 crc = f(crc, data, len): 第一次传 CRCx_INIT, 返回值就是截至目前的 CRC,
+ * 分段计算时把上一段的返回值传回去即可 (CRC32/32C 按 zlib 约定在内部取反, INIT 为 0).
+ *
+ * 硬件路径 (编译期选择, 未启用时 *_hw 退回 slicing-by-8):
+ *   x86 SSE4.2 (-msse4.2)           crc32 指令只实现 CRC32C, 没有 IEEE CRC32
+ *   ARMv8 CRC (-march=armv8-a+crc)  __crc32* / __crc32c* 两种都有
+ * crc8() / crc16() / crc32() / crc32c() 是当前平台上最快的变体.
+ *
+ * 查表来自 crc_tables.h (gen_crc_tables.py 生成), 共约 22 KB; 只用逐字节查表时,
+ * 配合 -fdata-sections -Wl,--gc-sections 只会链接进用到的那几张表.
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC8_INIT   0x00u
+#define CRC16_INIT  0xFFFFu
+#define CRC32_INIT  0u
+#define CRC32C_INIT 0u
+
+#if defined(__ARM_FEATURE_CRC32)
+#define CRC_HW_CRC32  1
+#define CRC_HW_CRC32C 1
+#elif defined(__SSE4_2__)
+#define CRC_HW_CRC32C 1
+#endif
+
+uint8_t  crc8_bitwise(uint8_t crc, const void* data, size_t len);
+uint8_t  crc8_table(uint8_t crc, const void* data, size_t len);
+uint8_t  crc8_slice4(uint8_t crc, const void* data, size_t len);
+uint8_t  crc8_slice8(uint8_t crc, const void* data, size_t len);
+
+uint16_t crc16_bitwise(uint16_t crc, const void* data, size_t len);
+uint16_t crc16_table(uint16_t crc, const void* data, size_t len);
+uint16_t crc16_slice4(uint16_t crc, const void* data, size_t len);
+uint16_t crc16_slice8(uint16_t crc, const void* data, size_t len);
+
+uint32_t crc32_bitwise(uint32_t crc, const void* data, size_t len);
+uint32_t crc32_table(uint32_t crc, const void* data, size_t len);
+uint32_t crc32_slice4(uint32_t crc, const void* data, size_t len);
+uint32_t crc32_slice8(uint32_t crc, const void* data, size_t len);
+uint32_t crc32_hw(uint32_t crc, const void* data, size_t len);
+
+uint32_t crc32c_bitwise(uint32_t crc, const void* data, size_t len);
+uint32_t crc32c_table(uint32_t crc, const void* data, size_t len);
+uint32_t crc32c_slice4(uint32_t crc, const void* data, size_t len);
+uint32_t crc32c_slice8(uint32_t crc, const void* data, size_t len);
+uint32_t crc32c_hw(uint32_t crc, const void* data, size_t len);
+
+/* 各算法在本平台上的最快实现 */
+static inline uint8_t  crc8(uint8_t crc, const void* data, size_t len) { return crc8_slice8(crc, data, len); }
+static inline uint16_t crc16(uint16_t crc, const void* data, size_t len) { return crc16_slice8(crc, data, len); }
+static inline uint32_t crc32(uint32_t crc, const void* data, size_t len) {
+#ifdef CRC_HW_CRC32
+    return crc32_hw(crc, data, len);
+#else
+    return crc32_slice8(crc, data, len);
+#endif
+}
+static inline uint32_t crc32c(uint32_t crc, const void* data, size_t len) {
+#ifdef CRC_HW_CRC32C
+    return crc32c_hw(crc, data, len);
+#else
+    return crc32c_slice8(crc, data, len);
+#endif
+}
+
+#endif /* CRC_H */
@@ -0,0 +1,90 @@
+"""生成 crc_tables.h: CRC8 / CRC16-CCITT / CRC32 / CRC32C 的 slicing-by-8 查找表.
+
+    python gen_crc_tables.py                  # 写到本目录的 crc_tables.h
+    python gen_crc_tables.py -o out.h
+
+表 0 就是普通的 256 项字节表; 表 k 是 "该字节后面再跟 k 个零字节" 的 CRC, slicing-by-4/8 用前 4/8 张.
+多项式与位序都改在 CRCS 里, 不要手改生成的头文件.
+"""
+import argparse
+import os
+
+SLICES = 8
+
+# (C 名字, 位宽, 多项式 (反射算法用反转后的多项式), 是否反射, 说明)
+CRCS = (
+    ("crc8", 8, 0x07, False, "CRC-8 (SMBus): poly 0x07, init 0x00, MSB first"),
+    ("crc16", 16, 0x1021, False, "CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF, MSB first"),
+    ("crc32", 32, 0xEDB88320, True, "CRC-32 (IEEE 802.3 / zlib): poly 0x04C11DB7 reflected"),
+    ("crc32c", 32, 0x82F63B78, True, "CRC-32C (Castagnoli, SSE4.2 crc32): poly 0x1EDC6F41 reflected"),
+)
+
+
+def byte_table(width, poly, reflected):
+    mask = (1 << width) - 1
+    table = []
+    for b in range(256):
+        if reflected:
+            c = b
+            for _ in range(8):
+                c = (c >> 1) ^ poly if c & 1 else c >> 1
+        else:
+            top = 1 << (width - 1)
+            c = b << (width - 8)
+            for _ in range(8):
+                c = ((c << 1) ^ poly) if c & top else c << 1
+        table.append(c & mask)
+    return table
+
+
+def sliced_tables(width, poly, reflected):
+    t0 = byte_table(width, poly, reflected)
+    tables = [t0]
+    mask = (1 << width) - 1
+    for _ in range(1, SLICES):
+        prev = tables[-1]
+        if reflected:
+            tables.append([(v >> 8) ^ t0[v & 0xFF] for v in prev])
+        else:
+            tables.append([((v << 8) & mask) ^ t0[v >> (width - 8)] for v in prev])
+    return tables
+
+
+def emit(out, name, width, tables, comment):
+    ctype = {8: "uint8_t", 16: "uint16_t", 32: "uint32_t"}[width]
+    digits = width // 4
+    per_line = {8: 16, 16: 12, 32: 8}[width]
+    out.append("/* %s */" % comment)
+    out.append("static const %s %s_lut[%d][256] = {" % (ctype, name, SLICES))
+    for t in tables:
+        out.append("    {")
+        for i in range(0, 256, per_line):
+            row = ", ".join("0x%0*X" % (digits, v) for v in t[i:i + per_line])
+            out.append("        %s," % row)
+        out.append("    },")
+    out.append("};")
+    out.append("")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("-o", "--out", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "crc_tables.h"))
+    args = ap.parse_args()
+
+    out = [
+        "/* 由 gen_crc_tables.py 生成, 不要手改. */",
+        "#ifndef CRC_TABLES_H",
+        "#define CRC_TABLES_H",
+        "",
+        "#include <stdint.h>",
+        "",
+    ]
+    for name, width, poly, reflected, comment in CRCS:
+        emit(out, name, width, sliced_tables(width, poly, reflected), comment)
+    out.append("#endif /* CRC_TABLES_H */")
+    with open(args.out, "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,257 @@
+/* 流式滤波器耗时测试: 逐样本调用 (每个 ISR 一次 push) 对比块处理 (DMA 半缓冲一次 process)
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates filter.c bench_filter.c \
+ *           ../../Templates/benchmark.c -o bench_filter -lm
+ * 在 x86 上加 -DBENCH_TIMER=BENCH_TIMER_TSC (Cortex-M 上默认 DWT) 可直接得到 cycles/op;
+ * 再加 -DFILTER_NO_SIMD 得到标量内积的对照 (CMake 里是 bench_filter_scalar).
+ *
+ * 输入规模是块长 (每次 process 的样本数); 逐样本一栏对同样多的样本逐个调用 push, 两栏每样本耗时之差
+ * 就是逐次调用的开销. 计时前先做自检: 随机切块的块处理必须与逐样本一致 (Q15 逐位一致),
+ * 并与 double 参考实现比较, 超出误差界限时报 MISMATCH 并返回 1.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "filter.h"
+
+#define FIR_TAPS   32
+#define BQ_STAGES  4         /* 8 阶 Butterworth 低通 */
+#define MAX_BLOCK  4096u
+#define N_CHECK    5000
+#define PI         3.14159265358979323846
+
+static float   g_h[FIR_TAPS];
+static int16_t g_hq[FIR_TAPS];
+static float   g_bq[5 * BQ_STAGES];
+
+static float   g_fir_line[FIR_STATE_LEN(FIR_TAPS)];
+static int16_t g_firq_line[FIR_STATE_LEN(FIR_TAPS)];
+static fir_f32_t g_fir;
+static fir_q15_t g_firq;
+static biquad_f32_stage_t g_bq_st[BQ_STAGES];
+static biquad_q15_stage_t g_bqq_st[BQ_STAGES];
+static biquad_f32_t g_biq;
+static biquad_q15_t g_biqq;
+
+static float   g_in[MAX_BLOCK], g_out[MAX_BLOCK];
+static int16_t g_inq[MAX_BLOCK], g_outq[MAX_BLOCK];
+
+static uint32_t g_rng = 1;
+
+static uint32_t rng_next(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+/* [-0.9, 0.9) 的噪声叠加一个低频正弦, 同时给出 Q15 版本 (float 输入就是 Q15 值 / 32768, 两者可直接比较) */
+static void gen_signal(float* x, int16_t* xq, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t v = (int32_t)(rng_next() % 39322u) - 19661 + (int32_t)(9830.0 * sin(0.01 * (double)i));
+        xq[i] = (int16_t)v;
+        x[i] = (float)v / 32768.0f;
+    }
+}
+
+/* Hamming 窗 sinc 低通 (截止 0.1 fs), 直流增益 1; Q15 系数的 L1 范数约 1.1, 满足 fir_q15_init 的要求 */
+static void design_fir(void) {
+    double sum = 0.0, h[FIR_TAPS];
+    for (int k = 0; k < FIR_TAPS; k++) {
+        double t = k - (FIR_TAPS - 1) / 2.0;
+        double sinc = t == 0.0 ? 2 * 0.1 : sin(2 * PI * 0.1 * t) / (PI * t);
+        h[k] = sinc * (0.54 - 0.46 * cos(2 * PI * k / (FIR_TAPS - 1)));
+        sum += h[k];
+    }
+    for (int k = 0; k < FIR_TAPS; k++) {
+        g_h[k] = (float)(h[k] / sum);
+        g_hq[k] = (int16_t)lrint(h[k] / sum * 32768.0);
+    }
+}
+
+/* 8 阶 Butterworth 低通 (截止 0.05 fs), 双线性变换后拆成 4 个二阶节, 每节 Q = 1 / (2 cos theta_k) */
+static void design_biquad(void) {
+    double w0 = 2 * PI * 0.05, cw = cos(w0), sw = sin(w0);
+    for (int k = 0; k < BQ_STAGES; k++) {
+        double q = 1.0 / (2.0 * cos(PI * (2 * k + 1) / (4.0 * BQ_STAGES)));
+        double alpha = sw / (2 * q), a0 = 1 + alpha;
+        float* c = g_bq + 5 * k;
+        c[0] = (float)((1 - cw) / 2 / a0);
+        c[1] = (float)((1 - cw) / a0);
+        c[2] = c[0];
+        c[3] = (float)(-2 * cw / a0);
+        c[4] = (float)((1 - alpha) / a0);
+    }
+}
+
+/* ---------------- 自检 ---------------- */
+
+/* 长度 N_CHECK 的信号按 1..37 的随机块长喂给 process, 覆盖 pos 回绕、零头与 in == out 原地处理 */
+static size_t block_len(size_t i) {
+    size_t len = 1 + rng_next() % 37;
+    return len < N_CHECK - i ? len : N_CHECK - i;
+}
+#define FOR_RANDOM_BLOCKS(i, len) for (size_t i = 0, len = block_len(0); i < N_CHECK; i += len, len = block_len(i))
+
+static int check_fir(uint32_t taps) {
+    static float x[N_CHECK], yp[N_CHECK], yb[N_CHECK];
+    static int16_t xq[N_CHECK], ypq[N_CHECK], ybq[N_CHECK];
+    float line[FIR_STATE_LEN(FIR_TAPS)];
+    int16_t lineq[FIR_STATE_LEN(FIR_TAPS)];
+    fir_f32_t f;
+    fir_q15_t fq;
+    gen_signal(x, xq, N_CHECK);
+
+    fir_f32_init(&f, g_h, line, taps);
+    for (size_t i = 0; i < N_CHECK; i++) yp[i] = fir_f32_push(&f, x[i]);
+    fir_f32_init(&f, g_h, line, taps);
+    memcpy(yb, x, sizeof yb);
+    FOR_RANDOM_BLOCKS(i, len) fir_f32_process(&f, yb + i, yb + i, len);
+
+    if (fir_q15_init(&fq, g_hq, lineq, taps) != 0) return -1;
+    for (size_t i = 0; i < N_CHECK; i++) ypq[i] = fir_q15_push(&fq, xq[i]);
+    fir_q15_init(&fq, g_hq, lineq, taps);
+    FOR_RANDOM_BLOCKS(i, len) fir_q15_process(&fq, xq + i, ybq + i, len);
+
+    for (size_t n = 0; n < N_CHECK; n++) {
+        double ref = 0.0;
+        int64_t refq = 0;
+        for (uint32_t k = 0; k < taps && k <= n; k++) {
+            ref += (double)g_h[k] * x[n - k];
+            refq += (int32_t)g_hq[k] * xq[n - k];
+        }
+        refq = (refq + (1 << 14)) >> 15;
+        refq = refq > INT16_MAX ? INT16_MAX : (refq < INT16_MIN ? INT16_MIN : refq);
+        if (fabs(yp[n] - ref) > 1e-5 || fabs(yb[n] - ref) > 1e-5 || ypq[n] != refq || ybq[n] != refq) {
+            fprintf(stderr, "MISMATCH: fir taps=%u at sample %zu: push %g block %g ref %g, q15 %d %d ref %d\n", taps,
+                    n, yp[n], yb[n], ref, ypq[n], ybq[n], (int)refq);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int check_biquad(void) {
+    static float x[N_CHECK], yp[N_CHECK], yb[N_CHECK];
+    static int16_t xq[N_CHECK], ypq[N_CHECK], ybq[N_CHECK];
+    biquad_f32_stage_t st[BQ_STAGES];
+    biquad_q15_stage_t stq[BQ_STAGES];
+    biquad_f32_t f;
+    biquad_q15_t fq;
+    gen_signal(x, xq, N_CHECK);
+
+    biquad_f32_init(&f, st, g_bq, BQ_STAGES);
+    for (size_t i = 0; i < N_CHECK; i++) yp[i] = biquad_f32_push(&f, x[i]);
+    biquad_f32_init(&f, st, g_bq, BQ_STAGES);
+    FOR_RANDOM_BLOCKS(i, len) biquad_f32_process(&f, x + i, yb + i, len);
+
+    if (biquad_q15_init(&fq, stq, g_bq, BQ_STAGES) != 0) return -1;
+    for (size_t i = 0; i < N_CHECK; i++) ypq[i] = biquad_q15_push(&fq, xq[i]);
+    biquad_q15_init(&fq, stq, g_bq, BQ_STAGES);
+    memcpy(ybq, xq, sizeof ybq);
+    FOR_RANDOM_BLOCKS(i, len) biquad_q15_process(&fq, ybq + i, ybq + i, len);
+
+    /* double 参考: 同样的 (float) 系数, 直接 I 型 */
+    double s[BQ_STAGES][4] = {{0}};
+    double max_f = 0.0, max_q = 0.0;
+    for (size_t n = 0; n < N_CHECK; n++) {
+        double v = x[n];
+        for (int k = 0; k < BQ_STAGES; k++) {
+            const float* c = g_bq + 5 * k;
+            double y = c[0] * v + c[1] * s[k][0] + c[2] * s[k][1] - c[3] * s[k][2] - c[4] * s[k][3];
+            s[k][1] = s[k][0];
+            s[k][0] = v;
+            s[k][3] = s[k][2];
+            s[k][2] = y;
+            v = y;
+        }
+        if (fabs(yp[n] - v) > max_f) max_f = fabs(yp[n] - v);
+        if (fabs(ypq[n] / 32768.0 - v) > max_q) max_q = fabs(ypq[n] / 32768.0 - v);
+        if (fabs(yb[n] - yp[n]) > 1e-6f || ybq[n] != ypq[n]) {
+            fprintf(stderr, "MISMATCH: biquad block != push at sample %zu: %g/%g, q15 %d/%d\n", n, yb[n], yp[n],
+                    ybq[n], ypq[n]);
+            return -1;
+        }
+    }
+    fprintf(stderr, "# accuracy biquad f32 max %.3g, q15 max %.3g (%.1f LSB)\n", max_f, max_q, max_q * 32768.0);
+    if (max_f > 1e-4 || max_q > 64.0 / 32768.0) {
+        fprintf(stderr, "MISMATCH: biquad error exceeds limit\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* ---------------- 测试 ---------------- */
+
+static size_t g_n;
+
+#define BENCH_FILTER(label, body)           \
+    {                                       \
+        bench_t b;                          \
+        BENCH(b, label, {                   \
+            body;                           \
+            BENCH_CLOBBER();                \
+        });                                 \
+        bench_set_size(&b, n, n * bytes);   \
+        bench_report(&b);                   \
+    }
+
+static void bench_block(size_t n) {
+    char name[64];
+    size_t bytes = sizeof(float);
+    g_n = n;
+    snprintf(name, sizeof name, "fir f32 %d taps push", FIR_TAPS);
+    BENCH_FILTER(name, for (size_t i = 0; i < g_n; i++) g_out[i] = fir_f32_push(&g_fir, g_in[i]));
+    snprintf(name, sizeof name, "fir f32 %d taps block", FIR_TAPS);
+    BENCH_FILTER(name, fir_f32_process(&g_fir, g_in, g_out, g_n));
+    snprintf(name, sizeof name, "biquad f32 x%d push", BQ_STAGES);
+    BENCH_FILTER(name, for (size_t i = 0; i < g_n; i++) g_out[i] = biquad_f32_push(&g_biq, g_in[i]));
+    snprintf(name, sizeof name, "biquad f32 x%d block", BQ_STAGES);
+    BENCH_FILTER(name, biquad_f32_process(&g_biq, g_in, g_out, g_n));
+
+    bytes = sizeof(int16_t);
+    snprintf(name, sizeof name, "fir q15 %d taps push", FIR_TAPS);
+    BENCH_FILTER(name, for (size_t i = 0; i < g_n; i++) g_outq[i] = fir_q15_push(&g_firq, g_inq[i]));
+    snprintf(name, sizeof name, "fir q15 %d taps block", FIR_TAPS);
+    BENCH_FILTER(name, fir_q15_process(&g_firq, g_inq, g_outq, g_n));
+    snprintf(name, sizeof name, "biquad q15 x%d push", BQ_STAGES);
+    BENCH_FILTER(name, for (size_t i = 0; i < g_n; i++) g_outq[i] = biquad_q15_push(&g_biqq, g_inq[i]));
+    snprintf(name, sizeof name, "biquad q15 x%d block", BQ_STAGES);
+    BENCH_FILTER(name, biquad_q15_process(&g_biqq, g_inq, g_outq, g_n));
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    fprintf(stderr, "# filter kernels: %s\n", filter_isa());
+    design_fir();
+    design_biquad();
+    static const uint32_t check_taps[] = {1, 3, 5, 8, 13, 31, FIR_TAPS};
+    for (size_t i = 0; i < sizeof check_taps / sizeof check_taps[0]; i++)
+        if (check_fir(check_taps[i]) != 0) return 1;
+    if (check_biquad() != 0) return 1;
+
+    fir_f32_init(&g_fir, g_h, g_fir_line, FIR_TAPS);
+    fir_q15_init(&g_firq, g_hq, g_firq_line, FIR_TAPS);
+    biquad_f32_init(&g_biq, g_bq_st, g_bq, BQ_STAGES);
+    biquad_q15_init(&g_biqq, g_bqq_st, g_bq, BQ_STAGES);
+    gen_signal(g_in, g_inq, MAX_BLOCK);
+    /* 让数组地址逃逸: 否则编译器知道 BENCH_CLOBBER 碰不到这些内部链接的数组, 会把不变的计算提到循环外 */
+    BENCH_DO_NOT_OPTIMIZE(g_in);
+    BENCH_DO_NOT_OPTIMIZE(g_out);
+    BENCH_DO_NOT_OPTIMIZE(g_inq);
+    BENCH_DO_NOT_OPTIMIZE(g_outq);
+
+    static const size_t defaults[] = {4, 16, 64, 256, 1024};
+    const size_t* sizes;
+    size_t n_sizes = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    for (size_t i = 0; i < n_sizes; i++) {
+        if (sizes[i] == 0 || sizes[i] > MAX_BLOCK) {
+            fprintf(stderr, "# skip size %zu: must be 1..%u\n", sizes[i], MAX_BLOCK);
+            continue;
+        }
+        bench_block(sizes[i]);
+    }
+    return bench_summary();
+}
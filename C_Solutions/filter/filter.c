@@ -0,0 +1,458 @@
+/* 流式 FIR / biquad 滤波器实现
+ *
+ * FIR 内积有两种形状, 都按 SIMD 路径各写一份:
+ *   dot  : 一个输出, 系数与延迟线逐元素相乘后水平求和 (逐样本接口, 块首尾的零头)
+ *   dot4 : 连续 4 个输出. 4 个新样本写在 p-1 .. p-4, 以 base = p-4 为起点时输出 m 的窗口从 base+3-m 开始,
+ *          所以 loadu(s + base + k) 的第 l 个通道正好是输出 3-l 的第 k 项: 广播 h[k] 乘上去即可,
+ *          4 个通道就是 4 个输出 (顺序相反, 最后反转一次). 系数读一次用 4 次, 没有水平求和.
+ * 块内 pos 跨过 0 的那几个样本 (p < 4) 凑不成连续的 4 个窗口, 退回逐个 dot; 环越长占比越小.
+ */
+#include "filter.h"
+
+#include <string.h>
+
+#if defined(FILTER_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(FILTER_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+/* __ssat 只要 SAT (Cortex-M3 也有), __smlad / __smlald 要 DSP (Cortex-M4/M7) */
+#if defined(__ARM_FEATURE_SAT) || defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+static inline int16_t sat_q15(int32_t x) {
+#if defined(__ARM_FEATURE_SAT)
+    return (int16_t)__ssat(x, 16);
+#else
+    return (int16_t)(x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x));
+#endif
+}
+
+/* Q30 累加值 -> Q15, 四舍五入 (与 SSE2 packs / NEON vqrshrn 的结果一致) */
+static inline int16_t round_q15(int32_t acc) { return sat_q15((acc + (1 << 14)) >> 15); }
+
+#if defined(FILTER_SIMD_DSP)
+/* 两个相邻的 int16 作为一个字读出 (低半字在前); Cortex-M4/M7 的 LDR 允许非对齐 */
+static inline int16x2_t ld_pair(const int16_t* p) {
+    int32_t v;
+    memcpy(&v, p, sizeof v);
+    return (int16x2_t)v;
+}
+#endif
+
+/* ---------------- float 内积 ---------------- */
+
+static inline float dot_f32(const float* h, const float* s, uint32_t taps) {
+    uint32_t k = 0;
+    float sum = 0.0f;
+#if defined(FILTER_SIMD_SSE2)
+    __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();  /* 两个累加器隔开加法的延迟 */
+    for (; k + 8 <= taps; k += 8) {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(h + k), _mm_loadu_ps(s + k)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(h + k + 4), _mm_loadu_ps(s + k + 4)));
+    }
+    a0 = _mm_add_ps(a0, a1);
+    a0 = _mm_add_ps(a0, _mm_movehl_ps(a0, a0));
+    a0 = _mm_add_ss(a0, _mm_shuffle_ps(a0, a0, 1));
+    sum = _mm_cvtss_f32(a0);
+#elif defined(FILTER_SIMD_NEON)
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+    for (; k + 8 <= taps; k += 8) {
+        a0 = vmlaq_f32(a0, vld1q_f32(h + k), vld1q_f32(s + k));
+        a1 = vmlaq_f32(a1, vld1q_f32(h + k + 4), vld1q_f32(s + k + 4));
+    }
+    a0 = vaddq_f32(a0, a1);
+    float32x2_t t = vadd_f32(vget_low_f32(a0), vget_high_f32(a0));
+    sum = vget_lane_f32(vpadd_f32(t, t), 0);
+#endif
+    for (; k < taps; k++) sum += h[k] * s[k];
+    return sum;
+}
+
+/* out[m] = sum_k h[k] * s[k + 3 - m], m = 0..3; 读 s[0 .. taps + 2] */
+static inline void dot4_f32(const float* h, const float* s, uint32_t taps, float* out) {
+    uint32_t k = 0;
+#if defined(FILTER_SIMD_SSE2)
+    __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+    for (; k + 2 <= taps; k += 2) {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_set1_ps(h[k]), _mm_loadu_ps(s + k)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_set1_ps(h[k + 1]), _mm_loadu_ps(s + k + 1)));
+    }
+    if (k < taps) a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_set1_ps(h[k]), _mm_loadu_ps(s + k)));
+    a0 = _mm_add_ps(a0, a1);
+    _mm_storeu_ps(out, _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(0, 1, 2, 3)));
+#elif defined(FILTER_SIMD_NEON)
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+    for (; k + 2 <= taps; k += 2) {
+        a0 = vmlaq_n_f32(a0, vld1q_f32(s + k), h[k]);
+        a1 = vmlaq_n_f32(a1, vld1q_f32(s + k + 1), h[k + 1]);
+    }
+    if (k < taps) a0 = vmlaq_n_f32(a0, vld1q_f32(s + k), h[k]);
+    float32x4_t r = vrev64q_f32(vaddq_f32(a0, a1));
+    vst1q_f32(out, vcombine_f32(vget_high_f32(r), vget_low_f32(r)));
+#else
+    float y0 = 0.0f, y1 = 0.0f, y2 = 0.0f, y3 = 0.0f;
+    for (; k < taps; k++) {
+        float c = h[k];
+        y3 += c * s[k];
+        y2 += c * s[k + 1];
+        y1 += c * s[k + 2];
+        y0 += c * s[k + 3];
+    }
+    out[0] = y0;
+    out[1] = y1;
+    out[2] = y2;
+    out[3] = y3;
+#endif
+}
+
+/* ---------------- Q15 内积 (32 位累加, 由 L1 范数限制保证不溢出) ---------------- */
+
+static inline int32_t dot_q15(const int16_t* h, const int16_t* s, uint32_t taps) {
+    uint32_t k = 0;
+    int32_t acc = 0;
+#if defined(FILTER_SIMD_SSE2)
+    __m128i a = _mm_setzero_si128();
+    for (; k + 8 <= taps; k += 8)
+        a = _mm_add_epi32(a, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(h + k)),
+                                            _mm_loadu_si128((const __m128i*)(s + k))));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    acc = _mm_cvtsi128_si32(a);
+#elif defined(FILTER_SIMD_NEON)
+    int32x4_t a = vdupq_n_s32(0);
+    for (; k + 4 <= taps; k += 4) a = vmlal_s16(a, vld1_s16(h + k), vld1_s16(s + k));
+    int32x2_t t = vadd_s32(vget_low_s32(a), vget_high_s32(a));
+    acc = vget_lane_s32(vpadd_s32(t, t), 0);
+#elif defined(FILTER_SIMD_DSP)
+    for (; k + 2 <= taps; k += 2) acc = __smlad(ld_pair(h + k), ld_pair(s + k), acc);
+#endif
+    for (; k < taps; k++) acc += (int32_t)h[k] * s[k];
+    return acc;
+}
+
+/* 同 dot4_f32, 结果直接舍入成 Q15 */
+static inline void dot4_q15(const int16_t* h, const int16_t* s, uint32_t taps, int16_t* out) {
+    uint32_t k = 0;
+#if defined(FILTER_SIMD_SSE2)
+    /* 每次两项: 交织 s[k + l] 与 s[k + 1 + l] 后与 (h[k], h[k+1]) 做 pmaddwd, 通道 l 得到输出 3-l 的两项之和.
+     * 奇数个系数时最后一对补 0 系数, 多读的 s[taps + 3] 仍在延迟线内 (s 最多从 len - 5 开始) */
+#define DOT4_PAIR(c)                                                                                   \
+    do {                                                                                               \
+        __m128i x0 = _mm_loadl_epi64((const __m128i*)(s + k));                                         \
+        __m128i x1 = _mm_loadl_epi64((const __m128i*)(s + k + 1));                                     \
+        a = _mm_add_epi32(a, _mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), _mm_set1_epi32((int32_t)(c)))); \
+    } while (0)
+    __m128i a = _mm_setzero_si128();
+    for (; k + 2 <= taps; k += 2) DOT4_PAIR((uint16_t)h[k] | (uint32_t)(uint16_t)h[k + 1] << 16);
+    if (k < taps) DOT4_PAIR((uint16_t)h[k]);
+#undef DOT4_PAIR
+    a = _mm_srai_epi32(_mm_add_epi32(a, _mm_set1_epi32(1 << 14)), 15);
+    a = _mm_packs_epi32(a, a);  /* 饱和到 int16 */
+    _mm_storel_epi64((__m128i*)out, _mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3)));
+#elif defined(FILTER_SIMD_NEON)
+    int32x4_t a = vdupq_n_s32(0);
+    for (; k < taps; k++) a = vmlal_n_s16(a, vld1_s16(s + k), h[k]);
+    vst1_s16(out, vrev64_s16(vqrshrn_n_s32(a, 15)));
+#else
+    int32_t y0 = 0, y1 = 0, y2 = 0, y3 = 0;
+#if defined(FILTER_SIMD_DSP)
+    for (; k + 2 <= taps; k += 2) {
+        int16x2_t c = ld_pair(h + k);
+        y3 = __smlad(c, ld_pair(s + k), y3);
+        y2 = __smlad(c, ld_pair(s + k + 1), y2);
+        y1 = __smlad(c, ld_pair(s + k + 2), y1);
+        y0 = __smlad(c, ld_pair(s + k + 3), y0);
+    }
+#endif
+    for (; k < taps; k++) {
+        int32_t c = h[k];
+        y3 += c * s[k];
+        y2 += c * s[k + 1];
+        y1 += c * s[k + 2];
+        y0 += c * s[k + 3];
+    }
+    out[0] = round_q15(y0);
+    out[1] = round_q15(y1);
+    out[2] = round_q15(y2);
+    out[3] = round_q15(y3);
+#endif
+}
+
+/* ---------------- FIR ---------------- */
+
+int fir_f32_init(fir_f32_t* f, const float* h, float* state, uint32_t taps) {
+    if (f == NULL || h == NULL || state == NULL || taps == 0) return -1;
+    f->h = h;
+    f->state = state;
+    f->taps = taps;
+    f->len = taps + 3;
+    fir_f32_reset(f);
+    return 0;
+}
+
+void fir_f32_reset(fir_f32_t* f) {
+    memset(f->state, 0, FIR_STATE_LEN(f->taps) * sizeof *f->state);
+    f->pos = 0;
+}
+
+int fir_q15_init(fir_q15_t* f, const int16_t* h, int16_t* state, uint32_t taps) {
+    if (f == NULL || h == NULL || state == NULL || taps == 0) return -1;
+    uint32_t l1 = 0;
+    for (uint32_t k = 0; k < taps; k++) {
+        l1 += (uint32_t)(h[k] < 0 ? -(int32_t)h[k] : h[k]);
+        if (l1 > 65535u) return -1;
+    }
+    f->h = h;
+    f->state = state;
+    f->taps = taps;
+    f->len = taps + 3;
+    fir_q15_reset(f);
+    return 0;
+}
+
+void fir_q15_reset(fir_q15_t* f) {
+    memset(f->state, 0, FIR_STATE_LEN(f->taps) * sizeof *f->state);
+    f->pos = 0;
+}
+
+float fir_f32_push(fir_f32_t* f, float x) {
+    uint32_t p = f->pos ? f->pos - 1 : f->len - 1;
+    f->state[p] = f->state[p + f->len] = x;
+    f->pos = p;
+    return dot_f32(f->h, f->state + p, f->taps);
+}
+
+int16_t fir_q15_push(fir_q15_t* f, int16_t x) {
+    uint32_t p = f->pos ? f->pos - 1 : f->len - 1;
+    f->state[p] = f->state[p + f->len] = x;
+    f->pos = p;
+    return round_q15(dot_q15(f->h, f->state + p, f->taps));
+}
+
+void fir_f32_process(fir_f32_t* f, const float* in, float* out, size_t n) {
+    const float* h = f->h;
+    float* s = f->state;
+    const uint32_t taps = f->taps, len = f->len;
+    uint32_t p = f->pos;
+    size_t i = 0;
+    while (i < n) {
+        if (p >= 4 && n - i >= 4) {
+            /* 先把 4 个输入都写进延迟线再算输出: in 与 out 是同一个数组时也不会读到已写的输出 */
+            for (uint32_t m = 0; m < 4; m++) s[p - 1 - m] = s[p - 1 - m + len] = in[i + m];
+            p -= 4;
+            dot4_f32(h, s + p, taps, out + i);
+            i += 4;
+        } else {
+            p = p ? p - 1 : len - 1;
+            s[p] = s[p + len] = in[i];
+            out[i++] = dot_f32(h, s + p, taps);
+        }
+    }
+    f->pos = p;
+}
+
+void fir_q15_process(fir_q15_t* f, const int16_t* in, int16_t* out, size_t n) {
+    const int16_t* h = f->h;
+    int16_t* s = f->state;
+    const uint32_t taps = f->taps, len = f->len;
+    uint32_t p = f->pos;
+    size_t i = 0;
+    while (i < n) {
+        if (p >= 4 && n - i >= 4) {
+            for (uint32_t m = 0; m < 4; m++) s[p - 1 - m] = s[p - 1 - m + len] = in[i + m];
+            p -= 4;
+            dot4_q15(h, s + p, taps, out + i);
+            i += 4;
+        } else {
+            p = p ? p - 1 : len - 1;
+            s[p] = s[p + len] = in[i];
+            out[i++] = round_q15(dot_q15(h, s + p, taps));
+        }
+    }
+    f->pos = p;
+}
+
+/* ---------------- biquad float (转置直接 II 型) ---------------- */
+
+/* 块处理每次把相邻 4 级 (余下的按 2 级 / 1 级) 放在同一个循环里, 各级状态是局部副本, 整块期间留在寄存器里:
+ * 后一级处理样本 k 的同时前一级已经可以处理样本 k + 1, 乱序核上几条递推链重叠执行.
+ * 一级一个循环反而比逐样本慢 (逐样本时所有级天然交错, 整个块只剩一条串行的依赖链) */
+#define BQ_CASCADE(stage_t, step, f, in, out, n)                                                         \
+    do {                                                                                                 \
+        uint32_t i_ = 0;                                                                                 \
+        for (; i_ + 4 <= (f)->n_stages; i_ += 4) {                                                       \
+            stage_t a_ = (f)->st[i_], b_ = (f)->st[i_ + 1], c_ = (f)->st[i_ + 2], d_ = (f)->st[i_ + 3];  \
+            for (size_t k_ = 0; k_ < (n); k_++)                                                          \
+                (out)[k_] = step(&d_, step(&c_, step(&b_, step(&a_, (in)[k_]))));                        \
+            (f)->st[i_] = a_;                                                                            \
+            (f)->st[i_ + 1] = b_;                                                                        \
+            (f)->st[i_ + 2] = c_;                                                                        \
+            (f)->st[i_ + 3] = d_;                                                                        \
+            (in) = (out); /* 后面各级在 out 上原地处理 */                                                \
+        }                                                                                                \
+        if (i_ + 2 <= (f)->n_stages) {                                                                   \
+            stage_t a_ = (f)->st[i_], b_ = (f)->st[i_ + 1];                                              \
+            for (size_t k_ = 0; k_ < (n); k_++) (out)[k_] = step(&b_, step(&a_, (in)[k_]));              \
+            (f)->st[i_] = a_;                                                                            \
+            (f)->st[i_ + 1] = b_;                                                                        \
+            (in) = (out);                                                                                \
+            i_ += 2;                                                                                     \
+        }                                                                                                \
+        if (i_ < (f)->n_stages) {                                                                        \
+            stage_t a_ = (f)->st[i_];                                                                    \
+            for (size_t k_ = 0; k_ < (n); k_++) (out)[k_] = step(&a_, (in)[k_]);                         \
+            (f)->st[i_] = a_;                                                                            \
+        }                                                                                                \
+    } while (0)
+
+int biquad_f32_init(biquad_f32_t* f, biquad_f32_stage_t* storage, const float* coeffs, uint32_t n_stages) {
+    if (f == NULL || storage == NULL || coeffs == NULL || n_stages == 0) return -1;
+    for (uint32_t i = 0; i < n_stages; i++) {
+        const float* c = coeffs + 5 * i;
+        storage[i].b0 = c[0];
+        storage[i].b1 = c[1];
+        storage[i].b2 = c[2];
+        storage[i].a1 = c[3];
+        storage[i].a2 = c[4];
+    }
+    f->st = storage;
+    f->n_stages = n_stages;
+    biquad_f32_reset(f);
+    return 0;
+}
+
+void biquad_f32_reset(biquad_f32_t* f) {
+    for (uint32_t i = 0; i < f->n_stages; i++) f->st[i].s1 = f->st[i].s2 = 0.0f;
+}
+
+/* 与 y 无关的项先加好, 依赖上一拍输出的链上只剩一次乘法和一次减法 */
+static inline float bq_f32_step(biquad_f32_stage_t* q, float x) {
+    float y = q->b0 * x + q->s1;
+    q->s1 = (q->b1 * x + q->s2) - q->a1 * y;
+    q->s2 = q->b2 * x - q->a2 * y;
+    return y;
+}
+
+float biquad_f32_push(biquad_f32_t* f, float x) {
+    for (uint32_t i = 0; i < f->n_stages; i++) x = bq_f32_step(&f->st[i], x);
+    return x;
+}
+
+void biquad_f32_process(biquad_f32_t* f, const float* in, float* out, size_t n) {
+    BQ_CASCADE(biquad_f32_stage_t, bq_f32_step, f, in, out, n);
+}
+
+/* ---------------- biquad Q15 (直接 I 型) ---------------- */
+
+/* 四舍五入到 Q15 并钳位; 调用方已保证 |c| * 2^15 / 2^shift < 32767.5 */
+static int16_t coef_q15(float c, int shift) {
+    float v = c * (32768.0f / (float)(1 << shift));
+    return (int16_t)(int32_t)(v + (v >= 0.0f ? 0.5f : -0.5f));
+}
+
+int biquad_q15_init(biquad_q15_t* f, biquad_q15_stage_t* storage, const float* coeffs, uint32_t n_stages) {
+    if (f == NULL || storage == NULL || coeffs == NULL || n_stages == 0) return -1;
+    for (uint32_t i = 0; i < n_stages; i++) {
+        const float* c = coeffs + 5 * i;
+        float m = 0.0f;
+        for (int j = 0; j < 5; j++) {
+            float a = c[j] < 0.0f ? -c[j] : c[j];
+            if (a > m) m = a;
+        }
+        int shift = 0;
+        while (shift <= BIQUAD_Q15_MAX_SHIFT && m * (32768.0f / (float)(1 << shift)) >= 32767.5f) shift++;
+        if (shift > BIQUAD_Q15_MAX_SHIFT) return -1;
+        biquad_q15_stage_t* q = &storage[i];
+        q->b0 = coef_q15(c[0], shift);
+        q->b1 = coef_q15(c[1], shift);
+        q->b2 = coef_q15(c[2], shift);
+        q->na1 = coef_q15(-c[3], shift);
+        q->na2 = coef_q15(-c[4], shift);
+        q->shift = (int8_t)shift;
+    }
+    f->st = storage;
+    f->n_stages = n_stages;
+    biquad_q15_reset(f);
+    return 0;
+}
+
+void biquad_q15_reset(biquad_q15_t* f) {
+    for (uint32_t i = 0; i < f->n_stages; i++) f->st[i].x1 = f->st[i].x2 = f->st[i].y1 = f->st[i].y2 = 0;
+}
+
+/* 五个 Q30 乘积之和可能超过 2^31, 用 64 位累加; 结果右移 15 - shift 回到 Q15 */
+static inline int16_t biquad_q15_out(int64_t acc, int shift) {
+    int rs = 15 - shift;
+    int64_t y = (acc + ((int64_t)1 << (rs - 1))) >> rs;
+    return (int16_t)(y > INT16_MAX ? INT16_MAX : (y < INT16_MIN ? INT16_MIN : y));
+}
+
+/* 前三项只依赖输入, 两个反馈项放在最后; Cortex-M4 上 GCC 把每项编成一条 SMLALBB */
+static inline int16_t bq_q15_step(biquad_q15_stage_t* q, int16_t x) {
+    int64_t acc = (int64_t)((int32_t)q->b0 * x + (int32_t)q->b1 * q->x1) + (int32_t)q->b2 * q->x2 +
+                  (int32_t)q->na1 * q->y1 + (int32_t)q->na2 * q->y2;
+    int16_t y = biquad_q15_out(acc, q->shift);
+    q->x2 = q->x1;
+    q->x1 = x;
+    q->y2 = q->y1;
+    q->y1 = y;
+    return y;
+}
+
+int16_t biquad_q15_push(biquad_q15_t* f, int16_t x) {
+    for (uint32_t i = 0; i < f->n_stages; i++) x = bq_q15_step(&f->st[i], x);
+    return x;
+}
+
+#if defined(FILTER_SIMD_DSP)
+
+/* Cortex-M 是顺序核, 多级交错得不到重叠, 反而因寄存器不够而溢出到栈上, 所以逐级处理.
+ * 系数与状态成对打包在寄存器里: (b1, b2) . (x1, x2) 和 (-a1, -a2) . (y1, y2) 各是一条 SMLALD,
+ * 新样本移入低半字, 旧的 x1 / y1 自然进到高半字 */
+void biquad_q15_process(biquad_q15_t* f, const int16_t* in, int16_t* out, size_t n) {
+    for (uint32_t i = 0; i < f->n_stages; i++) {
+        biquad_q15_stage_t* q = &f->st[i];
+        const int shift = q->shift;
+        const int32_t b0 = q->b0;
+        const int16x2_t cb = (int16x2_t)((uint32_t)(uint16_t)q->b1 | (uint32_t)(uint16_t)q->b2 << 16);
+        const int16x2_t ca = (int16x2_t)((uint32_t)(uint16_t)q->na1 | (uint32_t)(uint16_t)q->na2 << 16);
+        uint32_t xs = (uint16_t)q->x1 | (uint32_t)(uint16_t)q->x2 << 16;
+        uint32_t ys = (uint16_t)q->y1 | (uint32_t)(uint16_t)q->y2 << 16;
+        for (size_t k = 0; k < n; k++) {
+            int16_t x = in[k];
+            int64_t acc = __smlald(cb, (int16x2_t)xs, (int64_t)(b0 * x));
+            acc = __smlald(ca, (int16x2_t)ys, acc);
+            int16_t y = biquad_q15_out(acc, shift);
+            xs = xs << 16 | (uint16_t)x;
+            ys = ys << 16 | (uint16_t)y;
+            out[k] = y;
+        }
+        q->x1 = (int16_t)xs;
+        q->x2 = (int16_t)(xs >> 16);
+        q->y1 = (int16_t)ys;
+        q->y2 = (int16_t)(ys >> 16);
+        in = out;
+    }
+}
+
+#else
+
+void biquad_q15_process(biquad_q15_t* f, const int16_t* in, int16_t* out, size_t n) {
+    BQ_CASCADE(biquad_q15_stage_t, bq_q15_step, f, in, out, n);
+}
+
+#endif
+
+const char* filter_isa(void) {
+#if defined(FILTER_SIMD_SSE2)
+    return "sse2";
+#elif defined(FILTER_SIMD_NEON)
+    return "neon";
+#elif defined(FILTER_SIMD_DSP)
+    return "dsp";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,116 @@
+/* 流式 FIR / IIR (biquad 级联) 滤波器 - float 与 Q15, 逐样本与块处理两套接口
+ *
+ * - FIR 延迟线是 "双写" 环形缓冲区: 环长 len = taps + 3, 每个新样本同时写到 pos 与 pos + len,
+ *   最近 taps 个样本因此总是连续地放在 state[pos .. pos + taps - 1] (最新在前), 与系数 h[0..taps-1]
+ *   一一对应. 内积循环里没有取模和回绕判断, 可以直接用 SIMD 做非对齐加载. 多出的 3 个位置留给块处理:
+ *   一次写入 4 个新样本时, 其中较早的 3 个输出仍要用到的旧样本不会被覆盖.
+ * - fir_*_process 一次处理一块: 每 4 个输出共用一次系数加载, 4 个输出落在同一个向量的 4 个通道里,
+ *   不需要逐样本的水平求和; 块内状态 (pos, 指针) 留在寄存器里, 没有逐样本的函数调用.
+ * - biquad 是递推的, 时间方向上无法向量化; 块处理把相邻 4 级 (余下的按 2 级 / 1 级) 放进同一个样本循环,
+ *   这几级的系数与状态在整块期间都留在寄存器里, 几条递推链在乱序核上重叠执行; 逐样本接口则每个样本都要
+ *   把所有级重新读写一遍. 只有 Cortex-M 的 DSP 路径 (顺序核, 寄存器少) 真正逐级处理: 整块过完第 1 级再过第 2 级.
+ * - 存储区由调用方提供 (静态数组), 不 malloc; 系数数组只保存指针, 调用方在滤波器生命周期内保持有效.
+ *
+ * 内积在编译期选择: x86 SSE2 (x86-64 默认就有), ARM NEON, Cortex-M4/M7 的 SMLAD (__ARM_FEATURE_DSP,
+ * 一条指令两次 16x16 乘加); -DFILTER_NO_SIMD 强制走标量循环. 同一输入下块处理与逐样本的 Q15 结果逐位一致,
+ * float 结果只差求和顺序带来的舍入.
+ *
+ *   static const float h[32] = {...};
+ *   static float line[FIR_STATE_LEN(32)];
+ *   static fir_f32_t lp;
+ *   fir_f32_init(&lp, h, line, 32);
+ *   // DMA 半传输中断: fir_f32_process(&lp, adc_half, filtered, 64);
+ *   // 或逐样本 ISR:   y = fir_f32_push(&lp, x);
+ */
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(FILTER_NO_SIMD) && defined(__SSE2__)
+#define FILTER_SIMD_SSE2 1
+#elif !defined(FILTER_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define FILTER_SIMD_NEON 1
+#elif !defined(FILTER_NO_SIMD) && defined(__ARM_FEATURE_DSP)
+#define FILTER_SIMD_DSP 1
+#endif
+
+#define FIR_STATE_LEN(taps) (2u * ((taps) + 3u))  /* 延迟线元素个数 */
+#define BIQUAD_Q15_MAX_SHIFT 2                     /* Q15 biquad 系数最大放大 2^2 倍, 即 |系数| < 4 */
+
+/* ---------------- FIR ---------------- */
+
+typedef struct {
+    const float* h;    /* taps 个系数, y[n] = sum h[k] * x[n - k] */
+    float*   state;    /* FIR_STATE_LEN(taps) 个 */
+    uint32_t taps;
+    uint32_t len;      /* 环长 taps + 3 */
+    uint32_t pos;      /* 最新样本的位置, 新样本写到 pos - 1 (回绕到 len - 1) */
+} fir_f32_t;
+
+typedef struct {
+    const int16_t* h;  /* Q15 系数; 要求 sum |h[k]| <= 65535 (L1 范数 < 2), 见 fir_q15_init */
+    int16_t* state;
+    uint32_t taps;
+    uint32_t len;
+    uint32_t pos;
+} fir_q15_t;
+
+/* state 至少 FIR_STATE_LEN(taps) 个元素, taps >= 1. 成功返回 0, 参数非法返回 -1 */
+int  fir_f32_init(fir_f32_t* f, const float* h, float* state, uint32_t taps);
+void fir_f32_reset(fir_f32_t* f);
+/* Q15 累加用 32 位: L1 范数 < 2 保证任何部分和都不超过 65535 * 32768 < 2^31, 所以 SMLAD / pmaddwd
+ * 不会溢出; 输出四舍五入后饱和到 int16. 系数 L1 范数过大返回 -1 */
+int  fir_q15_init(fir_q15_t* f, const int16_t* h, int16_t* state, uint32_t taps);
+void fir_q15_reset(fir_q15_t* f);
+
+/* 逐样本: 推入 x, 返回 y[n] */
+float   fir_f32_push(fir_f32_t* f, float x);
+int16_t fir_q15_push(fir_q15_t* f, int16_t x);
+/* 块处理: out[i] 对应 in[i]; in 与 out 可以是同一个数组 */
+void fir_f32_process(fir_f32_t* f, const float* in, float* out, size_t n);
+void fir_q15_process(fir_q15_t* f, const int16_t* in, int16_t* out, size_t n);
+
+/* ---------------- biquad 级联 ----------------
+ * 每级 H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2), 系数数组按级排列 {b0, b1, b2, a1, a2}.
+ * float 用转置直接 II 型 (每级 2 个状态); Q15 用直接 I 型 (每级 4 个状态, 只有一个累加器, 64 位累加) */
+
+typedef struct {
+    float b0, b1, b2, a1, a2;
+    float s1, s2;
+} biquad_f32_stage_t;
+
+typedef struct {
+    int16_t b0, b1, b2;       /* Q15 尾数, 实际系数 = c * 2^shift / 32768 */
+    int16_t na1, na2;         /* 存 -a1, -a2: 内积全是加法, 可以成对送进 SMLALD */
+    int8_t  shift;
+    int16_t x1, x2, y1, y2;
+} biquad_q15_stage_t;
+
+typedef struct {
+    biquad_f32_stage_t* st;
+    uint32_t n_stages;
+} biquad_f32_t;
+
+typedef struct {
+    biquad_q15_stage_t* st;
+    uint32_t n_stages;
+} biquad_q15_t;
+
+/* storage 至少 n_stages 个; coeffs 为 5 * n_stages 个 float (初始化时复制, 之后不再引用).
+ * 成功返回 0; Q15 版本某级系数绝对值 >= 2^BIQUAD_Q15_MAX_SHIFT 时返回 -1 */
+int  biquad_f32_init(biquad_f32_t* f, biquad_f32_stage_t* storage, const float* coeffs, uint32_t n_stages);
+void biquad_f32_reset(biquad_f32_t* f);
+int  biquad_q15_init(biquad_q15_t* f, biquad_q15_stage_t* storage, const float* coeffs, uint32_t n_stages);
+void biquad_q15_reset(biquad_q15_t* f);
+
+float   biquad_f32_push(biquad_f32_t* f, float x);
+int16_t biquad_q15_push(biquad_q15_t* f, int16_t x);
+void biquad_f32_process(biquad_f32_t* f, const float* in, float* out, size_t n);
+void biquad_q15_process(biquad_q15_t* f, const int16_t* in, int16_t* out, size_t n);
+
+/* 当前内积路径的名字: "sse2" / "neon" / "dsp" / "scalar" */
+const char* filter_isa(void);
+
+#endif /* FILTER_H */
@@ -0,0 +1,306 @@
+/* 主机端中断仿真器实现
+ *
+ * 事件只有两类: 某个中断源触发, 或栈顶的执行体 (中断/主循环步) 做完. 中断源最多十几个,
+ * 每次线性扫描找最早的事件即可, 不需要堆.
+ */
+#include "isr_sim.h"
+
+#include <math.h>
+#include <string.h>
+
+#define PRIO_THREAD 256          /* 主循环/空闲: 比任何中断都低 */
+
+/* ---------------- 随机数: splitmix64, 与平台无关, 保证可复现 ---------------- */
+
+static uint64_t rng_next(isr_sim_t* s) {
+    uint64_t z = (s->rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/* [0, 1) */
+static double rng_unit(isr_sim_t* s) { return (double)(rng_next(s) >> 11) * (1.0 / 9007199254740992.0); }
+
+/* ---------------- 触发时刻 ---------------- */
+
+static isr_time_t jittered(isr_sim_t* s, const isr_source_t* src) {
+    uint32_t j = src->cfg.jitter_ns;
+    if (j == 0) return src->nominal;
+    int64_t off = (int64_t)(rng_next(s) % (2u * (uint64_t)j + 1u)) - (int64_t)j;
+    int64_t t = (int64_t)src->nominal + off;
+    return t < (int64_t)s->now ? s->now : (isr_time_t)t;  /* 只有第一次 (phase < jitter) 会被截到 now */
+}
+
+static isr_time_t exp_interval(isr_sim_t* s, uint32_t mean_ns) {
+    double t = -log(1.0 - rng_unit(s)) * (double)mean_ns;
+    return t < 1.0 ? 1 : (isr_time_t)t;
+}
+
+/* t 时刻已经触发过一次, 算出同一中断源的下一次自主触发 */
+static void schedule_next(isr_sim_t* s, isr_source_t* src, isr_time_t t) {
+    switch (src->cfg.kind) {
+    case ISR_SRC_PERIODIC:
+        src->nominal += src->cfg.period_ns;
+        src->next_fire = jittered(s, src);
+        break;
+    case ISR_SRC_POISSON:
+        src->next_fire = t + exp_interval(s, src->cfg.period_ns);
+        break;
+    default:
+        src->next_fire = ISR_SIM_NEVER;
+        break;
+    }
+}
+
+static void fire(isr_source_t* src, isr_time_t t) {
+    src->st.fired++;
+    if (src->pending) {
+        src->st.lost++;           /* 挂起位已置位, 这次触发被合并 */
+    } else {
+        src->pending = 1;
+        src->pend_since = t;
+    }
+}
+
+static void fire_due(isr_sim_t* s) {
+    for (int i = 0; i < s->n_src; i++) {
+        isr_source_t* src = &s->src[i];
+        while (src->next_fire <= s->now) {
+            isr_time_t t = src->next_fire;
+            fire(src, t);
+            schedule_next(s, src, t);
+        }
+        if (src->sw_fire <= s->now) {
+            fire(src, src->sw_fire);
+            src->sw_fire = ISR_SIM_NEVER;
+        }
+    }
+}
+
+static isr_time_t next_event(const isr_sim_t* s) {
+    isr_time_t t = ISR_SIM_NEVER;
+    for (int i = 0; i < s->n_src; i++) {
+        if (s->src[i].next_fire < t) t = s->src[i].next_fire;
+        if (s->src[i].sw_fire < t) t = s->src[i].sw_fire;
+    }
+    return t;
+}
+
+/* ---------------- 调度 ---------------- */
+
+/* 优先级最高的挂起中断; 同优先级取 id 小的 (与 NVIC 按异常号仲裁一致) */
+static int best_pending(const isr_sim_t* s) {
+    int best = -1;
+    for (int i = 0; i < s->n_src; i++) {
+        if (s->src[i].pending && (best < 0 || s->src[i].cfg.priority < s->src[best].cfg.priority)) best = i;
+    }
+    return best;
+}
+
+static int running_prio(const isr_sim_t* s) {
+    if (s->depth == 0) return PRIO_THREAD;
+    int id = s->stack[s->depth - 1].src;
+    return id == ISR_SIM_MAIN ? PRIO_THREAD : s->src[id].cfg.priority;
+}
+
+/* 执行回调, 返回它占用的仿真时间 (模型耗时 + 追加耗时 + 实测耗时 * scale) */
+static isr_time_t run_handler(isr_sim_t* s, isr_handler_t fn, void* ctx, uint32_t cost_ns) {
+    s->charge = 0;
+    if (fn != NULL) {
+        if (s->clock != NULL) {
+            uint64_t t0 = s->clock();
+            fn(ctx);
+            uint64_t t1 = s->clock();
+            s->charge += (isr_time_t)((double)(t1 - t0) * (double)s->clock_scale);
+        } else {
+            fn(ctx);
+        }
+    }
+    return (isr_time_t)cost_ns + s->charge;
+}
+
+static void start_isr(isr_sim_t* s, int id) {
+    isr_source_t* src = &s->src[id];
+    if (s->depth > 0) {
+        int top = s->stack[s->depth - 1].src;
+        if (top == ISR_SIM_MAIN) s->main_st.preempted++;
+        else s->src[top].st.preempted++;
+    }
+    src->pending = 0;
+
+    isr_frame_t* f = &s->stack[s->depth++];
+    f->src = id;
+    f->trigger = src->pend_since;
+
+    isr_time_t lat = s->now + s->entry_ns - src->pend_since;
+    if (lat > src->st.latency_max) src->st.latency_max = lat;
+    src->st.latency_sum += lat;
+    src->st.started++;
+
+    isr_time_t cost = run_handler(s, src->cfg.handler, src->cfg.ctx, src->cfg.cost_ns);
+    f->remaining = s->entry_ns + cost + s->exit_ns;
+    src->st.busy += f->remaining;
+}
+
+static void start_main(isr_sim_t* s) {
+    isr_frame_t* f = &s->stack[s->depth++];
+    f->src = ISR_SIM_MAIN;
+    f->trigger = s->now;
+    f->remaining = run_handler(s, s->main_step, s->main_ctx, s->main_cost_ns);
+    if (f->remaining == 0) f->remaining = 1;  /* 零耗时的主循环会让仿真时间停住 */
+    s->main_st.busy += f->remaining;
+}
+
+/* 状态变化后决定栈顶执行什么: 可抢占就压入挂起的中断, CPU 空着就开始下一步主循环 */
+static void dispatch(isr_sim_t* s) {
+    int id = best_pending(s);
+    if (id >= 0 && (int)s->src[id].cfg.priority < running_prio(s)) {
+        start_isr(s, id);
+    } else if (s->depth == 0 && s->main_step != NULL) {
+        start_main(s);
+    }
+}
+
+static void complete(isr_sim_t* s) {
+    isr_frame_t* f = &s->stack[--s->depth];
+    isr_time_t resp = s->now - f->trigger;
+    isr_stats_t* st;
+    if (f->src == ISR_SIM_MAIN) {
+        st = &s->main_st;
+    } else {
+        st = &s->src[f->src].st;
+        const isr_source_cfg_t* c = &s->src[f->src].cfg;
+        uint32_t limit = c->deadline_ns ? c->deadline_ns : c->period_ns;
+        if (limit != 0 && resp > limit) st->deadline_miss++;
+    }
+    st->handled++;
+    st->response_sum += resp;
+    if (resp > st->response_max) st->response_max = resp;
+}
+
+void isr_sim_run(isr_sim_t* s, isr_time_t duration) {
+    isr_time_t end = s->now + duration;
+    for (;;) {
+        dispatch(s);
+        isr_time_t t = next_event(s);
+        if (s->depth > 0 && s->now + s->stack[s->depth - 1].remaining < t)
+            t = s->now + s->stack[s->depth - 1].remaining;
+        if (t > end) t = end;
+
+        if (s->depth > 0) s->stack[s->depth - 1].remaining -= t - s->now;
+        else s->idle += t - s->now;
+        s->now = t;
+
+        /* 同一时刻先完成再触发: 触发的中断由下一轮 dispatch 决定是抢占还是尾链 */
+        if (s->depth > 0 && s->stack[s->depth - 1].remaining == 0) complete(s);
+        fire_due(s);
+        if (s->now >= end) break;
+    }
+}
+
+/* ---------------- 配置 ---------------- */
+
+void isr_sim_init(isr_sim_t* s, uint64_t seed) {
+    memset(s, 0, sizeof *s);
+    s->rng = seed;
+    s->clock_scale = 1.0f;
+}
+
+int isr_sim_add(isr_sim_t* s, const isr_source_cfg_t* cfg) {
+    if (s->n_src >= ISR_SIM_MAX_SOURCES) return -1;
+    if (cfg->kind != ISR_SRC_EXTERNAL && cfg->period_ns == 0) return -1;
+    if (cfg->kind == ISR_SRC_PERIODIC && cfg->jitter_ns > cfg->period_ns / 2) return -1;
+
+    int id = s->n_src++;
+    isr_source_t* src = &s->src[id];
+    memset(src, 0, sizeof *src);
+    src->cfg = *cfg;
+    src->sw_fire = ISR_SIM_NEVER;
+    switch (cfg->kind) {
+    case ISR_SRC_PERIODIC:
+        src->nominal = s->now + cfg->phase_ns;
+        src->next_fire = jittered(s, src);
+        break;
+    case ISR_SRC_POISSON:
+        src->next_fire = s->now + exp_interval(s, cfg->period_ns);
+        break;
+    default:
+        src->next_fire = ISR_SIM_NEVER;
+        break;
+    }
+    return id;
+}
+
+void isr_sim_set_main(isr_sim_t* s, isr_handler_t step, void* ctx, uint32_t cost_ns) {
+    s->main_step = step;
+    s->main_ctx = ctx;
+    s->main_cost_ns = cost_ns;
+}
+
+void isr_sim_set_overhead(isr_sim_t* s, uint32_t entry_ns, uint32_t exit_ns) {
+    s->entry_ns = entry_ns;
+    s->exit_ns = exit_ns;
+}
+
+void isr_sim_set_cost_clock(isr_sim_t* s, isr_clock_t clock, float scale) {
+    s->clock = clock;
+    s->clock_scale = scale;
+}
+
+int isr_sim_trigger(isr_sim_t* s, int id, uint32_t delay_ns) {
+    if (id < 0 || id >= s->n_src) return -1;
+    isr_source_t* src = &s->src[id];
+    isr_time_t t = s->now + delay_ns;
+    if (src->sw_fire != ISR_SIM_NEVER) {
+        src->st.fired++;          /* 上一次请求还没触发 (如转换尚未完成又被启动): 两次合并成一次 */
+        src->st.lost++;
+        if (t < src->sw_fire) src->sw_fire = t;
+    } else {
+        src->sw_fire = t;
+    }
+    return 0;
+}
+
+/* ---------------- 统计 ---------------- */
+
+const isr_stats_t* isr_sim_stats(const isr_sim_t* s, int id) {
+    if (id == ISR_SIM_MAIN) return &s->main_st;
+    return (id >= 0 && id < s->n_src) ? &s->src[id].st : NULL;
+}
+
+void isr_sim_reset_stats(isr_sim_t* s) {
+    for (int i = 0; i < s->n_src; i++) memset(&s->src[i].st, 0, sizeof s->src[i].st);
+    memset(&s->main_st, 0, sizeof s->main_st);
+    s->idle = 0;
+    s->stats_start = s->now;
+}
+
+static double avg_us(isr_time_t sum, uint64_t n) { return n ? (double)sum / (double)n / 1e3 : 0.0; }
+
+void isr_sim_report(const isr_sim_t* s, FILE* f) {
+    double span = (double)(s->now - s->stats_start);
+    if (span <= 0.0) return;
+    double isr_busy = 0.0;
+    for (int i = 0; i < s->n_src; i++) {
+        const isr_source_t* src = &s->src[i];
+        const isr_stats_t* st = &src->st;
+        isr_busy += (double)st->busy;
+        fprintf(f,
+                "# %-10s prio %3u %8.2f kHz  latency avg %7.3f max %7.3f us  response avg %7.3f max %7.3f us"
+                "  miss %llu lost %llu preempted %llu  load %5.1f%%\n",
+                src->cfg.name ? src->cfg.name : "?", (unsigned)src->cfg.priority,
+                (double)st->fired / span * 1e6, avg_us(st->latency_sum, st->started), (double)st->latency_max / 1e3,
+                avg_us(st->response_sum, st->handled), (double)st->response_max / 1e3,
+                (unsigned long long)st->deadline_miss, (unsigned long long)st->lost,
+                (unsigned long long)st->preempted, 100.0 * (double)st->busy / span);
+    }
+    if (s->main_step != NULL) {
+        const isr_stats_t* st = &s->main_st;
+        fprintf(f, "# %-10s steps %llu  step avg %7.3f max %7.3f us  preempted %llu  load %5.1f%%\n", "main",
+                (unsigned long long)st->handled, avg_us(st->response_sum, st->handled),
+                (double)st->response_max / 1e3, (unsigned long long)st->preempted, 100.0 * (double)st->busy / span);
+    }
+    fprintf(f, "# %-10s isr load %5.1f%%  idle %5.1f%%  over %.3f ms\n", "cpu", 100.0 * isr_busy / span,
+            100.0 * (double)s->idle / span, span / 1e6);
+}
@@ -0,0 +1,139 @@
+/* 主机端中断仿真器 - 离散事件调度, 在 PC 上给实时代码做压力测试
+ *
+ * 模拟一颗单核 MCU: 若干中断源 (定时器/ADC/UART...) 按设定的频率与抖动触发, 调用注册的 C 回调;
+ * 没有中断要处理时执行主循环的一步. 时间是仿真时间 (ns), 与主机实际耗时无关, 结果可复现.
+ *
+ * - 优先级与 NVIC 相同: 数值越小越高, 只有更高优先级才能抢占; 同优先级按注册顺序 (id 小的先) 尾链.
+ * - 挂起位只有一位: 中断挂起期间再次触发会被合并, 记为 lost (真实硬件上就是丢了一次中断).
+ * - 回调在主机上一次执行完, 副作用发生在仿真中 "开始执行" 的时刻; 它占用的仿真时间
+ *   = 模型耗时 cost_ns + 回调里 isr_sim_charge() 追加的耗时 (+ 可选: 实测主机耗时 * scale),
+ *   被更高优先级抢占时这段时间相应后延. 主循环同样按 "一步" 为单位, 步子越小交错越细.
+ * - 每个中断源统计: 延迟 (触发 -> 回调开始, 含进入开销), 完成时间 (触发 -> 执行完),
+ *   错过期限次数 (完成时间 > deadline_ns), 被抢占次数和 CPU 占用.
+ * - 全部状态在 isr_sim_t 内部 (定长数组), 不 malloc.
+ *
+ *   static isr_sim_t sim;
+ *   isr_sim_init(&sim, 1);
+ *   isr_source_cfg_t tim = {.name = "tim", .kind = ISR_SRC_PERIODIC, .period_ns = 50000,
+ *                           .priority = 1, .cost_ns = 3000, .handler = control_isr};
+ *   int tim_id = isr_sim_add(&sim, &tim);
+ *   isr_sim_set_main(&sim, main_loop_step, NULL, 500);
+ *   isr_sim_run(&sim, 100000000);          // 仿真 100 ms
+ *   isr_sim_report(&sim, stderr);
+ */
+#ifndef ISR_SIM_H
+#define ISR_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef ISR_SIM_MAX_SOURCES
+#define ISR_SIM_MAX_SOURCES 16
+#endif
+#define ISR_SIM_MAIN (-1)        /* 栈帧中表示主循环的 "中断源" 编号 */
+
+typedef uint64_t isr_time_t;     /* 仿真时间, ns */
+typedef void (*isr_handler_t)(void* ctx);
+typedef uint64_t (*isr_clock_t)(void);  /* 主机时钟, 返回 ns */
+
+typedef enum {
+    ISR_SRC_PERIODIC,            /* 定时器/PWM: 标称时刻 phase + k*period, 每次加 [-jitter, +jitter] 均匀抖动 */
+    ISR_SRC_POISSON,             /* UART 接收/外部事件: 间隔服从均值为 period 的指数分布 */
+    ISR_SRC_EXTERNAL             /* 只由 isr_sim_trigger() 触发, 如定时器启动的 ADC 转换完成中断 */
+} isr_src_kind_t;
+
+typedef struct {
+    const char*    name;
+    isr_src_kind_t kind;
+    uint32_t       period_ns;    /* PERIODIC: 周期; POISSON: 平均间隔; EXTERNAL: 不用 */
+    uint32_t       jitter_ns;    /* 只用于 PERIODIC, 不超过 period/2 (保证触发顺序不变) */
+    uint32_t       phase_ns;     /* 第一次触发的时刻 (PERIODIC) */
+    uint32_t       deadline_ns;  /* 触发到执行完的期限; 0 表示等于 period_ns (都为 0 时不检查) */
+    uint32_t       cost_ns;      /* 每次执行的模型耗时, 不含进出中断的开销 */
+    uint8_t        priority;     /* 0 最高 */
+    isr_handler_t  handler;      /* 可以为 NULL (只占用 CPU 时间) */
+    void*          ctx;
+} isr_source_cfg_t;
+
+typedef struct {
+    uint64_t   fired;            /* 触发次数 (含被合并的) */
+    uint64_t   started;          /* 开始执行的次数 (含被抢占或仿真结束时仍未执行完的), 平均延迟的分母 */
+    uint64_t   handled;          /* 执行完的次数; 主循环为执行的步数 */
+    uint64_t   lost;             /* 挂起期间再次触发而被合并 */
+    uint64_t   deadline_miss;
+    uint64_t   preempted;        /* 执行中被更高优先级抢占的次数 */
+    isr_time_t latency_max, latency_sum;   /* 延迟在开始执行时计入, 响应时间在执行完时计入 */
+    isr_time_t response_max, response_sum;
+    isr_time_t busy;             /* 占用的 CPU 时间 (含进出开销) */
+} isr_stats_t;
+
+typedef struct {
+    isr_source_cfg_t cfg;
+    isr_stats_t      st;
+    isr_time_t       nominal;    /* PERIODIC: 下一次的标称时刻 (不含抖动, 避免漂移) */
+    isr_time_t       next_fire;  /* 下一次自主触发; 没有时为 ISR_SIM_NEVER */
+    isr_time_t       sw_fire;    /* isr_sim_trigger() 请求的触发时刻 */
+    isr_time_t       pend_since; /* 挂起时刻 = 本次触发时刻 */
+    uint8_t          pending;
+} isr_source_t;
+
+typedef struct {
+    int        src;              /* 中断源 id 或 ISR_SIM_MAIN */
+    isr_time_t remaining;        /* 还需要的 CPU 时间 */
+    isr_time_t trigger;          /* 触发时刻 (主循环为开始时刻) */
+} isr_frame_t;
+
+typedef struct {
+    isr_source_t  src[ISR_SIM_MAX_SOURCES];
+    int           n_src;
+    isr_frame_t   stack[ISR_SIM_MAX_SOURCES + 1];  /* 抢占栈, 栈顶是正在执行的 */
+    int           depth;
+    isr_time_t    now;
+    isr_time_t    stats_start;
+    isr_time_t    idle;          /* 既无中断也无主循环时的空闲时间 (WFI) */
+    uint32_t      entry_ns, exit_ns;  /* 进出中断的开销 (压栈/出栈, 尾链时同样计入) */
+    isr_handler_t main_step;
+    void*         main_ctx;
+    uint32_t      main_cost_ns;
+    isr_stats_t   main_st;
+    isr_clock_t   clock;         /* 非 NULL 时把实测的回调耗时 * scale 计入仿真时间 */
+    float         clock_scale;
+    isr_time_t    charge;        /* 当前回调通过 isr_sim_charge() 追加的耗时 */
+    uint64_t      rng;
+} isr_sim_t;
+
+#define ISR_SIM_NEVER UINT64_MAX
+
+/* seed 决定抖动与泊松间隔的随机序列 (相同 seed 结果完全相同). 默认进出开销各 0 */
+void isr_sim_init(isr_sim_t* s, uint64_t seed);
+/* 注册中断源, 返回 id; 超出 ISR_SIM_MAX_SOURCES 或参数非法 (周期为 0, 抖动过大) 返回 -1 */
+int  isr_sim_add(isr_sim_t* s, const isr_source_cfg_t* cfg);
+/* 主循环: 没有中断要处理时反复调用 step, 每步占用 cost_ns (至少 1 ns) + 追加的耗时 */
+void isr_sim_set_main(isr_sim_t* s, isr_handler_t step, void* ctx, uint32_t cost_ns);
+/* 进出中断的固定开销, 如 Cortex-M4 约 12 + 10 个周期 */
+void isr_sim_set_overhead(isr_sim_t* s, uint32_t entry_ns, uint32_t exit_ns);
+/* 用主机实测耗时代替/补充模型耗时: scale = 目标机耗时 / 主机耗时 (如主机快 20 倍时取 20).
+ * 实测值会受主机调度影响, 最坏值要谨慎看待; clock 为 NULL 时关闭 */
+void isr_sim_set_cost_clock(isr_sim_t* s, isr_clock_t clock, float scale);
+
+/* 仿真 duration ns; 可多次调用, 在上次停下的位置继续 */
+void isr_sim_run(isr_sim_t* s, isr_time_t duration);
+
+/* ---------------- 以下在回调中调用 ---------------- */
+
+/* 给当前回调 (或主循环步) 追加 ns 的执行时间, 如按处理的字节数计费 */
+static inline void isr_sim_charge(isr_sim_t* s, uint32_t ns) { s->charge += ns; }
+/* 从现在起 delay_ns 后挂起中断源 id (软件触发 / 外设延迟完成). 上一次请求尚未触发时两次合并,
+ * 保留较早的时刻并记一次 lost. 成功返回 0, id 非法返回 -1 */
+int  isr_sim_trigger(isr_sim_t* s, int id, uint32_t delay_ns);
+static inline isr_time_t isr_sim_now(const isr_sim_t* s) { return s->now; }
+
+/* ---------------- 统计 ---------------- */
+
+const isr_stats_t* isr_sim_stats(const isr_sim_t* s, int id);  /* id 为 ISR_SIM_MAIN 时返回主循环的统计 */
+void isr_sim_reset_stats(isr_sim_t* s);
+/* 每个中断源一行: 频率, 延迟/完成时间的平均与最大, 错过期限, 丢失, CPU 占用; 行首 "# " */
+void isr_sim_report(const isr_sim_t* s, FILE* f);
+
+#endif /* ISR_SIM_H */
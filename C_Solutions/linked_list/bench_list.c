@@ -0,0 +1,285 @@
+/* 链表遍历/插入测试: 经典 (malloc / 打散的内存池) vs 侵入式 vs 展开链表 vs 下标链表
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates -I../allocator clist.c ulist.c idxlist.c \
+ *           ../allocator/allocator.c ../allocator/pool.c ../allocator/arena.c ../allocator/tlsf.c \
+ *           bench_list.c ../../Templates/benchmark.c -o bench_list -lm
+ * 节点池在使用前被随机打乱, 模拟长时间运行后节点在内存中分散的情形 (下标链表天然连续).
+ * 计时前每种链表都先建表、插入再删除 g_keys, 每一步都与参考数组逐个比较内容和顺序;
+ * 计时循环里的 remove 也必须都找到元素, 遍历和也要对. 不一致时报 MISMATCH, main 返回 1.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+
+#include "clist.h"
+#include "idxlist.h"
+#include "list.h"
+#include "pool.h"
+#include "ulist.h"
+
+#define MAX_N      16384u
+#define POOL_BYTES (MAX_N * 64u)
+#define OPS        64u   /* 插入/删除测试每次迭代的操作数, 写在行名里; n 列是链表长度 */
+
+static uint8_t g_pool_mem[POOL_BYTES] __attribute__((aligned(64)));
+static void* g_tmp[POOL_BYTES / sizeof(void*)];
+static idxlist_node_t g_idx_nodes[MAX_N + OPS];
+static list_value_t g_keys[OPS];
+static list_value_t g_ref[MAX_N + OPS];  /* 参考内容: 建表后是偶数 0..2n-2, 插入后再有序并入各个键 */
+static list_value_t g_got[MAX_N + OPS];  /* 从链表里按顺序读出的内容 */
+
+/* 全部借出后按随机顺序归还, 之后的分配地址就是打乱的 */
+static void shuffle_pool(pool_t* p) {
+    size_t n = 0;
+    void* b;
+    while ((b = pool_alloc(p)) != NULL) g_tmp[n++] = b;
+    for (size_t i = n; i > 1; i--) {
+        size_t j = (size_t)rand() % i;
+        void* t = g_tmp[i - 1];
+        g_tmp[i - 1] = g_tmp[j];
+        g_tmp[j] = t;
+    }
+    while (n > 0) pool_free(p, g_tmp[--n]);
+    p->peak = 0;
+}
+
+static void report(bench_t* b, size_t n) {
+    bench_set_size(b, n, 0);
+    bench_report(b);
+}
+
+/* 偶数 0..2n-2; with_keys 时把 g_keys (取模后) 有序并入, 与 insert_sorted 的结果一致 */
+static size_t make_ref(size_t n, int with_keys) {
+    list_value_t keys[OPS];
+    size_t m = 0;
+    if (with_keys) {
+        for (uint32_t o = 0; o < OPS; o++) {  /* OPS 很小, 插入排序即可 */
+            list_value_t v = g_keys[o] % (list_value_t)(2 * n);
+            size_t j = m++;
+            for (; j > 0 && keys[j - 1] > v; j--) keys[j] = keys[j - 1];
+            keys[j] = v;
+        }
+    }
+    size_t len = 0, k = 0;
+    for (size_t e = 0; e < n; e++) {
+        for (; k < m && keys[k] < (list_value_t)(2 * e); k++) g_ref[len++] = keys[k];
+        g_ref[len++] = (list_value_t)(2 * e);
+    }
+    while (k < m) g_ref[len++] = keys[k++];
+    return len;
+}
+
+/* g_got[0..got) 与 g_ref[0..want) 逐个比较; size 是链表自己记录的长度 */
+static int same_contents(const char* label, const char* stage, size_t got, size_t size, size_t want) {
+    if (got != want || size != want) {
+        fprintf(stderr, "MISMATCH: %s after %s: %zu elements (size %zu), expected %zu\n", label, stage, got, size,
+                want);
+        return -1;
+    }
+    for (size_t i = 0; i < want; i++) {
+        if (g_got[i] != g_ref[i]) {
+            fprintf(stderr, "MISMATCH: %s after %s: element %zu is %ld, expected %ld\n", label, stage, i,
+                    (long)g_got[i], (long)g_ref[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* 三种值链表接口相同, 用同一个宏生成 run_<P>(): 建表 (偶数 0..2n) -> 遍历求和 -> 有序插入奇数再删掉.
+ * 计时前先把同样的步骤走一遍, 每一步都读出全表与 g_ref 比较 */
+#define DEFINE_RUN_VALUE_LIST(P)                                                                  \
+    static size_t P##_collect(const P##_t* l) {                                                   \
+        size_t k = 0;                                                                             \
+        for (P##_iter_t it = P##_begin(l); P##_valid(&it) && k < MAX_N + OPS; P##_next(&it))      \
+            g_got[k++] = P##_get(&it);  /* 上限防止链接成环时死循环 */                           \
+        return k;                                                                                 \
+    }                                                                                             \
+    static int P##_check(P##_t* l, const char* label, size_t n) {                                 \
+        for (size_t k = 0; k < n; k++)                                                            \
+            if (P##_push_back(l, (list_value_t)(2 * k)) != 0) return same_contents(label, "push_back", 0, 0, n); \
+        if (same_contents(label, "push_back", P##_collect(l), P##_size(l), make_ref(n, 0)) != 0) return -1; \
+        for (uint32_t o = 0; o < OPS; o++) P##_insert_sorted(l, g_keys[o] % (list_value_t)(2 * n));  \
+        if (same_contents(label, "insert_sorted", P##_collect(l), P##_size(l), make_ref(n, 1)) != 0) return -1; \
+        for (uint32_t o = 0; o < OPS; o++) {                                                      \
+            if (P##_remove(l, g_keys[o] % (list_value_t)(2 * n)) != 0) {                          \
+                fprintf(stderr, "MISMATCH: %s remove did not find key %u\n", label, (unsigned)o);  \
+                return -1;                                                                        \
+            }                                                                                     \
+        }                                                                                         \
+        if (same_contents(label, "remove", P##_collect(l), P##_size(l), make_ref(n, 0)) != 0) return -1; \
+        P##_clear(l);                                                                             \
+        return same_contents(label, "clear", P##_collect(l), P##_size(l), 0);                     \
+    }                                                                                             \
+    static int run_##P(P##_t* l, const char* label, size_t n) {                                   \
+        bench_t b;                                                                                \
+        char name[80];                                                                            \
+        int64_t sum = 0;                                                                          \
+        int fail = 0;                                                                             \
+        if (P##_check(l, label, n) != 0) return -1;                                               \
+        for (size_t k = 0; k < n; k++) P##_push_back(l, (list_value_t)(2 * k));                   \
+        snprintf(name, sizeof name, "%s traverse", label);                                        \
+        BENCH(b, name, {                                                                          \
+            sum = 0;                                                                              \
+            for (P##_iter_t it = P##_begin(l); P##_valid(&it); P##_next(&it)) sum += P##_get(&it); \
+            BENCH_DO_NOT_OPTIMIZE(sum);                                                           \
+        });                                                                                       \
+        report(&b, n);                                                                            \
+        snprintf(name, sizeof name, "%s insert+remove x%u", label, OPS);                          \
+        BENCH(b, name, {                                                                          \
+            for (uint32_t o = 0; o < OPS; o++) P##_insert_sorted(l, g_keys[o] % (list_value_t)(2 * n)); \
+            for (uint32_t o = 0; o < OPS; o++) fail |= P##_remove(l, g_keys[o] % (list_value_t)(2 * n)); \
+        });                                                                                       \
+        report(&b, n);                                                                            \
+        P##_clear(l);                                                                             \
+        if (fail != 0 || sum != (int64_t)n * (int64_t)(n - 1)) {                                  \
+            fprintf(stderr, "MISMATCH: %s timed run: traverse sum %lld, remove failed %d\n", label, (long long)sum, \
+                    fail != 0);                                                                   \
+            return -1;                                                                            \
+        }                                                                                         \
+        return 0;                                                                                 \
+    }
+
+DEFINE_RUN_VALUE_LIST(clist)
+DEFINE_RUN_VALUE_LIST(ulist)
+DEFINE_RUN_VALUE_LIST(idxlist)
+
+typedef struct {
+    list_value_t v;
+    list_head_t  node;
+} item_t;
+
+/* 在第一个 > v 的元素前插入; 池耗尽返回 -1 */
+static int intrusive_insert(pool_t* p, list_head_t* head, list_value_t v) {
+    list_head_t* pos;
+    item_t* it = (item_t*)pool_alloc(p);
+    if (it == NULL) return -1;
+    it->v = v;
+    list_for_each(pos, head) if (list_entry(pos, item_t, node)->v > v) break;
+    list_add_tail(&it->node, pos);  /* pos 可能是表头, 即追加到末尾 */
+    return 0;
+}
+
+/* 删除第一个等于 v 的元素; 找不到返回 -1 (此时 pos 停在表头, 不能 list_del) */
+static int intrusive_remove(pool_t* p, list_head_t* head, list_value_t v) {
+    list_head_t* pos;
+    list_for_each(pos, head) if (list_entry(pos, item_t, node)->v == v) break;
+    if (pos == head) return -1;
+    list_del(pos);
+    pool_free(p, list_entry(pos, item_t, node));
+    return 0;
+}
+
+static size_t intrusive_collect(const list_head_t* head, size_t* size) {
+    const list_head_t* pos;
+    size_t k = 0;
+    for (pos = head->next; pos != head && k < MAX_N + OPS; pos = pos->next)
+        g_got[k++] = list_entry(pos, item_t, node)->v;
+    *size = k;
+    return k;
+}
+
+/* 与值链表相同的步骤; 侵入式链表没有长度字段, size 就是遍历到的个数 */
+static int intrusive_check(pool_t* p, const char* label, size_t n) {
+    LIST_HEAD(head);
+    size_t size, got;
+    int fail = 0;
+    for (size_t k = 0; k < n; k++) fail |= intrusive_insert(p, &head, (list_value_t)(2 * k));
+    got = intrusive_collect(&head, &size);
+    if (fail != 0 || same_contents(label, "build", got, size, make_ref(n, 0)) != 0) return -1;
+    for (uint32_t o = 0; o < OPS; o++) fail |= intrusive_insert(p, &head, g_keys[o] % (list_value_t)(2 * n));
+    got = intrusive_collect(&head, &size);
+    if (fail != 0 || same_contents(label, "insert", got, size, make_ref(n, 1)) != 0) return -1;
+    for (uint32_t o = 0; o < OPS; o++) {
+        if (intrusive_remove(p, &head, g_keys[o] % (list_value_t)(2 * n)) != 0) {
+            fprintf(stderr, "MISMATCH: %s remove did not find key %u\n", label, (unsigned)o);
+            return -1;
+        }
+    }
+    got = intrusive_collect(&head, &size);
+    if (same_contents(label, "remove", got, size, make_ref(n, 0)) != 0) return -1;
+    for (size_t k = 0; k < n; k++) intrusive_remove(p, &head, (list_value_t)(2 * k));
+    if (!list_empty(&head) || p->used != 0) {
+        fprintf(stderr, "MISMATCH: %s nodes left after removing every element\n", label);
+        return -1;
+    }
+    return 0;
+}
+
+static int run_intrusive(pool_t* p, const char* label, size_t n) {
+    bench_t b;
+    char name[80];
+    LIST_HEAD(head);
+    int64_t sum = 0;
+    int fail = 0;
+    if (intrusive_check(p, label, n) != 0) return -1;
+    for (size_t k = 0; k < n; k++) intrusive_insert(p, &head, (list_value_t)(2 * k));  /* 升序, 每次都追加到末尾 */
+    snprintf(name, sizeof name, "%s traverse", label);
+    BENCH(b, name, {
+        item_t* it;
+        sum = 0;
+        list_for_each_entry(it, &head, item_t, node) sum += it->v;
+        BENCH_DO_NOT_OPTIMIZE(sum);
+    });
+    report(&b, n);
+
+    snprintf(name, sizeof name, "%s insert+remove x%u", label, OPS);
+    BENCH(b, name, {
+        for (uint32_t o = 0; o < OPS; o++) fail |= intrusive_insert(p, &head, g_keys[o] % (list_value_t)(2 * n));
+        for (uint32_t o = 0; o < OPS; o++) fail |= intrusive_remove(p, &head, g_keys[o] % (list_value_t)(2 * n));
+    });
+    report(&b, n);
+    if (fail != 0 || sum != (int64_t)n * (int64_t)(n - 1)) {
+        fprintf(stderr, "MISMATCH: %s timed run: traverse sum %lld, insert/remove failed %d\n", label,
+                (long long)sum, fail != 0);
+        return -1;
+    }
+    return 0;
+}
+
+static int run_size(size_t n) {
+    char label[48];
+    pool_t pool;
+    allocator_t sys = allocator_system();
+    allocator_t pa = allocator_pool(&pool);
+    clist_t cl;
+    ulist_t ul;
+    idxlist_t xl;
+
+    clist_init(&cl, &sys);
+    if (run_clist(&cl, "clist malloc", n) != 0) return -1;
+
+    pool_init(&pool, g_pool_mem, POOL_BYTES, sizeof(clist_node_t));
+    shuffle_pool(&pool);
+    clist_init(&cl, &pa);
+    if (run_clist(&cl, "clist scattered", n) != 0) return -1;
+
+    pool_init(&pool, g_pool_mem, POOL_BYTES, sizeof(item_t));
+    shuffle_pool(&pool);
+    if (run_intrusive(&pool, "intrusive scattered", n) != 0) return -1;
+
+    pool_init(&pool, g_pool_mem, POOL_BYTES, sizeof(ulist_node_t));
+    shuffle_pool(&pool);
+    snprintf(label, sizeof label, "ulist K=%u", (unsigned)ULIST_K);
+    ulist_init(&ul, &pa);
+    if (run_ulist(&ul, label, n) != 0) return -1;
+
+    idxlist_init(&xl, g_idx_nodes, n + OPS);
+    return run_idxlist(&xl, "idxlist", n);
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    srand(1);
+    for (uint32_t k = 0; k < OPS; k++) g_keys[k] = (list_value_t)(2 * (rand() % (int)MAX_N) + 1);  /* 奇数, 必然不重复删错 */
+    static const size_t defaults[] = {64, 1024, MAX_N};
+    const size_t* sizes;
+    size_t n = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    for (size_t i = 0; i < n; i++) {
+        if (sizes[i] == 0 || sizes[i] > MAX_N) {
+            fprintf(stderr, "# skip size %zu: must be 1..%u\n", sizes[i], MAX_N);
+            continue;
+        }
+        if (run_size(sizes[i]) != 0) return 1;
+    }
+    return bench_summary();
+}
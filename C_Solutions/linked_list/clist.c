@@ -0,0 +1,84 @@
+/* 经典单向链表实现 */
+#include "clist.h"
+
+void clist_init(clist_t* l, const allocator_t* alloc) {
+    l->head = l->tail = NULL;
+    l->size = 0;
+    l->alloc = alloc;
+}
+
+static clist_node_t* new_node(clist_t* l, list_value_t v, clist_node_t* next) {
+    clist_node_t* n = (clist_node_t*)alloc_new(l->alloc, sizeof(clist_node_t));
+    if (n != NULL) {
+        n->value = v;
+        n->next = next;
+        l->size++;
+    }
+    return n;
+}
+
+int clist_push_front(clist_t* l, list_value_t v) {
+    clist_node_t* n = new_node(l, v, l->head);
+    if (n == NULL) return -1;
+    if (l->head == NULL) l->tail = n;
+    l->head = n;
+    return 0;
+}
+
+int clist_push_back(clist_t* l, list_value_t v) {
+    clist_node_t* n = new_node(l, v, NULL);
+    if (n == NULL) return -1;
+    if (l->tail != NULL) l->tail->next = n;
+    else l->head = n;
+    l->tail = n;
+    return 0;
+}
+
+int clist_pop_front(clist_t* l, list_value_t* out) {
+    clist_node_t* n = l->head;
+    if (n == NULL) return -1;
+    *out = n->value;
+    l->head = n->next;
+    if (l->head == NULL) l->tail = NULL;
+    l->size--;
+    alloc_delete(l->alloc, n);
+    return 0;
+}
+
+int clist_insert_sorted(clist_t* l, list_value_t v) {
+    /* 二级指针: 表头和中间节点的 next 统一处理, 不需要特判 */
+    clist_node_t** link = &l->head;
+    while (*link != NULL && (*link)->value <= v) link = &(*link)->next;
+    clist_node_t* n = new_node(l, v, *link);
+    if (n == NULL) return -1;
+    if (*link == NULL) l->tail = n;
+    *link = n;
+    return 0;
+}
+
+int clist_remove(clist_t* l, list_value_t v) {
+    clist_node_t** link = &l->head;
+    clist_node_t* prev = NULL;
+    while (*link != NULL && (*link)->value != v) {
+        prev = *link;
+        link = &(*link)->next;
+    }
+    clist_node_t* n = *link;
+    if (n == NULL) return -1;
+    *link = n->next;
+    if (l->tail == n) l->tail = prev;
+    l->size--;
+    alloc_delete(l->alloc, n);
+    return 0;
+}
+
+void clist_clear(clist_t* l) {
+    clist_node_t* n = l->head;
+    while (n != NULL) {
+        clist_node_t* next = n->next;
+        alloc_delete(l->alloc, n);
+        n = next;
+    }
+    l->head = l->tail = NULL;
+    l->size = 0;
+}
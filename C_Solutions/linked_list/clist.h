@@ -0,0 +1,38 @@
+/* 经典单向链表: 每个元素单独分配一个节点 (经 allocator_t, 可接 malloc / pool / tlsf) */
+#ifndef CLIST_H
+#define CLIST_H
+
+#include "allocator.h"
+#include "list.h"
+
+typedef struct clist_node {
+    struct clist_node* next;
+    list_value_t       value;
+} clist_node_t;
+
+typedef struct {
+    clist_node_t*      head;
+    clist_node_t*      tail;
+    size_t             size;
+    const allocator_t* alloc;
+} clist_t;
+
+typedef struct {
+    clist_node_t* node;
+} clist_iter_t;
+
+void   clist_init(clist_t* l, const allocator_t* alloc);
+int    clist_push_front(clist_t* l, list_value_t v);
+int    clist_push_back(clist_t* l, list_value_t v);
+int    clist_pop_front(clist_t* l, list_value_t* out);
+int    clist_insert_sorted(clist_t* l, list_value_t v);
+int    clist_remove(clist_t* l, list_value_t v);
+void   clist_clear(clist_t* l);
+static inline size_t clist_size(const clist_t* l) { return l->size; }
+
+static inline clist_iter_t clist_begin(const clist_t* l) { clist_iter_t it = {l->head}; return it; }
+static inline int clist_valid(const clist_iter_t* it) { return it->node != NULL; }
+static inline void clist_next(clist_iter_t* it) { it->node = it->node->next; }
+static inline list_value_t clist_get(const clist_iter_t* it) { return it->node->value; }
+
+#endif /* CLIST_H */
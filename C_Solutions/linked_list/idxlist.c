@@ -0,0 +1,88 @@
+/* 下标链表实现 */
+#include "idxlist.h"
+
+int idxlist_init(idxlist_t* l, idxlist_node_t* storage, size_t capacity) {
+    if (l == NULL || storage == NULL || capacity == 0 || capacity > IDXLIST_MAX_CAPACITY) return -1;
+    l->nodes = storage;
+    l->capacity = (uint16_t)capacity;
+    idxlist_clear(l);
+    return 0;
+}
+
+void idxlist_clear(idxlist_t* l) {
+    for (uint16_t i = 0; i < l->capacity; i++) l->nodes[i].next = (uint16_t)(i + 1);
+    l->nodes[l->capacity - 1].next = IDXLIST_NIL;
+    l->free_head = 0;
+    l->head = l->tail = IDXLIST_NIL;
+    l->size = 0;
+}
+
+static uint16_t take_node(idxlist_t* l, list_value_t v) {
+    uint16_t i = l->free_head;
+    if (i != IDXLIST_NIL) {
+        l->free_head = l->nodes[i].next;
+        l->nodes[i].value = v;
+        l->size++;
+    }
+    return i;
+}
+
+/* 把节点 i 链接到 prev 与 next 之间 (任一侧为 IDXLIST_NIL 表示表头/表尾) */
+static void link_between(idxlist_t* l, uint16_t i, uint16_t prev, uint16_t next) {
+    idxlist_node_t* n = l->nodes;
+    n[i].prev = prev;
+    n[i].next = next;
+    if (prev != IDXLIST_NIL) n[prev].next = i;
+    else l->head = i;
+    if (next != IDXLIST_NIL) n[next].prev = i;
+    else l->tail = i;
+}
+
+static void unlink_node(idxlist_t* l, uint16_t i) {
+    idxlist_node_t* n = l->nodes;
+    if (n[i].prev != IDXLIST_NIL) n[n[i].prev].next = n[i].next;
+    else l->head = n[i].next;
+    if (n[i].next != IDXLIST_NIL) n[n[i].next].prev = n[i].prev;
+    else l->tail = n[i].prev;
+    n[i].next = l->free_head;
+    l->free_head = i;
+    l->size--;
+}
+
+int idxlist_push_front(idxlist_t* l, list_value_t v) {
+    uint16_t i = take_node(l, v);
+    if (i == IDXLIST_NIL) return -1;
+    link_between(l, i, IDXLIST_NIL, l->head);
+    return 0;
+}
+
+int idxlist_push_back(idxlist_t* l, list_value_t v) {
+    uint16_t i = take_node(l, v);
+    if (i == IDXLIST_NIL) return -1;
+    link_between(l, i, l->tail, IDXLIST_NIL);
+    return 0;
+}
+
+int idxlist_pop_front(idxlist_t* l, list_value_t* out) {
+    if (l->head == IDXLIST_NIL) return -1;
+    *out = l->nodes[l->head].value;
+    unlink_node(l, l->head);
+    return 0;
+}
+
+int idxlist_insert_sorted(idxlist_t* l, list_value_t v) {
+    uint16_t next = l->head;
+    while (next != IDXLIST_NIL && l->nodes[next].value <= v) next = l->nodes[next].next;
+    uint16_t i = take_node(l, v);
+    if (i == IDXLIST_NIL) return -1;
+    link_between(l, i, next != IDXLIST_NIL ? l->nodes[next].prev : l->tail, next);
+    return 0;
+}
+
+int idxlist_remove(idxlist_t* l, list_value_t v) {
+    uint16_t i = l->head;
+    while (i != IDXLIST_NIL && l->nodes[i].value != v) i = l->nodes[i].next;
+    if (i == IDXLIST_NIL) return -1;
+    unlink_node(l, i);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/* 下标链表: 节点放在调用方提供的连续数组里, 用 16 位下标代替指针
+ *
+ * 64 位机上一个 int32 元素的双向链表节点从 24 字节降到 8 字节, 32 位 MCU 上从 12 降到 8;
+ * 节点都在一块内存里, 遍历的局部性比分散分配好. 最多 65535 个节点 (0xFFFF 表示空).
+ * 空闲节点用 next 串成空闲链表, 插入删除都是 O(1), 不需要任何分配器.
+ */
+#ifndef IDXLIST_H
+#define IDXLIST_H
+
+#include "list.h"
+
+#define IDXLIST_NIL 0xFFFFu
+#define IDXLIST_MAX_CAPACITY 0xFFFFu
+
+typedef struct {
+    list_value_t value;
+    uint16_t     next, prev;
+} idxlist_node_t;
+
+typedef struct {
+    idxlist_node_t* nodes;
+    uint16_t        head, tail;
+    uint16_t        free_head;
+    uint16_t        size;
+    uint16_t        capacity;
+} idxlist_t;
+
+typedef struct {
+    const idxlist_node_t* nodes;
+    uint16_t              idx;
+} idxlist_iter_t;
+
+/* capacity 不超过 IDXLIST_MAX_CAPACITY. 成功返回 0 */
+int    idxlist_init(idxlist_t* l, idxlist_node_t* storage, size_t capacity);
+int    idxlist_push_front(idxlist_t* l, list_value_t v);
+int    idxlist_push_back(idxlist_t* l, list_value_t v);
+int    idxlist_pop_front(idxlist_t* l, list_value_t* out);
+int    idxlist_insert_sorted(idxlist_t* l, list_value_t v);
+int    idxlist_remove(idxlist_t* l, list_value_t v);
+void   idxlist_clear(idxlist_t* l);
+static inline size_t idxlist_size(const idxlist_t* l) { return l->size; }
+
+static inline idxlist_iter_t idxlist_begin(const idxlist_t* l) { idxlist_iter_t it = {l->nodes, l->head}; return it; }
+static inline int idxlist_valid(const idxlist_iter_t* it) { return it->idx != IDXLIST_NIL; }
+static inline void idxlist_next(idxlist_iter_t* it) { it->idx = it->nodes[it->idx].next; }
+static inline list_value_t idxlist_get(const idxlist_iter_t* it) { return it->nodes[it->idx].value; }
+
+#endif /* IDXLIST_H */
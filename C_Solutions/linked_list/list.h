@@ -0,0 +1,99 @@
+/* 链表公共部分: 侵入式双向链表 list_head (Linux 内核风格) + 值链表的统一接口约定
+ *
+ * 侵入式链表: 节点嵌在用户结构体里, 链表本身不分配内存, 一个对象可以同时挂在多个链表上.
+ *   struct task { int prio; list_head_t node; };
+ *   LIST_HEAD(ready);
+ *   list_add_tail(&t->node, &ready);
+ *   list_for_each_entry(t, &ready, struct task, node) run(t);
+ *
+ * 存放 list_value_t 的三种值链表共用同一套接口 (X = clist / ulist / idxlist):
+ *   int    X_push_front(X_t*, list_value_t)    成功 0, 内存不足 -1
+ *   int    X_push_back(X_t*, list_value_t)
+ *   int    X_pop_front(X_t*, list_value_t* out) 空链表返回 -1
+ *   int    X_insert_sorted(X_t*, list_value_t) 在第一个 > v 的元素前插入, 保持升序
+ *   int    X_remove(X_t*, list_value_t)        删除第一个等于 v 的元素, 找不到返回 -1
+ *   size_t X_size(const X_t*)
+ *   void   X_clear(X_t*)
+ *   for (X_iter_t it = X_begin(l); X_valid(&it); X_next(&it)) use(X_get(&it));
+ *
+ *   clist.h    经典链表, 每个元素一个节点 (经 allocator_t 分配), 遍历就是追指针
+ *   ulist.h    展开链表, 每个节点是一条缓存行, 存 ULIST_K 个元素
+ *   idxlist.h  下标链表, 节点在调用方提供的连续数组里, 16 位下标代替指针
+ */
+#ifndef LIST_H
+#define LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef LIST_VALUE_T
+#define LIST_VALUE_T int32_t
+#endif
+typedef LIST_VALUE_T list_value_t;
+
+/* ---------------- 侵入式双向循环链表 ---------------- */
+
+typedef struct list_head {
+    struct list_head* next;
+    struct list_head* prev;
+} list_head_t;
+
+#define LIST_HEAD_INIT(name) { &(name), &(name) }
+#define LIST_HEAD(name) list_head_t name = LIST_HEAD_INIT(name)
+
+/* 由成员指针得到外层结构体指针 */
+#define container_of(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+#define list_entry(ptr, type, member) container_of(ptr, type, member)
+
+static inline void list_init(list_head_t* h) {
+    h->next = h;
+    h->prev = h;
+}
+
+static inline void list_link_(list_head_t* n, list_head_t* prev, list_head_t* next) {
+    next->prev = n;
+    n->next = next;
+    n->prev = prev;
+    prev->next = n;
+}
+
+/* 插在 pos 之后 (用作栈) */
+static inline void list_add(list_head_t* n, list_head_t* pos) { list_link_(n, pos, pos->next); }
+/* 插在 pos 之前; pos 为表头时即追加到末尾 (用作队列) */
+static inline void list_add_tail(list_head_t* n, list_head_t* pos) { list_link_(n, pos->prev, pos); }
+
+/* 摘下节点后让它自环, 重复删除或 list_empty 判断都是安全的 */
+static inline void list_del(list_head_t* n) {
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    list_init(n);
+}
+
+static inline void list_move_tail(list_head_t* n, list_head_t* h) {
+    list_del(n);
+    list_add_tail(n, h);
+}
+
+static inline int list_empty(const list_head_t* h) { return h->next == h; }
+
+/* 把 src 整条接到 dst 末尾, src 变为空 */
+static inline void list_splice_tail(list_head_t* src, list_head_t* dst) {
+    if (list_empty(src)) return;
+    src->next->prev = dst->prev;
+    dst->prev->next = src->next;
+    src->prev->next = dst;
+    dst->prev = src->prev;
+    list_init(src);
+}
+
+#define list_for_each(pos, head) for ((pos) = (head)->next; (pos) != (head); (pos) = (pos)->next)
+
+/* 遍历过程中允许 list_del(pos) */
+#define list_for_each_safe(pos, tmp, head) \
+    for ((pos) = (head)->next, (tmp) = (pos)->next; (pos) != (head); (pos) = (tmp), (tmp) = (pos)->next)
+
+#define list_for_each_entry(pos, head, type, member) \
+    for ((pos) = list_entry((head)->next, type, member); &(pos)->member != (head); \
+         (pos) = list_entry((pos)->member.next, type, member))
+
+#endif /* LIST_H */
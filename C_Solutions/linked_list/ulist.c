@@ -0,0 +1,123 @@
+/* 展开链表实现 */
+#include "ulist.h"
+
+#include <string.h>
+
+void ulist_init(ulist_t* l, const allocator_t* alloc) {
+    l->head = l->tail = NULL;
+    l->size = 0;
+    l->alloc = alloc;
+}
+
+/* 在 prev 之后挂一个空节点 (prev 为 NULL 时放在表头) */
+static ulist_node_t* new_node(ulist_t* l, ulist_node_t* prev) {
+    ulist_node_t* n = (ulist_node_t*)alloc_new(l->alloc, sizeof(ulist_node_t));
+    if (n == NULL) return NULL;
+    n->count = 0;
+    if (prev != NULL) {
+        n->next = prev->next;
+        prev->next = n;
+    } else {
+        n->next = l->head;
+        l->head = n;
+    }
+    if (n->next == NULL) l->tail = n;
+    return n;
+}
+
+static void insert_at(ulist_node_t* n, uint32_t pos, list_value_t v) {
+    memmove(&n->items[pos + 1], &n->items[pos], (n->count - pos) * sizeof(list_value_t));
+    n->items[pos] = v;
+    n->count++;
+}
+
+/* 删除 n->items[pos]; 节点变空时摘下释放 (prev 是 n 的前一个节点或 NULL) */
+static void erase_at(ulist_t* l, ulist_node_t* prev, ulist_node_t* n, uint32_t pos) {
+    n->count--;
+    memmove(&n->items[pos], &n->items[pos + 1], (n->count - pos) * sizeof(list_value_t));
+    l->size--;
+    if (n->count == 0) {
+        if (prev != NULL) prev->next = n->next;
+        else l->head = n->next;
+        if (l->tail == n) l->tail = prev;
+        alloc_delete(l->alloc, n);
+    }
+}
+
+int ulist_push_front(ulist_t* l, list_value_t v) {
+    ulist_node_t* n = l->head;
+    if (n == NULL || n->count == ULIST_K) {
+        n = new_node(l, NULL);
+        if (n == NULL) return -1;
+    }
+    insert_at(n, 0, v);
+    l->size++;
+    return 0;
+}
+
+int ulist_push_back(ulist_t* l, list_value_t v) {
+    ulist_node_t* n = l->tail;
+    if (n == NULL || n->count == ULIST_K) {
+        n = new_node(l, l->tail);
+        if (n == NULL) return -1;
+    }
+    n->items[n->count++] = v;
+    l->size++;
+    return 0;
+}
+
+int ulist_pop_front(ulist_t* l, list_value_t* out) {
+    if (l->head == NULL) return -1;
+    *out = l->head->items[0];
+    erase_at(l, NULL, l->head, 0);
+    return 0;
+}
+
+int ulist_insert_sorted(ulist_t* l, list_value_t v) {
+    if (l->head == NULL) return ulist_push_back(l, v);
+    /* 先按节点的最后一个元素跳过整节点, 再在节点内找位置 */
+    ulist_node_t* n = l->head;
+    while (n->next != NULL && n->items[n->count - 1] <= v) n = n->next;
+    uint32_t pos = 0;
+    while (pos < n->count && n->items[pos] <= v) pos++;
+    if (n->count == ULIST_K) {
+        /* 满节点对半分裂, 后一半搬到新节点 */
+        ulist_node_t* m = new_node(l, n);
+        if (m == NULL) return -1;
+        uint32_t half = (uint32_t)(ULIST_K / 2);
+        m->count = (uint32_t)ULIST_K - half;
+        memcpy(m->items, &n->items[half], m->count * sizeof(list_value_t));
+        n->count = half;
+        if (pos > half) {
+            n = m;
+            pos -= half;
+        }
+    }
+    insert_at(n, pos, v);
+    l->size++;
+    return 0;
+}
+
+int ulist_remove(ulist_t* l, list_value_t v) {
+    ulist_node_t* prev = NULL;
+    for (ulist_node_t* n = l->head; n != NULL; prev = n, n = n->next) {
+        for (uint32_t i = 0; i < n->count; i++) {
+            if (n->items[i] == v) {
+                erase_at(l, prev, n, i);
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+void ulist_clear(ulist_t* l) {
+    ulist_node_t* n = l->head;
+    while (n != NULL) {
+        ulist_node_t* next = n->next;
+        alloc_delete(l->alloc, n);
+        n = next;
+    }
+    l->head = l->tail = NULL;
+    l->size = 0;
+}
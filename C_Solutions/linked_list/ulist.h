@@ -0,0 +1,56 @@
+/* 展开链表 (unrolled linked list): 每个节点恰好一条缓存行, 连续存放 ULIST_K 个元素
+ *
+ * 遍历时每次追指针能拿到 K 个元素, 缓存未命中次数约为经典链表的 1/K;
+ * 中间插入满节点时对半分裂, 删除后节点变空才释放. 节点经 allocator_t 分配,
+ * 配合 block_size = ULIST_NODE_BYTES 的内存池最合适.
+ */
+#ifndef ULIST_H
+#define ULIST_H
+
+#include "allocator.h"
+#include "list.h"
+
+#ifndef ULIST_NODE_BYTES
+#define ULIST_NODE_BYTES 64
+#endif
+#define ULIST_K ((ULIST_NODE_BYTES - sizeof(void*) - sizeof(uint32_t)) / sizeof(list_value_t))
+
+typedef struct ulist_node {
+    struct ulist_node* next;
+    uint32_t           count;
+    list_value_t       items[ULIST_K];
+} ulist_node_t;
+
+typedef struct {
+    ulist_node_t*      head;
+    ulist_node_t*      tail;
+    size_t             size;
+    const allocator_t* alloc;
+} ulist_t;
+
+typedef struct {
+    ulist_node_t* node;
+    uint32_t      idx;
+} ulist_iter_t;
+
+void   ulist_init(ulist_t* l, const allocator_t* alloc);
+int    ulist_push_front(ulist_t* l, list_value_t v);
+int    ulist_push_back(ulist_t* l, list_value_t v);
+int    ulist_pop_front(ulist_t* l, list_value_t* out);
+int    ulist_insert_sorted(ulist_t* l, list_value_t v);
+int    ulist_remove(ulist_t* l, list_value_t v);
+void   ulist_clear(ulist_t* l);
+static inline size_t ulist_size(const ulist_t* l) { return l->size; }
+
+/* 节点不会为空, 所以 idx == count 时换到下一个节点即可 */
+static inline ulist_iter_t ulist_begin(const ulist_t* l) { ulist_iter_t it = {l->head, 0}; return it; }
+static inline int ulist_valid(const ulist_iter_t* it) { return it->node != NULL; }
+static inline void ulist_next(ulist_iter_t* it) {
+    if (++it->idx == it->node->count) {
+        it->node = it->node->next;
+        it->idx = 0;
+    }
+}
+static inline list_value_t ulist_get(const ulist_iter_t* it) { return it->node->items[it->idx]; }
+
+#endif /* ULIST_H */
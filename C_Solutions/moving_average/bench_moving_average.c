@@ -0,0 +1,189 @@
+/* 滑动窗口统计测试: O(1) 增量更新 vs 每个样本重新扫描整个窗口
+ * 计时前先把 O(1) 版本的每个输出与逐窗口重新计算的参考值比对 (整数精确相等, 浮点在容差内).
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates moving_average.c bench_moving_average.c \
+ *           ../../Templates/benchmark.c -o bench_moving_average -lm
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "moving_average.h"
+
+#define MAX_WINDOW 1024u
+#define BLOCK      1024u   /* 每次迭代处理的样本数 */
+#define CHECK_LEN  (16u * BLOCK)  /* 自检的样本数: 远多于窗口长度, 环形下标回绕多次, 浮点累积误差也有时间显现 */
+#define MEAN_TOL   1e-4   /* 浮点平均值的绝对误差上限 (输入 0..3.3 V) */
+#define VAR_TOL    1e-3   /* 浮点窗口方差的绝对误差上限 (方差约 0.9 V^2) */
+
+static int32_t g_in[BLOCK];
+static float g_inf[BLOCK];
+static int32_t g_win[MAX_WINDOW];
+static float g_winf[MAX_WINDOW];
+static mm_entry_t g_q[MAX_WINDOW];
+
+/* 原来的写法: 写入环形缓冲区后把整个窗口重新加一遍 */
+static int32_t naive_mean(int32_t* win, uint32_t w, uint32_t* idx, int32_t x) {
+    win[*idx] = x;
+    *idx = (*idx + 1) & (w - 1);
+    int64_t s = 0;
+    for (uint32_t k = 0; k < w; k++) s += win[k];
+    return (int32_t)(s / (int64_t)w);
+}
+
+static int32_t naive_max(int32_t* win, uint32_t w, uint32_t* idx, int32_t x) {
+    win[*idx] = x;
+    *idx = (*idx + 1) & (w - 1);
+    int32_t m = win[0];
+    for (uint32_t k = 1; k < w; k++) m = win[k] > m ? win[k] : m;
+    return m;
+}
+
+/* 样本流是 g_in 的重复; 第 t 个输出的窗口是 [max(0, t-w+1), t], 每次直接重新扫描算参考值 */
+static int check_window(uint32_t w) {
+    ma_i32_t mi;
+    ma_f32_t mf;
+    minmax_t mx, mn;
+    static mm_entry_t q_min[MAX_WINDOW];
+    ma_i32_init(&mi, g_win, w);
+    ma_f32_init(&mf, g_winf, w);
+    minmax_init(&mx, g_q, w, MINMAX_MAX);
+    minmax_init(&mn, q_min, w, MINMAX_MIN);
+    double max_mean_err = 0.0, max_var_err = 0.0;
+    for (uint32_t t = 0; t < CHECK_LEN; t++) {
+        int32_t got_mean = ma_i32_push(&mi, g_in[t % BLOCK]);
+        float got_meanf = ma_f32_push(&mf, g_inf[t % BLOCK]);
+        int32_t got_max = minmax_push(&mx, g_in[t % BLOCK]);
+        int32_t got_min = minmax_push(&mn, g_in[t % BLOCK]);
+
+        uint32_t cnt = t + 1 < w ? t + 1 : w;
+        int64_t sum = 0;
+        int32_t hi = INT32_MIN, lo = INT32_MAX;
+        double fsum = 0.0, fsq = 0.0;
+        for (uint32_t k = t + 1 - cnt; k <= t; k++) {
+            int32_t x = g_in[k % BLOCK];
+            sum += x;
+            hi = x > hi ? x : hi;
+            lo = x < lo ? x : lo;
+            fsum += g_inf[k % BLOCK];
+        }
+        double fmean = fsum / cnt;
+        for (uint32_t k = t + 1 - cnt; k <= t; k++) fsq += (g_inf[k % BLOCK] - fmean) * (g_inf[k % BLOCK] - fmean);
+        /* 预热期按已有样本数求平均, 与填满后一样四舍五入 (输入非负), 见 ma_i32_mean */
+        int32_t want_mean = (int32_t)((sum + cnt / 2) / cnt);
+        if (got_mean != want_mean || got_max != hi || got_min != lo) {
+            fprintf(stderr, "MISMATCH: w=%u sample %u: mean %d/%d max %d/%d min %d/%d\n", (unsigned)w, (unsigned)t,
+                    (int)got_mean, (int)want_mean, (int)got_max, (int)hi, (int)got_min, (int)lo);
+            return -1;
+        }
+        double mean_err = fabs(got_meanf - fmean), var_err = fabs(ma_f32_variance(&mf) - fsq / cnt);
+        max_mean_err = mean_err > max_mean_err ? mean_err : max_mean_err;
+        max_var_err = var_err > max_var_err ? var_err : max_var_err;
+        if (mean_err > MEAN_TOL || var_err > VAR_TOL) {
+            fprintf(stderr, "MISMATCH: w=%u sample %u: f32 mean error %.3g, variance error %.3g\n", (unsigned)w,
+                    (unsigned)t, mean_err, var_err);
+            return -1;
+        }
+    }
+    fprintf(stderr, "# w=%u over %u samples: f32 mean error max %.3g, variance error max %.3g\n", (unsigned)w,
+            (unsigned)CHECK_LEN, max_mean_err, max_var_err);
+    return 0;
+}
+
+static int bench_window(uint32_t w) {
+    bench_t b;
+    char name[64];
+    ma_i32_t mi;
+    ma_f32_t mf;
+    minmax_t mx;
+    uint32_t idx = 0;
+
+    if (check_window(w) != 0) return -1;
+
+    for (uint32_t k = 0; k < w; k++) g_win[k] = 0;
+    snprintf(name, sizeof name, "mean naive w=%u", (unsigned)w);
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BLOCK; k++) BENCH_DO_NOT_OPTIMIZE(naive_mean(g_win, w, &idx, g_in[k]));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(int32_t));
+    bench_report(&b);
+
+    ma_i32_init(&mi, g_win, w);
+    snprintf(name, sizeof name, "mean i32 O(1) w=%u", (unsigned)w);
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BLOCK; k++) BENCH_DO_NOT_OPTIMIZE(ma_i32_push(&mi, g_in[k]));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(int32_t));
+    bench_report(&b);
+
+    ma_f32_init(&mf, g_winf, w);
+    snprintf(name, sizeof name, "mean+var f32 O(1) w=%u", (unsigned)w);
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BLOCK; k++) BENCH_DO_NOT_OPTIMIZE(ma_f32_push(&mf, g_inf[k]));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(float));
+    bench_report(&b);
+
+    for (uint32_t k = 0; k < w; k++) g_win[k] = 0;
+    idx = 0;
+    snprintf(name, sizeof name, "max naive w=%u", (unsigned)w);
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BLOCK; k++) BENCH_DO_NOT_OPTIMIZE(naive_max(g_win, w, &idx, g_in[k]));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(int32_t));
+    bench_report(&b);
+
+    minmax_init(&mx, g_q, w, MINMAX_MAX);
+    snprintf(name, sizeof name, "max deque w=%u", (unsigned)w);
+    BENCH(b, name, {
+        for (uint32_t k = 0; k < BLOCK; k++) BENCH_DO_NOT_OPTIMIZE(minmax_push(&mx, g_in[k]));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(int32_t));
+    bench_report(&b);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    srand(1);
+    for (uint32_t k = 0; k < BLOCK; k++) {
+        g_in[k] = rand() % 4096;  /* 12 位 ADC */
+        g_inf[k] = (float)g_in[k] * (3.3f / 4096.0f);
+    }
+    static const size_t defaults[] = {16, 256, MAX_WINDOW};
+    const size_t* windows;
+    size_t n = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &windows);
+    for (size_t i = 0; i < n; i++) {
+        size_t w = windows[i];
+        if (w == 0 || w > MAX_WINDOW || (w & (w - 1)) != 0) {
+            fprintf(stderr, "# skip window %zu: must be a power of two <= %u\n", w, MAX_WINDOW);
+            continue;
+        }
+        if (bench_window((uint32_t)w) != 0) return 1;
+    }
+
+    /* 累计 Welford 与两遍法 (double) 比对 */
+    welford_t wf;
+    welford_reset(&wf);
+    double mean = 0.0, sq = 0.0;
+    for (uint32_t k = 0; k < BLOCK; k++) {
+        welford_push(&wf, g_inf[k]);
+        mean += g_inf[k];
+    }
+    mean /= BLOCK;
+    for (uint32_t k = 0; k < BLOCK; k++) sq += (g_inf[k] - mean) * (g_inf[k] - mean);
+    if (fabs(welford_variance(&wf) - sq / (BLOCK - 1)) > VAR_TOL) {
+        fprintf(stderr, "MISMATCH: welford variance %g, expected %g\n", (double)welford_variance(&wf), sq / (BLOCK - 1));
+        return 1;
+    }
+
+    bench_t b;
+    welford_reset(&wf);
+    BENCH(b, "welford f32", {
+        for (uint32_t k = 0; k < BLOCK; k++) welford_push(&wf, g_inf[k]);
+        BENCH_DO_NOT_OPTIMIZE(welford_variance(&wf));
+    });
+    bench_set_size(&b, BLOCK, BLOCK * sizeof(float));
+    bench_report(&b);
+    return bench_summary();
+}
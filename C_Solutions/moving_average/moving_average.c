@@ -0,0 +1,55 @@
+/* O(1) 滑动窗口统计 - 初始化 (热路径见 moving_average.h 中的 inline 函数) */
+#include "moving_average.h"
+
+static int is_pow2(uint32_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+int ma_i32_init(ma_i32_t* m, int32_t* storage, uint32_t window) {
+    if (m == NULL || storage == NULL || !is_pow2(window)) return -1;
+    m->buf = storage;
+    m->mask = window - 1;
+    m->shift = 0;
+    while ((1u << m->shift) < window) m->shift++;
+    ma_i32_reset(m);
+    return 0;
+}
+
+void ma_i32_reset(ma_i32_t* m) {
+    m->idx = 0;
+    m->count = 0;
+    m->sum = 0;
+}
+
+int ma_f32_init(ma_f32_t* m, float* storage, uint32_t window) {
+    if (m == NULL || storage == NULL || !is_pow2(window)) return -1;
+    m->buf = storage;
+    m->mask = window - 1;
+    m->inv_w = 1.0f / (float)window;  /* 2 的幂的倒数可精确表示 */
+    ma_f32_reset(m);
+    return 0;
+}
+
+void ma_f32_reset(ma_f32_t* m) {
+    m->idx = 0;
+    m->count = 0;
+    m->sum = 0.0f;
+    m->comp = 0.0f;
+    m->mean = 0.0f;
+    m->m2 = 0.0f;
+}
+
+int minmax_init(minmax_t* w, mm_entry_t* storage, uint32_t window, int mode) {
+    if (w == NULL || storage == NULL || !is_pow2(window)) return -1;
+    if (mode != MINMAX_MIN && mode != MINMAX_MAX) return -1;
+    w->q = storage;
+    w->mask = window - 1;
+    w->window = window;
+    w->flip = mode == MINMAX_MAX ? -1 : 0;
+    minmax_reset(w);
+    return 0;
+}
+
+void minmax_reset(minmax_t* w) {
+    w->head = 0;
+    w->tail = 0;
+    w->seq = 0;
+}
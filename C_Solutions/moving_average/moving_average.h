@@ -0,0 +1,165 @@
+/* O(1) 滑动窗口统计: 滑动平均 (整数/浮点), 滑动最小/最大值, Welford 方差
+ *
+ * - 窗口长度必须是 2 的幂: 环形下标用掩码取模, 整数平均值用移位代替除法.
+ * - 每来一个样本只做 "加新减旧", 与窗口长度无关; 不再每次重新累加整个窗口.
+ * - 存储区由调用方提供 (静态数组), 不 malloc. 热路径是本文件中的 inline 函数, 可直接在 ISR 中调用.
+ *
+ *   static int32_t adc_win[64];
+ *   static ma_i32_t adc_avg;
+ *   ma_i32_init(&adc_avg, adc_win, 64);
+ *   // ISR: filtered = ma_i32_push(&adc_avg, adc_read());
+ */
+#ifndef MOVING_AVERAGE_H
+#define MOVING_AVERAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ---------------- 整数滑动平均 ---------------- */
+
+typedef struct {
+    int32_t* buf;
+    uint32_t mask;     /* window - 1 */
+    uint32_t shift;    /* log2(window) */
+    uint32_t idx;      /* 下一个写入 (也是最旧样本) 的位置 */
+    uint32_t count;    /* 已有样本数, 填满后固定为 window */
+    int64_t  sum;      /* 精确的窗口和, 不会累积误差 */
+} ma_i32_t;
+
+/* storage 至少 window 个元素; window 必须是 2 的幂. 成功返回 0, 参数非法返回 -1 */
+int ma_i32_init(ma_i32_t* m, int32_t* storage, uint32_t window);
+void ma_i32_reset(ma_i32_t* m);
+
+/* 四舍五入 (.5 向正无穷, 即 floor((sum + n/2) / n)). 窗口未满时按已有样本数求平均, 舍入方式相同,
+ * 填满的那一刻输出不会跳变 (只有这段预热期会用到除法) */
+static inline int32_t ma_i32_mean(const ma_i32_t* m) {
+    if (m->count > m->mask) return (int32_t)((m->sum + ((int64_t)1 << m->shift >> 1)) >> m->shift);
+    if (m->count == 0) return 0;
+    int64_t n = m->sum + (int64_t)(m->count >> 1);
+    int64_t q = n / (int64_t)m->count;   /* C 的除法向零截断, 负数时修正成向下取整, 与算术右移一致 */
+    return (int32_t)(q - (n % (int64_t)m->count < 0));
+}
+
+/* 加入一个样本, 返回新的窗口平均值 (四舍五入) */
+static inline int32_t ma_i32_push(ma_i32_t* m, int32_t x) {
+    int32_t old = m->count > m->mask ? m->buf[m->idx] : 0;
+    m->count += m->count <= m->mask;
+    m->sum += (int64_t)x - old;
+    m->buf[m->idx] = x;
+    m->idx = (m->idx + 1) & m->mask;
+    return ma_i32_mean(m);
+}
+
+/* ---------------- 浮点滑动平均 + 窗口方差 ---------------- */
+
+typedef struct {
+    float*   buf;
+    uint32_t mask;
+    uint32_t idx;
+    uint32_t count;
+    float    inv_w;    /* 1 / window, 初始化时算好 */
+    float    sum;      /* Kahan 补偿求和: 漂移被限制在几个 ulp 量级, 不随样本数线性增长, 但并非为零
+                        * (不要用 -ffast-math 编译, 会把补偿项优化掉) */
+    float    comp;
+    float    mean;
+    float    m2;       /* 窗口内离差平方和 */
+} ma_f32_t;
+
+int ma_f32_init(ma_f32_t* m, float* storage, uint32_t window);
+void ma_f32_reset(ma_f32_t* m);
+
+/* 加入一个样本, 返回新的窗口平均值. 同时用滑动 Welford 公式 O(1) 更新窗口方差 */
+static inline float ma_f32_push(ma_f32_t* m, float x) {
+    int full = m->count > m->mask;
+    float old = full ? m->buf[m->idx] : 0.0f;
+    float delta = x - old;
+    /* Kahan: comp 记录上一次加法丢掉的低位 */
+    float y = delta - m->comp;
+    float t = m->sum + y;
+    m->comp = (t - m->sum) - y;
+    m->sum = t;
+
+    float mean_old = m->mean;
+    if (full) {
+        m->mean = m->sum * m->inv_w;
+        /* 同时移出 old、移入 x: M2' = M2 + (x - old)(x - mean' + old - mean) */
+        m->m2 += delta * (x - m->mean + old - mean_old);
+    } else {
+        m->count++;
+        m->mean = m->sum / (float)m->count;
+        m->m2 += (x - mean_old) * (x - m->mean);
+    }
+    if (m->m2 < 0.0f) m->m2 = 0.0f;  /* 舍入可能让 M2 略小于 0 */
+    m->buf[m->idx] = x;
+    m->idx = (m->idx + 1) & m->mask;
+    return m->mean;
+}
+
+static inline float ma_f32_mean(const ma_f32_t* m) { return m->mean; }
+
+/* 窗口内的总体方差 (除以样本数) */
+static inline float ma_f32_variance(const ma_f32_t* m) {
+    if (m->count > m->mask) return m->m2 * m->inv_w;
+    return m->count ? m->m2 / (float)m->count : 0.0f;
+}
+
+/* ---------------- 滑动最小值 / 最大值 (单调队列) ---------------- */
+
+typedef struct {
+    int32_t  v;        /* 比较键: 最大值模式下存 ~x, 这样两种模式共用同一个 "<=" 比较 */
+    uint32_t seq;      /* 样本序号, 用于判断是否已滑出窗口 */
+} mm_entry_t;
+
+typedef struct {
+    mm_entry_t* q;     /* 环形双端队列, 键值单调递增, 队首即窗口内的最小键 */
+    uint32_t mask;
+    uint32_t head;     /* 队首 (自由增长) */
+    uint32_t tail;     /* 队尾后一个位置 (自由增长) */
+    uint32_t seq;      /* 下一个样本的序号 */
+    uint32_t window;
+    int32_t  flip;     /* 0: 最小值; -1: 最大值 (~x 反转有符号整数的顺序, 不会溢出) */
+} minmax_t;
+
+#define MINMAX_MIN 0
+#define MINMAX_MAX 1
+
+/* storage 至少 window 个元素; window 必须是 2 的幂. mode 取 MINMAX_MIN / MINMAX_MAX */
+int minmax_init(minmax_t* w, mm_entry_t* storage, uint32_t window, int mode);
+void minmax_reset(minmax_t* w);
+
+/* 加入一个样本, 返回窗口内 (最近 window 个样本) 的最小/最大值.
+ * 每个样本最多入队出队各一次: 均摊 O(1), 单次最坏 O(window) (单调序列时回退队尾) */
+static inline int32_t minmax_push(minmax_t* w, int32_t x) {
+    int32_t key = x ^ w->flip;
+    uint32_t s = w->seq++;
+    if (w->head != w->tail && s - w->q[w->head & w->mask].seq >= w->window) w->head++;
+    while (w->head != w->tail && w->q[(w->tail - 1) & w->mask].v >= key) w->tail--;
+    w->q[w->tail & w->mask] = (mm_entry_t){key, s};
+    w->tail++;
+    return w->q[w->head & w->mask].v ^ w->flip;
+}
+
+/* ---------------- Welford 累计均值/方差 (不限窗口) ---------------- */
+
+typedef struct {
+    uint32_t n;
+    float    mean;
+    float    m2;
+} welford_t;
+
+static inline void welford_reset(welford_t* s) { s->n = 0; s->mean = 0.0f; s->m2 = 0.0f; }
+
+/* 数值稳定的单遍算法: 不会出现 E[x^2] - E[x]^2 的大数相消 */
+static inline void welford_push(welford_t* s, float x) {
+    s->n++;
+    float d = x - s->mean;
+    s->mean += d / (float)s->n;
+    s->m2 += d * (x - s->mean);
+}
+
+/* 样本方差 (除以 n - 1); 少于 2 个样本返回 0 */
+static inline float welford_variance(const welford_t* s) {
+    return s->n > 1 ? s->m2 / (float)(s->n - 1) : 0.0f;
+}
+
+#endif /* MOVING_AVERAGE_H */
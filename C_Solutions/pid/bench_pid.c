@@ -0,0 +1,212 @@
+/* 定点 PID 更新耗时测试: 逐个 Q15 / Q31 / float 对比 SoA 批量 Q15
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates pid.c bench_pid.c \
+ *           ../../Templates/benchmark.c -o bench_pid -lm
+ * 在 x86 上加 -DBENCH_TIMER=BENCH_TIMER_TSC (Cortex-M 上默认 DWT) 可直接得到 cycles/op.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+
+#include "pid.h"
+
+#define N_CTRL 32       /* 每次迭代更新的控制器个数, 如多轴电流环 + 速度环 */
+#define TS     1e-4f    /* 10 kHz 控制周期 */
+
+static pid_q15_t g_q15[N_CTRL];
+static pid_q31_t g_q31[N_CTRL];
+static pid_q15_batch_t g_batch;
+static int16_t g_sp15[N_CTRL], g_pv15[N_CTRL], g_out15[N_CTRL];
+static int32_t g_sp31[N_CTRL], g_pv31[N_CTRL], g_out31[N_CTRL];
+
+/* 浮点参照实现 (位置式 + 积分钳位), 代表有 FPU 时的常见写法 */
+typedef struct {
+    float kp, ki_ts, kd_ts, integ, prev, out_min, out_max;
+} pid_f32_t;
+
+static pid_f32_t g_f32[N_CTRL];
+static float g_spf[N_CTRL], g_pvf[N_CTRL], g_outf[N_CTRL];
+
+static float pid_f32_update(pid_f32_t* p, float sp, float pv) {
+    float e = sp - pv;
+    p->integ += p->ki_ts * e;
+    if (p->integ > p->out_max) p->integ = p->out_max;
+    if (p->integ < p->out_min) p->integ = p->out_min;
+    float u = p->kp * e + p->integ + p->kd_ts * (e - p->prev);
+    p->prev = e;
+    return u > p->out_max ? p->out_max : (u < p->out_min ? p->out_min : u);
+}
+
+static void setup(void) {
+    srand(1);
+    for (int i = 0; i < N_CTRL; i++) {
+        float kp = 0.8f + 0.01f * (float)i, ki = 200.0f, kd = 1e-5f;
+        pid_q15_init(&g_q15[i], kp, ki, kd, TS, -30000, 30000);
+        pid_q31_init(&g_q31[i], kp, ki, kd, TS, -2000000000, 2000000000);
+        g_f32[i] = (pid_f32_t){kp, ki * TS, kd / TS, 0.0f, 0.0f, -0.9f, 0.9f};
+        g_sp15[i] = (int16_t)(rand() % 20000 - 10000);
+        g_pv15[i] = (int16_t)(rand() % 20000 - 10000);
+        g_sp31[i] = (int32_t)g_sp15[i] << 16;
+        g_pv31[i] = (int32_t)g_pv15[i] << 16;
+        g_spf[i] = (float)g_sp15[i] / 32768.0f;
+        g_pvf[i] = (float)g_pv15[i] / 32768.0f;
+    }
+    pid_q15_batch_init(&g_batch, g_q15, N_CTRL);
+}
+
+#define CHECK_STEPS 1000
+
+static int16_t rand_q15(int amp) { return (int16_t)(rand() % (2 * amp + 1) - amp); }
+
+static double abs_diff(double a, double b) { return a > b ? a - b : b - a; }
+
+/* 线性区 (没有触到限幅) 里增量式与位置式是同一个差分方程, 定点输出与 float 参照之差应在误差界内.
+ * 输入: 每拍 |e| <= 0.05 的零均值随机误差, 1000 拍里积分项只有 ~0.02, 远离 +-0.9 的限幅.
+ *   Q15: 每拍 delta 的舍入误差在 +-0.5 LSB 内, 增量式里会一直累积成随机游走 (1000 拍 sigma ~9 LSB),
+ *        32 个控制器里最大的实测 ~30 LSB, 界取 64 LSB (逐拍同号的最坏情形 500 LSB 实际不会出现).
+ *   Q31: 定点本身比单精度参照精确, 差值主要是 float 的 24 位尾数, 实测 ~1e-7, 界取 1e-6 */
+#define Q15_ERR_BOUND (64.0 / 32768.0)
+#define Q31_ERR_BOUND 1e-6
+
+static int check_float_ref(void) {
+    pid_q15_t q15[N_CTRL];
+    pid_q31_t q31[N_CTRL];
+    pid_f32_t f32[N_CTRL];
+    double err15 = 0.0, err31 = 0.0;
+    for (int i = 0; i < N_CTRL; i++) {
+        q15[i] = g_q15[i];
+        q31[i] = g_q31[i];
+        f32[i] = g_f32[i];
+    }
+    for (int step = 0; step < CHECK_STEPS; step++) {
+        for (int i = 0; i < N_CTRL; i++) {
+            int16_t pv = g_pv15[i], sp = (int16_t)(pv + rand_q15(1600));
+            float uf = pid_f32_update(&f32[i], (float)sp / 32768.0f, (float)pv / 32768.0f);
+            double u15 = pid_q15_update(&q15[i], sp, pv) / 32768.0;
+            double u31 = pid_q31_update(&q31[i], (int32_t)sp << 16, (int32_t)pv << 16) / 2147483648.0;
+            if (uf >= 0.5f || uf <= -0.5f) {
+                fprintf(stderr, "MISMATCH: float reference left the linear region: ctrl %d step %d\n", i, step);
+                return -1;
+            }
+            if (abs_diff(u15, uf) > err15) err15 = abs_diff(u15, uf);
+            if (abs_diff(u31, uf) > err31) err31 = abs_diff(u31, uf);
+        }
+    }
+    fprintf(stderr, "# float reference: max |q15 - f32| = %.3g (%.1f LSB), max |q31 - f32| = %.3g\n", err15,
+            err15 * 32768.0, err31);
+    if (err15 > Q15_ERR_BOUND || err31 > Q31_ERR_BOUND) {
+        fprintf(stderr, "MISMATCH: fixed-point output off the float reference (bounds %.3g / %.3g)\n",
+                Q15_ERR_BOUND, Q31_ERR_BOUND);
+        return -1;
+    }
+    return 0;
+}
+
+/* 抗积分饱和: 大阶跃把输出顶到上限并保持很久, 积分不应继续累积, 阶跃反向的第一拍输出就要离开上限.
+ * 积分失控的实现会在上限停留很多拍 (多积了 ~1800 拍 * 0.012) */
+static int check_windup(void) {
+    const int16_t big = 20000;  /* e ~= 0.61, 约 40 拍顶到上限 */
+    for (int i = 0; i < N_CTRL; i++) {
+        pid_q15_t q15 = g_q15[i];
+        pid_q31_t q31 = g_q31[i];
+        pid_f32_t f32 = g_f32[i];
+        for (int dir = 1; dir >= -1; dir -= 2) {
+            int16_t e = (int16_t)(dir * big);
+            for (int step = 0; step < 2 * CHECK_STEPS; step++) {
+                int16_t y15 = pid_q15_update(&q15, e, 0);
+                int32_t y31 = pid_q31_update(&q31, (int32_t)e << 16, 0);
+                float yf = pid_f32_update(&f32, (float)e / 32768.0f, 0.0f);
+                int at15 = dir > 0 ? y15 == q15.out_max : y15 == q15.out_min;
+                int at31 = dir > 0 ? y31 == q31.out_max : y31 == q31.out_min;
+                int atf = dir > 0 ? yf == f32.out_max : yf == f32.out_min;
+                if (step == 0 && dir < 0 && (y15 >= q15.out_max || y31 >= q31.out_max || yf >= f32.out_max)) {
+                    fprintf(stderr, "MISMATCH: ctrl %d still at out_max after the step reversed (wind-up)\n", i);
+                    return -1;
+                }
+                if (step >= 200 && (!at15 || !at31 || !atf || f32.integ > f32.out_max || f32.integ < f32.out_min)) {
+                    fprintf(stderr, "MISMATCH: ctrl %d not clamped at step %d of the %s step\n", i, step,
+                            dir > 0 ? "positive" : "negative");
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* 批量版对照逐个更新的参照: 参照的系数按 pid_q15_batch_init 的方式右移对齐到批次共同的 shift,
+ * 之后两者是同一组整数运算, 必须逐位一致. shift 全相同时参照就是原控制器 */
+static int check_batch(const pid_q15_t* ctrls, const char* label) {
+    pid_q15_t ref[N_CTRL];
+    pid_q15_batch_t b;
+    pid_q15_batch_init(&b, ctrls, N_CTRL);
+    for (int i = 0; i < N_CTRL; i++) {
+        int d = b.shift - ctrls[i].shift;
+        ref[i] = ctrls[i];
+        ref[i].a0 = (int16_t)(ctrls[i].a0 >> d);
+        ref[i].a1 = (int16_t)(ctrls[i].a1 >> d);
+        ref[i].a2 = (int16_t)(ctrls[i].a2 >> d);
+        ref[i].shift = b.shift;
+    }
+    for (int step = 0; step < CHECK_STEPS; step++) {
+        int16_t sp[N_CTRL], pv[N_CTRL], out[N_CTRL];
+        for (int i = 0; i < N_CTRL; i++) {  /* 幅度足够大, 线性区和限幅都会走到 */
+            sp[i] = rand_q15(10000);
+            pv[i] = rand_q15(10000);
+        }
+        pid_q15_batch_update(&b, sp, pv, out);
+        for (int i = 0; i < N_CTRL; i++) {
+            if (pid_q15_update(&ref[i], sp[i], pv[i]) != out[i]) {
+                fprintf(stderr, "MISMATCH: %s batch: ctrl %d step %d\n", label, i, step);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* 增益跨度大的一组控制器, shift 从 0 到 3 都有, 批量时要重新对齐系数 */
+static int check_batch_mixed(void) {
+    pid_q15_t mixed[N_CTRL];
+    for (int i = 0; i < N_CTRL; i++)
+        pid_q15_init(&mixed[i], 0.05f + 0.25f * (float)i, 50.0f * (float)(i % 5), 2e-5f * (float)(i % 3), TS,
+                     -30000, 30000);
+    return check_batch(mixed, "mixed-shift");
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    setup();
+    if (check_float_ref() != 0 || check_windup() != 0) return 1;
+    if (check_batch(g_q15, "uniform-shift") != 0 || check_batch_mixed() != 0) return 1;
+    bench_t b;
+
+    BENCH(b, "pid q15 scalar", {
+        for (int k = 0; k < N_CTRL; k++) g_out15[k] = pid_q15_update(&g_q15[k], g_sp15[k], g_pv15[k]);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, N_CTRL, 0);
+    bench_report(&b);
+
+    BENCH(b, "pid q15 batch", {
+        pid_q15_batch_update(&g_batch, g_sp15, g_pv15, g_out15);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, N_CTRL, 0);
+    bench_report(&b);
+
+    BENCH(b, "pid q31 scalar", {
+        for (int k = 0; k < N_CTRL; k++) g_out31[k] = pid_q31_update(&g_q31[k], g_sp31[k], g_pv31[k]);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, N_CTRL, 0);
+    bench_report(&b);
+
+    BENCH(b, "pid f32 scalar", {
+        for (int k = 0; k < N_CTRL; k++) g_outf[k] = pid_f32_update(&g_f32[k], g_spf[k], g_pvf[k]);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, N_CTRL, 0);
+    bench_report(&b);
+
+    return bench_summary();
+}
@@ -0,0 +1,174 @@
+/* 定点 PID 控制器实现 */
+#include "pid.h"
+
+/* __ssat 只要 SAT (Cortex-M3 也有), __smlald 要 DSP (Cortex-M4/M7) */
+#if defined(__ARM_FEATURE_SAT) || defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+#define Q15_ONE 32768.0f
+#define Q31_ONE 2147483648.0f
+#define Q15_COEFF_MAX 32767   /* 避开 -32768: 两个乘积之和才不会溢出 int32 */
+
+/* ---------------- 饱和运算 ---------------- */
+
+static inline int16_t sat_q15(int32_t x) {
+#if defined(__ARM_FEATURE_SAT)
+    return (int16_t)__ssat(x, 16);
+#else
+    return (int16_t)(x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x));
+#endif
+}
+
+static inline int32_t sat_q31(int64_t x) {
+    return (int32_t)(x > INT32_MAX ? INT32_MAX : (x < INT32_MIN ? INT32_MIN : x));
+}
+
+static inline int64_t clamp64(int64_t x, int64_t lo, int64_t hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+/* ---------------- 初始化: 增益折算 ---------------- */
+
+/* 选取最小的 shift 使所有系数 / 2^shift 落在 (-1, 1) 内 */
+static int pick_shift(const float* a, int count) {
+    float m = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float v = a[i] < 0.0f ? -a[i] : a[i];
+        if (v > m) m = v;
+    }
+    int shift = 0;
+    while (shift <= PID_MAX_SHIFT && m >= (float)(1L << shift)) shift++;
+    return shift > PID_MAX_SHIFT ? -1 : shift;
+}
+
+static int velocity_coeffs(float kp, float ki, float kd, float ts, float a[3]) {
+    if (ts <= 0.0f) return -1;
+    a[0] = kp + ki * ts + kd / ts;
+    a[1] = -(kp + 2.0f * kd / ts);
+    a[2] = kd / ts;
+    return 0;
+}
+
+static int32_t to_fixed(float v, int shift, float one, int32_t max) {
+    float scaled = v / (float)(1L << shift) * one;
+    scaled += scaled < 0.0f ? -0.5f : 0.5f;
+    if (scaled > (float)max) return max;
+    if (scaled < -(float)max) return -max;
+    return (int32_t)scaled;
+}
+
+int pid_q15_init(pid_q15_t* p, float kp, float ki, float kd, float ts, int16_t out_min, int16_t out_max) {
+    float a[3];
+    if (p == NULL || out_min > out_max || velocity_coeffs(kp, ki, kd, ts, a)) return -1;
+    int shift = pick_shift(a, 3);
+    if (shift < 0) return -1;
+    p->a0 = (int16_t)to_fixed(a[0], shift, Q15_ONE, Q15_COEFF_MAX);
+    p->a1 = (int16_t)to_fixed(a[1], shift, Q15_ONE, Q15_COEFF_MAX);
+    p->a2 = (int16_t)to_fixed(a[2], shift, Q15_ONE, Q15_COEFF_MAX);
+    p->shift = (int8_t)shift;
+    p->out_min = out_min;
+    p->out_max = out_max;
+    pid_q15_reset(p);
+    return 0;
+}
+
+int pid_q31_init(pid_q31_t* p, float kp, float ki, float kd, float ts, int32_t out_min, int32_t out_max) {
+    float a[3];
+    if (p == NULL || out_min > out_max || velocity_coeffs(kp, ki, kd, ts, a)) return -1;
+    int shift = pick_shift(a, 3);
+    if (shift < 0) return -1;
+    /* float 尾数只有 24 位, 2^31 边界附近取 INT32_MAX - 127 以免舍入越界 */
+    p->a0 = to_fixed(a[0], shift, Q31_ONE, INT32_MAX - 127);
+    p->a1 = to_fixed(a[1], shift, Q31_ONE, INT32_MAX - 127);
+    p->a2 = to_fixed(a[2], shift, Q31_ONE, INT32_MAX - 127);
+    p->shift = (int8_t)shift;
+    p->out_min = out_min;
+    p->out_max = out_max;
+    pid_q31_reset(p);
+    return 0;
+}
+
+void pid_q15_reset(pid_q15_t* p) {
+    p->x1 = p->x2 = 0;
+    p->y = 0 < p->out_min ? p->out_min : (0 > p->out_max ? p->out_max : 0);
+}
+
+void pid_q31_reset(pid_q31_t* p) {
+    p->x1 = p->x2 = 0;
+    p->y = 0 < p->out_min ? p->out_min : (0 > p->out_max ? p->out_max : 0);
+}
+
+/* ---------------- 单个控制器更新 ---------------- */
+
+int16_t pid_q15_update(pid_q15_t* p, int16_t setpoint, int16_t measurement) {
+    int16_t e = sat_q15((int32_t)setpoint - measurement);
+    /* 系数不含 -32768, 两个 Q30 乘积之和不会溢出 int32; 第三项再扩展到 64 位 */
+    int64_t acc = (int64_t)((int32_t)p->a0 * e + (int32_t)p->a1 * p->x1) + (int32_t)p->a2 * p->x2;
+    int rs = 15 - p->shift;
+    int64_t delta = (acc + ((int64_t)1 << (rs - 1))) >> rs;  /* 四舍五入: 截断会让积分每拍偏 -0.5 LSB */
+    p->y = (int16_t)clamp64((int64_t)p->y + delta, p->out_min, p->out_max);
+    p->x2 = p->x1;
+    p->x1 = e;
+    return p->y;
+}
+
+int32_t pid_q31_update(pid_q31_t* p, int32_t setpoint, int32_t measurement) {
+    int32_t e = sat_q31((int64_t)setpoint - measurement);
+    /* 三个 Q62 乘积各自舍入到 Q31 再相加, 避免 64 位累加溢出 */
+    const int64_t half = (int64_t)1 << 30;
+    int64_t acc = (((int64_t)p->a0 * e + half) >> 31) + (((int64_t)p->a1 * p->x1 + half) >> 31) +
+                  (((int64_t)p->a2 * p->x2 + half) >> 31);
+    p->y = (int32_t)clamp64((int64_t)p->y + acc * ((int64_t)1 << p->shift), p->out_min, p->out_max);
+    p->x2 = p->x1;
+    p->x1 = e;
+    return p->y;
+}
+
+/* ---------------- 批量更新 (SoA) ---------------- */
+
+int pid_q15_batch_init(pid_q15_batch_t* b, const pid_q15_t* ctrls, size_t n) {
+    if (b == NULL || ctrls == NULL || n > PID_BATCH_MAX) return -1;
+    int shift = 0;
+    for (size_t i = 0; i < n; i++)
+        if (ctrls[i].shift > shift) shift = ctrls[i].shift;
+    b->n = n;
+    b->shift = (int8_t)shift;
+    for (size_t i = 0; i < n; i++) {
+        int d = shift - ctrls[i].shift;  /* 统一到共同的 shift, 精度略有损失 */
+        b->a0[i] = (int16_t)(ctrls[i].a0 >> d);
+        b->a1[i] = (int16_t)(ctrls[i].a1 >> d);
+        b->a2[i] = (int16_t)(ctrls[i].a2 >> d);
+        b->x1[i] = ctrls[i].x1;
+        b->x2[i] = ctrls[i].x2;
+        b->y[i] = ctrls[i].y;
+        b->out_min[i] = ctrls[i].out_min;
+        b->out_max[i] = ctrls[i].out_max;
+    }
+    return 0;
+}
+
+void pid_q15_batch_update(pid_q15_batch_t* b, const int16_t* setpoint, const int16_t* measurement,
+                          int16_t* out) {
+    const size_t n = b->n;
+    const int rs = 15 - b->shift;
+    const int64_t round = (int64_t)1 << (rs - 1);
+    for (size_t i = 0; i < n; i++) {
+        int16_t e = sat_q15((int32_t)setpoint[i] - measurement[i]);
+#if defined(__ARM_FEATURE_DSP)
+        /* SMLALD: 一条指令完成 a0*e + a1*x1 并累加到 64 位, 再补上 a2*x2 */
+        uint32_t coef = (uint16_t)b->a0[i] | ((uint32_t)(uint16_t)b->a1[i] << 16);
+        uint32_t xs = (uint16_t)e | ((uint32_t)(uint16_t)b->x1[i] << 16);
+        int64_t acc = __smlald((int16x2_t)coef, (int16x2_t)xs, (int64_t)b->a2[i] * b->x2[i]);
+#else
+        int64_t acc = (int64_t)((int32_t)b->a0[i] * e + (int32_t)b->a1[i] * b->x1[i]) +
+                      (int32_t)b->a2[i] * b->x2[i];
+#endif
+        int64_t y = (int64_t)b->y[i] + ((acc + round) >> rs);
+        y = clamp64(y, b->out_min[i], b->out_max[i]);
+        b->y[i] = (int16_t)y;
+        b->x2[i] = b->x1[i];
+        b->x1[i] = e;
+        out[i] = (int16_t)y;
+    }
+}
@@ -0,0 +1,67 @@
+/* 定点 PID 控制器 - Q15 / Q31, 无 FPU 目标
+ *
+ * 采用增量 (速度) 式离散 PID, 增益在初始化时折算成三个系数, 更新时没有除法:
+ *     y[k] = y[k-1] + A0*e[k] + A1*e[k-1] + A2*e[k-2]
+ *     A0 = Kp + Ki*Ts + Kd/Ts,  A1 = -(Kp + 2*Kd/Ts),  A2 = Kd/Ts
+ * 抗积分饱和: 积分状态就是输出 y 本身, y 每拍都被钳位到 [out_min, out_max],
+ * 执行器饱和期间不会继续累积.
+ *
+ * 系数可能大于 1, 以 "Q15/Q31 尾数 * 2^shift" 存储 (shift 0..14, 初始化时自动选取).
+ * 误差与输出都是归一化的 Q15/Q31 量 (满量程 = 1.0).
+ *
+ * 批量接口 pid_q15_batch_t 以结构数组 (SoA) 形式一次更新 N 个控制器:
+ * 循环体没有分支, 编译器可向量化; Cortex-M4/M7 上用 SMLALD 一条指令做两次 16x16 乘加.
+ */
+#ifndef PID_H
+#define PID_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PID_MAX_SHIFT 14      /* 系数最大放大 2^14 倍; 保留 1 位给舍入 */
+#ifndef PID_BATCH_MAX
+#define PID_BATCH_MAX 32      /* 一个批次最多的控制器个数 */
+#endif
+
+typedef struct {
+    int16_t a0, a1, a2;       /* Q15 尾数, 实际系数 = a * 2^shift; 取值 [-32767, 32767] */
+    int8_t  shift;
+    int16_t x1, x2;           /* e[k-1], e[k-2] */
+    int16_t y;                /* y[k-1] */
+    int16_t out_min, out_max;
+} pid_q15_t;
+
+typedef struct {
+    int32_t a0, a1, a2;       /* Q31 尾数 */
+    int8_t  shift;
+    int32_t x1, x2;
+    int32_t y;
+    int32_t out_min, out_max;
+} pid_q31_t;
+
+typedef struct {
+    size_t  n;
+    int8_t  shift;            /* 整个批次共用, 取各控制器 shift 的最大值 */
+    int16_t a0[PID_BATCH_MAX], a1[PID_BATCH_MAX], a2[PID_BATCH_MAX];
+    int16_t x1[PID_BATCH_MAX], x2[PID_BATCH_MAX];
+    int16_t y[PID_BATCH_MAX];
+    int16_t out_min[PID_BATCH_MAX], out_max[PID_BATCH_MAX];
+} pid_q15_batch_t;
+
+/* 由连续域增益初始化 (浮点运算只发生在初始化阶段). out_min/out_max 为 Q15/Q31 输出限幅.
+ * 成功返回 0; 增益超出 2^PID_MAX_SHIFT 或限幅非法返回 -1 */
+int pid_q15_init(pid_q15_t* p, float kp, float ki, float kd, float ts, int16_t out_min, int16_t out_max);
+int pid_q31_init(pid_q31_t* p, float kp, float ki, float kd, float ts, int32_t out_min, int32_t out_max);
+void pid_q15_reset(pid_q15_t* p);
+void pid_q31_reset(pid_q31_t* p);
+
+int16_t pid_q15_update(pid_q15_t* p, int16_t setpoint, int16_t measurement);
+int32_t pid_q31_update(pid_q31_t* p, int32_t setpoint, int32_t measurement);
+
+/* 把 n 个已初始化的控制器打包成一个批次; 统一到最大的 shift (其余系数右移对齐). n 过大返回 -1 */
+int  pid_q15_batch_init(pid_q15_batch_t* b, const pid_q15_t* ctrls, size_t n);
+/* 一次更新批次内全部控制器: out[i] = PID_i(setpoint[i] - measurement[i]) */
+void pid_q15_batch_update(pid_q15_batch_t* b, const int16_t* setpoint, const int16_t* measurement,
+                          int16_t* out);
+
+#endif /* PID_H */
@@ -0,0 +1,191 @@
+/* SPSC 环形缓冲区吞吐量测试
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates ring_buffer.c bench_ring_buffer.c \
+ *           ../../Templates/benchmark.c -o bench_ring_buffer -lm -lpthread
+ * 计时前先校验消费者收到的正是生产者写入的序列 (单个/批量/span 混用, 下标多次回绕);
+ * 双线程测试中消费者逐个校验收到的值. 任何错位都报 MISMATCH, main 返回 1.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "ring_buffer.h"
+
+#define RING_CAP   1024u
+#define BATCH      256u    /* 每次迭代传输的元素个数 */
+#define XFER_TOTAL BATCH
+
+static uint32_t g_storage[RING_CAP];
+static spsc_ring_t g_ring;
+static uint32_t g_src[BATCH], g_dst[BATCH];
+
+#define CHECK_TOTAL (RING_CAP * 37u + 5u)  /* 校验传输的元素总数: 不是容量的整数倍, 下标在任意位置回绕 */
+
+/* 单线程交替生产/消费, 每轮的批量大小和 API (x1 / _n / span) 都在变; 消费者收到的必须是 0, 1, 2, ... */
+static int check_sequence(void) {
+    uint32_t next_in = 0, next_out = 0, tmp[RING_CAP];
+    spsc_init(&g_ring, g_storage, RING_CAP, sizeof(uint32_t));
+    for (uint32_t round = 0; next_out < CHECK_TOTAL; round++) {
+        /* 批量大小在 1..RING_CAP+7 之间变化, 既有跨越末尾的 span, 也有因满/空而被截短的请求 */
+        uint32_t want = 1u + (round * 2654435761u >> 22) % (RING_CAP + 7u);
+        if (want > CHECK_TOTAL - next_in) want = CHECK_TOTAL - next_in;
+        size_t n;
+        switch (round % 3) {
+        case 0:
+            for (n = 0; n < want && spsc_push(&g_ring, &next_in) == 0; n++) next_in++;
+            break;
+        case 1:
+            for (uint32_t k = 0; k < want && k < RING_CAP; k++) tmp[k] = next_in + k;
+            n = spsc_push_n(&g_ring, tmp, want < RING_CAP ? want : RING_CAP);
+            next_in += (uint32_t)n;
+            break;
+        default: {
+            void* p;
+            n = spsc_push_span(&g_ring, &p, want);
+            for (size_t k = 0; k < n; k++) ((uint32_t*)p)[k] = next_in++;
+            spsc_push_commit(&g_ring, n);
+        }
+        }
+        if (spsc_size(&g_ring) != next_in - next_out || spsc_size(&g_ring) > RING_CAP) {
+            fprintf(stderr, "MISMATCH: ring size %zu after pushing %u and popping %u\n", spsc_size(&g_ring),
+                    (unsigned)next_in, (unsigned)next_out);
+            return -1;
+        }
+
+        /* 消费侧用另一套批量大小, 读写节奏不同步 */
+        want = 1u + (round * 40503u >> 6) % (RING_CAP + 7u);
+        switch ((round / 2) % 3) {
+        case 0:
+            for (n = 0; n < want && spsc_pop(&g_ring, &tmp[n % RING_CAP]) == 0; n++)
+                if (tmp[n % RING_CAP] != next_out++) goto bad;
+            break;
+        case 1:
+            n = spsc_pop_n(&g_ring, tmp, want < RING_CAP ? want : RING_CAP);
+            for (size_t k = 0; k < n; k++)
+                if (tmp[k] != next_out++) goto bad;
+            break;
+        default: {
+            const void* p;
+            n = spsc_pop_span(&g_ring, &p, want);
+            for (size_t k = 0; k < n; k++)
+                if (((const uint32_t*)p)[k] != next_out++) goto bad;
+            spsc_pop_commit(&g_ring, n);
+        }
+        }
+    }
+    if (spsc_pop(&g_ring, tmp) != -1) {
+        fprintf(stderr, "MISMATCH: pop from an empty ring succeeded\n");
+        return -1;
+    }
+    for (uint32_t k = 0; k < RING_CAP; k++) spsc_push(&g_ring, &k);
+    if (spsc_push(&g_ring, tmp) != -1) {
+        fprintf(stderr, "MISMATCH: push into a full ring succeeded\n");
+        return -1;
+    }
+    return 0;
+bad:
+    fprintf(stderr, "MISMATCH: consumer expected element %u, got a different value\n", (unsigned)(next_out - 1));
+    return -1;
+}
+
+/* 同一线程内先写后读: 只测 API 本身的开销 (ISR 与主循环在单核上交替执行的场景) */
+static int bench_single_thread(void) {
+    bench_t b;
+    if (check_sequence() != 0) return -1;
+    spsc_init(&g_ring, g_storage, RING_CAP, sizeof(uint32_t));
+
+    BENCH(b, "spsc push/pop x1", {
+        for (uint32_t k = 0; k < BATCH; k++) spsc_push(&g_ring, &g_src[k]);
+        for (uint32_t k = 0; k < BATCH; k++) spsc_pop(&g_ring, &g_dst[k]);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, BATCH, BATCH * sizeof(uint32_t));
+    bench_report(&b);
+
+    BENCH(b, "spsc push_n/pop_n", {
+        spsc_push_n(&g_ring, g_src, BATCH);
+        spsc_pop_n(&g_ring, g_dst, BATCH);
+        BENCH_CLOBBER();
+    });
+    bench_set_size(&b, BATCH, BATCH * sizeof(uint32_t));
+    bench_report(&b);
+
+    /* 零拷贝: 生产者直接在槽位里构造数据, 消费者直接在槽位里处理 */
+    BENCH(b, "spsc span zero-copy", {
+        uint32_t left = BATCH, sum = 0;
+        while (left) {
+            void* p;
+            size_t n = spsc_push_span(&g_ring, &p, left);
+            for (size_t k = 0; k < n; k++) ((uint32_t*)p)[k] = (uint32_t)k;
+            spsc_push_commit(&g_ring, n);
+            left -= (uint32_t)n;
+        }
+        for (left = BATCH; left;) {
+            const void* p;
+            size_t n = spsc_pop_span(&g_ring, &p, left);
+            for (size_t k = 0; k < n; k++) sum += ((const uint32_t*)p)[k];
+            spsc_pop_commit(&g_ring, n);
+            left -= (uint32_t)n;
+        }
+        BENCH_DO_NOT_OPTIMIZE(sum);
+    });
+    bench_set_size(&b, BATCH, BATCH * sizeof(uint32_t));
+    bench_report(&b);
+    return 0;
+}
+
+/* 跨线程: 消费者线程持续读, 生产者在计时循环里写满 BATCH 个; 测缓存行在两核间往返的代价 */
+static volatile int g_stop;
+static size_t g_received, g_bad;  /* 消费者收到的元素数; 第一个错位元素的序号 + 1 (0 表示没有) */
+
+/* 生产者每次迭代写 g_src = 0..BATCH-1, 所以第 i 个收到的元素必须是 i % BATCH */
+static void* consumer_main(void* arg) {
+    uint32_t v;
+    size_t got = 0, bad = 0;
+    (void)arg;
+    while (!g_stop) {
+        size_t n = spsc_pop_n(&g_ring, g_dst, BATCH);
+        if (n == 0) sched_yield();
+        for (size_t k = 0; k < n; k++, got++)
+            if (g_dst[k] != got % BATCH && bad == 0) bad = got + 1;
+    }
+    for (; spsc_pop(&g_ring, &v) == 0; got++)
+        if (v != got % BATCH && bad == 0) bad = got + 1;
+    g_received = got;
+    g_bad = bad;
+    return NULL;
+}
+
+static int bench_two_threads(void) {
+    bench_t b;
+    pthread_t th;
+    spsc_init(&g_ring, g_storage, RING_CAP, sizeof(uint32_t));
+    g_stop = 0;
+    if (pthread_create(&th, NULL, consumer_main, NULL) != 0) return 0;
+
+    BENCH(b, "spsc 2-thread push_n", {
+        size_t done = 0;
+        while (done < XFER_TOTAL) {
+            size_t k = spsc_push_n(&g_ring, g_src + done, XFER_TOTAL - done);
+            if (k == 0) sched_yield();
+            done += k;
+        }
+    });
+    g_stop = 1;
+    pthread_join(th, NULL);
+    if (g_bad != 0 || g_received % BATCH != 0) {
+        fprintf(stderr, "MISMATCH: 2-thread consumer got %zu elements, first out of sequence at %zu\n", g_received,
+                g_bad ? g_bad - 1 : g_received);
+        return -1;
+    }
+    bench_set_size(&b, XFER_TOTAL, XFER_TOTAL * sizeof(uint32_t));
+    bench_report(&b);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    for (uint32_t k = 0; k < BATCH; k++) g_src[k] = k;
+    if (bench_single_thread() != 0 || bench_two_threads() != 0) return 1;
+    return bench_summary();
+}
@@ -0,0 +1,44 @@
+/* 无锁 SPSC 环形缓冲区 - 初始化与批量拷贝 (热路径见 ring_buffer.h 中的 inline 函数) */
+#include "ring_buffer.h"
+
+int spsc_init(spsc_ring_t* r, void* storage, size_t capacity, size_t esize) {
+    if (r == NULL || storage == NULL || esize == 0) return -1;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return -1;  /* 必须是 2 的幂 */
+    RB_INIT(&r->head, 0);
+    RB_INIT(&r->tail, 0);
+    r->tail_cache = 0;
+    r->head_cache = 0;
+    r->buf = (uint8_t*)storage;
+    r->mask = capacity - 1;
+    r->esize = esize;
+    return 0;
+}
+
+size_t spsc_push_n(spsc_ring_t* r, const void* src, size_t n) {
+    const uint8_t* s = (const uint8_t*)src;
+    size_t done = 0;
+    /* 最多两段: 先写到缓冲区末尾, 再从头写剩下的; 每段写完立即发布 */
+    for (int seg = 0; seg < 2 && done < n; seg++) {
+        void* p;
+        size_t k = spsc_push_span(r, &p, n - done);
+        if (k == 0) break;
+        memcpy(p, s + done * r->esize, k * r->esize);
+        done += k;
+        RB_STORE_REL(&r->head, RB_LOAD_RLX(&r->head) + k);
+    }
+    return done;
+}
+
+size_t spsc_pop_n(spsc_ring_t* r, void* dst, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    size_t done = 0;
+    for (int seg = 0; seg < 2 && done < n; seg++) {
+        const void* p;
+        size_t k = spsc_pop_span(r, &p, n - done);
+        if (k == 0) break;
+        memcpy(d + done * r->esize, p, k * r->esize);
+        done += k;
+        spsc_pop_commit(r, k);
+    }
+    return done;
+}
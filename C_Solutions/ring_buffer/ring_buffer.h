@@ -0,0 +1,153 @@
+/* 无锁 SPSC 环形缓冲区 - 单生产者 (如 ISR) / 单消费者 (如主循环)
+ *
+ * - 容量必须是 2 的幂: 下标用掩码取模, 读写下标都是自由增长的计数器, 差值即元素个数, 不浪费槽位.
+ * - 生产者只写 head, 消费者只写 tail; 两者各占一条缓存行, 避免伪共享.
+ *   每一侧还缓存对方下标的旧值, 只有看起来满/空时才去读对方的缓存行.
+ * - 内存序: C11 <stdatomic.h> 可用时用 acquire/release, 否则用 GCC __atomic 内建函数.
+ * - 存储区由调用方提供 (静态数组), 不 malloc.
+ *
+ *   static uint8_t storage[256];
+ *   static spsc_ring_t rx;
+ *   spsc_init(&rx, storage, 256, 1);
+ *   // ISR:       spsc_push(&rx, &byte);
+ *   // 主循环:     while (spsc_pop(&rx, &byte) == 0) handle(byte);
+ *   // DMA 零拷贝: n = spsc_push_span(&rx, &p, want); dma_start(p, n); ... spsc_push_commit(&rx, n);
+ */
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef RB_CACHE_LINE
+#define RB_CACHE_LINE 64  /* 无数据缓存的 Cortex-M 可设为 2 * sizeof(size_t) 以节省 RAM */
+#endif
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+typedef atomic_size_t rb_index_t;
+#define RB_INIT(p, v)      atomic_init((p), (v))
+#define RB_LOAD_RLX(p)     atomic_load_explicit((p), memory_order_relaxed)
+#define RB_LOAD_ACQ(p)     atomic_load_explicit((p), memory_order_acquire)
+#define RB_STORE_REL(p, v) atomic_store_explicit((p), (v), memory_order_release)
+#elif defined(__GNUC__)
+typedef size_t rb_index_t;
+#define RB_INIT(p, v)      (*(p) = (v))
+#define RB_LOAD_RLX(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define RB_LOAD_ACQ(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RB_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#error "ring_buffer.h needs C11 atomics or GCC __atomic builtins"
+#endif
+
+/* 成员按缓存行对齐: 每组成员从新的一行开始, 编译器自动补齐, 结构体本身也随之按 RB_CACHE_LINE 对齐.
+ * (手工计算的 char pad[] 在 RB_CACHE_LINE 刚好等于两个下标大小时会变成长度为 0 的数组, 不是合法的 C) */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define RB_ALIGNED _Alignas(RB_CACHE_LINE)
+#elif defined(__GNUC__)
+#define RB_ALIGNED __attribute__((aligned(RB_CACHE_LINE)))
+#else
+#error "ring_buffer.h needs C11 _Alignas or GCC __attribute__((aligned))"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    /* 生产者缓存行 */
+    RB_ALIGNED rb_index_t head;  /* 下一个写入位置 (自由增长) */
+    size_t     tail_cache;       /* 生产者看到的 tail 旧值 */
+    /* 消费者缓存行 */
+    RB_ALIGNED rb_index_t tail;  /* 下一个读取位置 (自由增长) */
+    size_t     head_cache;       /* 消费者看到的 head 旧值 */
+    /* 初始化后只读, 单独一行: 两侧都会读, 不能与任何一侧的下标共享 */
+    RB_ALIGNED uint8_t* buf;
+    size_t     mask;             /* capacity - 1 */
+    size_t     esize;            /* 元素字节数 */
+} spsc_ring_t;
+
+/* capacity 必须是 2 的幂, storage 至少 capacity * esize 字节. 成功返回 0, 参数非法返回 -1 */
+int    spsc_init(spsc_ring_t* r, void* storage, size_t capacity, size_t esize);
+/* 批量拷贝版本, 内部最多两段 memcpy; 返回实际写入/读出的元素个数 */
+size_t spsc_push_n(spsc_ring_t* r, const void* src, size_t n);
+size_t spsc_pop_n(spsc_ring_t* r, void* dst, size_t n);
+
+static inline size_t spsc_capacity(const spsc_ring_t* r) { return r->mask + 1; }
+
+/* 当前元素个数 (另一侧并发修改时只是近似值) */
+static inline size_t spsc_size(spsc_ring_t* r) {
+    return RB_LOAD_ACQ(&r->head) - RB_LOAD_ACQ(&r->tail);
+}
+
+/* ---------------- 生产者侧 ---------------- */
+
+/* 可写的连续区间: *ptr 指向第一个空槽, 返回最多 want 个、不跨越缓冲区末尾的空槽数 */
+static inline size_t spsc_push_span(spsc_ring_t* r, void** ptr, size_t want) {
+    size_t head = RB_LOAD_RLX(&r->head);
+    size_t cap = r->mask + 1;
+    size_t free_n = cap - (head - r->tail_cache);
+    if (free_n < want) {
+        r->tail_cache = RB_LOAD_ACQ(&r->tail);  /* 看起来不够才刷新, 减少跨核缓存行访问 */
+        free_n = cap - (head - r->tail_cache);
+    }
+    size_t idx = head & r->mask;
+    size_t contig = cap - idx;
+    size_t n = want < free_n ? want : free_n;
+    if (n > contig) n = contig;
+    *ptr = r->buf + idx * r->esize;
+    return n;
+}
+
+/* 发布 n 个已写入 span 的元素: release 保证数据先于 head 对消费者可见 */
+static inline void spsc_push_commit(spsc_ring_t* r, size_t n) {
+    RB_STORE_REL(&r->head, RB_LOAD_RLX(&r->head) + n);
+}
+
+/* 写入一个元素, 满返回 -1 */
+static inline int spsc_push(spsc_ring_t* r, const void* elem) {
+    void* slot;
+    if (spsc_push_span(r, &slot, 1) == 0) return -1;
+    memcpy(slot, elem, r->esize);
+    spsc_push_commit(r, 1);
+    return 0;
+}
+
+/* ---------------- 消费者侧 ---------------- */
+
+/* 可读的连续区间: *ptr 指向最旧的元素, 返回最多 want 个、不跨越缓冲区末尾的元素数 */
+static inline size_t spsc_pop_span(spsc_ring_t* r, const void** ptr, size_t want) {
+    size_t tail = RB_LOAD_RLX(&r->tail);
+    size_t avail = r->head_cache - tail;
+    if (avail < want) {
+        r->head_cache = RB_LOAD_ACQ(&r->head);
+        avail = r->head_cache - tail;
+    }
+    size_t idx = tail & r->mask;
+    size_t contig = r->mask + 1 - idx;
+    size_t n = want < avail ? want : avail;
+    if (n > contig) n = contig;
+    *ptr = r->buf + idx * r->esize;
+    return n;
+}
+
+/* 归还 n 个已处理完的元素槽位给生产者 */
+static inline void spsc_pop_commit(spsc_ring_t* r, size_t n) {
+    RB_STORE_REL(&r->tail, RB_LOAD_RLX(&r->tail) + n);
+}
+
+/* 读出一个元素, 空返回 -1 */
+static inline int spsc_pop(spsc_ring_t* r, void* elem) {
+    const void* slot;
+    if (spsc_pop_span(r, &slot, 1) == 0) return -1;
+    memcpy(elem, slot, r->esize);
+    spsc_pop_commit(r, 1);
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RING_BUFFER_H */
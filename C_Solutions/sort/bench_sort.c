@@ -0,0 +1,283 @@
+/* 排序 / 查找内核测试: verifier.py 的四种分布 (random / sorted / reverse / few-unique) x 各种规模
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -I../../Templates sort.c sort_network.c search.c bench_sort.c \
+ *           ../../Templates/benchmark.c -o bench_sort -lm
+ * 排序网络走 AVX2: 加 -mavx2 (或 -march=native); 只测标量网络: 加 -DSORT_NO_SIMD.
+ *
+ * 每次迭代先把输入拷到工作区再排序, 拷贝本身的耗时见 "memcpy" 一行.
+ * 插入排序只测到 INSERTION_MAX_N; 规模 >= LARGE_N 时样本数降到 LARGE_SAMPLES, 否则 10^7 一档要跑几分钟.
+ * 查找: 每次迭代做 N_QUERIES 次 lower_bound, 键在数组取值范围内均匀分布.
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sort.h"
+
+#define MAX_N           10000000u
+#define INSERTION_MAX_N 4096u
+#define LARGE_N         1000000u
+#define LARGE_SAMPLES   3u
+#define N_QUERIES       1024u
+#define FEW_UNIQUE_K    16u       /* 与 verifier.py 相同 */
+
+/* 与 verifier.py 的分布同名 (随机数发生器不同, 数值不一样) */
+enum { DIST_RANDOM, DIST_SORTED, DIST_REVERSE, DIST_FEW_UNIQUE, N_DISTS };
+static const char* const g_dist_names[N_DISTS] = {"random", "sorted", "reverse", "few-unique"};
+
+static int32_t* g_in;
+static int32_t* g_work;
+static int32_t* g_tmp;            /* 基数排序的临时区 / Eytzinger 数组 (n + 1) */
+static uint64_t g_rng;
+
+static uint32_t rng_next(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return (uint32_t)(g_rng >> 32);
+}
+
+/* sorted: 把 32 位值域均分成 n 段, 第 i 个元素落在第 i 段, 非降序且不需要真的排一遍 */
+static void gen(int dist, int32_t* a, size_t n, uint64_t seed) {
+    g_rng = seed * 0x9E3779B97F4A7C15ull + 1;
+    uint64_t w = n ? ((uint64_t)1 << 32) / n : 0;
+    int32_t pool[FEW_UNIQUE_K];
+    for (unsigned k = 0; k < FEW_UNIQUE_K; k++) pool[k] = (int32_t)rng_next();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t r = rng_next();
+        switch (dist) {
+        case DIST_RANDOM:
+            a[i] = (int32_t)(uint32_t)r;
+            break;
+        case DIST_SORTED:
+        case DIST_REVERSE: {
+            size_t pos = dist == DIST_SORTED ? i : n - 1 - i;
+            a[i] = (int32_t)(uint32_t)((uint64_t)pos * w + (w ? r % w : 0) + 0x80000000u);
+            break;
+        }
+        default:
+            a[i] = pool[r % FEW_UNIQUE_K];
+            break;
+        }
+    }
+}
+
+/* ---------------- 被测内核 ---------------- */
+
+static int cmp_i32(const void* x, const void* y) {
+    int32_t a = *(const int32_t*)x, b = *(const int32_t*)y;
+    return (a > b) - (a < b);
+}
+
+static void run_qsort(int32_t* a, size_t n) { qsort(a, n, sizeof *a, cmp_i32); }
+static void run_radix(int32_t* a, size_t n) { sort_radix_i32(a, g_tmp, n); }
+static void run_copy(int32_t* a, size_t n) { (void)a; (void)n; }
+
+/* 独立的 16 元素块各自排序 (不是整体有序), 用来和插入排序比较叶子的代价 */
+static void run_blocks(int32_t* a, size_t n) {
+    size_t i = 0;
+    for (; i + SORT_NETWORK_MAX <= n; i += SORT_NETWORK_MAX) sort_bitonic16_i32(a + i);
+    sort_network_i32(a + i, n - i);
+}
+
+typedef struct {
+    const char* name;
+    void (*fn)(int32_t* a, size_t n);
+    size_t max_n;
+    int full;                     /* 0: 结果不是整体有序 (memcpy / 分块) */
+} sorter_t;
+
+static const sorter_t g_sorters[] = {
+    {"memcpy", run_copy, MAX_N, 0},
+    {"qsort", run_qsort, MAX_N, 1},
+    {"insertion", sort_insertion_i32, INSERTION_MAX_N, 1},
+    {"intro", sort_intro_i32, MAX_N, 1},
+    {"branchless", sort_branchless_i32, MAX_N, 1},
+    {"radix", run_radix, MAX_N, 1},
+    {"bitonic16 blocks", run_blocks, MAX_N, 0},
+};
+#define N_SORTERS (sizeof g_sorters / sizeof g_sorters[0])
+
+/* ---------------- 正确性 ---------------- */
+
+/* 与顺序无关的指纹: 排序前后必须一致 */
+static uint64_t multiset_hash(const int32_t* a, size_t n) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x = (uint64_t)(uint32_t)a[i] * 0x9E3779B97F4A7C15ull;
+        h += x ^ (x >> 29);
+    }
+    return h;
+}
+
+static int is_sorted(const int32_t* a, size_t n) {
+    for (size_t i = 1; i < n; i++)
+        if (a[i - 1] > a[i]) return 0;
+    return 1;
+}
+
+/* 小规模逐元素对比 qsort (含 0/1/2, 网络边界 15..17, 插入排序阈值附近), 每个分布几个种子;
+ * 再加上针对快排的输入: 全相等, 风琴管 (先升后降), 只有两种值 */
+static int self_check(void) {
+    static const size_t ns[] = {0, 1, 2, 3, 7, 15, 16, 17, 23, 24, 25, 31, 33, 64, 100, 257, 1000, 4096};
+    static int32_t ref[4096];
+    for (size_t t = 0; t < sizeof ns / sizeof ns[0]; t++) {
+        size_t n = ns[t];
+        for (int d = 0; d < N_DISTS + 3; d++) {
+            for (uint64_t seed = 1; seed <= 3; seed++) {
+                if (d < N_DISTS) {
+                    gen(d, g_in, n, seed);
+                } else {
+                    for (size_t i = 0; i < n; i++) {
+                        if (d == N_DISTS) g_in[i] = 7;
+                        else if (d == N_DISTS + 1) g_in[i] = (int32_t)(i < n / 2 ? i : n - i);
+                        else g_in[i] = (int32_t)((i * 7919u) & 1u) - 1;
+                    }
+                }
+                memcpy(ref, g_in, n * sizeof *ref);
+                run_qsort(ref, n);
+                for (size_t s = 0; s < N_SORTERS; s++) {
+                    if (!g_sorters[s].full) continue;
+                    memcpy(g_work, g_in, n * sizeof *g_work);
+                    g_sorters[s].fn(g_work, n);
+                    if (n > 0 && memcmp(g_work, ref, n * sizeof *ref) != 0) {
+                        fprintf(stderr, "%s: wrong result (n=%zu, input %d, seed %llu)\n", g_sorters[s].name, n, d,
+                                (unsigned long long)seed);
+                        return -1;
+                    }
+                }
+                if (n <= SORT_NETWORK_MAX) {
+                    memcpy(g_work, g_in, n * sizeof *g_work);
+                    sort_network_i32(g_work, n);
+                    if (n > 0 && memcmp(g_work, ref, n * sizeof *ref) != 0) {
+                        fprintf(stderr, "sort_network_i32: wrong result (n=%zu)\n", n);
+                        return -1;
+                    }
+                }
+                /* 查找: 数组里的每个值, 其左右相邻的值, 以及两端之外 */
+                search_eytzinger_build(ref, g_tmp, n);
+                for (size_t i = 0; i <= n; i++) {
+                    int32_t keys[3] = {INT32_MIN, INT32_MAX, INT32_MAX};
+                    if (i < n) {
+                        keys[0] = ref[i];
+                        keys[1] = ref[i] == INT32_MIN ? ref[i] : ref[i] - 1;
+                        keys[2] = ref[i] == INT32_MAX ? ref[i] : ref[i] + 1;
+                    }
+                    for (int q = 0; q < 3; q++) {
+                        size_t want = search_lower_bound_i32(ref, n, keys[q]);
+                        size_t e = search_eytzinger_i32(g_tmp, n, keys[q]);
+                        size_t lin = 0;
+                        while (lin < n && ref[lin] < keys[q]) lin++;
+                        if (want != lin || search_branchless_i32(ref, n, keys[q]) != lin ||
+                            (lin == n ? e != 0 : (e == 0 || g_tmp[e] != ref[lin]))) {
+                            fprintf(stderr, "search: wrong result (n=%zu, key %ld)\n", n, (long)keys[q]);
+                            return -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* ---------------- 测试 ---------------- */
+
+static size_t g_n;
+static const sorter_t* g_cur;
+
+static int bench_sorters(size_t n) {
+    char name[64];
+    for (int d = 0; d < N_DISTS; d++) {
+        gen(d, g_in, n, 42);
+        uint64_t h = multiset_hash(g_in, n);
+        for (size_t s = 0; s < N_SORTERS; s++) {
+            g_cur = &g_sorters[s];
+            if (n > g_cur->max_n) continue;
+            snprintf(name, sizeof name, "%s %s", g_cur->name, g_dist_names[d]);
+            bench_t b;
+            BENCH(b, name, {
+                memcpy(g_work, g_in, g_n * sizeof *g_work);
+                g_cur->fn(g_work, g_n);
+                BENCH_DO_NOT_OPTIMIZE(g_work[0]);
+            });
+            bench_set_size(&b, n, n * sizeof *g_in);
+            bench_report(&b);
+            if (multiset_hash(g_work, n) != h || (g_cur->full && !is_sorted(g_work, n))) {
+                fprintf(stderr, "MISMATCH: %s produced a wrong result at n=%zu\n", name, n);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int32_t g_queries[N_QUERIES];
+
+#define BENCH_SEARCH(label, expr)                                      \
+    {                                                                  \
+        bench_t b;                                                     \
+        BENCH(b, label, {                                              \
+            size_t acc = 0;                                            \
+            for (unsigned q = 0; q < N_QUERIES; q++) acc += (expr);    \
+            BENCH_DO_NOT_OPTIMIZE(acc);                                \
+        });                                                            \
+        bench_set_size(&b, n, 0);                                      \
+        bench_report(&b);                                              \
+    }
+
+static void bench_search(size_t n) {
+    gen(DIST_SORTED, g_in, n, 7);
+    search_eytzinger_build(g_in, g_tmp, n);
+    g_rng = 99;
+    for (unsigned q = 0; q < N_QUERIES; q++) g_queries[q] = (int32_t)rng_next();
+    BENCH_SEARCH("lower_bound x1024", search_lower_bound_i32(g_in, n, g_queries[q]));
+    BENCH_SEARCH("branchless x1024", search_branchless_i32(g_in, n, g_queries[q]));
+    BENCH_SEARCH("eytzinger x1024", search_eytzinger_i32(g_tmp, n, g_queries[q]));
+}
+
+static int alloc_buffers(size_t n) {
+    free(g_in);
+    free(g_work);
+    free(g_tmp);
+    g_in = malloc(n * sizeof *g_in);
+    g_work = malloc(n * sizeof *g_work);
+    g_tmp = malloc((n + 1) * sizeof *g_tmp);
+    return g_in && g_work && g_tmp ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    fprintf(stderr, "# sorting network: %s\n", sort_network_isa());
+    if (alloc_buffers(4096) != 0 || self_check() != 0) {
+        fprintf(stderr, "MISMATCH: sort/search self-check failed\n");
+        return 1;
+    }
+
+    static const size_t defaults[] = {16, 256, 4096, 65536, 1000000, 10000000};
+    const size_t* sizes;
+    size_t n_sizes = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    bench_config_t saved = bench_config;
+    for (size_t i = 0; i < n_sizes; i++) {
+        size_t n = sizes[i];
+        if (n == 0 || n > MAX_N) {
+            fprintf(stderr, "# skip size %zu: must be 1..%u\n", n, MAX_N);
+            continue;
+        }
+        if (alloc_buffers(n) != 0) {
+            fprintf(stderr, "# skip size %zu: out of memory\n", n);
+            continue;
+        }
+        bench_config = saved;
+        if (n >= LARGE_N) {
+            bench_config.samples = LARGE_SAMPLES;
+            bench_config.warmup = 1;
+        }
+        if (n > INSERTION_MAX_N) fprintf(stderr, "# n=%zu: insertion sort skipped (O(n^2))\n", n);
+        g_n = n;
+        if (bench_sorters(n) != 0) return 1;
+        bench_search(n);
+    }
+    bench_config = saved;
+    return bench_summary();
+}
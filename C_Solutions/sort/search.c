@@ -0,0 +1,60 @@
+/* 有序数组上的 lower_bound: 有分支 / 无分支 / Eytzinger 布局 */
+#include "sort.h"
+
+#include "bitops.h"
+
+/* Eytzinger 查找时预取 4 层之后的节点: 第 k 个节点往下 4 层的 16 个后代正好连续,
+ * 16 个 int32_t = 一条 64 字节缓存行 */
+#define EYT_PREFETCH_LEVELS 4u
+#if defined(__GNUC__)
+#define EYT_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define EYT_PREFETCH(p) ((void)0)
+#endif
+
+size_t search_lower_bound_i32(const int32_t* a, size_t n, int32_t key) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* 每步区间长度减半, 只移动起点: 三目运算编译成条件传送, 循环次数固定为 ceil(log2 n) */
+size_t search_branchless_i32(const int32_t* a, size_t n, int32_t key) {
+    if (n == 0) return 0;
+    const int32_t* base = a;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = base[half] < key ? base + half : base;
+        n -= half;
+    }
+    return (size_t)(base - a) + (size_t)(*base < key);
+}
+
+/* 中序遍历完全二叉树 (节点 k 的孩子是 2k, 2k + 1), 依次填入有序元素; 递归深度 log2 n */
+static size_t eyt_fill(const int32_t* a, int32_t* e, size_t n, size_t i, size_t k) {
+    if (k <= n) {
+        i = eyt_fill(a, e, n, i, 2 * k);
+        e[k] = a[i++];
+        i = eyt_fill(a, e, n, i, 2 * k + 1);
+    }
+    return i;
+}
+
+void search_eytzinger_build(const int32_t* a, int32_t* e, size_t n) { eyt_fill(a, e, n, 0, 1); }
+
+/* 一路向下走到叶子以外: 向右走的步在 k 中记为 1. 结果是最后一次向左走之前的那个节点,
+ * 即去掉 k 末尾连续的 1 再去掉一位 */
+size_t search_eytzinger_i32(const int32_t* e, size_t n, int32_t key) {
+    size_t k = 1;
+    while (k <= n) {
+        /* 越过数组末尾的预取不会出错, 按整数算地址以免构造越界指针 */
+        EYT_PREFETCH((const void*)((uintptr_t)e + (k << EYT_PREFETCH_LEVELS) * sizeof *e));
+        k = 2 * k + (size_t)(e[k] < key);
+    }
+    k >>= bit_ctz64(~(uint64_t)k) + 1u;
+    return k;
+}
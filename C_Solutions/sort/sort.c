@@ -0,0 +1,207 @@
+/* 比较排序 (插入 / introsort / 无分支分区快排) 与 LSD 基数排序 */
+#include "sort.h"
+
+#include <string.h>
+
+#define SWAP_I32(x, y) do { int32_t t_ = (x); (x) = (y); (y) = t_; } while (0)
+
+/* 递归深度上限 2 * floor(log2 n), 超过说明分区持续失衡 (被构造的输入), 改用堆排序 */
+static int depth_limit(size_t n) {
+    int d = 0;
+    while (n > 1) {
+        n >>= 1;
+        d += 2;
+    }
+    return d;
+}
+
+void sort_insertion_i32(int32_t* a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int32_t x = a[i];
+        size_t j = i;
+        while (j > 0 && a[j - 1] > x) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = x;
+    }
+}
+
+/* ---------------- 堆排序 (introsort 的退路) ---------------- */
+
+static void sift_down(int32_t* a, size_t i, size_t n) {
+    int32_t x = a[i];
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) break;
+        if (c + 1 < n && a[c + 1] > a[c]) c++;
+        if (a[c] <= x) break;
+        a[i] = a[c];
+        i = c;
+    }
+    a[i] = x;
+}
+
+static void heap_sort(int32_t* a, size_t n) {
+    for (size_t i = n / 2; i-- > 0;) sift_down(a, i, n);
+    for (size_t i = n; i-- > 1;) {
+        SWAP_I32(a[0], a[i]);
+        sift_down(a, 0, i);
+    }
+}
+
+/* a[n/4], a[n/2], a[3n/4] 的中位数换到 a[0] 作为主元. 不取两端: 分区后主元换走的那个元素
+ * 留在子区间开头 (Lomuto 还会把右半部分轮转一位), 有序输入上取两端会选到次大值而退化 */
+static void pivot_to_front(int32_t* a, size_t n) {
+    size_t x = n / 4, m = n / 2, y = n - n / 4 - 1;
+    if (a[m] < a[x]) SWAP_I32(a[m], a[x]);
+    if (a[y] < a[m]) {
+        SWAP_I32(a[y], a[m]);
+        if (a[m] < a[x]) SWAP_I32(a[m], a[x]);
+    }
+    SWAP_I32(a[0], a[m]);
+}
+
+/* ---------------- introsort ---------------- */
+
+/* Hoare 分区, 主元在 a[0]: 返回 j, [0, j] <= p <= [j + 1, n), 且两边都不空.
+ * 与主元相等的键两边都会停下来交换, 所以大量重复键时仍然对半分 */
+static size_t hoare_partition(int32_t* a, size_t n) {
+    int32_t p = a[0];
+    size_t i = 0, j = n;
+    for (;;) {
+        do i++; while (i < n && a[i] < p);  /* 主元不一定是最大值, 右端没有哨兵 */
+        do j--; while (a[j] > p);
+        if (i >= j) return j;
+        SWAP_I32(a[i], a[j]);
+    }
+}
+
+static void intro_loop(int32_t* a, size_t n, int depth) {
+    while (n > SORT_INSERTION_CUTOFF) {
+        if (depth-- == 0) {
+            heap_sort(a, n);
+            return;
+        }
+        pivot_to_front(a, n);
+        size_t j = hoare_partition(a, n) + 1;
+        /* 递归较短的一边, 较长的一边循环处理: 栈深度 O(log n) */
+        if (j < n - j) {
+            intro_loop(a, j, depth);
+            a += j;
+            n -= j;
+        } else {
+            intro_loop(a + j, n - j, depth);
+            n = j;
+        }
+    }
+    sort_insertion_i32(a, n);
+}
+
+void sort_intro_i32(int32_t* a, size_t n) {
+    if (n > 1) intro_loop(a, n, depth_limit(n));
+}
+
+/* ---------------- 无分支分区快排 ---------------- */
+
+/* Lomuto 分区, 主元在 a[0]. 每个元素都无条件写两次, 只有下标按比较结果前进:
+ * 循环体里没有依赖数据的分支. le 非 0 时按 <= 分 (键与主元相等的都归到左边).
+ * 返回左半部分的长度 (不含主元), 主元最终位于 a[返回值] */
+static size_t lomuto_branchless(int32_t* a, size_t n, int le) {
+    int32_t p = a[0];
+    size_t lt = 1;
+    if (le) {
+        for (size_t i = 1; i < n; i++) {
+            int32_t x = a[i];
+            a[i] = a[lt];
+            a[lt] = x;
+            lt += (size_t)(x <= p);
+        }
+    } else {
+        for (size_t i = 1; i < n; i++) {
+            int32_t x = a[i];
+            a[i] = a[lt];
+            a[lt] = x;
+            lt += (size_t)(x < p);
+        }
+    }
+    SWAP_I32(a[0], a[lt - 1]);
+    return lt - 1;
+}
+
+/* pred 非 NULL 时是本区间左边相邻的元素 (上一层的主元或其左侧), 它 <= 区间内所有键.
+ * 主元等于 *pred 说明区间里有一串与它相等的键: 按 <= 分区后左边全是等值, 不必再排 (pdqsort) */
+static void branchless_loop(int32_t* a, size_t n, const int32_t* pred, int depth) {
+    while (n > SORT_NETWORK_MAX) {
+        if (depth-- == 0) {
+            heap_sort(a, n);
+            return;
+        }
+        pivot_to_front(a, n);
+        if (pred != NULL && *pred == a[0]) {
+            size_t m = lomuto_branchless(a, n, 1) + 1;
+            pred = &a[m - 1];
+            a += m;
+            n -= m;
+            continue;
+        }
+        size_t m = lomuto_branchless(a, n, 0);
+        if (m < n - m - 1) {
+            branchless_loop(a, m, pred, depth);
+            pred = &a[m];
+            a += m + 1;
+            n -= m + 1;
+        } else {
+            branchless_loop(a + m + 1, n - m - 1, &a[m], depth);
+            n = m;
+        }
+    }
+    sort_network_i32(a, n);
+}
+
+void sort_branchless_i32(int32_t* a, size_t n) {
+    if (n > 1) branchless_loop(a, n, NULL, depth_limit(n));
+}
+
+/* ---------------- LSD 基数排序 ---------------- */
+
+#define RADIX_BITS    8u
+#define RADIX_BUCKETS (1u << RADIX_BITS)
+#define RADIX_PASSES  4u
+
+/* 翻转符号位后按无符号比较, 负数排在前面 */
+static inline uint32_t radix_key(int32_t x) { return (uint32_t)x ^ 0x80000000u; }
+
+void sort_radix_i32(int32_t* a, int32_t* tmp, size_t n) {
+    if (n < 2) return;
+    size_t count[RADIX_PASSES][RADIX_BUCKETS] = {{0}};  /* 栈上 4 KB (32 位) / 8 KB (64 位) */
+    for (size_t i = 0; i < n; i++) {
+        uint32_t k = radix_key(a[i]);
+        count[0][k & 0xFFu]++;
+        count[1][(k >> 8) & 0xFFu]++;
+        count[2][(k >> 16) & 0xFFu]++;
+        count[3][k >> 24]++;
+    }
+
+    int32_t* src = a;
+    int32_t* dst = tmp;
+    for (unsigned pass = 0; pass < RADIX_PASSES; pass++) {
+        size_t* c = count[pass];
+        unsigned shift = pass * RADIX_BITS;
+        if (c[(radix_key(src[0]) >> shift) & 0xFFu] == n) continue;  /* 这一位全都一样 */
+        size_t sum = 0;
+        for (unsigned d = 0; d < RADIX_BUCKETS; d++) {
+            size_t t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        for (size_t i = 0; i < n; i++) {
+            int32_t x = src[i];
+            dst[c[(radix_key(x) >> shift) & 0xFFu]++] = x;
+        }
+        int32_t* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != a) memcpy(a, src, n * sizeof *a);
+}
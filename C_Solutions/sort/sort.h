@@ -0,0 +1,69 @@
+/* 排序与查找内核 (int32_t): 插入排序, introsort, 无分支分区快排, LSD 基数排序,
+ * 16 元素双调排序网络 (AVX2 / NEON / 标量), 以及有分支 / 无分支 / Eytzinger 布局的二分查找
+ *
+ *   sort_insertion_i32    小数组 / 近乎有序时最快, O(n^2), 稳定
+ *   sort_intro_i32        三数取中 + Hoare 分区, 递归过深改堆排序, 小区间插入排序; O(n log n) 最坏
+ *   sort_branchless_i32   无分支 Lomuto 分区 (比较结果直接加到下标上, 编译成 setcc/cmov),
+ *                         随机数据上没有分支预测失败; 重复键按 pdqsort 的办法一次分完; 叶子用排序网络
+ *   sort_radix_i32        LSD 基数排序, 每趟 8 位共 4 趟, 一次扫描建好全部直方图,
+ *                         某一位上所有键都相同的那趟直接跳过; 需要 n 个元素的临时缓冲区, 稳定
+ *   sort_network_i32      n <= SORT_NETWORK_MAX 的排序网络, 比较序列与数据无关
+ *
+ * 不分配内存, 除 sort_radix_i32 的 tmp 外都是原地排序, 所有递归深度 O(log n).
+ *
+ * SIMD 路径在编译期选择 (x86 加 -mavx2, AArch64 默认带 NEON), -DSORT_NO_SIMD 强制走标量网络.
+ *
+ * 查找: 都返回第一个 >= key 的位置 (lower_bound).
+ *   search_lower_bound_i32      教科书式二分, 每步一个难以预测的分支
+ *   search_branchless_i32       长度折半, 每步一次条件传送, 步数只取决于 n
+ *   search_eytzinger_i32        数组按 BFS 顺序 (堆序) 重排后查找, 前几层常驻缓存, 可以预取
+ *                               下面几层; 需要先 search_eytzinger_build 并保存 n + 1 个元素
+ */
+#ifndef SORT_H
+#define SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SORT_NETWORK_MAX     16u   /* 排序网络一次处理的元素个数 */
+#define SORT_INSERTION_CUTOFF 24u  /* introsort 的小区间改用插入排序 */
+
+#if !defined(SORT_NO_SIMD) && defined(__AVX2__)
+#define SORT_SIMD_AVX2 1
+#elif !defined(SORT_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SORT_SIMD_NEON 1
+#endif
+
+void sort_insertion_i32(int32_t* a, size_t n);
+void sort_intro_i32(int32_t* a, size_t n);
+void sort_branchless_i32(int32_t* a, size_t n);
+/* tmp 至少 n 个元素, 返回时内容未定义 */
+void sort_radix_i32(int32_t* a, int32_t* tmp, size_t n);
+
+/* 原地排好 v[0..15] */
+void sort_bitonic16_i32(int32_t v[SORT_NETWORK_MAX]);
+/* n <= SORT_NETWORK_MAX, 不足 16 个时用 INT32_MAX 补齐后走同一个网络 */
+void sort_network_i32(int32_t* a, size_t n);
+
+/* 当前 SIMD 路径的名字: "avx2" / "neon" / "scalar" */
+const char* sort_network_isa(void);
+
+/* ---------------- 查找 (a 非降序) ---------------- */
+
+size_t search_lower_bound_i32(const int32_t* a, size_t n, int32_t key);
+size_t search_branchless_i32(const int32_t* a, size_t n, int32_t key);
+
+/* 把有序数组 a[0..n) 按 Eytzinger 顺序写到 e[1..n] (e[0] 不用) */
+void search_eytzinger_build(const int32_t* a, int32_t* e, size_t n);
+/* 返回 e 中第一个 >= key 的下标 (1..n), 所有元素都 < key 时返回 0 */
+size_t search_eytzinger_i32(const int32_t* e, size_t n, int32_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SORT_H */
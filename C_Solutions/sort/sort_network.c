@@ -0,0 +1,174 @@
+/* 16 元素双调排序网络: 4 个阶段共 10 层比较-交换, 每层对所有元素同时做 min/max
+ *
+ * 元素 i 在第 (k, j) 层与 i ^ j 比较; (i & k) == 0 的一组升序, 其余降序, 所以
+ * 元素 i 取 max 当且仅当 ((i & j) != 0) != ((i & k) != 0). 下面 SIMD 版本的混合掩码
+ * 就是这个式子按寄存器逐位算出来的常量.
+ *   AVX2: 两个 __m256i, 层内伙伴用 shuffle / permute2x128 取得, blend 选 min 或 max
+ *   NEON: 四个 int32x4_t, j >= 4 的层在寄存器之间做, j = 2 / 1 用 vext / vrev64 取伙伴
+ */
+#include "sort.h"
+
+#if defined(SORT_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(SORT_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(SORT_SIMD_AVX2)
+
+/* 寄存器内一层: partner 是伙伴排列, imm 的第 l 位为 1 表示该通道取 max */
+#define NET_LAYER(v, partner, imm)                                           \
+    do {                                                                     \
+        __m256i p_ = (partner);                                              \
+        (v) = _mm256_blend_epi32(_mm256_min_epi32((v), p_), _mm256_max_epi32((v), p_), (imm)); \
+    } while (0)
+#define PARTNER1(v) _mm256_shuffle_epi32((v), _MM_SHUFFLE(2, 3, 0, 1))
+#define PARTNER2(v) _mm256_shuffle_epi32((v), _MM_SHUFFLE(1, 0, 3, 2))
+#define PARTNER4(v) _mm256_permute2x128_si256((v), (v), 0x01)
+
+void sort_bitonic16_i32(int32_t v[SORT_NETWORK_MAX]) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)v);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(v + 8));
+    /* k = 2 */
+    NET_LAYER(a, PARTNER1(a), 0x66);
+    NET_LAYER(b, PARTNER1(b), 0x66);
+    /* k = 4 */
+    NET_LAYER(a, PARTNER2(a), 0x3C);
+    NET_LAYER(b, PARTNER2(b), 0x3C);
+    NET_LAYER(a, PARTNER1(a), 0x5A);
+    NET_LAYER(b, PARTNER1(b), 0x5A);
+    /* k = 8: a 升序, b 降序 */
+    NET_LAYER(a, PARTNER4(a), 0xF0);
+    NET_LAYER(b, PARTNER4(b), 0x0F);
+    NET_LAYER(a, PARTNER2(a), 0xCC);
+    NET_LAYER(b, PARTNER2(b), 0x33);
+    NET_LAYER(a, PARTNER1(a), 0xAA);
+    NET_LAYER(b, PARTNER1(b), 0x55);
+    /* k = 16: 先在两个寄存器之间, 再各自在寄存器内 */
+    __m256i lo = _mm256_min_epi32(a, b);
+    b = _mm256_max_epi32(a, b);
+    a = lo;
+    NET_LAYER(a, PARTNER4(a), 0xF0);
+    NET_LAYER(b, PARTNER4(b), 0xF0);
+    NET_LAYER(a, PARTNER2(a), 0xCC);
+    NET_LAYER(b, PARTNER2(b), 0xCC);
+    NET_LAYER(a, PARTNER1(a), 0xAA);
+    NET_LAYER(b, PARTNER1(b), 0xAA);
+    _mm256_storeu_si256((__m256i*)v, a);
+    _mm256_storeu_si256((__m256i*)(v + 8), b);
+}
+
+const char* sort_network_isa(void) { return "avx2"; }
+
+#elif defined(SORT_SIMD_NEON)
+
+/* 寄存器内一层: mask 通道全 1 表示取 max */
+static inline int32x4_t net_layer(int32x4_t v, int32x4_t p, uint32x4_t take_max) {
+    return vbslq_s32(take_max, vmaxq_s32(v, p), vminq_s32(v, p));
+}
+#define PARTNER1(v) vrev64q_s32(v)
+#define PARTNER2(v) vextq_s32((v), (v), 2)
+
+/* 寄存器之间一层: x 取 min, y 取 max */
+#define NET_CROSS(x, y)                   \
+    do {                                  \
+        int32x4_t lo_ = vminq_s32(x, y);  \
+        (y) = vmaxq_s32(x, y);            \
+        (x) = lo_;                        \
+    } while (0)
+
+static const uint32_t g_masks[5][4] = {
+    {0, ~0u, ~0u, 0},    /* 0110 */
+    {0, 0, ~0u, ~0u},    /* 0011 */
+    {~0u, ~0u, 0, 0},    /* 1100 */
+    {0, ~0u, 0, ~0u},    /* 0101 */
+    {~0u, 0, ~0u, 0},    /* 1010 */
+};
+
+void sort_bitonic16_i32(int32_t v[SORT_NETWORK_MAX]) {
+    const uint32x4_t m0110 = vld1q_u32(g_masks[0]), m0011 = vld1q_u32(g_masks[1]);
+    const uint32x4_t m1100 = vld1q_u32(g_masks[2]), m0101 = vld1q_u32(g_masks[3]);
+    const uint32x4_t m1010 = vld1q_u32(g_masks[4]);
+    int32x4_t q0 = vld1q_s32(v), q1 = vld1q_s32(v + 4), q2 = vld1q_s32(v + 8), q3 = vld1q_s32(v + 12);
+    /* k = 2 */
+    q0 = net_layer(q0, PARTNER1(q0), m0110);
+    q1 = net_layer(q1, PARTNER1(q1), m0110);
+    q2 = net_layer(q2, PARTNER1(q2), m0110);
+    q3 = net_layer(q3, PARTNER1(q3), m0110);
+    /* k = 4: 偶数号寄存器升序, 奇数号降序 */
+    q0 = net_layer(q0, PARTNER2(q0), m0011);
+    q1 = net_layer(q1, PARTNER2(q1), m1100);
+    q2 = net_layer(q2, PARTNER2(q2), m0011);
+    q3 = net_layer(q3, PARTNER2(q3), m1100);
+    q0 = net_layer(q0, PARTNER1(q0), m0101);
+    q1 = net_layer(q1, PARTNER1(q1), m1010);
+    q2 = net_layer(q2, PARTNER1(q2), m0101);
+    q3 = net_layer(q3, PARTNER1(q3), m1010);
+    /* k = 8: q0/q1 升序, q2/q3 降序 */
+    NET_CROSS(q0, q1);
+    NET_CROSS(q3, q2);
+    q0 = net_layer(q0, PARTNER2(q0), m0011);
+    q1 = net_layer(q1, PARTNER2(q1), m0011);
+    q2 = net_layer(q2, PARTNER2(q2), m1100);
+    q3 = net_layer(q3, PARTNER2(q3), m1100);
+    q0 = net_layer(q0, PARTNER1(q0), m0101);
+    q1 = net_layer(q1, PARTNER1(q1), m0101);
+    q2 = net_layer(q2, PARTNER1(q2), m1010);
+    q3 = net_layer(q3, PARTNER1(q3), m1010);
+    /* k = 16: 全部升序 */
+    NET_CROSS(q0, q2);
+    NET_CROSS(q1, q3);
+    NET_CROSS(q0, q1);
+    NET_CROSS(q2, q3);
+    q0 = net_layer(q0, PARTNER2(q0), m0011);
+    q1 = net_layer(q1, PARTNER2(q1), m0011);
+    q2 = net_layer(q2, PARTNER2(q2), m0011);
+    q3 = net_layer(q3, PARTNER2(q3), m0011);
+    q0 = net_layer(q0, PARTNER1(q0), m0101);
+    q1 = net_layer(q1, PARTNER1(q1), m0101);
+    q2 = net_layer(q2, PARTNER1(q2), m0101);
+    q3 = net_layer(q3, PARTNER1(q3), m0101);
+    vst1q_s32(v, q0);
+    vst1q_s32(v + 4, q1);
+    vst1q_s32(v + 8, q2);
+    vst1q_s32(v + 12, q3);
+}
+
+const char* sort_network_isa(void) { return "neon"; }
+
+#else
+
+/* 标量: 同一个网络, 比较-交换编译成 min/max (cmov), 依然没有依赖数据的分支 */
+void sort_bitonic16_i32(int32_t v[SORT_NETWORK_MAX]) {
+    for (unsigned k = 2; k <= SORT_NETWORK_MAX; k <<= 1) {
+        for (unsigned j = k >> 1; j > 0; j >>= 1) {
+            for (unsigned i = 0; i < SORT_NETWORK_MAX; i++) {
+                unsigned p = i ^ j;
+                if (p < i) continue;
+                int32_t x = v[i], y = v[p];
+                int32_t lo = x < y ? x : y, hi = x < y ? y : x;
+                int up = (i & k) == 0;
+                v[i] = up ? lo : hi;
+                v[p] = up ? hi : lo;
+            }
+        }
+    }
+}
+
+const char* sort_network_isa(void) { return "scalar"; }
+
+#endif
+
+void sort_network_i32(int32_t* a, size_t n) {
+    if (n < 2) return;
+    if (n == SORT_NETWORK_MAX) {
+        sort_bitonic16_i32(a);
+        return;
+    }
+    int32_t v[SORT_NETWORK_MAX];
+    size_t i = 0;
+    for (; i < n; i++) v[i] = a[i];
+    for (; i < SORT_NETWORK_MAX; i++) v[i] = INT32_MAX;  /* 补齐的最大值都排到末尾 */
+    sort_bitonic16_i32(v);
+    for (i = 0; i < n; i++) a[i] = v[i];
+}
@@ -1,8 +1,11 @@
-#include <iostream>
-using namespace std;
+/* 刷题 IO 模板 - 编译: g++ -O2 -std=c++17 acm_io.cpp
+ *                 (多核评测机上的长输入: g++ -O2 -std=c++17 -DACM_IO_ASYNC -pthread acm_io.cpp) */
+#include "acm_io.hpp"
+
 int main() {
-    ios::sync_with_stdio(0); cin.tie(0);
+    static FastReader in;   // 64 KB 缓冲, 放静态区而不是栈上
+    static FastWriter out;  // 析构时自动 flush
     int n;
-    if(cin >> n) cout << "Input: " << n << endl;
+    if (in.read(n)) out << "Input: " << n << '\n';
     return 0;
 }
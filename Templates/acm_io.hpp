@@ -0,0 +1,674 @@
+/* 刷题 IO 模板 - 块读取快速输入 / 缓冲输出 (C++17)
+ *
+ * 不经过 iostream/stdio: 输入用 read(2) 按 64 KB 块读入, 在缓冲区内原地解析, 不分配内存;
+ * 输出先攒在缓冲区里, 满了或析构时一次 write(2), 整数自己转换, 不走 printf.
+ * 输入重定向自普通文件时 (./a.out < in.txt) 整个文件 mmap 进来原地解析, 省掉拷贝到缓冲区的开销;
+ * 管道/终端或映射失败时自动退回 read(2) (-DACM_IO_NO_MMAP 关闭). 注意映射过的页会计入 RSS,
+ * 按 RSS 限制内存的评测机上, 输入文件接近内存上限时应关闭.
+ *
+ *   static FastReader in;
+ *   static FastWriter out;
+ *   int n = in.read<int>();
+ *   out << n << '\n';                 // 不要用 endl, 每行 flush 会抵消缓冲的意义
+ *
+ * 异步流水线 (-DACM_IO_ASYNC, 需 -pthread, 默认关闭): 非 mmap 输入 (管道 / 终端) 由后台线程预读 kSlots 块,
+ * 解析线程 refill 时只做一次 memcpy, read(2) 的等待与拷贝和解析重叠; FastWriter 双缓冲, 一块写满后交给
+ * 后台线程 write(2), 同时继续填另一块. mmap 的输入靠内核预读 (MADV_SEQUENTIAL), 不另开线程.
+ * 评测机只给单核或禁止线程时不要打开.
+ *
+ * 数字转换的加速路径 (均可关闭):
+ *   SWAR  小端机器上每次把 8 个数字字符当作一个 uint64 转换 (-DACM_IO_NO_SWAR 关闭)
+ *   SIMD  read_array() 用 AVX2 / AArch64 NEON 一次找出 32 字节内的所有分隔符,
+ *         再按已知长度批量转换 (-DACM_IO_NO_SIMD 关闭; x86 需 -mavx2)
+ */
+#ifndef ACM_IO_HPP
+#define ACM_IO_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include <cerrno>
+#include <unistd.h>
+
+#ifdef ACM_IO_ASYNC
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <poll.h>
+#endif
+
+#if !defined(ACM_IO_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define ACM_IO_MMAP 1
+#endif
+
+#if !defined(ACM_IO_NO_SWAR) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ACM_IO_SWAR 1
+#endif
+
+#if !defined(ACM_IO_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define ACM_IO_SIMD 1
+#elif !defined(ACM_IO_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ACM_IO_SIMD 1
+#endif
+
+namespace acm_io_detail {
+
+inline uint64_t load8(const char* p) {
+    uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// 8 个字节是否全是 '0'..'9': 高半字节必须为 3, 且加 6 后不进位到高半字节
+inline bool is_eight_digits(uint64_t w) {
+    return ((w & 0xF0F0F0F0F0F0F0F0ull) | (((w + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+// 把 8 个数字字符 (小端载入) 转成整数: 相邻两位 -> 两位数 -> 四位数 -> 八位数, 共 3 次乘法
+inline uint32_t parse_eight_digits(uint64_t w) {
+    const uint64_t mask = 0x000000FF000000FFull;
+    const uint64_t mul1 = 100 + (1000000ull << 32);
+    const uint64_t mul2 = 1 + (10000ull << 32);
+    w -= 0x3030303030303030ull;
+    w = (w * 10) + (w >> 8);
+    w = (((w & mask) * mul1) + (((w >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(w);
+}
+
+#ifdef ACM_IO_SIMD
+// 32 字节窗口的非空白掩码: 第 j 位为 1 表示 p[j] > ' '
+inline uint32_t nonspace_mask32(const char* p) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(' '))));
+#else
+    // NEON 没有 movemask: 每字节与各自的位权相与, 再横向求和得到 16 位掩码
+    static const uint8_t kBitWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weights = vld1q_u8(kBitWeights);
+    const uint8x16_t space = vdupq_n_u8(' ');
+    uint32_t mask = 0;
+    for (int half = 0; half < 2; half++) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16 * half));
+        uint8x16_t m = vandq_u8(vcgtq_u8(v, space), weights);
+        uint32_t bits = vaddv_u8(vget_low_u8(m)) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(m))) << 8);
+        mask |= bits << (16 * half);
+    }
+    return mask;
+#endif
+}
+#endif
+
+// 写完 [p, p + n); 出错 (对端关闭等) 时放弃剩余部分
+inline void write_all(int fd, const char* p, size_t n) {
+    size_t done = 0;
+    while (done < n) {
+        ssize_t k = ::write(fd, p + done, n - done);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        done += static_cast<size_t>(k);
+    }
+}
+
+#ifdef ACM_IO_ASYNC
+// 预读线程: 环形的 kSlots 个块, 每块一次 read(2) (拿到多少算多少, 交互题不会等满一块).
+// 块在读线程与解析线程之间只靠 w_ / r_ 交接, 拷贝都在锁外.
+class ReadAhead {
+public:
+    static constexpr size_t kBlock = 1 << 16;
+    static constexpr unsigned kSlots = 4;
+
+    explicit ReadAhead(int fd) : fd_(fd), thread_([this] { run(); }) {}
+    ReadAhead(const ReadAhead&) = delete;
+    ReadAhead& operator=(const ReadAhead&) = delete;
+    ~ReadAhead() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    // 拷出最多 cap 字节: 至少等到一块 (或 EOF), 之后只取已经读好的块, 不再等待. EOF 返回 0
+    size_t take(char* dst, size_t cap) {
+        size_t got = 0;
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] { return w_ != r_ || done_; });
+        while (got < cap && w_ != r_) {
+            Slot& s = slots_[r_ % kSlots];
+            lk.unlock();
+            size_t n = s.len - s.off < cap - got ? s.len - s.off : cap - got;
+            std::memcpy(dst + got, s.data + s.off, n);
+            s.off += n;
+            got += n;
+            lk.lock();
+            if (s.off == s.len) {
+                r_++;
+                cv_.notify_all();
+            }
+        }
+        return got;
+    }
+
+private:
+    struct Slot {
+        size_t len = 0;
+        size_t off = 0;
+        char data[kBlock];
+    };
+
+    void run() {
+        std::unique_lock<std::mutex> lk(mu_);
+        for (;;) {
+            cv_.wait(lk, [&] { return stop_ || w_ - r_ < kSlots; });
+            if (stop_) return;
+            Slot& s = slots_[w_ % kSlots];
+            lk.unlock();
+            ssize_t n = read_block(s.data);
+            lk.lock();
+            if (n <= 0) {
+                done_ = true;
+                cv_.notify_all();
+                return;
+            }
+            s.len = static_cast<size_t>(n);
+            s.off = 0;
+            w_++;
+            cv_.notify_all();
+        }
+    }
+
+    // 先 poll 再 read: 输入迟迟不来时 (终端, 程序提前结束) 析构函数最多等一个 poll 周期, 不会卡在 read 里
+    ssize_t read_block(char* p) {
+        for (;;) {
+            pollfd pfd = {fd_, POLLIN, 0};
+            int r = ::poll(&pfd, 1, 50);
+            if (stop_requested()) return -1;
+            if (r == 0 || (r < 0 && errno == EINTR)) continue;
+            ssize_t n = ::read(fd_, p, kBlock);
+            if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            return n;
+        }
+    }
+
+    bool stop_requested() {
+        std::lock_guard<std::mutex> lk(mu_);
+        return stop_;
+    }
+
+    int fd_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    unsigned w_ = 0;  // 已读好的块数 (读线程写)
+    unsigned r_ = 0;  // 已用完的块数 (解析线程写)
+    bool done_ = false;
+    bool stop_ = false;
+    Slot slots_[kSlots];
+    std::thread thread_;  // 最后初始化: 线程启动时其余成员都已就绪
+};
+
+// 写线程: 一次只持有一块; submit 在上一块写完之前阻塞, 所以调用方拿回的另一块总是空闲的
+class WriteBehind {
+public:
+    explicit WriteBehind(int fd) : fd_(fd), thread_([this] { run(); }) {}
+    WriteBehind(const WriteBehind&) = delete;
+    WriteBehind& operator=(const WriteBehind&) = delete;
+    ~WriteBehind() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();  // 先写完手上的块再退出
+    }
+
+    void submit(const char* p, size_t n) {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] { return p_ == nullptr; });
+        p_ = p;
+        n_ = n;
+        cv_.notify_all();
+    }
+
+    // 等到交出的块都已写出
+    void wait() {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] { return p_ == nullptr; });
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lk(mu_);
+        for (;;) {
+            cv_.wait(lk, [&] { return stop_ || p_ != nullptr; });
+            if (p_ == nullptr) return;
+            const char* p = p_;
+            size_t n = n_;
+            lk.unlock();
+            write_all(fd_, p, n);
+            lk.lock();
+            p_ = nullptr;
+            cv_.notify_all();
+        }
+    }
+
+    int fd_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    const char* p_ = nullptr;  // 正在写的块, nullptr 表示空闲
+    size_t n_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+};
+#endif
+
+}  // namespace acm_io_detail
+
+class FastReader {
+public:
+    static constexpr size_t kBufSize = 1 << 16;
+    static constexpr size_t kMaxNumber = 64;  // read_array 的 SIMD 窗口之后至少留这么多字节
+    static constexpr size_t kPad = 64;        // 末尾留白: 哨兵 + SWAR 越过哨兵的 8 字节读取
+
+    explicit FastReader(int fd = STDIN_FILENO) : fd_(fd), cur_(buf_), end_(buf_), buf_() {
+#ifdef ACM_IO_MMAP
+        map_input();
+#endif
+#ifdef ACM_IO_ASYNC
+        if (map_ == nullptr) ahead_ = std::make_unique<acm_io_detail::ReadAhead>(fd_);
+#endif
+    }
+    FastReader(const FastReader&) = delete;
+    FastReader& operator=(const FastReader&) = delete;
+    ~FastReader() {
+#ifdef ACM_IO_MMAP
+        if (map_ != nullptr) ::munmap(map_, map_len_);
+#endif
+    }
+
+    // 输入是否来自 mmap (否则是 read(2) 块读取)
+    bool mapped() const { return map_ != nullptr; }
+
+    // 读取一个值: 有符号/无符号整数, float/double, char (第一个非空白字符), std::string_view (token)
+    // 输入耗尽时返回 false, x 保持不变
+    template <class T>
+    bool read(T& x) {
+        static_assert(!std::is_same_v<T, bool>, "read<bool> is ambiguous");
+        if (!skip_space()) return false;
+        if constexpr (std::is_same_v<T, char>) {
+            x = *cur_++;
+        } else if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            if constexpr (std::is_signed_v<T>) {
+                bool neg = (*cur_ == '-');
+                cur_ += (neg || *cur_ == '+');  // 符号是缓冲区最后一个字节时, parse_digits 会先 refill
+                U v = parse_digits<U>();
+                x = static_cast<T>(neg ? U(0) - v : v);
+            } else {
+                cur_ += (*cur_ == '+');
+                x = parse_digits<U>();
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            std::string_view t = token();  // from_chars 要求整段连续: 跨块的 token 由 token() 拼好
+            const char* b = t.data() + (t[0] == '+');  // from_chars 不接受前导 '+'
+            std::from_chars(b, t.data() + t.size(), x);
+        } else {
+            static_assert(std::is_same_v<T, std::string_view>, "unsupported type for FastReader::read");
+            x = token();
+        }
+        return true;
+    }
+
+    template <class T>
+    T read() {
+        T x{};
+        read(x);
+        return x;
+    }
+
+    // 读取一个以空白分隔的 token. 返回的视图指向内部缓冲区, 下一次读取后失效;
+    // 超过 kBufSize 的 token 会被截断. (mmap 模式下视图一直有效到析构, 也没有长度限制.)
+    std::string_view token() {
+        if (!skip_space()) return {};
+        char* p = cur_;
+        for (;;) {
+            while (static_cast<unsigned char>(*p) > ' ') ++p;
+            if (p < end_ || eof_ || (cur_ == buf_ && end_ == buf_ + kBufSize)) break;
+            size_t off = static_cast<size_t>(p - cur_);
+            refill();  // token 跨越缓冲区末尾: 挪到开头后继续读
+            p = cur_ + off;
+        }
+        std::string_view tok(cur_, static_cast<size_t>(p - cur_));
+        cur_ = p;
+        return tok;
+    }
+
+    // 批量读取最多 n 个整数到调用方提供的 out, 返回实际读到的个数.
+    // SIMD 路径假定输入只含整数与 ASCII 空白.
+    template <class T>
+    size_t read_array(T* out, size_t n) {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "read_array needs an integer type");
+        size_t i = 0;
+#ifdef ACM_IO_SIMD
+        constexpr size_t kWin = 32;
+        while (i < n) {
+            ensure(kWin + kMaxNumber);
+            if (static_cast<size_t>(end_ - cur_) < kWin + kMaxNumber) break;  // 接近 EOF, 交给标量路径
+            uint32_t m = acm_io_detail::nonspace_mask32(cur_);
+            uint32_t starts = m & ~(m << 1);  // token 首字节
+            uint32_t ends = m & ~(m >> 1);    // token 末字节 (第 31 位可能还没结束)
+            size_t advance = kWin;
+            if ((m >> 31) && static_cast<unsigned char>(cur_[kWin]) > ' ') {
+                // 最后一个 token 跨出窗口: 留到下一轮, 下一轮窗口从它的首字节开始
+                unsigned last = 31u - static_cast<unsigned>(__builtin_clz(starts));
+                if (last == 0) {  // 单个 token 超过 32 字节 (前导零之类), 走标量
+                    read(out[i++]);
+                    continue;
+                }
+                starts &= ~(1u << last);
+                ends &= ~(1u << 31);
+                advance = last;
+            }
+            while (starts && i < n) {
+                unsigned b = static_cast<unsigned>(__builtin_ctz(starts));
+                unsigned e = static_cast<unsigned>(__builtin_ctz(ends));
+                out[i++] = parse_span<T>(cur_ + b, e - b + 1);
+                starts &= starts - 1;
+                ends &= ends - 1;
+                if (i == n) advance = e + 1;
+            }
+            cur_ += advance;
+        }
+#endif
+        for (; i < n && read(out[i]); ++i) {}
+        return i;
+    }
+
+    // 跳过空白后是否已没有任何输入
+    bool eof() { return !skip_space(); }
+
+private:
+#ifdef ACM_IO_MMAP
+    // 把文件从当前偏移到末尾整体映射, 成功后 [cur_, end_) 就是全部剩余输入, eof_ 直接置位, refill 不再调用.
+    // 映射是只读的: 解析路径本来就不写缓冲区, 只有 refill 会写哨兵.
+    void map_input() {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) return;
+        off_t pos = ::lseek(fd_, 0, SEEK_CUR);
+        if (pos < 0 || st.st_size <= pos) return;  // 空输入交给 read 路径, 第一次 refill 即 EOF
+        const uint64_t page = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+        const uint64_t start = static_cast<uint64_t>(pos) / page * page;  // mmap 的文件偏移必须按页对齐
+        const uint64_t file_len = static_cast<uint64_t>(st.st_size) - start;
+        if (file_len > SIZE_MAX - kPad - page) return;  // 32 位进程放不下, 退回 read
+        const size_t len = static_cast<size_t>((file_len + kPad + page - 1) / page * page);
+
+        // 哨兵和 SWAR/SIMD 越过末尾的读取需要 end_ 之后有 kPad 个 0 字节. 文件末页剩余部分内核会补 0,
+        // 但访问文件末页之后的映射页会 SIGBUS, 所以先占一段全 0 的匿名映射, 再把文件 MAP_FIXED 盖在开头.
+        void* base = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) return;
+        if (::mmap(base, static_cast<size_t>(file_len), PROT_READ, MAP_PRIVATE | MAP_FIXED, fd_,
+                   static_cast<off_t>(start)) == MAP_FAILED) {
+            ::munmap(base, len);
+            return;
+        }
+        ::madvise(base, static_cast<size_t>(file_len), MADV_SEQUENTIAL);  // 加大预读, 读过的页可尽早回收
+#ifdef MADV_HUGEPAGE
+        ::madvise(base, len, MADV_HUGEPAGE);  // 文件系统支持只读大页时减少 TLB 缺失, 不支持则忽略
+#endif
+        map_ = base;
+        map_len_ = len;
+        cur_ = static_cast<char*>(base) + (static_cast<uint64_t>(pos) - start);
+        end_ = static_cast<char*>(base) + file_len;
+        eof_ = true;
+        ::lseek(fd_, 0, SEEK_END);  // 和 read 路径一样把输入标记为已读完
+    }
+#endif
+
+    // 跳过空白; 输入耗尽返回 false
+    bool skip_space() {
+        for (;;) {
+            while (cur_ < end_ && static_cast<unsigned char>(*cur_) <= ' ') ++cur_;
+            if (cur_ < end_) return true;
+            if (!refill()) return false;
+        }
+    }
+
+    // 保证 [cur_, end_) 至少有 k 字节 (已到 EOF 时尽力而为)
+    void ensure(size_t k) {
+        if (static_cast<size_t>(end_ - cur_) < k && !eof_) refill();
+    }
+
+    // 把剩余的未解析字节挪到缓冲区开头, 再读一块填满; 读不到新数据返回 false
+    bool refill() {
+        if (eof_) return false;
+        size_t rem = static_cast<size_t>(end_ - cur_);
+        std::memmove(buf_, cur_, rem);
+        cur_ = buf_;
+        end_ = buf_ + rem;
+        ssize_t n = read_block(end_, kBufSize - rem);
+        if (n <= 0) {
+            eof_ = true;
+            n = 0;
+        }
+        end_ += n;
+        *end_ = '\0';  // 哨兵: 数字循环遇到 '\0' 自然停止, 不用检查 end_
+        return n > 0;
+    }
+
+    ssize_t read_block(char* p, size_t cap) {
+#ifdef ACM_IO_ASYNC
+        if (ahead_) return cap ? static_cast<ssize_t>(ahead_->take(p, cap)) : 0;
+#endif
+        ssize_t n;
+        do {
+            n = ::read(fd_, p, cap);
+        } while (n < 0 && errno == EINTR);
+        return n;
+    }
+
+    // 数字停在哨兵 (cur_ == end_) 而输入还没完, 说明 token 被 read(2) 切开了 (管道 / 交互题里写端中途 flush):
+    // 已解析的部分留在 v 里, refill 之后接着累加. 不预先凑满 kMaxNumber 字节, 所以分隔符已到时从不阻塞
+    template <class U>
+    U parse_digits() {
+        U v = 0;
+        for (;;) {
+#ifdef ACM_IO_SWAR
+            if constexpr (sizeof(U) >= 4) {
+                // 哨兵 '\0' 不是数字, 所以越过 end_ 的 8 字节窗口一定不满足 is_eight_digits
+                for (uint64_t w; acm_io_detail::is_eight_digits(w = acm_io_detail::load8(cur_)); cur_ += 8)
+                    v = static_cast<U>(v * 100000000u + acm_io_detail::parse_eight_digits(w));
+            }
+#endif
+            for (unsigned d; (d = static_cast<unsigned>(*cur_ - '0')) < 10u; ++cur_) v = static_cast<U>(v * 10 + d);
+            if (cur_ != end_ || !refill()) return v;
+        }
+    }
+
+    // 已知长度的数字串 (可带符号), 不再逐字节判断分隔符
+    template <class T>
+    static T parse_span(const char* p, size_t len) {
+        using U = std::make_unsigned_t<T>;
+        bool neg = (*p == '-');
+        size_t skip = (neg || *p == '+');
+        p += skip;
+        len -= skip;
+        U v = 0;
+#ifdef ACM_IO_SWAR
+        if constexpr (sizeof(U) >= 4) {
+            for (; len >= 8; len -= 8, p += 8)
+                v = static_cast<U>(v * 100000000u + acm_io_detail::parse_eight_digits(acm_io_detail::load8(p)));
+        }
+#endif
+        for (; len; len--, p++) v = static_cast<U>(v * 10 + static_cast<unsigned>(*p - '0'));
+        return static_cast<T>(neg ? U(0) - v : v);
+    }
+
+    int fd_;
+    bool eof_ = false;
+    void* map_ = nullptr;  // mmap 模式下的映射起点
+    size_t map_len_ = 0;
+    char* cur_;
+    char* end_;
+    char buf_[kBufSize + kPad];
+#ifdef ACM_IO_ASYNC
+    std::unique_ptr<acm_io_detail::ReadAhead> ahead_;  // 只在 read(2) 路径上创建
+#endif
+};
+
+namespace acm_io_detail {
+// "00".."99" 两位数字表, 编译期生成
+struct DigitPairs {
+    char d[200];
+    constexpr DigitPairs() : d() {
+        for (int i = 0; i < 100; i++) {
+            d[2 * i] = static_cast<char>('0' + i / 10);
+            d[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+inline constexpr DigitPairs kDigitPairs{};
+}  // namespace acm_io_detail
+
+class FastWriter {
+public:
+    static constexpr size_t kBufSize = 1 << 16;
+    static constexpr size_t kMaxNumber = 64;  // 写一个数字前保证剩余空间至少这么多
+
+    explicit FastWriter(int fd = STDOUT_FILENO) : fd_(fd), pos_(0) {
+#ifdef ACM_IO_ASYNC
+        behind_ = std::make_unique<acm_io_detail::WriteBehind>(fd_);
+#endif
+    }
+    FastWriter(const FastWriter&) = delete;
+    FastWriter& operator=(const FastWriter&) = delete;
+    ~FastWriter() { flush(); }
+
+    template <class T>
+    FastWriter& write(const T& x) {
+        if constexpr (std::is_same_v<T, char>) {
+            if (pos_ == kBufSize) spill();
+            buf_[pos_++] = x;
+        } else if constexpr (std::is_integral_v<T>) {
+            reserve(kMaxNumber);
+            using U = std::make_unsigned_t<T>;
+            U v = static_cast<U>(x);
+            if constexpr (std::is_signed_v<T>) {
+                if (x < 0) {
+                    buf_[pos_++] = '-';
+                    v = U(0) - v;
+                }
+            }
+            put_unsigned(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            auto r = std::to_chars(buf_ + pos_, buf_ + kBufSize, x);
+            if (r.ec != std::errc()) {
+                spill();
+                r = std::to_chars(buf_, buf_ + kBufSize, x);
+            }
+            pos_ = static_cast<size_t>(r.ptr - buf_);
+        } else {
+            put_string(std::string_view(x));
+        }
+        return *this;
+    }
+
+    // 定点小数, 等价于 printf("%.*f", prec, x)
+    FastWriter& write_fixed(double x, int prec) {
+        auto r = std::to_chars(buf_ + pos_, buf_ + kBufSize, x, std::chars_format::fixed, prec);
+        if (r.ec != std::errc()) {
+            spill();
+            r = std::to_chars(buf_, buf_ + kBufSize, x, std::chars_format::fixed, prec);
+        }
+        pos_ = static_cast<size_t>(r.ptr - buf_);
+        return *this;
+    }
+
+    template <class T>
+    FastWriter& operator<<(const T& x) { return write(x); }
+
+    // 返回时已缓冲的输出全部交给了内核 (交互题靠它); 异步模式下也会等写线程写完
+    void flush() {
+        spill();
+#ifdef ACM_IO_ASYNC
+        behind_->wait();
+#endif
+    }
+
+private:
+    // 交出当前缓冲区: 异步模式下交给写线程并换另一块继续填, 否则直接 write(2)
+    void spill() {
+        if (pos_ == 0) return;
+#ifdef ACM_IO_ASYNC
+        behind_->submit(buf_, pos_);
+        buf_ = buf_ == store_[0] ? store_[1] : store_[0];
+#else
+        acm_io_detail::write_all(fd_, buf_, pos_);
+#endif
+        pos_ = 0;
+    }
+
+    void reserve(size_t k) {
+        if (kBufSize - pos_ < k) spill();
+    }
+
+    // 从低位向高位每次转换两位 (查表), 除法次数减半
+    template <class U>
+    void put_unsigned(U v) {
+        char tmp[24];
+        char* p = tmp + sizeof(tmp);
+        while (v >= 100) {
+            unsigned r = static_cast<unsigned>(v % 100);
+            v /= 100;
+            p -= 2;
+            std::memcpy(p, acm_io_detail::kDigitPairs.d + 2 * r, 2);
+        }
+        if (v >= 10) {
+            p -= 2;
+            std::memcpy(p, acm_io_detail::kDigitPairs.d + 2 * v, 2);
+        } else {
+            *--p = static_cast<char>('0' + v);
+        }
+        size_t len = static_cast<size_t>(tmp + sizeof(tmp) - p);
+        std::memcpy(buf_ + pos_, p, len);
+        pos_ += len;
+    }
+
+    void put_string(std::string_view s) {
+        while (!s.empty()) {
+            if (pos_ == kBufSize) spill();
+            size_t n = s.size() < kBufSize - pos_ ? s.size() : kBufSize - pos_;
+            std::memcpy(buf_ + pos_, s.data(), n);
+            pos_ += n;
+            s.remove_prefix(n);
+        }
+    }
+
+#ifdef ACM_IO_ASYNC
+    static constexpr int kBuffers = 2;  // 一块在写线程手上, 一块在填
+#else
+    static constexpr int kBuffers = 1;
+#endif
+
+    int fd_;
+    size_t pos_;
+    char store_[kBuffers][kBufSize];
+    char* buf_ = store_[0];
+#ifdef ACM_IO_ASYNC
+    std::unique_ptr<acm_io_detail::WriteBehind> behind_;
+#endif
+};
+
+#endif /* ACM_IO_HPP */
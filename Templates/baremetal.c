@@ -1,11 +1,332 @@
-/* 裸机/手撕代码模板 - 模拟无标准库环境 */
-#define NULL ((void *)0)
-typedef unsigned long size_t;
+/* 裸机/手撕代码模板 - 模拟无标准库环境
+ *
+ * 编译: gcc -O2 -ffreestanding -fno-tree-loop-distribute-patterns -c baremetal.c
+ *   -fno-tree-loop-distribute-patterns: 防止 GCC 把逐字节循环"优化"回 memcpy 调用 (裸机下无 libc 可链接)
+ * 可选 SIMD 路径: -DBM_USE_SIMD (x86 需 -msse2, AArch64/ARMv7 需 NEON)
+ */
+#include "baremetal.h"  /* 只依赖 stddef.h/stdint.h, 二者属于 freestanding 头文件, 不需要 libc */
+#include "bitops.h"     /* 同样只有 static inline + stdint.h */
 
-// 手动实现 memcpy
-void* my_memcpy(void* dest, const void* src, size_t n) {
+/* 机器字: 中段按 size_t 宽度搬运. may_alias 声明字指针可以别名任意字节缓冲区, 避免严格别名问题 */
+#if defined(__GNUC__)
+typedef size_t __attribute__((__may_alias__)) word_t;
+#else
+typedef size_t word_t;
+#endif
+#define WORD_SIZE  (sizeof(word_t))
+#define WORD_MASK  (WORD_SIZE - 1)
+#define SMALL_COPY (4 * WORD_SIZE)  /* 短于此长度直接逐字节, 对齐的开销不划算 */
+#define ONES       ((word_t)-1 / 0xFF)  /* 0x0101...01, 乘以字节值即可广播到整个字 */
+#define HIGHS      (ONES * 0x80)        /* 0x8080...80 */
+/* "字内含零字节" 位技巧: 结果非零当且仅当 v 中某字节为 0.
+ * 借位只会向高位传播, 所以最低的置位一定对应真正的零字节 (小端下即内存中第一个). */
+#define HAS_ZERO(v) (((v) - ONES) & ~(v) & HIGHS)
+
+/* 小端: 用 ctz 直接定位掩码中第一个置位字节 (无 CLZ 指令的目标上 bit_ctz 回落到 SWAR);
+ * 32 位字用 bit_ctz32: 64 位 ctz 在 32 位目标上会变成 libgcc 的 __ctzdi2 调用.
+ * 字节序未知时回落到逐字节扫描该字 */
+#if defined(BIT_LITTLE_ENDIAN) && SIZE_MAX == UINT32_MAX
+#define FIRST_BYTE(mask) ((size_t)bit_ctz32((uint32_t)(mask)) / 8)
+#elif defined(BIT_LITTLE_ENDIAN)
+#define FIRST_BYTE(mask) ((size_t)bit_ctz64((uint64_t)(mask)) / 8)
+#endif
+
+/* 非对齐字访问: 仅在硬件支持非对齐 LDR/MOV 的目标上启用 (Cortex-M0 不支持) */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__) || defined(__ARM_FEATURE_UNALIGNED))
+#define BM_UNALIGNED_OK 1
+typedef struct __attribute__((__packed__, __may_alias__)) { size_t v; } uword_t;
+#endif
+
+/* 可选 SIMD 路径: 16 字节向量, 非对齐 load + 对齐 store */
+#if defined(BM_USE_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>              /* 编译器自带头文件, 不依赖 libc */
+typedef __m128i vec_t;
+#define VEC_LOAD(p)     _mm_loadu_si128((const __m128i*)(const void*)(p))
+#define VEC_STORE(p, v) _mm_store_si128((__m128i*)(void*)(p), (v))
+#define VEC_SIZE        16
+#elif defined(BM_USE_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+typedef uint8x16_t vec_t;
+#define VEC_LOAD(p)     vld1q_u8((const unsigned char*)(p))
+#define VEC_STORE(p, v) vst1q_u8((unsigned char*)(p), (v))
+#define VEC_SIZE        16
+#endif
+
+// 参考实现: 逐字节拷贝 (原始版本, 用于对比吞吐量)
+void* my_memcpy_naive(void* dest, const void* src, size_t n) {
     char* d = (char*)dest;
     const char* s = (const char*)src;
     while (n--) *d++ = *s++;
     return dest;
 }
+
+/* 前向拷贝: 头部逐字节对齐 -> 中段按字 (8x 展开) -> 尾部逐字节.
+ * 每轮先读后写, 当 d < s 时即使区间重叠也安全, memmove 复用此函数. */
+static void copy_forward(unsigned char* d, const unsigned char* s, size_t n) {
+#ifdef VEC_SIZE
+    if (n >= 4 * VEC_SIZE) {
+        while ((uintptr_t)d & (VEC_SIZE - 1)) { *d++ = *s++; n--; }
+        for (; n >= 4 * VEC_SIZE; n -= 4 * VEC_SIZE, d += 4 * VEC_SIZE, s += 4 * VEC_SIZE) {
+            vec_t v0 = VEC_LOAD(s), v1 = VEC_LOAD(s + VEC_SIZE);
+            vec_t v2 = VEC_LOAD(s + 2 * VEC_SIZE), v3 = VEC_LOAD(s + 3 * VEC_SIZE);
+            VEC_STORE(d, v0); VEC_STORE(d + VEC_SIZE, v1);
+            VEC_STORE(d + 2 * VEC_SIZE, v2); VEC_STORE(d + 3 * VEC_SIZE, v3);
+        }
+        for (; n >= VEC_SIZE; n -= VEC_SIZE, d += VEC_SIZE, s += VEC_SIZE)
+            VEC_STORE(d, VEC_LOAD(s));
+    }
+#endif
+    if (n >= SMALL_COPY) {
+        while ((uintptr_t)d & WORD_MASK) { *d++ = *s++; n--; }
+        if (((uintptr_t)s & WORD_MASK) == 0) {
+            word_t* wd = (word_t*)(void*)d;
+            const word_t* ws = (const word_t*)(const void*)s;
+            for (; n >= 8 * WORD_SIZE; n -= 8 * WORD_SIZE, wd += 8, ws += 8) {
+                word_t w0 = ws[0], w1 = ws[1], w2 = ws[2], w3 = ws[3];
+                word_t w4 = ws[4], w5 = ws[5], w6 = ws[6], w7 = ws[7];
+                wd[0] = w0; wd[1] = w1; wd[2] = w2; wd[3] = w3;
+                wd[4] = w4; wd[5] = w5; wd[6] = w6; wd[7] = w7;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) *wd++ = *ws++;
+            d = (unsigned char*)wd;
+            s = (const unsigned char*)ws;
+        }
+#ifdef BM_UNALIGNED_OK
+        else {
+            /* 源与目的相对错位: 目的已对齐, 源走非对齐字读取, 4x 展开 */
+            word_t* wd = (word_t*)(void*)d;
+            const uword_t* us = (const uword_t*)(const void*)s;
+            for (; n >= 4 * WORD_SIZE; n -= 4 * WORD_SIZE, wd += 4, us += 4) {
+                word_t w0 = us[0].v, w1 = us[1].v, w2 = us[2].v, w3 = us[3].v;
+                wd[0] = w0; wd[1] = w1; wd[2] = w2; wd[3] = w3;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) *wd++ = (us++)->v;
+            d = (unsigned char*)wd;
+            s = (const unsigned char*)us;
+        }
+#endif
+    }
+    while (n--) *d++ = *s++;
+}
+
+/* 后向拷贝: 从末尾向前, 结构与 copy_forward 镜像. 用于 d > s 且区间重叠的情况. */
+static void copy_backward(unsigned char* d, const unsigned char* s, size_t n) {
+    d += n;
+    s += n;
+#ifdef VEC_SIZE
+    if (n >= 4 * VEC_SIZE) {
+        while ((uintptr_t)d & (VEC_SIZE - 1)) { *--d = *--s; n--; }
+        for (; n >= 4 * VEC_SIZE; n -= 4 * VEC_SIZE) {
+            d -= 4 * VEC_SIZE;
+            s -= 4 * VEC_SIZE;
+            vec_t v0 = VEC_LOAD(s), v1 = VEC_LOAD(s + VEC_SIZE);
+            vec_t v2 = VEC_LOAD(s + 2 * VEC_SIZE), v3 = VEC_LOAD(s + 3 * VEC_SIZE);
+            VEC_STORE(d, v0); VEC_STORE(d + VEC_SIZE, v1);
+            VEC_STORE(d + 2 * VEC_SIZE, v2); VEC_STORE(d + 3 * VEC_SIZE, v3);
+        }
+        for (; n >= VEC_SIZE; n -= VEC_SIZE) {
+            d -= VEC_SIZE;
+            s -= VEC_SIZE;
+            VEC_STORE(d, VEC_LOAD(s));
+        }
+    }
+#endif
+    if (n >= SMALL_COPY) {
+        while ((uintptr_t)d & WORD_MASK) { *--d = *--s; n--; }
+        if (((uintptr_t)s & WORD_MASK) == 0) {
+            word_t* wd = (word_t*)(void*)d;
+            const word_t* ws = (const word_t*)(const void*)s;
+            for (; n >= 8 * WORD_SIZE; n -= 8 * WORD_SIZE) {
+                wd -= 8;
+                ws -= 8;
+                word_t w0 = ws[0], w1 = ws[1], w2 = ws[2], w3 = ws[3];
+                word_t w4 = ws[4], w5 = ws[5], w6 = ws[6], w7 = ws[7];
+                wd[7] = w7; wd[6] = w6; wd[5] = w5; wd[4] = w4;
+                wd[3] = w3; wd[2] = w2; wd[1] = w1; wd[0] = w0;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) *--wd = *--ws;
+            d = (unsigned char*)wd;
+            s = (const unsigned char*)ws;
+        }
+#ifdef BM_UNALIGNED_OK
+        else {
+            word_t* wd = (word_t*)(void*)d;
+            const uword_t* us = (const uword_t*)(const void*)s;
+            for (; n >= 4 * WORD_SIZE; n -= 4 * WORD_SIZE) {
+                wd -= 4;
+                us -= 4;
+                word_t w0 = us[0].v, w1 = us[1].v, w2 = us[2].v, w3 = us[3].v;
+                wd[3] = w3; wd[2] = w2; wd[1] = w1; wd[0] = w0;
+            }
+            for (; n >= WORD_SIZE; n -= WORD_SIZE) *--wd = (--us)->v;
+            d = (unsigned char*)wd;
+            s = (const unsigned char*)us;
+        }
+#endif
+    }
+    while (n--) *--d = *--s;
+}
+
+// 手动实现 memcpy: 区间不得重叠 (重叠请用 my_memmove)
+void* my_memcpy(void* dest, const void* src, size_t n) {
+    copy_forward((unsigned char*)dest, (const unsigned char*)src, n);
+    return dest;
+}
+
+// 手动实现 memmove: 正确处理重叠区间
+void* my_memmove(void* dest, const void* src, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    const unsigned char* s = (const unsigned char*)src;
+    if (d == s || n == 0) return dest;
+    /* 无符号差值 >= n 说明 d 在 s 之前, 或两区间不重叠: 前向拷贝安全 */
+    if ((uintptr_t)d - (uintptr_t)s >= n) copy_forward(d, s, n);
+    else copy_backward(d, s, n);
+    return dest;
+}
+
+// 参考实现: 逐字节填充
+void* my_memset_naive(void* dest, int c, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    while (n--) *d++ = (unsigned char)c;
+    return dest;
+}
+
+// 手动实现 memset: 字节值广播成整字, 对齐后按字写入 (8x 展开)
+void* my_memset(void* dest, int c, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    unsigned char b = (unsigned char)c;
+    if (n >= SMALL_COPY) {
+        word_t w = ONES * b;
+        while ((uintptr_t)d & WORD_MASK) { *d++ = b; n--; }
+        word_t* wd = (word_t*)(void*)d;
+        for (; n >= 8 * WORD_SIZE; n -= 8 * WORD_SIZE, wd += 8) {
+            wd[0] = w; wd[1] = w; wd[2] = w; wd[3] = w;
+            wd[4] = w; wd[5] = w; wd[6] = w; wd[7] = w;
+        }
+        for (; n >= WORD_SIZE; n -= WORD_SIZE) *wd++ = w;
+        d = (unsigned char*)wd;
+    }
+    while (n--) *d++ = b;
+    return dest;
+}
+
+// 参考实现: 逐字节比较
+int my_memcmp_naive(const void* a, const void* b, size_t n) {
+    const unsigned char* p = (const unsigned char*)a;
+    const unsigned char* q = (const unsigned char*)b;
+    for (; n; n--, p++, q++)
+        if (*p != *q) return *p - *q;
+    return 0;
+}
+
+// 手动实现 memcmp: 按字比较, 异或非零即提前退出, 再在该字内定位第一个不同字节
+int my_memcmp(const void* a, const void* b, size_t n) {
+    const unsigned char* p = (const unsigned char*)a;
+    const unsigned char* q = (const unsigned char*)b;
+    if (n >= SMALL_COPY) {
+        while ((uintptr_t)p & WORD_MASK) {
+            if (*p != *q) return *p - *q;
+            p++; q++; n--;
+        }
+        const word_t* wp = (const word_t*)(const void*)p;
+        if (((uintptr_t)q & WORD_MASK) == 0) {
+            const word_t* wq = (const word_t*)(const void*)q;
+            for (; n >= WORD_SIZE; n -= WORD_SIZE, wp++, wq++) {
+                word_t x = *wp ^ *wq;
+                if (x) {
+#ifdef FIRST_BYTE
+                    size_t i = FIRST_BYTE(x);
+                    return ((const unsigned char*)wp)[i] - ((const unsigned char*)wq)[i];
+#else
+                    break;  /* 回落到逐字节, 最多再扫一个字 */
+#endif
+                }
+            }
+            q = (const unsigned char*)wq;
+        }
+#ifdef BM_UNALIGNED_OK
+        else {
+            const uword_t* uq = (const uword_t*)(const void*)q;
+            for (; n >= WORD_SIZE; n -= WORD_SIZE, wp++, uq++) {
+                word_t x = *wp ^ uq->v;
+                if (x) {
+#ifdef FIRST_BYTE
+                    size_t i = FIRST_BYTE(x);
+                    return ((const unsigned char*)wp)[i] - ((const unsigned char*)uq)[i];
+#else
+                    break;
+#endif
+                }
+            }
+            q = (const unsigned char*)uq;
+        }
+#endif
+        p = (const unsigned char*)wp;
+    }
+    for (; n; n--, p++, q++)
+        if (*p != *q) return *p - *q;
+    return 0;
+}
+
+// 参考实现: 逐字节找 '\0'
+size_t my_strlen_naive(const char* s) {
+    const char* p = s;
+    while (*p) p++;
+    return (size_t)(p - s);
+}
+
+// 手动实现 strlen: 对齐后每次检查一个字是否含零字节
+size_t my_strlen(const char* s) {
+    const char* p = s;
+    while ((uintptr_t)p & WORD_MASK) {
+        if (*p == '\0') return (size_t)(p - s);
+        p++;
+    }
+    /* 对齐的字读取不会跨页, 读到结尾之后同一字内的字节在硬件上是安全的 (ASan 会误报) */
+    const word_t* w = (const word_t*)(const void*)p;
+    word_t v = *w;
+    while (!HAS_ZERO(v)) v = *++w;
+    p = (const char*)w;
+#ifdef FIRST_BYTE
+    return (size_t)(p - s) + FIRST_BYTE(HAS_ZERO(v));
+#else
+    while (*p) p++;
+    return (size_t)(p - s);
+#endif
+}
+
+// 参考实现: 逐字节查找
+void* my_memchr_naive(const void* s, int c, size_t n) {
+    const unsigned char* p = (const unsigned char*)s;
+    for (; n; n--, p++)
+        if (*p == (unsigned char)c) return (void*)p;
+    return NULL;
+}
+
+// 手动实现 memchr: 字与广播后的目标字节异或, 目标字节变成 0, 再用 HAS_ZERO 检测
+void* my_memchr(const void* s, int c, size_t n) {
+    const unsigned char* p = (const unsigned char*)s;
+    unsigned char b = (unsigned char)c;
+    if (n >= SMALL_COPY) {
+        while ((uintptr_t)p & WORD_MASK) {
+            if (*p == b) return (void*)p;
+            p++; n--;
+        }
+        word_t pat = ONES * b;
+        const word_t* w = (const word_t*)(const void*)p;
+        for (; n >= WORD_SIZE; n -= WORD_SIZE, w++) {
+            word_t m = HAS_ZERO(*w ^ pat);
+            if (m) {
+#ifdef FIRST_BYTE
+                return (void*)((const unsigned char*)w + FIRST_BYTE(m));
+#else
+                break;
+#endif
+            }
+        }
+        p = (const unsigned char*)w;
+    }
+    for (; n; n--, p++)
+        if (*p == b) return (void*)p;
+    return NULL;
+}
@@ -0,0 +1,30 @@
+/* 裸机 mem* / str* 内核库接口 (实现见 baremetal.c)
+ * 每个内核都附带 *_naive 逐字节参考版本, 便于同一份代码对比吞吐量与正确性. */
+#ifndef BAREMETAL_H
+#define BAREMETAL_H
+
+#include <stddef.h>  /* size_t, NULL */
+#include <stdint.h>  /* uintptr_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void*  my_memcpy(void* dest, const void* src, size_t n);
+void*  my_memmove(void* dest, const void* src, size_t n);
+void*  my_memset(void* dest, int c, size_t n);
+int    my_memcmp(const void* a, const void* b, size_t n);
+size_t my_strlen(const char* s);
+void*  my_memchr(const void* s, int c, size_t n);
+
+void*  my_memcpy_naive(void* dest, const void* src, size_t n);
+void*  my_memset_naive(void* dest, int c, size_t n);
+int    my_memcmp_naive(const void* a, const void* b, size_t n);
+size_t my_strlen_naive(const char* s);
+void*  my_memchr_naive(const void* s, int c, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BAREMETAL_H */
@@ -0,0 +1,433 @@
+/* 刷题 IO 的快速输入: FastReader 与 strtoll 逐个对照, 以及对比 scanf / strtoll 的解析耗时
+ * 编译: gcc -O2 -DBENCH_NO_MAIN -c benchmark.c -o benchmark.o
+ *       g++ -O2 -std=c++17 -pthread bench_acm_io.cpp benchmark.o -o bench_acm_io
+ *       (-mavx2 走 SIMD read_array, -DACM_IO_ASYNC 走预读线程, -DACM_IO_NO_SWAR -DACM_IO_NO_SIMD 是逐字节基线)
+ * 计时前先在两百份随机输入上检查: 正负号与前导 '+', "-0", 类型的最小 / 最大值 (int64 满 19 位),
+ * 前导零撑到 32 字节以上的 token, 空格 / '\t' / CRLF / 连续空白混合分隔, 开头有无空白, 末尾有无换行.
+ * 每份输入走四条路, 读到的整数必须与 strtoll 的结果逐个相同:
+ *   文件 (mmap), 从开头逐个 read<T>(); 文件从中间某个 token 开始, 随机长度的 read_array 与 read 交替;
+ *   包模式管道 (O_DIRECT, 每次 read(2) 恰好拿到一次 write 的内容), 写线程每次写 1..7 或 1..4096 字节,
+ *   数字被切在任意位置, 两种读法轮流用.
+ * --sizes 给出计时用的整数个数. 每个规模两份输入 (int32 / int64 全范围随机值, 单空格或换行分隔),
+ * 写到 $TMPDIR (默认 /tmp) 下, 测完删除. 同一份源码编译成 bench_acm_io_scalar (逐字节), bench_acm_io (SWAR),
+ * bench_acm_io_avx2 (SWAR + AVX2 read_array) 与 bench_acm_io_async (预读线程), 测试名相同, 对比中位数即可.
+ */
+#include "benchmark.h"  // 最先包含: 其中定义了 POSIX 特性宏
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "acm_io.hpp"
+
+namespace {
+
+constexpr int kCases = 200;
+constexpr size_t kMaxCaseValues = 1500;
+constexpr size_t LARGE_N = 1000000;
+constexpr size_t LARGE_SAMPLES = 3;
+
+struct xorshift {
+    uint64_t s;
+    uint32_t next() {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return static_cast<uint32_t>(s >> 32);
+    }
+    uint64_t next64() { return (uint64_t{next()} << 32) | next(); }
+};
+
+xorshift g_rng{1};  // 读 read_array 的随机长度也用它; 写线程各自有一份
+
+template <class T>
+const char* type_name() {
+    return sizeof(T) == 8 ? "i64" : "i32";
+}
+
+/* 值的分布偏向边界: 最小 / 最大值, 三位以内的小数, 九位以内, 以及整个类型范围 (int64 大多 19 位) */
+template <class T>
+T random_value() {
+    using L = std::numeric_limits<T>;
+    const uint64_t r = g_rng.next64();
+    const bool neg = g_rng.next() % 5 < 2;
+    switch (g_rng.next() % 8) {
+    case 0: return L::min();
+    case 1: return L::max();
+    case 2:
+    case 3: return static_cast<T>(neg ? -static_cast<T>(r % 1000) : static_cast<T>(r % 1000));
+    case 4:
+    case 5: return static_cast<T>(neg ? -static_cast<T>(r % 1000000000) : static_cast<T>(r % 1000000000));
+    default: return static_cast<T>(r);
+    }
+}
+
+void append_value(std::string& s, long long v, bool plus, size_t zero_pad) {
+    char digits[24];
+    const size_t len = static_cast<size_t>(std::snprintf(digits, sizeof digits, "%lld", v)) - (v < 0);
+    if (v < 0) s += '-';
+    else if (plus) s += '+';
+    if (zero_pad > len) s.append(zero_pad - len, '0');
+    s += digits + (v < 0);
+}
+
+const char* random_separator() {
+    static const char* const kSeps[16] = {" ", " ", " ", " ", " ", " ", "\n", "\n", "\n", "\n",
+                                          "\r\n", "\r\n", "\t", "  ", " \r\n", "\n\n\t"};
+    return kSeps[g_rng.next() % 16];
+}
+
+/* n 个随机整数的文本; starts 记下每个 token 的起始偏移 */
+template <class T>
+std::string messy_text(size_t n, std::vector<size_t>& starts) {
+    std::string s;
+    starts.clear();
+    if (g_rng.next() % 4 == 0) s += random_separator();
+    for (size_t i = 0; i < n; i++) {
+        if (i) s += random_separator();
+        starts.push_back(s.size());
+        const T v = random_value<T>();
+        const uint32_t r = g_rng.next() % 100;
+        if (v == 0 && r < 10) s += "-0";
+        else append_value(s, v, r < 15, r >= 96 ? 33 + g_rng.next() % 13 : 0);  // 前导零: token 超过 SIMD 窗口
+    }
+    if (g_rng.next() % 2) s += random_separator();
+    return s;
+}
+
+/* 计时用的输入: 常见的题目格式, 整个类型范围内的随机值, 每行 10 个 */
+template <class T>
+std::string plain_text(size_t n) {
+    std::string s;
+    s.reserve(n * (sizeof(T) == 8 ? 21 : 12));
+    for (size_t i = 0; i < n; i++) {
+        append_value(s, static_cast<T>(g_rng.next64()), false, 0);
+        s += i % 10 == 9 ? '\n' : ' ';
+    }
+    return s;
+}
+
+/* 参照: 从 text[from] 起用 strtoll 逐个解析; token 不是合法的 T 时返回 false */
+template <class T>
+bool strtoll_ref(const std::string& text, size_t from, std::vector<T>& out) {
+    out.clear();
+    const char* p = text.c_str() + from;
+    for (;;) {
+        while (*p != '\0' && static_cast<unsigned char>(*p) <= ' ') ++p;
+        if (*p == '\0') return true;
+        char* e;
+        errno = 0;
+        long long v = std::strtoll(p, &e, 10);
+        if (e == p || errno == ERANGE || v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max() ||
+            static_cast<unsigned char>(*e) > ' ')
+            return false;
+        out.push_back(static_cast<T>(v));
+        p = e;
+    }
+}
+
+template <class T>
+std::vector<T> read_each(FastReader& in) {
+    std::vector<T> v;
+    for (T x; in.read(x);) v.push_back(x);
+    return v;
+}
+
+/* 随机长度的 read_array, 中间夹着单个 read: SIMD 窗口停在任意位置之后, 两种读法都要能接着读 */
+template <class T>
+std::vector<T> read_chunks(FastReader& in) {
+    std::vector<T> v;
+    T buf[300];
+    for (;;) {
+        const size_t k = 1 + g_rng.next() % 300;
+        const size_t got = in.read_array(buf, k);
+        v.insert(v.end(), buf, buf + got);
+        if (got < k) return v;
+        T x;
+        if (g_rng.next() % 4 == 0) {
+            if (!in.read(x)) return v;
+            v.push_back(x);
+        }
+    }
+}
+
+template <class T>
+bool same_values(const char* path, int c, const std::vector<T>& got, const std::vector<T>& want) {
+    if (got == want) return true;
+    size_t i = 0;
+    while (i < got.size() && i < want.size() && got[i] == want[i]) i++;
+    std::fprintf(stderr, "MISMATCH: %s %s, case %d: read %zu values, strtoll %zu; first difference at %zu", path,
+                 type_name<T>(), c, got.size(), want.size(), i);
+    if (i < got.size() && i < want.size())
+        std::fprintf(stderr, " (%lld vs %lld)", static_cast<long long>(got[i]), static_cast<long long>(want[i]));
+    std::fputc('\n', stderr);
+    return false;
+}
+
+bool write_file(const std::string& path, const std::string& text) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    acm_io_detail::write_all(fd, text.data(), text.size());
+    return ::close(fd) == 0;
+}
+
+template <class T>
+bool check_file(const std::string& path, size_t from, size_t size, bool chunks, int c, const std::vector<T>& want) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0 || ::lseek(fd, static_cast<off_t>(from), SEEK_SET) < 0) {
+        std::fprintf(stderr, "MISMATCH: cannot reopen %s\n", path.c_str());
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    bool ok = true;
+    {
+        auto in = std::make_unique<FastReader>(fd);
+#ifdef ACM_IO_MMAP
+        if (in->mapped() != (from < size)) {  // 剩余为空的文件按约定走 read 路径
+            std::fprintf(stderr, "MISMATCH: file input, case %d: expected the mmap path\n", c);
+            ok = false;
+        }
+#else
+        (void)size;
+#endif
+        ok = ok && same_values(chunks ? "file read_array" : "file read", c, chunks ? read_chunks<T>(*in)
+                                                                                  : read_each<T>(*in), want);
+    }
+    ::close(fd);
+    return ok;
+}
+
+/* 写线程每次 write 1..max_chunk 字节. Linux 的包模式管道保证每次 read(2) 只拿到一次 write 的内容,
+ * 否则读端可能一次拿到好几块, 切分点就不一定落在数字中间了 */
+template <class T>
+bool check_pipe(const std::string& text, size_t max_chunk, bool chunks, int c, const std::vector<T>& want) {
+    int fds[2];
+#if defined(__linux__) && defined(O_DIRECT)
+    if (::pipe2(fds, O_DIRECT) != 0 && ::pipe(fds) != 0) return false;
+#else
+    if (::pipe(fds) != 0) return false;
+#endif
+    const uint64_t seed = g_rng.next64() | 1;
+    std::thread writer([&text, max_chunk, seed, fd = fds[1]] {
+        xorshift r{seed};
+        for (size_t off = 0; off < text.size();) {
+            size_t k = 1 + r.next() % max_chunk;
+            if (k > text.size() - off) k = text.size() - off;
+            acm_io_detail::write_all(fd, text.data() + off, k);  // 读端提前关闭时失败返回 (SIGPIPE 已忽略)
+            off += k;
+        }
+        ::close(fd);
+    });
+    bool ok;
+    {
+        auto in = std::make_unique<FastReader>(fds[0]);
+        const char* path = max_chunk < 16 ? (chunks ? "tiny-chunk pipe read_array" : "tiny-chunk pipe read")
+                                          : (chunks ? "pipe read_array" : "pipe read");
+        ok = !in->mapped() && same_values(path, c, chunks ? read_chunks<T>(*in) : read_each<T>(*in), want);
+    }
+    ::close(fds[0]);
+    writer.join();
+    return ok;
+}
+
+template <class T>
+bool check_type(const std::string& dir) {
+    const std::string path = dir + "/bench_acm_io_" + std::to_string(::getpid()) + ".txt";
+    std::vector<size_t> starts;
+    std::vector<T> want, tail;
+    bool files = true;
+    for (int c = 0; c < kCases; c++) {
+        const size_t n = c == 0 ? 0 : 1 + g_rng.next() % kMaxCaseValues;
+        const std::string text = messy_text<T>(n, starts);
+        const size_t from = n ? starts[g_rng.next() % n] : text.size();
+        if (!strtoll_ref(text, 0, want) || want.size() != n || !strtoll_ref(text, from, tail)) {
+            std::fprintf(stderr, "MISMATCH: case %d: strtoll rejects the generated %s text\n", c, type_name<T>());
+            return false;
+        }
+        if (files && !write_file(path, text)) {
+            std::fprintf(stderr, "# skip file checks: cannot write %s\n", path.c_str());
+            files = false;
+        }
+        const bool odd = (c & 1) != 0;
+        if (files && (!check_file(path, 0, text.size(), false, c, want) ||
+                      !check_file(path, from, text.size(), true, c, tail)))
+            return false;
+        if (!check_pipe(text, 7, odd, c, want) || !check_pipe(text, 4096, !odd, c, want)) return false;
+    }
+    if (files) ::unlink(path.c_str());
+    return true;
+}
+
+/* 对计时读到的值求和 (按 uint64 回绕), 与参照的和比较 */
+template <class T>
+uint64_t sum_of(const T* v, size_t n) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; i++) s += static_cast<uint64_t>(static_cast<int64_t>(v[i]));
+    return s;
+}
+
+template <class T>
+uint64_t fast_read_file(const char* path, T* out, size_t n, bool array) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    uint64_t s = 0;
+    {
+        auto in = std::make_unique<FastReader>(fd);
+        if (array) {
+            s = sum_of(out, in->read_array(out, n));
+        } else {
+            for (T x; in->read(x);) s += static_cast<uint64_t>(static_cast<int64_t>(x));
+        }
+    }
+    ::close(fd);
+    return s;
+}
+
+/* 普通管道, 写线程按 64 KB 一块写: 测 read(2) 路径 (异步版里是预读线程) 的吞吐 */
+template <class T>
+uint64_t fast_read_pipe(const std::string& text) {
+    int fds[2];
+    if (::pipe(fds) != 0) return 0;
+    std::thread writer([&text, fd = fds[1]] {
+        acm_io_detail::write_all(fd, text.data(), text.size());
+        ::close(fd);
+    });
+    uint64_t s = 0;
+    {
+        auto in = std::make_unique<FastReader>(fds[0]);
+        for (T x; in->read(x);) s += static_cast<uint64_t>(static_cast<int64_t>(x));
+    }
+    ::close(fds[0]);
+    writer.join();
+    return s;
+}
+
+template <class T>
+bool bench_type(size_t n, const std::string& dir) {
+    const char* type = type_name<T>();
+    const std::string text = plain_text<T>(n);
+    const std::string path = dir + "/bench_acm_io_" + std::to_string(::getpid()) + ".txt";
+    std::vector<T> want, got(n);
+    if (!strtoll_ref(text, 0, want) || want.size() != n) {
+        std::fprintf(stderr, "MISMATCH: strtoll rejects the generated %s input (n=%zu)\n", type, n);
+        return false;
+    }
+    if (!write_file(path, text)) {
+        std::fprintf(stderr, "# skip size %zu: cannot write %s\n", n, path.c_str());
+        return true;
+    }
+    const uint64_t want_sum = sum_of(want.data(), n);
+    bool ok = true;
+    bench_t b;
+    char name[64];
+    uint64_t s = 0;
+
+    std::FILE* f = std::fopen(path.c_str(), "r");
+    if (f != nullptr) {
+        std::snprintf(name, sizeof name, "scanf %s file", type);
+        BENCH(b, name, {
+            std::rewind(f);
+            s = 0;
+            for (long long x; std::fscanf(f, "%lld", &x) == 1;) s += static_cast<uint64_t>(x);
+            BENCH_DO_NOT_OPTIMIZE(s);
+        });
+        bench_set_size(&b, n, text.size());
+        bench_report(&b);
+        std::fclose(f);
+        ok = s == want_sum;
+    }
+
+    std::snprintf(name, sizeof name, "strtoll %s memory", type);
+    BENCH(b, name, {
+        s = 0;
+        char* e;
+        for (const char* p = text.c_str();; p = e) {
+            long long x = std::strtoll(p, &e, 10);
+            if (e == p) break;
+            s += static_cast<uint64_t>(x);
+        }
+        BENCH_DO_NOT_OPTIMIZE(s);
+    });
+    bench_set_size(&b, n, text.size());
+    bench_report(&b);
+    ok = ok && s == want_sum;
+
+    std::snprintf(name, sizeof name, "FastReader read %s file", type);
+    BENCH(b, name, s = fast_read_file<T>(path.c_str(), got.data(), n, false); BENCH_DO_NOT_OPTIMIZE(s));
+    bench_set_size(&b, n, text.size());
+    bench_report(&b);
+    ok = ok && s == want_sum;
+
+    std::snprintf(name, sizeof name, "FastReader read_array %s file", type);
+    BENCH(b, name, s = fast_read_file<T>(path.c_str(), got.data(), n, true); BENCH_DO_NOT_OPTIMIZE(s));
+    bench_set_size(&b, n, text.size());
+    bench_report(&b);
+    ok = ok && s == want_sum && got == want;
+
+    std::snprintf(name, sizeof name, "FastReader read %s pipe", type);
+    BENCH(b, name, s = fast_read_pipe<T>(text); BENCH_DO_NOT_OPTIMIZE(s));
+    bench_set_size(&b, n, text.size());
+    bench_report(&b);
+    ok = ok && s == want_sum;
+
+    if (!ok) std::fprintf(stderr, "MISMATCH: timed %s reads differ from strtoll (n=%zu)\n", type, n);
+    ::unlink(path.c_str());
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+#if defined(__AVX2__) && defined(__GNUC__)
+    if (!__builtin_cpu_supports("avx2")) {
+        std::fprintf(stderr, "# skip: this CPU has no AVX2\n");
+        return bench_summary();
+    }
+#endif
+    std::signal(SIGPIPE, SIG_IGN);  // 校验失败时读端提前关闭, 写线程只需看到 write 出错
+    const char* tmp = std::getenv("TMPDIR");
+    std::string dir = tmp && *tmp ? tmp : "/tmp";
+#ifdef ACM_IO_SWAR
+    const int swar = 1;
+#else
+    const int swar = 0;
+#endif
+#ifdef ACM_IO_SIMD
+    const int simd = 1;
+#else
+    const int simd = 0;
+#endif
+#ifdef ACM_IO_ASYNC
+    const int async = 1;
+#else
+    const int async = 0;
+#endif
+    std::fprintf(stderr, "# acm_io paths: swar %d, simd %d, async %d\n", swar, simd, async);
+    if (!check_type<int32_t>(dir) || !check_type<int64_t>(dir)) return 1;
+
+    static const size_t defaults[] = {100000, 1000000};
+    const size_t* sizes;
+    size_t n_sizes = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    bench_config_t saved = bench_config;
+    for (size_t i = 0; i < n_sizes; i++) {
+        bench_config = saved;
+        if (sizes[i] >= LARGE_N) {
+            bench_config.samples = LARGE_SAMPLES;
+            bench_config.warmup = 1;
+        }
+        if (!bench_type<int32_t>(sizes[i], dir) || !bench_type<int64_t>(sizes[i], dir)) return 1;
+    }
+    bench_config = saved;
+    return bench_summary();
+}
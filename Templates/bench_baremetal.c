@@ -0,0 +1,243 @@
+/* 裸机 mem* / str* 内核测试: 字宽 (可选 SIMD) 实现 vs 逐字节参考版本 vs libc
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN bench_baremetal.c baremetal.c benchmark.c -o bench_baremetal -lm
+ * 计时前先逐长度 / 逐对齐偏移与 libc 比对 (memmove 另测前后两个方向的重叠), 并检查缓冲区两侧的保护字节.
+ * 对比 SIMD 路径: baremetal.c 加 -DBM_USE_SIMD (CMake: -DGYM_BM_SIMD=ON).
+ */
+#include "benchmark.h"  /* 最先包含: 其中定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "baremetal.h"
+
+#define MAX_LEN   (64u * 1024u)
+#define CHECK_LEN 300u  /* 自检覆盖 0..CHECK_LEN 的每个长度: 短路径, 对齐头尾, 8x 展开的每种余数 */
+#define MAX_OFF   16u   /* 起点偏移 0..MAX_OFF-1, 覆盖 16 字节向量内的每种错位 */
+#define GUARD     32u   /* 目标区两侧的保护字节, 检查越界写 */
+#define FILL      0xA5u
+
+static unsigned char g_src[MAX_LEN + 2 * GUARD + MAX_OFF] __attribute__((aligned(64)));
+static unsigned char g_dst[MAX_LEN + 2 * GUARD + MAX_OFF] __attribute__((aligned(64)));
+static unsigned char g_ref[MAX_LEN + 2 * GUARD + MAX_OFF] __attribute__((aligned(64)));
+static char g_str[MAX_LEN + MAX_OFF + 1] __attribute__((aligned(64)));
+
+static int sign(int x) { return (x > 0) - (x < 0); }
+
+/* 目标区 [GUARD + off, GUARD + off + len) 之外是否仍为 FILL */
+static int guards_ok(const unsigned char* buf, size_t off, size_t len) {
+    for (size_t i = 0; i < GUARD + off; i++)
+        if (buf[i] != FILL) return 0;
+    for (size_t i = GUARD + off + len; i < GUARD + off + len + GUARD; i++)
+        if (buf[i] != FILL) return 0;
+    return 1;
+}
+
+static int check_memcpy(void* (*fn)(void*, const void*, size_t), const char* name) {
+    for (size_t len = 0; len <= CHECK_LEN; len++) {
+        for (size_t so = 0; so < MAX_OFF; so++) {
+            for (size_t off = 0; off < MAX_OFF; off++) {
+                memset(g_dst, FILL, len + 2 * GUARD + MAX_OFF);
+                unsigned char* d = g_dst + GUARD + off;
+                if (fn(d, g_src + so, len) != d || memcmp(d, g_src + so, len) != 0 || !guards_ok(g_dst, off, len)) {
+                    fprintf(stderr, "MISMATCH: %s len %zu src+%zu dst+%zu\n", name, len, so, off);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* 同一缓冲区内 dst = src + shift, shift 从 -(2*MAX_OFF+1) 到 +(2*MAX_OFF+1): 两个方向的重叠都覆盖到 */
+static int check_memmove(void) {
+    const long span = 2 * (long)MAX_OFF + 1;
+    for (size_t len = 0; len <= CHECK_LEN; len++) {
+        for (size_t base_off = 0; base_off < 8; base_off++) {
+            for (long shift = -span; shift <= span; shift++) {
+                size_t base = GUARD + (size_t)span + base_off;
+                size_t total = base + len + (size_t)span + GUARD;
+                memcpy(g_dst, g_src, total);
+                memcpy(g_ref, g_src, total);
+                unsigned char* d = g_dst + base + shift;
+                memmove(g_ref + base + shift, g_ref + base, len);
+                if (my_memmove(d, g_dst + base, len) != d || memcmp(g_dst, g_ref, total) != 0) {
+                    fprintf(stderr, "MISMATCH: my_memmove len %zu base+%zu shift %ld\n", len, base_off, shift);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_memset(void* (*fn)(void*, int, size_t), const char* name) {
+    static const int values[] = {0, 0x5A, 0xFF, 0x180};  /* 0x180 只取低 8 位, 即 0x80 */
+    for (size_t v = 0; v < sizeof values / sizeof values[0]; v++) {
+        for (size_t len = 0; len <= CHECK_LEN; len++) {
+            for (size_t off = 0; off < MAX_OFF; off++) {
+                memset(g_dst, FILL, len + 2 * GUARD + MAX_OFF);
+                unsigned char* d = g_dst + GUARD + off;
+                int ok = fn(d, values[v], len) == d && guards_ok(g_dst, off, len);
+                for (size_t i = 0; ok && i < len; i++) ok = d[i] == (unsigned char)values[v];
+                if (!ok) {
+                    fprintf(stderr, "MISMATCH: %s value 0x%x len %zu dst+%zu\n", name, values[v], len, off);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* 相等, 以及在每个位置上分别变大 / 变小 (含 0x80 以上的字节, 检查按无符号比较) */
+static int check_memcmp(int (*fn)(const void*, const void*, size_t), const char* name) {
+    for (size_t len = 0; len <= CHECK_LEN; len += (len < 80 ? 1 : 7)) {
+        for (size_t oa = 0; oa < MAX_OFF; oa += 3) {
+            for (size_t ob = 0; ob < MAX_OFF; ob++) {
+                const unsigned char* a = g_src + oa;
+                unsigned char* b = g_dst + ob;
+                memcpy(b, a, len);
+                for (size_t pos = 0; pos <= len; pos++) {
+                    for (int delta = -1; delta <= 1; delta += 2) {
+                        unsigned char saved = pos < len ? b[pos] : 0;
+                        if (pos < len) b[pos] = (unsigned char)(a[pos] ^ (delta > 0 ? 0x80u : 0x01u));
+                        int want = sign(memcmp(a, b, len)), got = sign(fn(a, b, len));
+                        if (pos < len) b[pos] = saved;
+                        if (got != want) {
+                            fprintf(stderr, "MISMATCH: %s len %zu a+%zu b+%zu diff at %zu\n", name, len, oa, ob, pos);
+                            return -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int check_strlen(size_t (*fn)(const char*), const char* name) {
+    for (size_t off = 0; off < MAX_OFF; off++) {
+        char* s = g_str + off;
+        for (size_t i = 0; i <= CHECK_LEN + 8; i++) s[i] = (char)(1 + rand() % 255);  /* 1..255, 含 0x80 以上 */
+        for (size_t len = 0; len <= CHECK_LEN; len++) {
+            char saved = s[len];
+            s[len] = '\0';
+            size_t got = fn(s);
+            s[len] = saved;
+            if (got != len) {
+                fprintf(stderr, "MISMATCH: %s len %zu str+%zu returned %zu\n", name, len, off, got);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* 目标字节放在每个位置上 (或不出现), 目标值覆盖 0 / 高位字节 / 只看低 8 位的 int */
+static int check_memchr(void* (*fn)(const void*, int, size_t), const char* name) {
+    static const int targets[] = {0, 0x41, 0x80, 0xFF, 0x141};
+    for (size_t t = 0; t < sizeof targets / sizeof targets[0]; t++) {
+        unsigned char c = (unsigned char)targets[t];
+        for (size_t off = 0; off < MAX_OFF; off += 3) {
+            unsigned char* p = g_dst + off;
+            for (size_t len = 0; len <= CHECK_LEN; len += (len < 80 ? 1 : 5)) {
+                for (size_t i = 0; i < len + 1; i++) p[i] = g_src[i] == c ? (unsigned char)(c + 1) : g_src[i];
+                for (size_t pos = 0; pos <= len; pos++) {  /* pos == len: 不出现 (紧跟在末尾之后的字节也不是) */
+                    if (pos < len) p[pos] = c;
+                    const void* want = pos < len ? p + pos : NULL;
+                    const void* got = fn(p, targets[t], len);
+                    if (pos < len) p[pos] = g_src[pos] == c ? (unsigned char)(c + 1) : g_src[pos];
+                    if (got != want) {
+                        fprintf(stderr, "MISMATCH: %s c 0x%x len %zu src+%zu at %zu\n", name, targets[t], len, off, pos);
+                        return -1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int self_check(void) {
+    if (check_memcpy(my_memcpy, "my_memcpy") || check_memcpy(my_memcpy_naive, "my_memcpy_naive")) return -1;
+    if (check_memmove()) return -1;
+    if (check_memset(my_memset, "my_memset") || check_memset(my_memset_naive, "my_memset_naive")) return -1;
+    if (check_memcmp(my_memcmp, "my_memcmp") || check_memcmp(my_memcmp_naive, "my_memcmp_naive")) return -1;
+    if (check_strlen(my_strlen, "my_strlen") || check_strlen(my_strlen_naive, "my_strlen_naive")) return -1;
+    if (check_memchr(my_memchr, "my_memchr") || check_memchr(my_memchr_naive, "my_memchr_naive")) return -1;
+    return 0;
+}
+
+static void report(bench_t* b, size_t len) {
+    bench_set_size(b, len, len);
+    bench_report(b);
+}
+
+static void bench_len(size_t len) {
+    bench_t b;
+    BENCH(b, "memcpy/naive", { my_memcpy_naive(g_dst, g_src, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memcpy/fast", { my_memcpy(g_dst, g_src, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memcpy/fast src+1", { my_memcpy(g_dst, g_src + 1, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memcpy/libc", { memcpy(g_dst, g_src, len); BENCH_CLOBBER(); });
+    report(&b, len);
+
+    /* 环形缓冲区整理 / 删除元素的典型形状: 区间向前挪一小段 (d < s, 重叠) */
+    BENCH(b, "memmove/fast overlap", { my_memmove(g_dst, g_dst + 8, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memmove/libc overlap", { memmove(g_dst, g_dst + 8, len); BENCH_CLOBBER(); });
+    report(&b, len);
+
+    BENCH(b, "memset/naive", { my_memset_naive(g_dst, (int)i_, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memset/fast", { my_memset(g_dst, (int)i_, len); BENCH_CLOBBER(); });
+    report(&b, len);
+    BENCH(b, "memset/libc", { memset(g_dst, (int)i_, len); BENCH_CLOBBER(); });
+    report(&b, len);
+
+    /* 相等的两块: 比较必须扫到末尾 */
+    memcpy(g_ref, g_src, len);
+    BENCH(b, "memcmp/naive", BENCH_DO_NOT_OPTIMIZE(my_memcmp_naive(g_src, g_ref, len)));
+    report(&b, len);
+    BENCH(b, "memcmp/fast", BENCH_DO_NOT_OPTIMIZE(my_memcmp(g_src, g_ref, len)));
+    report(&b, len);
+    BENCH(b, "memcmp/libc", BENCH_DO_NOT_OPTIMIZE(memcmp(g_src, g_ref, len)));
+    report(&b, len);
+
+    /* g_str 前 len 个字节都是 'a': strlen 扫到结尾, memchr 找不存在的字节 */
+    memset(g_str, 'a', len);
+    g_str[len] = '\0';
+    BENCH(b, "strlen/naive", BENCH_DO_NOT_OPTIMIZE(my_strlen_naive(g_str)));
+    report(&b, len);
+    BENCH(b, "strlen/fast", BENCH_DO_NOT_OPTIMIZE(my_strlen(g_str)));
+    report(&b, len);
+    BENCH(b, "strlen/libc", BENCH_DO_NOT_OPTIMIZE(strlen(g_str)));
+    report(&b, len);
+    BENCH(b, "memchr/naive", BENCH_DO_NOT_OPTIMIZE(my_memchr_naive(g_str, 'z', len)));
+    report(&b, len);
+    BENCH(b, "memchr/fast", BENCH_DO_NOT_OPTIMIZE(my_memchr(g_str, 'z', len)));
+    report(&b, len);
+    BENCH(b, "memchr/libc", BENCH_DO_NOT_OPTIMIZE(memchr(g_str, 'z', len)));
+    report(&b, len);
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    srand(1);
+    for (size_t i = 0; i < sizeof g_src; i++) g_src[i] = (unsigned char)rand();
+    if (self_check() != 0) return 1;
+
+    static const size_t defaults[] = {16, 64, 256, 4096, MAX_LEN};
+    const size_t* sizes;
+    size_t n = bench_sizes(defaults, sizeof defaults / sizeof defaults[0], &sizes);
+    for (size_t i = 0; i < n; i++) {
+        if (sizes[i] > MAX_LEN) {
+            fprintf(stderr, "# skip size %zu: buffers are %u bytes\n", sizes[i], MAX_LEN);
+            continue;
+        }
+        bench_len(sizes[i]);
+    }
+    return bench_summary();
+}
@@ -0,0 +1,157 @@
+/* 埋点开销测试: TRACE_BEGIN/END 与 snprintf 式日志对比, 并自检导出的 JSON
+ * 编译: gcc -O2 -std=c11 -DBENCH_NO_MAIN -DTRACE_ENABLE bench_trace.c trace.c benchmark.c -o bench_trace -lm
+ * 设置环境变量 TRACE_JSON=文件名 时, 把一段带嵌套作用域和计数器的示例轨迹写到该文件,
+ * 用 ui.perfetto.dev 或 chrome://tracing 打开.
+ */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1  /* 本测试就是测埋点本身 */
+#endif
+#include "trace.h"  /* 最先包含: 经 benchmark.h 定义了 POSIX 特性宏 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#define N_OPS    256u
+#define RING_CAP 4096u
+
+enum { TR_STEP, TR_FILTER, TR_PID, TR_FILL, TR_TICK };
+
+static trace_event_t g_buf[RING_CAP];
+static trace_ring_t g_ring;
+static char g_line[64];
+
+/* 被测的 "控制环" 一步: 几条整数运算, 量级与一次 Q15 滤波相当 */
+static inline uint32_t step(uint32_t x) { return (x * 2654435761u) ^ (x >> 13); }
+
+static void bench_probes(void) {
+    bench_t b;
+    uint32_t x = 1;
+    BENCH(b, "step (no probe)", {
+        for (uint32_t k = 0; k < N_OPS; k++) x = step(x);
+        BENCH_DO_NOT_OPTIMIZE(x);
+    });
+    bench_set_size(&b, N_OPS, 0);
+    bench_report(&b);
+
+    BENCH(b, "step + TRACE_BEGIN/END", {
+        for (uint32_t k = 0; k < N_OPS; k++) {
+            TRACE_BEGIN(TR_STEP);
+            x = step(x);
+            TRACE_END(TR_STEP);
+        }
+        BENCH_DO_NOT_OPTIMIZE(x);
+    });
+    bench_set_size(&b, N_OPS, 0);
+    bench_report(&b);
+
+    BENCH(b, "step + TRACE_COUNTER", {
+        for (uint32_t k = 0; k < N_OPS; k++) {
+            x = step(x);
+            TRACE_COUNTER(TR_FILL, x & 0xFFu);
+        }
+        BENCH_DO_NOT_OPTIMIZE(x);
+    });
+    bench_set_size(&b, N_OPS, 0);
+    bench_report(&b);
+
+    /* 对照: 只格式化不输出, 已经比埋点贵一个数量级; 真正 printf 到串口还要再加上传输时间 */
+    BENCH(b, "step + snprintf", {
+        for (uint32_t k = 0; k < N_OPS; k++) {
+            x = step(x);
+            snprintf(g_line, sizeof g_line, "t=%lu step %u\n", (unsigned long)k, (unsigned)x);
+        }
+        BENCH_DO_NOT_OPTIMIZE(g_line[0]);
+    });
+    bench_set_size(&b, N_OPS, 0);
+    bench_report(&b);
+}
+
+/* 嵌套作用域 + 计数器 + 瞬时事件, 用于自检和示例轨迹 */
+static void sample_trace(uint32_t steps) {
+    uint32_t x = 7;
+    for (uint32_t k = 0; k < steps; k++) {
+        TRACE_BEGIN(TR_STEP);
+        TRACE_BEGIN(TR_FILTER);
+        x = step(x);
+        TRACE_END(TR_FILTER);
+        TRACE_BEGIN(TR_PID);
+        x = step(x);
+        TRACE_END(TR_PID);
+        TRACE_COUNTER(TR_FILL, k % 17u);
+        if (k % 8u == 0) TRACE_INSTANT(TR_TICK);
+        TRACE_END(TR_STEP);
+    }
+    BENCH_DO_NOT_OPTIMIZE(x);
+}
+
+static long export_count(const trace_ring_t* r, char* json, size_t cap) {
+    FILE* f = tmpfile();
+    if (f == NULL) return -2;
+    trace_ring_t* rings[] = {(trace_ring_t*)r};
+    long n = trace_write_json(f, rings, 1);
+    size_t len = 0;
+    if (json != NULL) {
+        rewind(f);
+        len = fread(json, 1, cap - 1, f);
+        json[len] = '\0';
+    }
+    fclose(f);
+    return n;
+}
+
+/* 每步 7 条记录 (3 对 BEGIN/END, 1 个计数器) + 每 8 步一个瞬时事件 */
+static int self_check(void) {
+    static char json[1 << 16];
+    trace_ring_clear(&g_ring);
+    sample_trace(16);
+    if (g_ring.head != 16u * 7u + 2u) return 0;
+    if (export_count(&g_ring, json, sizeof json) != 16 * 7 + 2) return 0;
+    if (strstr(json, "\"name\": \"pid_update\", \"ph\": \"B\"") == NULL) return 0;
+    if (strstr(json, "\"args\": {\"value\": 15}") == NULL) return 0;
+
+    /* 覆盖后: 环里只剩最近 RING_CAP 条, 开头失去 BEGIN 的 END 被丢弃, 导出数 <= 容量 */
+    trace_ring_clear(&g_ring);
+    sample_trace(RING_CAP / 7u + 3u);
+    long n = export_count(&g_ring, NULL, 0);
+    if (trace_ring_lost(&g_ring) == 0 || n <= 0 || n > (long)RING_CAP) return 0;
+
+    /* 长期运行: head 在 2^32 处回绕. 直接把环摆到回绕前 5 条的状态 (laps 与 head 一致), 再写一圈多 */
+    trace_ring_clear(&g_ring);
+    g_ring.laps = (uint32_t)(((uint64_t)1 << 32) / RING_CAP) - 1u;
+    g_ring.head = 0u - 5u;
+    uint64_t before = (uint64_t)g_ring.laps * RING_CAP + (RING_CAP - 5u);
+    sample_trace(RING_CAP / 7u + 3u);
+    uint64_t written = (uint32_t)(g_ring.head + 5u);
+    n = export_count(&g_ring, NULL, 0);
+    if (g_ring.head >= written || trace_ring_lost(&g_ring) != before + written - RING_CAP) return 0;
+    if (n <= 0 || n > (long)RING_CAP) return 0;
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    if (bench_parse_args(argc, argv)) return 2;
+    trace_ring_init(&g_ring, g_buf, RING_CAP, "control");
+    trace_attach(&g_ring);
+    trace_set_name(TR_STEP, "control_step");
+    trace_set_name(TR_FILTER, "filter");
+    trace_set_name(TR_PID, "pid_update");
+    trace_set_name(TR_FILL, "rx_fill");
+    trace_set_name(TR_TICK, "tick");
+
+    if (!self_check()) {
+        fprintf(stderr, "MISMATCH: trace ring / JSON export self-check failed\n");
+        return 1;
+    }
+    bench_probes();
+
+    const char* path = getenv("TRACE_JSON");
+    if (path != NULL) {
+        trace_ring_clear(&g_ring);
+        sample_trace(200);
+        FILE* f = fopen(path, "w");
+        long n = trace_write_json(f, (trace_ring_t* const[]){&g_ring}, 1);
+        if (f != NULL) fclose(f);
+        fprintf(stderr, "# wrote %ld trace events to %s\n", n, path);
+    }
+    return bench_summary();
+}
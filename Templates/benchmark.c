@@ -1,5 +1,677 @@
-#include <stdio.h>
+/* 性能测试模板 - 计时后端 / 统计框架实现 + 示例
+ * 编译: gcc -O2 benchmark.c -lm        (作为库链接时加 -DBENCH_NO_MAIN)
+ *       gcc -O2 -DBENCH_TIMER=BENCH_TIMER_TSC benchmark.c   (x86 周期计数)
+ *       ./a.out --counters                                  (附带 perf 硬件计数器)
+ */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* syscall(SYS_perf_event_open); 同时覆盖 benchmark.h 里的 POSIX 特性宏 */
+#endif
+#include "benchmark.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_OVERHEAD_SAMPLES 1000   /* 取最小值, 排除中断/调度干扰 */
+#define BENCH_TSC_CALIB_NS     20000000u
+
+static int g_timer_ready;
+static bench_tick_t g_overhead;
+static double g_ns_per_tick = 1.0;
+
+#if BENCH_TIMER == BENCH_TIMER_TSC && (defined(__unix__) || defined(__APPLE__))
 #include <time.h>
-#define TIME_IT(func) do { clock_t s = clock(); func; clock_t e = clock(); printf("Time: %f s\n", (double)(e-s)/CLOCKS_PER_SEC); } while(0)
-void test_func() { for(volatile int i=0; i<1000000; i++); }
-int main() { TIME_IT(test_func()); return 0; }
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+void bench_timer_init(void) {
+    if (g_timer_ready) return;
+    g_timer_ready = 1;
+
+#if BENCH_TIMER == BENCH_TIMER_DWT
+    BENCH_DEMCR |= 1u << 24;        /* TRCENA */
+    BENCH_DWT_LAR = 0xC5ACCE55u;
+    BENCH_DWT_CYCCNT = 0;
+    BENCH_DWT_CTRL |= 1u;           /* CYCCNTENA */
+#ifdef BENCH_CPU_HZ
+    g_ns_per_tick = 1e9 / (double)(BENCH_CPU_HZ);
+#else
+    g_ns_per_tick = 0.0;
+#endif
+#elif BENCH_TIMER == BENCH_TIMER_TSC
+#if defined(__unix__) || defined(__APPLE__)
+    /* 对照单调时钟忙等一小段时间, 标定 TSC 频率 */
+    uint64_t t0 = mono_ns();
+    bench_tick_t c0 = bench_start();
+    uint64_t t1;
+    do { t1 = mono_ns(); } while (t1 - t0 < BENCH_TSC_CALIB_NS);
+    bench_tick_t c1 = bench_stop();
+    g_ns_per_tick = (double)(t1 - t0) / (double)(c1 - c0);
+#else
+    g_ns_per_tick = 0.0;
+#endif
+#endif
+
+    bench_tick_t best = (bench_tick_t)-1;
+    for (int i = 0; i < BENCH_OVERHEAD_SAMPLES; i++) {
+        bench_tick_t s = bench_start();
+        bench_tick_t e = bench_stop();
+        bench_tick_t d = bench_elapsed(s, e);
+        if (d < best) best = d;
+    }
+    g_overhead = best;
+}
+
+bench_tick_t bench_timer_overhead(void) {
+    bench_timer_init();
+    return g_overhead;
+}
+
+bench_tick_t bench_net(bench_tick_t start, bench_tick_t stop) {
+    bench_tick_t d = bench_elapsed(start, stop);
+    return d > g_overhead ? d - g_overhead : 0;
+}
+
+double bench_ticks_to_ns(double ticks) {
+    bench_timer_init();
+    return ticks * g_ns_per_tick;
+}
+
+double bench_ticks_to_cycles(double ticks) {
+#if BENCH_TIMER == BENCH_TIMER_DWT || BENCH_TIMER == BENCH_TIMER_TSC
+    return ticks;
+#elif defined(BENCH_CPU_HZ)
+    return bench_ticks_to_ns(ticks) * (double)(BENCH_CPU_HZ) / 1e9;
+#else
+    (void)ticks;
+    return 0.0;
+#endif
+}
+
+/* ---------------- 统计框架 ---------------- */
+
+#define BENCH_PHASE_CALIBRATE 0
+#define BENCH_PHASE_WARMUP    1
+#define BENCH_PHASE_SAMPLE    2
+#define BENCH_PHASE_DONE      3
+#define BENCH_CALIB_MAX_GROW  10.0   /* 标定时每轮迭代次数最多放大的倍数 */
+
+bench_config_t bench_config = {
+    100,        /* samples */
+    5,          /* warmup */
+    100000.0,   /* min_sample_ns: 100 us */
+    1u << 30,   /* max_iters */
+};
+
+#if !defined(__GNUC__)
+volatile uintptr_t bench_sink;
+#endif
+
+static double g_samples[BENCH_MAX_SAMPLES];  /* 每个样本的单次迭代耗时 (ticks) */
+
+/* 最短样本时间换算成 ticks; DWT 未知主频时直接把配置值当作 cycles */
+static double min_sample_ticks(void) {
+    double ns_per_tick = bench_ticks_to_ns(1.0);
+    return ns_per_tick > 0.0 ? bench_config.min_sample_ns / ns_per_tick : bench_config.min_sample_ns;
+}
+
+/* ---------------- 硬件性能计数器 (--counters) ----------------
+ * 每个正式样本前后各读一次, 差值累加; 计时区间内不做任何额外的事情. */
+
+static int g_pmu_on;
+static unsigned g_pmu_have;                  /* 位掩码: 成功打开的事件 */
+static uint64_t g_pmu_start[BENCH_PMU_N];
+static uint64_t g_pmu_start_en, g_pmu_start_run;
+static double g_pmu_sum[BENCH_PMU_N];
+static uint64_t g_pmu_iters;
+static const char* const g_pmu_names[BENCH_PMU_N] = {"cycles", "instructions", "l1d-misses", "llc-misses",
+                                                     "branch-misses"};
+
+#if BENCH_PMU == BENCH_PMU_PERF
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define BENCH_PMU_MASK UINT64_MAX
+#define PERF_CACHE_EVENT(cache, op, result) ((cache) | ((op) << 8) | ((result) << 16))
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} g_perf_events[BENCH_PMU_N] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     PERF_CACHE_EVENT(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static int g_pmu_fd = -1;                    /* 事件组组长, 整组一次 read */
+static int g_pmu_slot[BENCH_PMU_N];          /* 事件在组读取结果中的位置 */
+static int g_pmu_nr;
+
+static int perf_open(uint32_t type, uint64_t config, int group) {
+    struct perf_event_attr a;
+    memset(&a, 0, sizeof a);
+    a.size = sizeof a;
+    a.type = type;
+    a.config = config;
+    a.disabled = group < 0;                  /* 组长先关着, 组员都加进来后整组使能 */
+    a.exclude_kernel = 1;
+    a.exclude_hv = 1;
+    a.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &a, 0, -1, group, 0);
+}
+
+static int pmu_open(void) {
+    int err = 0;
+    for (int k = 0; k < BENCH_PMU_N; k++) {
+        g_pmu_slot[k] = -1;
+        int fd = perf_open(g_perf_events[k].type, g_perf_events[k].config, g_pmu_fd);
+        if (fd < 0) {
+            if (err == 0) err = errno;
+            continue;                        /* 个别事件不支持时其余照常 */
+        }
+        if (g_pmu_fd < 0) g_pmu_fd = fd;
+        g_pmu_slot[k] = g_pmu_nr++;
+        g_pmu_have |= 1u << k;
+    }
+    if (g_pmu_fd < 0) {
+        fprintf(stderr, "# counters unavailable: perf_event_open: %s (no hardware PMU, or perf_event_paranoid > 2)\n",
+                strerror(err));
+        return -1;
+    }
+    ioctl(g_pmu_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(g_pmu_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 0;
+}
+
+/* 组读取格式: nr, time_enabled, time_running, value[nr] */
+static int pmu_read(uint64_t* v, uint64_t* t_en, uint64_t* t_run) {
+    uint64_t buf[3 + BENCH_PMU_N];
+    ssize_t want = (ssize_t)((3 + (size_t)g_pmu_nr) * sizeof(uint64_t));
+    if (read(g_pmu_fd, buf, sizeof buf) < want) return -1;
+    *t_en = buf[1];
+    *t_run = buf[2];
+    for (int k = 0; k < BENCH_PMU_N; k++) v[k] = g_pmu_slot[k] >= 0 ? buf[3 + g_pmu_slot[k]] : 0;
+    return 0;
+}
+
+#elif BENCH_PMU == BENCH_PMU_ARMV8M
+#define BENCH_PMU_MASK     UINT32_MAX
+#define PMU_DEMCR          (*(volatile uint32_t*)0xE000EDFCu)
+#define PMU_EVCNTR(n)      (*(volatile uint32_t*)(0xE0003000u + 4u * (n)))
+#define PMU_CCNTR          (*(volatile uint32_t*)0xE000307Cu)
+#define PMU_EVTYPER(n)     (*(volatile uint32_t*)(0xE0003400u + 4u * (n)))
+#define PMU_CNTENSET       (*(volatile uint32_t*)0xE0003C00u)
+#define PMU_CTRL           (*(volatile uint32_t*)0xE0003E04u)
+#define PMU_EV_CHAIN       0x001Eu
+
+/* Armv8-M PMU 架构事件号; 下标 0 (周期) 用独立的 32 位 PMU_CCNTR */
+static const uint16_t g_pmu_events[BENCH_PMU_N] = {
+    0x0011u,   /* CPU_CYCLES */
+    0x0008u,   /* INST_RETIRED */
+    0x0003u,   /* L1D_CACHE_REFILL */
+    0x0037u,   /* LL_CACHE_MISS_RD (没有外部缓存时不计数) */
+    0x0010u,   /* BR_MIS_PRED */
+};
+
+static int pmu_open(void) {
+    PMU_DEMCR |= 1u << 24;                   /* TRCENA */
+    for (unsigned k = 1; k < BENCH_PMU_N; k++) {
+        unsigned lo = 2u * (k - 1u);         /* 偶数计数器计事件, 奇数计数器计它的溢出 (CHAIN) */
+        PMU_EVTYPER(lo) = g_pmu_events[k];
+        PMU_EVTYPER(lo + 1u) = PMU_EV_CHAIN;
+        PMU_CNTENSET = 3u << lo;
+    }
+    PMU_CNTENSET = 1u << 31;                 /* 周期计数器 */
+    PMU_CTRL = 1u | 2u | 4u;                 /* 使能, 清零事件计数器与周期计数器 */
+    g_pmu_have = (1u << BENCH_PMU_N) - 1u;
+    return 0;
+}
+
+/* 读两段 16 位计数器时低半段可能正好进位: 高半段前后不一致就重读 */
+static uint32_t pmu_chained(unsigned lo) {
+    uint32_t hi, v;
+    do {
+        hi = PMU_EVCNTR(lo + 1u);
+        v = PMU_EVCNTR(lo) & 0xFFFFu;
+    } while (hi != PMU_EVCNTR(lo + 1u));
+    return (hi << 16) | v;
+}
+
+static int pmu_read(uint64_t* v, uint64_t* t_en, uint64_t* t_run) {
+    v[0] = PMU_CCNTR;
+    for (unsigned k = 1; k < BENCH_PMU_N; k++) v[k] = pmu_chained(2u * (k - 1u));
+    *t_en = *t_run = 0;                      /* 没有复用, 不需要缩放 */
+    return 0;
+}
+
+#else
+#define BENCH_PMU_MASK UINT64_MAX
+
+static int pmu_open(void) {
+    fprintf(stderr, "# counters unavailable: no PMU backend for this target (BENCH_PMU_NONE)\n");
+    return -1;
+}
+
+static int pmu_read(uint64_t* v, uint64_t* t_en, uint64_t* t_run) {
+    (void)v;
+    (void)t_en;
+    (void)t_run;
+    return -1;
+}
+#endif
+
+int bench_pmu_enabled(void) { return g_pmu_on; }
+
+void bench_pmu_begin(bench_t* b) {
+    if (!g_pmu_on || b->phase_ != BENCH_PHASE_SAMPLE) return;
+    pmu_read(g_pmu_start, &g_pmu_start_en, &g_pmu_start_run);
+}
+
+void bench_pmu_end(bench_t* b) {
+    if (!g_pmu_on || b->phase_ != BENCH_PHASE_SAMPLE) return;
+    uint64_t v[BENCH_PMU_N], en, run;
+    if (pmu_read(v, &en, &run)) return;
+    /* 事件组被内核分时复用时按 "启用时间 / 实际计数时间" 放大; 这段时间内完全没计数就丢弃该样本 */
+    double scale = 1.0;
+    if (en != g_pmu_start_en) {
+        if (run == g_pmu_start_run) return;
+        scale = (double)(en - g_pmu_start_en) / (double)(run - g_pmu_start_run);
+    }
+    for (int k = 0; k < BENCH_PMU_N; k++)
+        g_pmu_sum[k] += (double)((v[k] - g_pmu_start[k]) & BENCH_PMU_MASK) * scale;
+    g_pmu_iters += b->iters;
+}
+
+void bench_begin(bench_t* b, const char* name) {
+    bench_timer_init();
+    b->name = name;
+    b->n = 0;
+    b->bytes = 0;
+    b->iters = 1;
+    b->samples = 0;
+    b->min = b->median = b->p90 = b->p99 = b->max = b->mean = b->stddev = 0.0;
+    for (int k = 0; k < BENCH_PMU_N; k++) {
+        b->pmu[k] = 0.0;
+        g_pmu_sum[k] = 0.0;
+    }
+    g_pmu_iters = 0;
+    b->phase_ = BENCH_PHASE_CALIBRATE;
+    b->left_ = 0;
+}
+
+int bench_next(bench_t* b) {
+    return b->phase_ != BENCH_PHASE_DONE;
+}
+
+static void start_sampling(bench_t* b) {
+    b->phase_ = BENCH_PHASE_SAMPLE;
+    b->left_ = bench_config.samples < BENCH_MAX_SAMPLES ? bench_config.samples : BENCH_MAX_SAMPLES;
+    if (b->left_ == 0) b->left_ = 1;
+}
+
+void bench_record(bench_t* b, bench_tick_t ticks) {
+    switch (b->phase_) {
+    case BENCH_PHASE_CALIBRATE: {
+        /* 迭代次数按实测比例放大, 直到单个样本达到最短测量时间 */
+        double target = min_sample_ticks();
+        if ((double)ticks < target && b->iters < bench_config.max_iters) {
+            double grow = ticks > 0 ? 1.2 * target / (double)ticks : BENCH_CALIB_MAX_GROW;
+            if (grow > BENCH_CALIB_MAX_GROW) grow = BENCH_CALIB_MAX_GROW;
+            if (grow < 2.0) grow = 2.0;
+            double next = (double)b->iters * grow;
+            b->iters = next > (double)bench_config.max_iters ? bench_config.max_iters : (uint64_t)next;
+            return;
+        }
+        b->phase_ = BENCH_PHASE_WARMUP;
+        b->left_ = bench_config.warmup;
+        if (b->left_ == 0) start_sampling(b);
+        return;
+    }
+    case BENCH_PHASE_WARMUP:
+        if (--b->left_ == 0) start_sampling(b);
+        return;
+    case BENCH_PHASE_SAMPLE:
+        g_samples[b->samples++] = (double)ticks / (double)b->iters;
+        if (--b->left_ == 0) b->phase_ = BENCH_PHASE_DONE;
+        return;
+    default:
+        return;
+    }
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* 最近秩法 (nearest-rank) 百分位 */
+static double percentile(const double* sorted, size_t n, double p) {
+    size_t rank = (size_t)ceil(p * (double)n);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void bench_finish(bench_t* b) {
+    size_t n = b->samples;
+    if (n == 0) return;
+    qsort(g_samples, n, sizeof(g_samples[0]), cmp_double);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += g_samples[i];
+    double mean = sum / (double)n;
+    double var = 0.0;
+    for (size_t i = 0; i < n; i++) var += (g_samples[i] - mean) * (g_samples[i] - mean);
+    b->min = g_samples[0];
+    b->max = g_samples[n - 1];
+    b->median = n % 2 ? g_samples[n / 2] : 0.5 * (g_samples[n / 2 - 1] + g_samples[n / 2]);
+    b->p90 = percentile(g_samples, n, 0.90);
+    b->p99 = percentile(g_samples, n, 0.99);
+    b->mean = mean;
+    b->stddev = n > 1 ? sqrt(var / (double)(n - 1)) : 0.0;
+    if (g_pmu_iters > 0) {
+        for (int k = 0; k < BENCH_PMU_N; k++)
+            b->pmu[k] = (g_pmu_have >> k) & 1u ? g_pmu_sum[k] / (double)g_pmu_iters : 0.0;
+    }
+}
+
+void bench_set_size(bench_t* b, size_t n, size_t bytes) {
+    b->n = n;
+    b->bytes = bytes;
+}
+
+/* ---------------- 输出 (text/csv/json) 与基线对比 ---------------- */
+
+#define BENCH_FMT_TEXT 0
+#define BENCH_FMT_CSV  1
+#define BENCH_FMT_JSON 2
+
+#ifndef BENCH_MAX_BASELINE
+#define BENCH_MAX_BASELINE 512
+#endif
+#define BENCH_NAME_MAX      96
+#define BENCH_LINE_MAX      512
+#define BENCH_DEFAULT_THRESHOLD 10.0
+
+typedef struct {
+    char   name[BENCH_NAME_MAX];
+    size_t n;
+    double ns;       /* 中位数 ns/op */
+    double cycles;   /* 中位数 cycles/op */
+} baseline_t;
+
+static int g_format = BENCH_FMT_TEXT;
+static FILE* g_out;
+static size_t g_rows;
+static double g_threshold = BENCH_DEFAULT_THRESHOLD;
+static baseline_t g_base[BENCH_MAX_BASELINE];
+static size_t g_base_n;
+static int g_have_base;
+static size_t g_compared, g_regressions;
+
+static FILE* out_stream(void) { return g_out ? g_out : stdout; }
+
+/* CSV 字段: 名字总是加引号, 内部引号写成两个 */
+static void csv_write_name(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"') fputc('"', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void json_write_name(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+/* 解析一行 CSV 的第一个字段 (可能带引号), 返回指向其后逗号之后的位置, 失败返回 NULL */
+static const char* csv_read_name(const char* p, char* out, size_t cap) {
+    size_t len = 0;
+    if (*p == '"') {
+        for (p++; *p; p++) {
+            if (*p == '"') {
+                if (p[1] != '"') break;
+                p++;
+            }
+            if (len + 1 < cap) out[len++] = *p;
+        }
+        if (*p != '"') return NULL;
+        p++;
+    } else {
+        for (; *p && *p != ','; p++)
+            if (len + 1 < cap) out[len++] = *p;
+    }
+    out[len] = '\0';
+    return *p == ',' ? p + 1 : NULL;
+}
+
+/* 读取 CSV 基线, 列顺序与 bench_report 的 CSV 输出一致 */
+static int load_baseline(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "bench: cannot open baseline '%s'\n", path);
+        return -1;
+    }
+    char line[BENCH_LINE_MAX];
+    while (fgets(line, sizeof(line), f) && g_base_n < BENCH_MAX_BASELINE) {
+        baseline_t* e = &g_base[g_base_n];
+        const char* p = csv_read_name(line, e->name, sizeof(e->name));
+        if (!p) continue;
+        unsigned long long n, iters, samples;
+        double ns, mn, p99, sd, bps, cyc = 0.0;
+        int got = sscanf(p, "%llu,%llu,%llu,%lf,%lf,%lf,%lf,%lf,%lf",
+                         &n, &iters, &samples, &ns, &mn, &p99, &sd, &bps, &cyc);
+        if (got < 4) continue;   /* 表头或残缺行 */
+        e->n = (size_t)n;
+        e->ns = ns;
+        e->cycles = got >= 9 ? cyc : 0.0;
+        g_base_n++;
+    }
+    fclose(f);
+    g_have_base = 1;
+    return 0;
+}
+
+static const baseline_t* find_baseline(const char* name, size_t n) {
+    for (size_t i = 0; i < g_base_n; i++)
+        if (g_base[i].n == n && strcmp(g_base[i].name, name) == 0) return &g_base[i];
+    return NULL;
+}
+
+/* 与基线对比; 返回相对变化百分比, 没有可比数据时返回 NAN */
+static double compare_baseline(const bench_t* b, double ns, double cycles) {
+    const baseline_t* e = find_baseline(b->name, b->n);
+    if (!e) return NAN;
+    double base, cur;
+    const char* unit;
+    if (e->ns > 0.0 && ns > 0.0) { base = e->ns; cur = ns; unit = "ns"; }
+    else if (e->cycles > 0.0 && cycles > 0.0) { base = e->cycles; cur = cycles; unit = "cycles"; }
+    else return NAN;
+    double delta = (cur - base) / base * 100.0;
+    g_compared++;
+    if (delta > g_threshold) {
+        g_regressions++;
+        fprintf(stderr, "REGRESSION %s [n=%zu]: %.2f -> %.2f %s/op (%+.1f%%)\n",
+                b->name, b->n, base, cur, unit, delta);
+    }
+    return delta;
+}
+
+void bench_report(const bench_t* b) {
+    FILE* f = out_stream();
+    double ns = bench_ticks_to_ns(b->median);
+    double cycles = bench_ticks_to_cycles(b->median);
+    double bps = (b->bytes > 0 && ns > 0.0) ? (double)b->bytes * 1e9 / ns : 0.0;
+    double delta = g_have_base ? compare_baseline(b, ns, cycles) : NAN;
+    const double* c = b->pmu;
+    double ipc = c[BENCH_PMU_CYCLES] > 0.0 ? c[BENCH_PMU_INSTRUCTIONS] / c[BENCH_PMU_CYCLES] : 0.0;
+
+    if (g_format == BENCH_FMT_CSV) {
+        if (g_rows == 0)
+            fprintf(f, "name,size,iters,samples,ns_per_op,min_ns,p99_ns,stddev_ns,bytes_per_s,cycles_per_op,"
+                       "pmu_cycles_per_op,instructions_per_op,ipc,l1d_misses_per_op,llc_misses_per_op,"
+                       "branch_misses_per_op\n");
+        csv_write_name(f, b->name);
+        fprintf(f, ",%zu,%llu,%zu,%.3f,%.3f,%.3f,%.3f,%.0f,%.3f",
+                b->n, (unsigned long long)b->iters, b->samples, ns,
+                bench_ticks_to_ns(b->min), bench_ticks_to_ns(b->p99), bench_ticks_to_ns(b->stddev),
+                bps, cycles);
+        fprintf(f, ",%.3f,%.3f,%.3f,%.4f,%.4f,%.4f\n", c[BENCH_PMU_CYCLES], c[BENCH_PMU_INSTRUCTIONS], ipc,
+                c[BENCH_PMU_L1D_MISSES], c[BENCH_PMU_LLC_MISSES], c[BENCH_PMU_BRANCH_MISSES]);
+    } else if (g_format == BENCH_FMT_JSON) {
+        fprintf(f, "%s\n  {\"name\": ", g_rows == 0 ? "[" : ",");
+        json_write_name(f, b->name);
+        fprintf(f, ", \"size\": %zu, \"iters\": %llu, \"samples\": %zu, \"ns_per_op\": %.3f, "
+                   "\"min_ns\": %.3f, \"p99_ns\": %.3f, \"stddev_ns\": %.3f, \"bytes_per_s\": %.0f, "
+                   "\"cycles_per_op\": %.3f",
+                b->n, (unsigned long long)b->iters, b->samples, ns,
+                bench_ticks_to_ns(b->min), bench_ticks_to_ns(b->p99), bench_ticks_to_ns(b->stddev),
+                bps, cycles);
+        fprintf(f, ", \"pmu_cycles_per_op\": %.3f, \"instructions_per_op\": %.3f, \"ipc\": %.3f, "
+                   "\"l1d_misses_per_op\": %.4f, \"llc_misses_per_op\": %.4f, \"branch_misses_per_op\": %.4f}",
+                c[BENCH_PMU_CYCLES], c[BENCH_PMU_INSTRUCTIONS], ipc, c[BENCH_PMU_L1D_MISSES],
+                c[BENCH_PMU_LLC_MISSES], c[BENCH_PMU_BRANCH_MISSES]);
+    } else {
+        if (g_rows == 0)
+            fprintf(f, "# timer overhead %llu %s (subtracted)\n",
+                    (unsigned long long)bench_timer_overhead(), BENCH_TICK_UNIT);
+        fprintf(f, "%-24s n=%-9zu %10llu iters x %3zu | %s/op  min %10.2f  med %10.2f  p90 %10.2f  p99 %10.2f  max %10.2f  sd %8.2f",
+                b->name, b->n, (unsigned long long)b->iters, b->samples, BENCH_TICK_UNIT,
+                b->min, b->median, b->p90, b->p99, b->max, b->stddev);
+        if (bps > 0.0) fprintf(f, "  %8.2f MB/s", bps / 1e6);
+        /* 每次迭代: IPC, 指令数, L1D/LLC 缺失, 分支预测失败 */
+        if (g_pmu_on)
+            fprintf(f, "  | ipc %5.2f  ins %10.1f  l1d-miss %8.2f  llc-miss %8.2f  br-miss %8.2f", ipc,
+                    c[BENCH_PMU_INSTRUCTIONS], c[BENCH_PMU_L1D_MISSES], c[BENCH_PMU_LLC_MISSES],
+                    c[BENCH_PMU_BRANCH_MISSES]);
+        if (!isnan(delta)) fprintf(f, "  %+6.1f%%%s", delta, delta > g_threshold ? " REGRESSION" : "");
+        fputc('\n', f);
+    }
+    g_rows++;
+}
+
+static const char* arg_value(const char* arg, const char* key) {
+    size_t len = strlen(key);
+    return strncmp(arg, key, len) == 0 ? arg + len : NULL;
+}
+
+static size_t g_sizes[BENCH_MAX_SIZES];
+static size_t g_sizes_n;
+
+/* "64,1024,16384" -> g_sizes; 空列表, 非数字或超过 BENCH_MAX_SIZES 个都算错误 */
+static int parse_sizes(const char* v) {
+    g_sizes_n = 0;
+    for (;;) {
+        char* end;
+        unsigned long long x = strtoull(v, &end, 10);
+        if (end == v || g_sizes_n == BENCH_MAX_SIZES) return -1;
+        g_sizes[g_sizes_n++] = (size_t)x;
+        if (*end == '\0') return 0;
+        if (*end != ',') return -1;
+        v = end + 1;
+    }
+}
+
+size_t bench_sizes(const size_t* defaults, size_t n_defaults, const size_t** sizes) {
+    if (g_sizes_n > 0) {
+        *sizes = g_sizes;
+        return g_sizes_n;
+    }
+    *sizes = defaults;
+    return n_defaults;
+}
+
+int bench_parse_args(int argc, char** argv) {
+    const char* v;
+    for (int i = 1; i < argc; i++) {
+        if ((v = arg_value(argv[i], "--format="))) {
+            if (strcmp(v, "text") == 0) g_format = BENCH_FMT_TEXT;
+            else if (strcmp(v, "csv") == 0) g_format = BENCH_FMT_CSV;
+            else if (strcmp(v, "json") == 0) g_format = BENCH_FMT_JSON;
+            else goto usage;
+        } else if ((v = arg_value(argv[i], "--out="))) {
+            g_out = fopen(v, "w");
+            if (!g_out) {
+                fprintf(stderr, "bench: cannot open '%s'\n", v);
+                return -1;
+            }
+        } else if ((v = arg_value(argv[i], "--baseline="))) {
+            if (load_baseline(v)) return -1;
+        } else if ((v = arg_value(argv[i], "--threshold="))) {
+            g_threshold = atof(v);
+        } else if ((v = arg_value(argv[i], "--sizes="))) {
+            if (parse_sizes(v)) goto usage;
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            if (!g_pmu_on && pmu_open() == 0) {
+                g_pmu_on = 1;
+                fprintf(stderr, "# counters:");
+                for (int k = 0; k < BENCH_PMU_N; k++)
+                    if ((g_pmu_have >> k) & 1u) fprintf(stderr, " %s", g_pmu_names[k]);
+                fputc('\n', stderr);
+            }
+        } else {
+            goto usage;
+        }
+    }
+    return 0;
+usage:
+    fprintf(stderr,
+            "usage: %s [--format=text|csv|json] [--out=FILE] [--baseline=FILE] [--threshold=PCT] [--sizes=N,N,...]"
+            " [--counters]\n",
+            argc > 0 ? argv[0] : "bench");
+    return -1;
+}
+
+int bench_summary(void) {
+    FILE* f = out_stream();
+    if (g_format == BENCH_FMT_JSON) fprintf(f, "%s]\n", g_rows == 0 ? "[" : "\n");
+    if (g_out) {
+        fclose(g_out);
+        g_out = NULL;
+    }
+    if (g_have_base)
+        fprintf(stderr, "bench: %zu compared against baseline, %zu regression(s) over %.1f%%\n",
+                g_compared, g_regressions, g_threshold);
+    return g_regressions ? 1 : 0;
+}
+
+void bench_run(bench_t* b, const char* name, bench_fn_t fn, void* ctx) {
+    BENCH(*b, name, fn(ctx));
+}
+
+#ifndef BENCH_NO_MAIN
+static void test_func(uint32_t n) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += i;
+        BENCH_DO_NOT_OPTIMIZE(acc);
+    }
+}
+
+int main(int argc, char** argv) {
+    static const size_t defaults[] = {1000, 10000};
+    const size_t* sizes;
+    if (bench_parse_args(argc, argv)) return 2;
+    size_t n = bench_sizes(defaults, sizeof(defaults) / sizeof(defaults[0]), &sizes);
+    for (size_t k = 0; k < n; k++) {
+        bench_t b;
+        BENCH(b, "test_func", test_func((uint32_t)sizes[k]));
+        bench_set_size(&b, sizes[k], 0);
+        bench_report(&b);
+    }
+    return bench_summary();
+}
+#endif
@@ -0,0 +1,261 @@
+/* 性能测试模板 - 高精度计时后端 + 统计测试框架 (实现见 benchmark.c)
+ *
+ * 后端在编译期选择, 可用 -DBENCH_TIMER=BENCH_TIMER_xxx 强制指定:
+ *   BENCH_TIMER_DWT   Cortex-M3/M4/M7/M33 的 DWT->CYCCNT, 单位 cycles (需定义 BENCH_CPU_HZ 才能换算 ns)
+ *   BENCH_TIMER_TSC   x86 rdtsc/rdtscp + lfence 串行化, 单位 cycles (TSC 参考周期, 启动时对 ns 标定)
+ *   BENCH_TIMER_POSIX clock_gettime(CLOCK_MONOTONIC_RAW), 单位 ns (Linux/Unix 默认)
+ *   BENCH_TIMER_CLOCK ISO C clock(), 单位 ns 但精度只有毫秒级, 仅作兜底
+ * 所有结果都已扣除计时器自身开销 (启动时测得的空 start/stop 最小值).
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/* clock_gettime 需要 POSIX 特性宏; 只有在任何系统头文件之前生效, 所以测试程序应最先包含本文件 */
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BENCH_TIMER_CLOCK 0
+#define BENCH_TIMER_POSIX 1
+#define BENCH_TIMER_TSC   2
+#define BENCH_TIMER_DWT   3
+
+#ifndef BENCH_TIMER
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define BENCH_TIMER BENCH_TIMER_DWT
+#elif defined(__unix__) || defined(__APPLE__)
+#define BENCH_TIMER BENCH_TIMER_POSIX
+#else
+#define BENCH_TIMER BENCH_TIMER_CLOCK
+#endif
+#endif
+
+typedef uint64_t bench_tick_t;
+
+#if BENCH_TIMER == BENCH_TIMER_DWT
+/* CoreSight 寄存器 (ARMv7-M ARM C1.8): DEMCR.TRCENA 打开跟踪单元, DWT_CTRL.CYCCNTENA 启动计数 */
+#define BENCH_DEMCR      (*(volatile uint32_t*)0xE000EDFCu)
+#define BENCH_DWT_CTRL   (*(volatile uint32_t*)0xE0001000u)
+#define BENCH_DWT_CYCCNT (*(volatile uint32_t*)0xE0001004u)
+#define BENCH_DWT_LAR    (*(volatile uint32_t*)0xE0001FB0u)  /* Cortex-M7 需先解锁 */
+#define BENCH_TICK_UNIT  "cycles"
+static inline bench_tick_t bench_now(void) { return BENCH_DWT_CYCCNT; }
+#define bench_start() bench_now()
+#define bench_stop()  bench_now()
+/* CYCCNT 只有 32 位, 按 32 位取差值即可正确处理一次回绕 */
+#define bench_elapsed(s, e) ((bench_tick_t)(uint32_t)((uint32_t)(e) - (uint32_t)(s)))
+
+#elif BENCH_TIMER == BENCH_TIMER_TSC
+#include <x86intrin.h>
+#define BENCH_TICK_UNIT "cycles"
+/* lfence 保证之前的指令都已完成, 且 rdtsc 不会被提前到被测代码之前 */
+static inline bench_tick_t bench_start(void) {
+    _mm_lfence();
+    bench_tick_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+/* rdtscp 等待之前的指令全部执行完; 之后的 lfence 阻止后续指令提前开始 */
+static inline bench_tick_t bench_stop(void) {
+    unsigned int aux;
+    bench_tick_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+#define bench_elapsed(s, e) ((e) - (s))
+
+#elif BENCH_TIMER == BENCH_TIMER_POSIX
+#include <time.h>
+#define BENCH_TICK_UNIT "ns"
+#ifdef CLOCK_MONOTONIC_RAW
+#define BENCH_CLOCK_ID CLOCK_MONOTONIC_RAW  /* 不受 NTP 调频影响 */
+#else
+#define BENCH_CLOCK_ID CLOCK_MONOTONIC
+#endif
+static inline bench_tick_t bench_now(void) {
+    struct timespec ts;
+    clock_gettime(BENCH_CLOCK_ID, &ts);
+    return (bench_tick_t)ts.tv_sec * 1000000000u + (bench_tick_t)ts.tv_nsec;
+}
+#define bench_start() bench_now()
+#define bench_stop()  bench_now()
+#define bench_elapsed(s, e) ((e) - (s))
+
+#else
+#include <time.h>
+#define BENCH_TICK_UNIT "ns"
+static inline bench_tick_t bench_now(void) {
+    return (bench_tick_t)clock() * (1000000000u / CLOCKS_PER_SEC);
+}
+#define bench_start() bench_now()
+#define bench_stop()  bench_now()
+#define bench_elapsed(s, e) ((e) - (s))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 计时器初始化: 使能 DWT / 标定 TSC 频率 / 测量计时开销. 可重复调用, 只生效一次. */
+void bench_timer_init(void);
+/* 一次空 start/stop 的开销 (ticks) */
+bench_tick_t bench_timer_overhead(void);
+/* 扣除计时开销后的净耗时 (ticks), 不会下溢 */
+bench_tick_t bench_net(bench_tick_t start, bench_tick_t stop);
+/* ticks -> ns; DWT 后端未定义 BENCH_CPU_HZ 时返回 0 */
+double bench_ticks_to_ns(double ticks);
+/* ticks -> cycles; 计时后端不是周期计数且未定义 BENCH_CPU_HZ 时返回 0 */
+double bench_ticks_to_cycles(double ticks);
+
+/* 计时一段代码, 输出扣除开销后的耗时 (ns 或 cycles, 取决于后端) */
+#define TIME_IT(func) do { \
+    bench_timer_init(); \
+    bench_tick_t s_ = bench_start(); \
+    func; \
+    bench_tick_t e_ = bench_stop(); \
+    printf("Time: %llu %s\n", (unsigned long long)bench_net(s_, e_), BENCH_TICK_UNIT); \
+} while (0)
+
+/* ---------------------------------------------------------------------------
+ * 统计测试框架: 自动标定迭代次数 -> 预热 -> 采样, 报告 min/median/p90/p99/max/stddev
+ *
+ *   int main(int argc, char** argv) {
+ *       if (bench_parse_args(argc, argv)) return 2;
+ *       bench_t b;
+ *       BENCH(b, "memcpy", my_memcpy(dst, src, 4096));
+ *       bench_set_size(&b, 4096, 4096);     // 输入规模 / 每次处理字节数 (用于 bytes/s)
+ *       bench_report(&b);
+ *       return bench_summary();             // 有性能回退时返回非 0
+ *   }
+ *
+ * 命令行参数 (bench_parse_args):
+ *   --format=text|csv|json   输出格式, 默认 text
+ *   --out=FILE               输出到文件而不是 stdout
+ *   --baseline=FILE          对比基线 (本程序 --format=csv 的输出), 回退信息写到 stderr
+ *   --threshold=PCT          中位数比基线慢超过 PCT% 视为回退, 默认 10
+ *   --sizes=N,N,...          覆盖测试程序自带的输入规模列表 (见 bench_sizes; 规模固定的测试忽略此项)
+ *   --counters               每个样本同时读取硬件性能计数器 (见下), 打不开时在 stderr 说明并继续只计时
+ * CSV/JSON 列: name, size, iters, samples, ns_per_op (中位数), min_ns, p99_ns, stddev_ns,
+ *              bytes_per_s, cycles_per_op, 以及计数器列 pmu_cycles_per_op, instructions_per_op, ipc,
+ *              l1d_misses_per_op, llc_misses_per_op, branch_misses_per_op;
+ *              取值为 0 表示该后端无法得到此数据 (未加 --counters 时计数器列全为 0).
+ *
+ * 硬件性能计数器后端 (编译期选择, 可用 -DBENCH_PMU=BENCH_PMU_xxx 强制指定):
+ *   BENCH_PMU_PERF    Linux perf_event_open, 一个事件组 (一次 read 读出全部), 只计用户态;
+ *                     虚拟机里通常没有硬件事件, 需要 perf_event_paranoid <= 2
+ *   BENCH_PMU_ARMV8M  Armv8.1-M PMU (Cortex-M55/M85), 16 位事件计数器两两级联成 32 位
+ *   BENCH_PMU_NONE    其他目标. Cortex-M3/M4/M7 的 DWT 只有 8 位的 CPI/LSU 等计数器, 一个样本内就会回绕,
+ *                     所以那里只有 DWT 周期数 (cycles_per_op)
+ * 计数器在计时区间之外读取, 数值是全部正式样本的总和 / 总迭代次数, 即每次迭代的平均值.
+ * ------------------------------------------------------------------------- */
+
+#define BENCH_PMU_NONE   0
+#define BENCH_PMU_PERF   1
+#define BENCH_PMU_ARMV8M 2
+
+#ifndef BENCH_PMU
+#if defined(__linux__)
+#define BENCH_PMU BENCH_PMU_PERF
+#elif defined(__ARM_ARCH_8_1M_MAIN__)
+#define BENCH_PMU BENCH_PMU_ARMV8M
+#else
+#define BENCH_PMU BENCH_PMU_NONE
+#endif
+#endif
+
+/* bench_t.pmu[] 的下标 */
+#define BENCH_PMU_CYCLES        0   /* 核心周期 (不同于 TSC 参考周期) */
+#define BENCH_PMU_INSTRUCTIONS  1
+#define BENCH_PMU_L1D_MISSES    2
+#define BENCH_PMU_LLC_MISSES    3
+#define BENCH_PMU_BRANCH_MISSES 4
+#define BENCH_PMU_N             5
+
+#ifndef BENCH_MAX_SAMPLES
+#define BENCH_MAX_SAMPLES 1024   /* 样本数组静态预分配, 热路径上不 malloc */
+#endif
+
+typedef struct {
+    size_t   samples;        /* 采样次数, 不超过 BENCH_MAX_SAMPLES */
+    size_t   warmup;         /* 预热样本数 (结果丢弃) */
+    double   min_sample_ns;  /* 单个样本的最短测量时间, 据此自动确定迭代次数 */
+    uint64_t max_iters;      /* 单个样本迭代次数上限 */
+} bench_config_t;
+
+extern bench_config_t bench_config;
+
+typedef struct {
+    const char* name;
+    size_t   n;              /* 输入规模 (元素个数), 0 表示未指定 */
+    size_t   bytes;          /* 每次迭代处理的字节数, 用于计算 bytes/s */
+    uint64_t iters;          /* 每个样本内的迭代次数 */
+    size_t   samples;        /* 有效样本数 */
+    /* 单次迭代耗时, 单位 BENCH_TICK_UNIT */
+    double   min, median, p90, p99, max, mean, stddev;
+    /* 每次迭代的平均计数, 下标 BENCH_PMU_xxx; 未启用或该事件不可用时为 0 */
+    double   pmu[BENCH_PMU_N];
+    /* 内部状态 */
+    int      phase_;
+    size_t   left_;
+} bench_t;
+
+void bench_begin(bench_t* b, const char* name);
+int  bench_next(bench_t* b);                      /* 还需要继续测量时返回 1 */
+void bench_record(bench_t* b, bench_tick_t ticks);
+void bench_finish(bench_t* b);
+void bench_set_size(bench_t* b, size_t n, size_t bytes);
+/* 在每个样本的计时区间前后调用 (BENCH/bench_run 已经做了); 未启用 --counters 时立即返回 */
+void bench_pmu_begin(bench_t* b);
+void bench_pmu_end(bench_t* b);
+/* --counters 生效 (计数器已打开) 时返回 1 */
+int  bench_pmu_enabled(void);
+void bench_report(const bench_t* b);             /* 按 --format 输出一行, 有基线时同时做对比 */
+
+#ifndef BENCH_MAX_SIZES
+#define BENCH_MAX_SIZES 16
+#endif
+
+int  bench_parse_args(int argc, char** argv);    /* 成功返回 0 */
+/* 本次运行要测的输入规模: 命令行给了 --sizes 就用它, 否则用 defaults. 返回个数, *sizes 指向列表.
+ * 超出测试程序能力的规模 (如超过静态缓冲区) 由测试程序跳过并在 stderr 说明. */
+size_t bench_sizes(const size_t* defaults, size_t n_defaults, const size_t** sizes);
+int  bench_summary(void);                        /* 收尾 (闭合 JSON, 关闭文件), 有回退返回 1 */
+
+/* 代码直接内联展开在计时循环中, 没有函数指针调用开销; 可变参数允许代码块里出现逗号 */
+#define BENCH(b, name, ...) do { \
+    bench_begin(&(b), (name)); \
+    while (bench_next(&(b))) { \
+        uint64_t n_ = (b).iters; \
+        bench_pmu_begin(&(b)); \
+        bench_tick_t s_ = bench_start(); \
+        for (uint64_t i_ = 0; i_ < n_; i_++) { __VA_ARGS__; } \
+        bench_tick_t e_ = bench_stop(); \
+        bench_pmu_end(&(b)); \
+        bench_record(&(b), bench_net(s_, e_)); \
+    } \
+    bench_finish(&(b)); \
+} while (0)
+
+/* 函数指针版本, 便于表驱动地批量跑多个变体 */
+typedef void (*bench_fn_t)(void* ctx);
+void bench_run(bench_t* b, const char* name, bench_fn_t fn, void* ctx);
+
+/* "不要优化掉": 让编译器认为 x 被读取 / 内存被改写, 防止被测代码被当成死代码删除 */
+#if defined(__GNUC__)
+#define BENCH_DO_NOT_OPTIMIZE(x) __asm__ __volatile__("" : : "g"(x) : "memory")
+#define BENCH_CLOBBER()          __asm__ __volatile__("" : : : "memory")
+#else
+extern volatile uintptr_t bench_sink;
+#define BENCH_DO_NOT_OPTIMIZE(x) (bench_sink = (uintptr_t)(x))
+#define BENCH_CLOBBER()          ((void)bench_sink)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H */
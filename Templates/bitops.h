@@ -0,0 +1,364 @@
+/* 位操作原语 - popcount / clz / ctz / 位反转 / 字节序 / 位段读写 / PEXT / PDEP
+ *
+ * 全部是 static inline, 只依赖 stdint.h (freestanding 头文件), 可直接在 baremetal.c 中使用.
+ * 有对应指令时映射到编译器内建函数或指令, 否则回落到无分支的 SWAR 实现:
+ *   popcount  x86 POPCNT (-mpopcnt) / AArch64 CNT;      Cortex-M 没有该指令, 用 SWAR (不调用 libgcc)
+ *   clz/ctz   x86 BSR/LZCNT/TZCNT / ARMv5+ CLZ (ctz = RBIT + CLZ); ARMv6-M 用 SWAR
+ *   reverse   ARMv7/ARMv8 RBIT, clang __builtin_bitreverse*; 否则 SWAR 交换 + 字节反转
+ *   bswap     __builtin_bswap* (x86 BSWAP/MOVBE, ARM REV); 否则移位拼装
+ *   field     x86 BMI1 BEXTR (-mbmi); ARM 上编译器会把移位+掩码合成 UBFX/BFI
+ *   pext/pdep x86 BMI2 (-mbmi2; 注意 Zen1/Zen2 上是微码实现, 很慢); 否则 Hacker's Delight 7-4/7-5
+ *             对数步并行前缀算法, 无分支
+ * clz/ctz 对 0 有定义: 返回位宽.
+ * -DBIT_NO_BUILTINS 强制全部走可移植实现, 便于在主机上测 SWAR 路径的性能.
+ */
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include <stdint.h>
+
+#ifdef __has_builtin
+#define BIT_HAS_BUILTIN(x) __has_builtin(x)
+#else
+#define BIT_HAS_BUILTIN(x) 0
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BIT_LITTLE_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BIT_BIG_ENDIAN 1
+#endif
+
+/* 硬件路径选择: BIT_HW_xxx 有定义表示该操作映射到单条 (或两条) 指令.
+ * BMI 直接用 __builtin_ia32_*: <immintrin.h> 会间接包含 stdlib.h, 不能用于 freestanding. */
+#if defined(__GNUC__) && !defined(BIT_NO_BUILTINS)
+#define BIT_HW_BSWAP 1
+#if defined(__POPCNT__) || defined(__aarch64__)
+#define BIT_HW_POPCOUNT 1
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(__ARM_FEATURE_CLZ)
+#define BIT_HW_CLZ 1
+#endif
+#if defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7 && defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH_ISA_THUMB >= 2)
+#define BIT_HW_RBIT 1
+#endif
+#if BIT_HAS_BUILTIN(__builtin_bitreverse32)
+#define BIT_HW_BITREVERSE 1
+#endif
+#if defined(__BMI__)
+#define BIT_HW_BMI 1
+#endif
+#if defined(__BMI2__)
+#define BIT_HW_BMI2 1
+#endif
+#endif
+
+#define BIT_MASK32(width) ((width) >= 32 ? 0xFFFFFFFFu : ((uint32_t)1 << (width)) - 1u)
+
+/* ---------------- popcount ---------------- */
+
+static inline unsigned bit_popcount32(uint32_t x) {
+#ifdef BIT_HW_POPCOUNT
+    return (unsigned)__builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555u);                 /* 每 2 位的计数 */
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u); /* 每 4 位 */
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;                 /* 每字节 */
+    return (x * 0x01010101u) >> 24;                   /* 乘法把 4 个字节加到最高字节 */
+#endif
+}
+
+static inline unsigned bit_popcount64(uint64_t x) {
+#ifdef BIT_HW_POPCOUNT
+    return (unsigned)__builtin_popcountll(x);
+#else
+    return bit_popcount32((uint32_t)x) + bit_popcount32((uint32_t)(x >> 32));
+#endif
+}
+
+/* ---------------- clz / ctz ---------------- */
+
+static inline unsigned bit_clz32(uint32_t x) {
+#ifdef BIT_HW_CLZ
+    return x ? (unsigned)__builtin_clz(x) : 32u;
+#else
+    /* 把最高位的 1 往右抹满, 再数 0 的个数 */
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    return bit_popcount32(~x);
+#endif
+}
+
+static inline unsigned bit_clz64(uint64_t x) {
+#ifdef BIT_HW_CLZ
+    return x ? (unsigned)__builtin_clzll(x) : 64u;
+#else
+    uint32_t hi = (uint32_t)(x >> 32);
+    return hi ? bit_clz32(hi) : 32u + bit_clz32((uint32_t)x);
+#endif
+}
+
+static inline unsigned bit_ctz32(uint32_t x) {
+#ifdef BIT_HW_CLZ
+    return x ? (unsigned)__builtin_ctz(x) : 32u;
+#else
+    return bit_popcount32((x & (0u - x)) - 1u);  /* 最低位 1 以下全变成 1; x == 0 时得到 32 */
+#endif
+}
+
+static inline unsigned bit_ctz64(uint64_t x) {
+#ifdef BIT_HW_CLZ
+    return x ? (unsigned)__builtin_ctzll(x) : 64u;
+#else
+    return bit_popcount64((x & (0u - x)) - 1u);
+#endif
+}
+
+/* 不小于 x 的最小 2 的幂 (x 为 0 或超过 2^31 时返回 0) */
+static inline uint32_t bit_ceil_pow2_32(uint32_t x) {
+    return x <= 1u ? x : (bit_clz32(x - 1u) == 0 ? 0u : (uint32_t)1 << (32u - bit_clz32(x - 1u)));
+}
+
+/* ---------------- 字节序 ---------------- */
+
+static inline uint16_t bit_bswap16(uint16_t x) {
+#ifdef BIT_HW_BSWAP
+    return __builtin_bswap16(x);
+#else
+    return (uint16_t)((x << 8) | (x >> 8));
+#endif
+}
+
+static inline uint32_t bit_bswap32(uint32_t x) {
+#ifdef BIT_HW_BSWAP
+    return __builtin_bswap32(x);
+#else
+    x = ((x << 8) & 0xFF00FF00u) | ((x >> 8) & 0x00FF00FFu);
+    return (x << 16) | (x >> 16);
+#endif
+}
+
+static inline uint64_t bit_bswap64(uint64_t x) {
+#ifdef BIT_HW_BSWAP
+    return __builtin_bswap64(x);
+#else
+    return ((uint64_t)bit_bswap32((uint32_t)x) << 32) | bit_bswap32((uint32_t)(x >> 32));
+#endif
+}
+
+/* 运行期检测: 把 1 存成多字节整数, 看最低地址的字节 */
+static inline int bit_is_little_endian(void) {
+    const union {
+        uint32_t u;
+        uint8_t  b[4];
+    } probe = {1u};
+    return probe.b[0] == 1;
+}
+
+#if defined(BIT_LITTLE_ENDIAN)
+#define BIT_HOST_IS_LE() 1
+#elif defined(BIT_BIG_ENDIAN)
+#define BIT_HOST_IS_LE() 0
+#else
+#define BIT_HOST_IS_LE() bit_is_little_endian()
+#endif
+
+/* 主机序 <-> 大端 (网络序) / 小端; 编译期已知字节序时没有运行时判断 */
+static inline uint16_t bit_to_be16(uint16_t x) { return BIT_HOST_IS_LE() ? bit_bswap16(x) : x; }
+static inline uint32_t bit_to_be32(uint32_t x) { return BIT_HOST_IS_LE() ? bit_bswap32(x) : x; }
+static inline uint64_t bit_to_be64(uint64_t x) { return BIT_HOST_IS_LE() ? bit_bswap64(x) : x; }
+static inline uint16_t bit_to_le16(uint16_t x) { return BIT_HOST_IS_LE() ? x : bit_bswap16(x); }
+static inline uint32_t bit_to_le32(uint32_t x) { return BIT_HOST_IS_LE() ? x : bit_bswap32(x); }
+static inline uint64_t bit_to_le64(uint64_t x) { return BIT_HOST_IS_LE() ? x : bit_bswap64(x); }
+#define bit_from_be16 bit_to_be16
+#define bit_from_be32 bit_to_be32
+#define bit_from_be64 bit_to_be64
+#define bit_from_le16 bit_to_le16
+#define bit_from_le32 bit_to_le32
+#define bit_from_le64 bit_to_le64
+
+/* 从字节流按指定字节序读写, 与主机字节序和对齐都无关 (编译器会合并成一次加载/REV) */
+static inline uint32_t bit_load_be32(const void* p) {
+    const uint8_t* b = (const uint8_t*)p;
+    return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+}
+
+static inline uint32_t bit_load_le32(const void* p) {
+    const uint8_t* b = (const uint8_t*)p;
+    return ((uint32_t)b[3] << 24) | ((uint32_t)b[2] << 16) | ((uint32_t)b[1] << 8) | b[0];
+}
+
+static inline void bit_store_be32(void* p, uint32_t v) {
+    uint8_t* b = (uint8_t*)p;
+    b[0] = (uint8_t)(v >> 24);
+    b[1] = (uint8_t)(v >> 16);
+    b[2] = (uint8_t)(v >> 8);
+    b[3] = (uint8_t)v;
+}
+
+static inline void bit_store_le32(void* p, uint32_t v) {
+    uint8_t* b = (uint8_t*)p;
+    b[0] = (uint8_t)v;
+    b[1] = (uint8_t)(v >> 8);
+    b[2] = (uint8_t)(v >> 16);
+    b[3] = (uint8_t)(v >> 24);
+}
+
+/* ---------------- 位反转 ---------------- */
+
+static inline uint32_t bit_reverse32(uint32_t x) {
+#ifdef BIT_HW_BITREVERSE
+    return __builtin_bitreverse32(x);
+#elif defined(BIT_HW_RBIT) && defined(__aarch64__)
+    uint32_t r;
+    __asm__("rbit %w0, %w1" : "=r"(r) : "r"(x));
+    return r;
+#elif defined(BIT_HW_RBIT)
+    uint32_t r;
+    __asm__("rbit %0, %1" : "=r"(r) : "r"(x));
+    return r;
+#else
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);  /* 相邻位 */
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);  /* 相邻 2 位 */
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);  /* 半字节 */
+    return bit_bswap32(x);                                     /* 剩下的就是字节反转 */
+#endif
+}
+
+static inline uint64_t bit_reverse64(uint64_t x) {
+#ifdef BIT_HW_BITREVERSE
+    return __builtin_bitreverse64(x);
+#elif defined(BIT_HW_RBIT) && defined(__aarch64__)
+    uint64_t r;
+    __asm__("rbit %0, %1" : "=r"(r) : "r"(x));
+    return r;
+#else
+    return ((uint64_t)bit_reverse32((uint32_t)x) << 32) | bit_reverse32((uint32_t)(x >> 32));
+#endif
+}
+
+static inline uint8_t bit_reverse8(uint8_t x) { return (uint8_t)(bit_reverse32(x) >> 24); }
+static inline uint16_t bit_reverse16(uint16_t x) { return (uint16_t)(bit_reverse32(x) >> 16); }
+
+/* ---------------- 位段读写 (寄存器字段) ---------------- */
+
+/* 取出 x 的 [pos, pos + width) 位, 1 <= width <= 32, pos + width <= 32 */
+static inline uint32_t bit_field_get32(uint32_t x, unsigned pos, unsigned width) {
+#ifdef BIT_HW_BMI
+    return __builtin_ia32_bextr_u32(x, pos | (width << 8));
+#else
+    return (x >> pos) & BIT_MASK32(width);
+#endif
+}
+
+/* 把 v 的低 width 位写进 x 的 [pos, pos + width), 其余位不变 (多出的高位被截掉) */
+static inline uint32_t bit_field_set32(uint32_t x, unsigned pos, unsigned width, uint32_t v) {
+    uint32_t m = BIT_MASK32(width) << pos;
+    return (x & ~m) | ((v << pos) & m);
+}
+
+/* ---------------- PEXT / PDEP ---------------- */
+
+/* 后缀异或: 第 i 位 = x 的第 0..i 位的异或 (按 1,2,4,.. 步长倍增) */
+static inline uint32_t bit_prefix_xor32_(uint32_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    return x;
+}
+
+static inline uint64_t bit_prefix_xor64_(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/* 把 mask 选中的位按顺序压到低位 */
+static inline uint32_t bit_pext32(uint32_t x, uint32_t mask) {
+#ifdef BIT_HW_BMI2
+    return __builtin_ia32_pext_si(x, mask);
+#else
+    /* Hacker's Delight 7-4: 第 i 轮把每个待移动位右移 2^i, 5 轮完成 */
+    uint32_t mk = ~mask << 1;
+    x &= mask;
+    for (unsigned i = 0; i < 5; i++) {
+        uint32_t mp = bit_prefix_xor32_(mk);
+        uint32_t mv = mp & mask;
+        mask = (mask ^ mv) | (mv >> (1u << i));
+        uint32_t t = x & mv;
+        x = (x ^ t) | (t >> (1u << i));
+        mk &= ~mp;
+    }
+    return x;
+#endif
+}
+
+/* pext 的逆: 把 x 的低位依次散布到 mask 选中的位上 */
+static inline uint32_t bit_pdep32(uint32_t x, uint32_t mask) {
+#ifdef BIT_HW_BMI2
+    return __builtin_ia32_pdep_si(x, mask);
+#else
+    uint32_t m0 = mask, mk = ~mask << 1, moves[5];
+    for (unsigned i = 0; i < 5; i++) {
+        uint32_t mp = bit_prefix_xor32_(mk);
+        uint32_t mv = mp & mask;
+        moves[i] = mv;
+        mask = (mask ^ mv) | (mv >> (1u << i));
+        mk &= ~mp;
+    }
+    for (unsigned i = 5; i-- > 0;) {
+        uint32_t mv = moves[i];
+        x = (x & ~mv) | ((x << (1u << i)) & mv);
+    }
+    return x & m0;
+#endif
+}
+
+static inline uint64_t bit_pext64(uint64_t x, uint64_t mask) {
+#if defined(BIT_HW_BMI2) && defined(__x86_64__)
+    return __builtin_ia32_pext_di(x, mask);
+#else
+    uint64_t mk = ~mask << 1;
+    x &= mask;
+    for (unsigned i = 0; i < 6; i++) {
+        uint64_t mp = bit_prefix_xor64_(mk);
+        uint64_t mv = mp & mask;
+        mask = (mask ^ mv) | (mv >> (1u << i));
+        uint64_t t = x & mv;
+        x = (x ^ t) | (t >> (1u << i));
+        mk &= ~mp;
+    }
+    return x;
+#endif
+}
+
+static inline uint64_t bit_pdep64(uint64_t x, uint64_t mask) {
+#if defined(BIT_HW_BMI2) && defined(__x86_64__)
+    return __builtin_ia32_pdep_di(x, mask);
+#else
+    uint64_t m0 = mask, mk = ~mask << 1, moves[6];
+    for (unsigned i = 0; i < 6; i++) {
+        uint64_t mp = bit_prefix_xor64_(mk);
+        uint64_t mv = mp & mask;
+        moves[i] = mv;
+        mask = (mask ^ mv) | (mv >> (1u << i));
+        mk &= ~mp;
+    }
+    for (unsigned i = 6; i-- > 0;) {
+        uint64_t mv = moves[i];
+        x = (x & ~mv) | ((x << (1u << i)) & mv);
+    }
+    return x & m0;
+#endif
+}
+
+#endif /* BITOPS_H */
@@ -0,0 +1,110 @@
+/* 堆用量探针: 通过链接器 --wrap 截获 malloc 系列调用, 统计峰值堆用量与分配次数
+ *
+ * 只在 -DGYM_FOOTPRINT=ON 时链接进测试程序 (见 cmake/GymBench.cmake), 链接选项
+ *   -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc,--wrap=aligned_alloc,--wrap=posix_memalign
+ * 把程序自身 (以及静态链接进来的库) 对 malloc 的引用改到这里的 __wrap_malloc, 原函数是 __real_malloc.
+ * 与 LD_PRELOAD 不同, 这在 newlib / 裸机上同样可用. 宿主机上共享库里的分配 (libc 内部, libstdc++ 的
+ * operator new) 截获不到, 所以 C++ 程序另外链接 heap_probe_new.cpp 把全局 operator new 改为调用 malloc.
+ *
+ * 字节数用 malloc_usable_size (glibc / newlib 都有), 即分配器实际交出的块大小, 不含块头.
+ * 程序退出时在 stderr 打印 "# heap peak ..."; 设置了环境变量 GYM_HEAP_OUT 时再把同样的数写成 CSV,
+ * bench 目标借此把堆峰值与计时结果放在一起 (cmake/footprint.py 汇总).
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) || defined(__NEWLIB__)
+#include <malloc.h>
+#define HEAP_BLOCK_SIZE(p) malloc_usable_size(p)
+#else
+#define HEAP_BLOCK_SIZE(p) ((size_t)0)  /* 只能统计次数 */
+#endif
+
+/* 多线程测试 (work_stealing 等) 会并发分配; 没有无锁原子操作的核 (Cortex-M0) 上只会单线程运行 */
+#if defined(__GCC_ATOMIC_POINTER_LOCK_FREE) && __GCC_ATOMIC_POINTER_LOCK_FREE == 2
+#define HEAP_ADD(var, v) __atomic_add_fetch(&(var), (v), __ATOMIC_RELAXED)
+#else
+#define HEAP_ADD(var, v) ((var) += (v))
+#endif
+
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t n);
+void* __real_aligned_alloc(size_t align, size_t n);
+int __real_posix_memalign(void** out, size_t align, size_t n);
+void __real_free(void* p);
+
+static ptrdiff_t g_live;  /* 当前仍未释放的字节数; 有符号, 见 on_free */
+static ptrdiff_t g_peak;
+static size_t g_allocs;
+static size_t g_frees;
+
+static void note_peak(ptrdiff_t live) {
+#if defined(__GCC_ATOMIC_POINTER_LOCK_FREE) && __GCC_ATOMIC_POINTER_LOCK_FREE == 2
+    ptrdiff_t old = __atomic_load_n(&g_peak, __ATOMIC_RELAXED);
+    while (live > old && !__atomic_compare_exchange_n(&g_peak, &old, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+#else
+    if (live > g_peak) g_peak = live;
+#endif
+}
+
+static void* on_alloc(void* p) {
+    if (p != NULL) {
+        HEAP_ADD(g_allocs, 1);
+        note_peak(HEAP_ADD(g_live, (ptrdiff_t)HEAP_BLOCK_SIZE(p)));
+    }
+    return p;
+}
+
+/* libc 内部分配、交给程序释放的块 (如 strdup) 从未计入, g_live 因此可能偏小甚至为负; 峰值只会偏低不会虚高 */
+static void on_free(size_t bytes) {
+    HEAP_ADD(g_frees, 1);
+    HEAP_ADD(g_live, -(ptrdiff_t)bytes);
+}
+
+void* __wrap_malloc(size_t n) { return on_alloc(__real_malloc(n)); }
+
+void* __wrap_calloc(size_t n, size_t size) { return on_alloc(__real_calloc(n, size)); }
+
+void* __wrap_aligned_alloc(size_t align, size_t n) { return on_alloc(__real_aligned_alloc(align, n)); }
+
+int __wrap_posix_memalign(void** out, size_t align, size_t n) {
+    int rc = __real_posix_memalign(out, align, n);
+    if (rc == 0) on_alloc(*out);
+    return rc;
+}
+
+/* 失败时原块仍然有效, 所以旧块的大小先记下, 成功之后才扣除 */
+void* __wrap_realloc(void* p, size_t n) {
+    size_t old = p != NULL ? HEAP_BLOCK_SIZE(p) : 0;
+    void* q = __real_realloc(p, n);
+    if (p == NULL) return on_alloc(q);
+    if (q == NULL) {
+        if (n == 0) on_free(old);  /* glibc 的 realloc(p, 0) 释放 p 并返回 NULL */
+        return q;
+    }
+    note_peak(HEAP_ADD(g_live, (ptrdiff_t)HEAP_BLOCK_SIZE(q) - (ptrdiff_t)old));
+    return q;
+}
+
+void __wrap_free(void* p) {
+    if (p != NULL) on_free(HEAP_BLOCK_SIZE(p));
+    __real_free(p);
+}
+
+/* 裸机上没有环境变量也没有文件系统: getenv 返回 NULL, 只剩 stderr 一行 */
+__attribute__((destructor)) static void heap_probe_report(void) {
+    size_t peak = (size_t)g_peak, allocs = g_allocs, frees = g_frees;
+    fprintf(stderr, "# heap peak %zu bytes, %zu allocations, %zu frees\n", peak, allocs, frees);
+    const char* path = getenv("GYM_HEAP_OUT");
+    if (path != NULL && *path) {
+        FILE* f = fopen(path, "w");
+        if (f != NULL) {
+            fprintf(f, "heap_peak,heap_allocs,heap_frees\n%zu,%zu,%zu\n", peak, allocs, frees);
+            fclose(f);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// 全局 operator new / delete 的替换实现: 全部转给 malloc / free, 从而被 heap_probe.c 的 --wrap 统计到.
+// 宿主机上 libstdc++ 是共享库, 它自带的 operator new 在库内部调用 malloc, 链接器的 --wrap 看不到;
+// 可执行文件里定义的 operator new 按 C++ 标准替换掉库里的版本. 只链接进 C++ 测试程序 (见 GymBench.cmake).
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* checked(void* p) {
+    if (p == nullptr) {
+#if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+#else
+        std::abort();  // 目标机上 -fno-exceptions
+#endif
+    }
+    return p;
+}
+
+// aligned_alloc 要求 size 是 align 的整数倍
+void* aligned(std::size_t n, std::align_val_t al) {
+    std::size_t a = static_cast<std::size_t>(al);
+    return std::aligned_alloc(a, (n + a - 1) / a * a);
+}
+
+}  // namespace
+
+void* operator new(std::size_t n) { return checked(std::malloc(n ? n : 1)); }
+void* operator new[](std::size_t n) { return checked(std::malloc(n ? n : 1)); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return std::malloc(n ? n : 1); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return std::malloc(n ? n : 1); }
+void* operator new(std::size_t n, std::align_val_t al) { return checked(aligned(n ? n : 1, al)); }
+void* operator new[](std::size_t n, std::align_val_t al) { return checked(aligned(n ? n : 1, al)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,117 @@
+/* 埋点环形缓冲区的初始化与 Chrome trace JSON 导出 (热路径全部在 trace.h) */
+#include "trace.h"
+
+TRACE_TLS trace_ring_t* trace_current = NULL;
+
+static const char* g_names[TRACE_MAX_IDS];
+static uint32_t g_next_tid = 1;
+
+int trace_ring_init(trace_ring_t* r, trace_event_t* storage, uint32_t capacity, const char* name) {
+    if (r == NULL || storage == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) return -1;
+    r->buf = storage;
+    r->mask = capacity - 1;
+    r->head = 0;
+    r->laps = 0;
+    r->tid = __atomic_fetch_add(&g_next_tid, 1u, __ATOMIC_RELAXED);
+    r->name = name;
+    return 0;
+}
+
+void trace_attach(trace_ring_t* r) { trace_current = r; }
+
+void trace_set_name(uint16_t id, const char* name) {
+    if (id < TRACE_MAX_IDS) g_names[id] = name;
+}
+
+void trace_ring_clear(trace_ring_t* r) {
+    r->laps = 0;
+    __atomic_store_n(&r->head, 0u, __ATOMIC_RELEASE);
+}
+
+/* ---------------- 导出 ---------------- */
+
+/* 名字只会是标识符式的字面量, 仍然转义引号和反斜杠以免生成非法 JSON */
+static void put_json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void put_name(FILE* f, uint16_t id) {
+    if (id < TRACE_MAX_IDS && g_names[id] != NULL) put_json_string(f, g_names[id]);
+    else fprintf(f, "\"id%u\"", (unsigned)id);
+}
+
+/* 环里最旧的一条仍然有效的记录 (未取模的下标); 写满过一圈后就是 head 往前一整圈, 按 2^32 取模 */
+static uint32_t ring_first(const trace_ring_t* r, uint32_t head) {
+    return r->laps ? head - (r->mask + 1u) : 0;
+}
+
+/* DWT->CYCCNT 只有 32 位 (168 MHz 下约 25 s 回绕一次): 按记录顺序累加差值展开成 64 位 */
+static uint64_t unwrap_ts(uint64_t prev_ext, uint64_t prev_raw, uint64_t raw) {
+#if BENCH_TIMER == BENCH_TIMER_DWT
+    return prev_ext + (uint32_t)((uint32_t)raw - (uint32_t)prev_raw);
+#else
+    (void)prev_ext;
+    (void)prev_raw;
+    return raw;
+#endif
+}
+
+long trace_write_json(FILE* f, trace_ring_t* const* rings, size_t n_rings) {
+    if (f == NULL) return -1;
+    /* 所有环共用一个时间零点: 最早的那条记录 */
+    uint64_t base = UINT64_MAX;
+    uint64_t lost = 0;
+    for (size_t k = 0; k < n_rings; k++) {
+        const trace_ring_t* r = rings[k];
+        uint32_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+        if (head == 0 && r->laps == 0) continue;
+        uint64_t t0 = r->buf[ring_first(r, head) & r->mask].ts;
+        if (t0 < base) base = t0;
+        lost += trace_ring_lost(r);
+    }
+    if (base == UINT64_MAX) base = 0;
+
+    long n = 0;
+    fprintf(f, "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"timer\": \"%s\", \"lost_events\": %llu},\n"
+               " \"traceEvents\": [\n",
+            BENCH_TICK_UNIT, (unsigned long long)lost);
+    const char* sep = "  ";
+    for (size_t k = 0; k < n_rings; k++) {
+        const trace_ring_t* r = rings[k];
+        uint32_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+        fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": ",
+                sep, (unsigned)r->tid);
+        put_json_string(f, r->name ? r->name : "thread");
+        fputs("}}", f);
+        sep = ",\n  ";
+
+        int depth = 0;
+        uint64_t raw_prev = 0, ext = 0;
+        for (uint32_t i = ring_first(r, head); i != head; i++) {
+            const trace_event_t* e = &r->buf[i & r->mask];
+            ext = (i == ring_first(r, head)) ? e->ts : unwrap_ts(ext, raw_prev, e->ts);
+            raw_prev = e->ts;
+            if (e->ph == TRACE_PH_BEGIN) {
+                depth++;
+            } else if (e->ph == TRACE_PH_END) {
+                if (depth == 0) continue;  /* 对应的 BEGIN 已被覆盖 */
+                depth--;
+            }
+            double us = ext >= base ? bench_ticks_to_ns((double)(ext - base)) / 1e3 : 0.0;
+            fprintf(f, "%s{\"name\": ", sep);
+            put_name(f, e->id);
+            fprintf(f, ", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 1, \"tid\": %u", e->ph, us, (unsigned)r->tid);
+            if (e->ph == TRACE_PH_COUNTER) fprintf(f, ", \"args\": {\"value\": %ld}", (long)e->arg);
+            else if (e->ph == TRACE_PH_INSTANT) fputs(", \"s\": \"t\"", f);
+            fputc('}', f);
+            n++;
+        }
+    }
+    fputs("\n]}\n", f);
+    return ferror(f) ? -1 : n;
+}
@@ -0,0 +1,173 @@
+/* 热路径埋点 - TRACE_BEGIN/TRACE_END 写入预分配的无锁环形缓冲区, 事后导出 Chrome/Perfetto JSON
+ *
+ * 埋点只做 "读时间戳 + 写 16 字节记录", 不格式化、不加锁、不调用任何库函数, 所以可以放在
+ * 控制环和 ISR 里而不改变要观察的时序 (printf 一次就是几十微秒). 计时后端与 benchmark.h 相同
+ * (DWT->CYCCNT / rdtsc / clock_gettime), 只是 rdtsc 不加 lfence: 单个埋点在 x86 上约 30 个周期
+ * (TSC 后端) 或 30 ns (clock_gettime 后端), Cortex-M 上约十几个周期.
+ *
+ * - 默认全部编译掉: 不定义 TRACE_ENABLE 时宏展开为 ((void)0), 参数不求值, 不留下任何代码.
+ *   CMake 中打开 -DGYM_TRACE=ON 即对所有目标定义 TRACE_ENABLE.
+ * - 每个线程一个环 (trace_attach() 绑定到线程局部指针), 单写者, 只在发布 head 时做一次 release 存储.
+ *   没有线程局部存储的目标 (裸机) 只有一个全局环, ISR 与主循环共用: 用原子 fetch_add 预留槽位,
+ *   中断嵌套时各自写各自的槽 (Cortex-M0 没有 LDREX/STREX, 需要关中断包住, 见 trace_reserve).
+ * - 环满后覆盖最旧的记录 (飞行记录仪), 导出时丢弃开头那些找不到 BEGIN 的 END.
+ * - 导出 (trace_write_json) 要在写者停下之后进行, 否则可能读到写了一半的记录.
+ *
+ *   enum { TR_LOOP, TR_PID, TR_FILL };
+ *   static trace_event_t tr_buf[4096];
+ *   static trace_ring_t tr;
+ *   trace_ring_init(&tr, tr_buf, 4096, "control");
+ *   trace_attach(&tr);
+ *   trace_set_name(TR_PID, "pid_update");
+ *   TRACE_BEGIN(TR_PID); u = pid_q15_update(&pid, sp, y); TRACE_END(TR_PID);
+ *   TRACE_COUNTER(TR_FILL, spsc_size(&rx));
+ *   trace_ring_t* rings[] = {&tr};
+ *   trace_write_json(fopen("trace.json", "w"), rings, 1);  // 用 ui.perfetto.dev 或 chrome://tracing 打开
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "benchmark.h"  /* 计时后端 (同时带来 POSIX 特性宏) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TRACE_MAX_IDS
+#define TRACE_MAX_IDS 256        /* 埋点 id 的个数上限 (名字表大小) */
+#endif
+
+/* 线程局部存储: 有操作系统线程的平台每线程一个环, 否则全局一个 ISR 安全的环 */
+#ifndef TRACE_PER_THREAD
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#define TRACE_PER_THREAD 1
+#else
+#define TRACE_PER_THREAD 0
+#endif
+#endif
+
+#if TRACE_PER_THREAD
+#ifdef __cplusplus
+#define TRACE_TLS thread_local
+#else
+#define TRACE_TLS _Thread_local
+#endif
+#else
+#define TRACE_TLS
+#endif
+
+/* Chrome trace 的事件类型 */
+#define TRACE_PH_BEGIN   'B'
+#define TRACE_PH_END     'E'
+#define TRACE_PH_INSTANT 'i'
+#define TRACE_PH_COUNTER 'C'
+
+typedef struct {
+    uint64_t ts;                 /* 计时器原始读数 (bench_tick_t 单位), 导出时换算成 us */
+    uint16_t id;
+    uint8_t  ph;                 /* TRACE_PH_xxx */
+    uint8_t  reserved;
+    int32_t  arg;                /* COUNTER 的数值, 其他类型为 0 */
+} trace_event_t;
+
+typedef struct {
+    trace_event_t* buf;
+    uint32_t       mask;         /* capacity - 1 */
+    uint32_t       head;         /* 已写入的记录总数 (自由增长, 2^32 后回绕), 低位即下一个槽位 */
+    uint32_t       laps;         /* 写满整圈的次数: 环是否已覆盖, 以及 head 回绕后的丢失数都看它 */
+    uint32_t       tid;          /* 导出时的线程号, 初始化时自动分配 */
+    const char*    name;         /* 导出时的线程名 */
+} trace_ring_t;
+
+extern TRACE_TLS trace_ring_t* trace_current;  /* 当前线程的环; 未绑定时埋点什么都不做 */
+
+/* capacity 必须是 2 的幂. 成功返回 0, 参数非法返回 -1 */
+int  trace_ring_init(trace_ring_t* r, trace_event_t* storage, uint32_t capacity, const char* name);
+/* 把当前线程的埋点写到 r (NULL 解除绑定); TRACE_PER_THREAD 为 0 时对所有上下文生效 */
+void trace_attach(trace_ring_t* r);
+/* 埋点 id 在导出时显示的名字; 没有登记的显示为 "id<n>". name 必须一直有效 (通常是字符串字面量) */
+void trace_set_name(uint16_t id, const char* name);
+void trace_ring_clear(trace_ring_t* r);
+/* 被覆盖而丢失的记录数. 不能直接比较 head 与容量: head 只有 32 位, 长期运行的固件 2^32 条之后 head
+ * 又从 0 开始; 总数按 laps 整圈加上当前圈内的下标重算, 64 位足够 */
+static inline uint64_t trace_ring_lost(const trace_ring_t* r) {
+    uint64_t total = (uint64_t)r->laps * (r->mask + 1u) + (r->head & r->mask);
+    return total > r->mask + 1u ? total - (r->mask + 1u) : 0;
+}
+
+/* 把若干个环导出为 Chrome trace JSON ({"traceEvents": [...]}); 返回写出的事件数, 写文件失败返回 -1 */
+long trace_write_json(FILE* f, trace_ring_t* const* rings, size_t n_rings);
+
+/* ---------------- 热路径 ---------------- */
+
+static inline uint64_t trace_now(void) {
+#if BENCH_TIMER == BENCH_TIMER_TSC
+    return __rdtsc();            /* 不串行化: 埋点不应该让流水线停下 */
+#else
+    return (uint64_t)bench_now();
+#endif
+}
+
+/* 预留一个槽位, 返回其下标 (未取模) */
+static inline uint32_t trace_reserve(trace_ring_t* r) {
+#if TRACE_PER_THREAD
+    return r->head;              /* 单写者: 写完记录后才发布 head */
+#else
+    /* ARMv7-M 上是 LDREX/ADD/STREX 循环; ARMv6-M (M0/M0+) 没有独占访问, GCC 会调用
+     * __atomic_fetch_add_4, 需要自行提供一个关中断实现的版本 */
+    return __atomic_fetch_add(&r->head, 1u, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline void trace_emit(uint16_t id, uint8_t ph, int32_t arg) {
+    trace_ring_t* r = trace_current;
+    if (r == NULL) return;
+    uint32_t i = trace_reserve(r);
+    trace_event_t* e = &r->buf[i & r->mask];
+    e->ts = trace_now();
+    e->id = id;
+    e->ph = ph;
+    e->reserved = 0;
+    e->arg = arg;
+    /* 写的是本圈最后一个槽: 每圈只有这一个写者, 也就只多一次比较 */
+#if TRACE_PER_THREAD
+    if ((i & r->mask) == r->mask) r->laps++;
+    __atomic_store_n(&r->head, i + 1u, __ATOMIC_RELEASE);
+#else
+    if ((i & r->mask) == r->mask) __atomic_fetch_add(&r->laps, 1u, __ATOMIC_RELAXED);
+#endif
+}
+
+#ifdef TRACE_ENABLE
+#define TRACE_BEGIN(id)        trace_emit((uint16_t)(id), TRACE_PH_BEGIN, 0)
+#define TRACE_END(id)          trace_emit((uint16_t)(id), TRACE_PH_END, 0)
+#define TRACE_INSTANT(id)      trace_emit((uint16_t)(id), TRACE_PH_INSTANT, 0)
+#define TRACE_COUNTER(id, val) trace_emit((uint16_t)(id), TRACE_PH_COUNTER, (int32_t)(val))
+#else
+#define TRACE_BEGIN(id)        ((void)0)
+#define TRACE_END(id)          ((void)0)
+#define TRACE_INSTANT(id)      ((void)0)
+#define TRACE_COUNTER(id, val) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+
+/* C++: 作用域埋点, 离开作用域 (包括提前 return) 时自动 END */
+#ifdef TRACE_ENABLE
+struct trace_scope {
+    explicit trace_scope(uint16_t id) : id_(id) { TRACE_BEGIN(id_); }
+    ~trace_scope() { TRACE_END(id_); }
+    trace_scope(const trace_scope&) = delete;
+    trace_scope& operator=(const trace_scope&) = delete;
+    uint16_t id_;
+};
+#define TRACE_CAT2_(a, b) a##b
+#define TRACE_CAT_(a, b)  TRACE_CAT2_(a, b)
+#define TRACE_SCOPE(id)   trace_scope TRACE_CAT_(trace_scope_, __LINE__)(static_cast<uint16_t>(id))
+#else
+#define TRACE_SCOPE(id)   ((void)0)
+#endif
+#endif /* __cplusplus */
+
+#endif /* TRACE_H */
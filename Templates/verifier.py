@@ -1,4 +1,495 @@
+"""对拍 / 压测数据生成器与并行对拍器.
+
+    python verifier.py                                   # 默认: 10 个 [0, 100] 随机整数 -> input.txt
+    python verifier.py gen -n 10000000 --dist zipf --lo 0 --hi 1000000 --seed 42 -o big.txt
+    python verifier.py gen -n 100000000 --dist sorted --workers 8 --count -o sorted.txt
+    python verifier.py stress sol.cpp brute.cpp --cases 2000 -n 50 --hi 1000
+
+gen:
+
+- 有 NumPy 时用向量化 RNG (PCG64), 否则回落到 random 模块, 两者输出不同但各自可复现.
+- 数据按块生成并直接流式写入文件, 不会拼出一个巨大的字符串.
+- 每块的种子只由 (--seed, 块序号) 决定, 与进程数无关: 同样的参数任意 --workers 输出完全一致.
+- 分布: random(均匀) / sorted(非降序) / reverse(非升序) / few-unique(少量不同值) / zipf(有界 Zipf).
+
+stress (对拍):
+- 候选解与暴力解各编译一次 (.c/.cpp 自动编译, .py 用当前解释器, 其他视为可执行文件).
+- 线程池把用例分发到所有核心; 输入经管道同时喂给两个进程, 不落盘.
+- 两边输出按空白分隔的 token 边读边比较, 第一处不同立即杀掉进程; 发现错误后停止派发新用例.
+- 内置用例格式为 "n\n a1 a2 ... an\n"; 失败用例会被 delta debugging 缩减到最小再报告.
+- 也可用 --gen-cmd 指定自定义生成器 (stdout 即输入, "{seed}" 会被替换), 此时不做缩减.
+"""
+import argparse
+import itertools
+import multiprocessing as mp
+import os
 import random
-with open("input.txt", "w") as f:
-    f.write(" ".join([str(random.randint(0,100)) for _ in range(10)]))
-print("Data generated.")
+import shlex
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from concurrent.futures import FIRST_COMPLETED, ThreadPoolExecutor, wait
+
+try:
+    import numpy as np
+except ImportError:  # 没有 NumPy 时退回纯 Python 实现
+    np = None
+
+DISTS = ("random", "sorted", "reverse", "few-unique", "zipf")
+DEFAULT_CHUNK = 1 << 20      # 每块元素个数
+FEW_UNIQUE_K = 16            # few-unique 分布的不同值个数
+ZIPF_MAX_RANKS = 1 << 16     # 有界 Zipf 的最大秩数
+FLOAT_EXACT = 1 << 53        # random.choices 基于浮点, 超过此范围就改用 randrange
+SHARED_STREAM = 0xFFFFFFFF   # 所有块共用的随机流序号 (few-unique 的取值池)
+PIPE_CHUNK = 1 << 16         # 读输出管道的块大小
+STDERR_KEEP = 4096           # 失败时展示的 stderr 尾部字节数
+SHRINK_MAX_RUNS = 2000       # 缩减阶段最多重跑次数
+TEMPLATES_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def chunk_specs(n, chunk):
+    """把 n 个元素切成 (序号, 起始下标, 个数) 的块."""
+    return [(i, off, min(chunk, n - off)) for i, off in enumerate(range(0, n, chunk))]
+
+
+def _rng(seed, idx):
+    if np is not None:
+        return np.random.default_rng(np.random.SeedSequence(seed, spawn_key=(idx,)))
+    return random.Random("%d:%d" % (seed, idx))
+
+
+def _uniform(rng, lo, hi, cnt):
+    if np is not None:
+        return rng.integers(lo, hi, size=cnt, endpoint=True)
+    if hi - lo + 1 <= FLOAT_EXACT:
+        return rng.choices(range(lo, hi + 1), k=cnt)
+    return [rng.randrange(lo, hi + 1) for _ in range(cnt)]
+
+
+def _sorted_chunk(rng, lo, hi, n, off, cnt):
+    """全局有序: 按位置比例给每块分配互不交叠的值域, 块内排序即可, 各块可独立生成."""
+    span = hi - lo + 1
+    sub_lo = lo + span * off // n
+    sub_hi = max(sub_lo, lo + span * (off + cnt) // n - 1)
+    vals = _uniform(rng, sub_lo, sub_hi, cnt)
+    if np is not None:
+        vals.sort()
+        return vals
+    return sorted(vals)
+
+
+def make_chunk(job):
+    """生成一块数据并格式化为以空格分隔的字符串 (在工作进程中执行)."""
+    (idx, off, cnt), dist, lo, hi, n, seed, zipf_a = job
+    rng = _rng(seed, idx)
+    if dist == "random":
+        vals = _uniform(rng, lo, hi, cnt)
+    elif dist == "sorted":
+        vals = _sorted_chunk(rng, lo, hi, n, off, cnt)
+    elif dist == "reverse":
+        # 镜像位置上的有序块倒过来, 拼起来就是全局非升序
+        vals = _sorted_chunk(rng, lo, hi, n, n - off - cnt, cnt)[::-1]
+    elif dist == "few-unique":
+        pool = _uniform(_rng(seed, SHARED_STREAM), lo, hi, FEW_UNIQUE_K)  # 所有块共用同一组取值
+        if np is not None:
+            vals = pool[rng.integers(0, len(pool), size=cnt)]
+        else:
+            vals = rng.choices(pool, k=cnt)
+    elif dist == "zipf":
+        # 有界 Zipf: 秩 r 的概率 ∝ 1/r^a, 秩 r 映射到值 lo + r - 1
+        ranks = min(hi - lo + 1, ZIPF_MAX_RANKS)
+        if np is not None:
+            cdf = np.cumsum(1.0 / np.arange(1, ranks + 1) ** zipf_a)
+            vals = lo + np.searchsorted(cdf, rng.random(cnt) * cdf[-1])
+        else:
+            acc, cum = 0.0, []
+            for r in range(1, ranks + 1):
+                acc += 1.0 / r ** zipf_a
+                cum.append(acc)
+            vals = [lo + r for r in rng.choices(range(ranks), cum_weights=cum, k=cnt)]
+    else:
+        raise ValueError("unknown distribution: %s" % dist)
+    if np is not None:
+        vals = vals.tolist()
+    return " ".join(map(str, vals))
+
+
+def generate(out, n, dist="random", lo=0, hi=100, seed=0, workers=1, chunk=DEFAULT_CHUNK,
+             zipf_a=1.2, count=False):
+    """生成 n 个整数流式写入文本文件对象 out; 返回写入的元素个数."""
+    if n < 0 or lo > hi:
+        raise ValueError("need n >= 0 and lo <= hi")
+    jobs = [(spec, dist, lo, hi, n, seed, zipf_a) for spec in chunk_specs(n, chunk)]
+    if count:
+        out.write("%d\n" % n)
+    workers = max(1, min(workers, len(jobs)))
+    if workers == 1:
+        parts = map(make_chunk, jobs)
+        _write_parts(out, parts)
+    else:
+        with mp.Pool(workers) as pool:
+            # imap 保持块顺序; 主进程边收边写, 内存只保留少量在途块
+            _write_parts(out, pool.imap(make_chunk, jobs))
+    out.write("\n")
+    return n
+
+
+def _write_parts(out, parts):
+    for i, text in enumerate(parts):
+        if i:
+            out.write(" ")
+        out.write(text)
+
+
+def cmd_gen(args):
+    if args.seed is None:
+        args.seed = random.SystemRandom().randrange(1 << 32)
+    t0 = time.perf_counter()
+    out = sys.stdout if args.output == "-" else open(args.output, "w", buffering=1 << 20)
+    try:
+        generate(out, args.n, args.dist, args.lo, args.hi, args.seed, args.workers, args.chunk,
+                 args.zipf_a, args.count)
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    print("Data generated: %d values (%s, %s) -> %s in %.2f s"
+          % (args.n, args.dist, "numpy" if np is not None else "python", args.output,
+             time.perf_counter() - t0), file=sys.stderr)
+    return 0
+
+
+# ---------------------------------------------------------------------------
+# stress: 并行对拍
+# ---------------------------------------------------------------------------
+
+def compile_source(src, build_dir, cflags=()):
+    """编译一次, 返回运行该程序的命令行 (list)."""
+    ext = os.path.splitext(src)[1].lower()
+    if ext == ".py":
+        return [sys.executable, os.path.abspath(src)]
+    if ext not in (".c", ".cc", ".cpp", ".cxx"):
+        return [os.path.abspath(src)]
+    exe = os.path.join(build_dir, os.path.basename(src) + ".bin")
+    if ext == ".c":
+        cmd = ["gcc", "-std=c11", "-O2", "-I", TEMPLATES_DIR, src, "-o", exe, "-lm"]
+    else:
+        cmd = ["g++", "-std=c++17", "-O2", "-I", TEMPLATES_DIR, src, "-o", exe]
+    subprocess.run(cmd + list(cflags), check=True)
+    return [exe]
+
+
+def _tokens(fd):
+    """从管道增量读取以空白分隔的 token."""
+    tail = b""
+    while True:
+        block = os.read(fd, PIPE_CHUNK)
+        if not block:
+            if tail:
+                yield tail
+            return
+        block = tail + block
+        parts = block.split()
+        tail = parts.pop() if parts and not block[-1:].isspace() else b""
+        yield from parts
+
+
+class _Live:
+    """记录正在运行的子进程, 发现错误后可以一次全部杀掉."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.procs = set()
+        self.stopped = False
+
+    def add(self, p):
+        with self.lock:
+            if self.stopped:
+                p.kill()
+            self.procs.add(p)
+
+    def remove(self, p):
+        with self.lock:
+            self.procs.discard(p)
+
+    def stop(self):
+        with self.lock:
+            self.stopped = True
+            for p in self.procs:
+                p.kill()
+
+
+def _feed(pipe, data):
+    try:
+        pipe.write(data)
+    except (BrokenPipeError, OSError):
+        pass  # 对方提前退出 / 被杀
+    finally:
+        try:
+            pipe.close()
+        except OSError:
+            pass
+
+
+def _drain(pipe, keep):
+    for block in iter(lambda: pipe.read(PIPE_CHUNK), b""):
+        keep[0] = (keep[0] + block)[-STDERR_KEEP:]
+
+
+def run_pair(cmd_a, cmd_b, data, timeout, live=None):
+    """把同一份输入同时喂给两个程序并增量比较输出.
+
+    返回 dict: ok, reason, index (第一处不同的 token 序号), got, expected,
+    time (两边各自的 CPU 时间 s), wall (整个用例的墙钟时间 s), stderr.
+    """
+    t0 = time.perf_counter()
+    procs, threads, errs, cpu = [], [], [], [0.0, 0.0]
+    for k, cmd in enumerate((cmd_a, cmd_b)):
+        p = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        if live is not None:
+            live.add(p)
+        keep = [b""]
+        threads += [threading.Thread(target=_feed, args=(p.stdin, data), daemon=True),
+                    threading.Thread(target=_drain, args=(p.stderr, keep), daemon=True)]
+        procs.append(p)
+        errs.append(keep)
+    for t in threads:
+        t.start()
+    timed_out = threading.Event()
+
+    def kill_all():
+        timed_out.set()
+        for p in procs:
+            p.kill()
+
+    timer = threading.Timer(timeout, kill_all)
+    timer.start()
+
+    def reap(k):
+        # wait4 拿到子进程自己的 CPU 时间, 不受两边输出被交替读取的影响
+        try:
+            _, status, ru = os.wait4(procs[k].pid, 0)
+        except ChildProcessError:  # 已被 Popen.kill() 内部的 poll() 回收, 只会发生在被杀掉的用例上
+            procs[k].wait()
+            return
+        procs[k].returncode = os.waitstatus_to_exitcode(status)
+        cpu[k] = ru.ru_utime + ru.ru_stime
+
+    reapers = [threading.Thread(target=reap, args=(k,), daemon=True) for k in range(2)]
+    for t in reapers:
+        t.start()
+    res = {"ok": True, "reason": "", "index": -1, "got": None, "expected": None}
+    streams = (_tokens(procs[0].stdout.fileno()), _tokens(procs[1].stdout.fileno()))
+    for i, (x, y) in enumerate(itertools.zip_longest(*streams)):
+        if x != y:
+            res.update(ok=False, reason="wrong answer", index=i, got=x, expected=y)
+            for p in procs:
+                p.kill()
+            break
+    for t in reapers:
+        t.join()
+    for p in procs:
+        p.stdout.close()
+        if live is not None:
+            live.remove(p)
+    timer.cancel()
+    for t in threads:
+        t.join()
+    codes = [p.returncode for p in procs]
+    if timed_out.is_set():
+        res.update(ok=False, reason="timeout (%.1f s)" % timeout)
+    elif res["ok"] and codes[0] != 0:
+        res.update(ok=False, reason="candidate exited with %d" % codes[0])
+    elif res["ok"] and codes[1] != 0:
+        res.update(ok=False, reason="reference exited with %d" % codes[1])
+    res["time"] = cpu
+    res["wall"] = time.perf_counter() - t0
+    res["stderr"] = [e[0] for e in errs]
+    return res
+
+
+def format_case(vals):
+    return ("%d\n%s\n" % (len(vals), " ".join(map(str, vals)))).encode()
+
+
+def builtin_case(args, case_seed):
+    """内置用例: 长度在 [1, n] 内随机, 元素按 --dist / --lo / --hi 生成."""
+    n = random.Random(case_seed).randint(1, args.n)
+    text = make_chunk(((0, 0, n), args.dist, args.lo, args.hi, n, case_seed, args.zipf_a))
+    return list(map(int, text.split()))
+
+
+def shrink_case(vals, lo, still_fails):
+    """ddmin: 先成块删除元素, 再把每个元素向 lo 折半, 只要仍然失败就保留修改."""
+    runs = 0
+    parts = 2
+    while len(vals) >= 2 and runs < SHRINK_MAX_RUNS:
+        size = max(1, len(vals) // parts)
+        for start in range(0, len(vals), size):
+            cand = vals[:start] + vals[start + size:]
+            runs += 1
+            if cand and still_fails(cand):
+                vals = cand
+                parts = max(parts - 1, 2)
+                break
+        else:
+            if size == 1:
+                break
+            parts = min(len(vals), parts * 2)
+    for i in range(len(vals)):
+        while vals[i] != lo and runs < SHRINK_MAX_RUNS:
+            cand = vals[:i] + [lo + (vals[i] - lo) // 2] + vals[i + 1:]
+            runs += 1
+            if not still_fails(cand):
+                break
+            vals = cand
+    return vals
+
+
+def _ms(sec):
+    return sec * 1000.0
+
+
+def _show(data, limit=2000):
+    text = data.decode(errors="replace")
+    return text if len(text) <= limit else text[:limit] + "... (%d bytes)" % len(data)
+
+
+def cmd_stress(args):
+    if args.seed is None:
+        args.seed = random.SystemRandom().randrange(1 << 32)
+    with tempfile.TemporaryDirectory(prefix="stress-") as build:
+        cflags = shlex.split(args.cflags)
+        try:
+            cand = compile_source(args.candidate, build, cflags)
+            ref = compile_source(args.reference, build, cflags)
+        except subprocess.CalledProcessError as e:
+            print("compile failed: %s" % " ".join(e.cmd), file=sys.stderr)
+            return 2
+
+        def make_input(case_seed):
+            if args.gen_cmd:
+                cmd = shlex.split(args.gen_cmd.replace("{seed}", str(case_seed)))
+                return subprocess.run(cmd, stdout=subprocess.PIPE, check=True).stdout, None
+            vals = builtin_case(args, case_seed)
+            return format_case(vals), vals
+
+        live = _Live()
+
+        def one(case):
+            case_seed = args.seed + case
+            data, vals = make_input(case_seed)
+            res = run_pair(cand, ref, data, args.timeout, live)
+            # 其他用例失败后被 live.stop() 杀掉的不算失败
+            res.update(case=case, seed=case_seed, data=data, vals=vals, aborted=live.stopped and not res["ok"])
+            return res
+
+        t0 = time.perf_counter()
+        results, failures = [], []
+        cases = iter(range(args.cases))
+        with ThreadPoolExecutor(max_workers=args.workers) as pool:
+            pending = {pool.submit(one, c) for c in itertools.islice(cases, 2 * args.workers)}
+            while pending:
+                finished, pending = wait(pending, return_when=FIRST_COMPLETED)
+                for f in finished:
+                    r = f.result()
+                    if r["ok"]:
+                        results.append(r)
+                        if args.verbose:
+                            print("case %5d seed %d: %d bytes, candidate %.2f ms, reference %.2f ms (cpu), wall %.2f ms"
+                                  % (r["case"], r["seed"], len(r["data"]), _ms(r["time"][0]), _ms(r["time"][1]),
+                                     _ms(r["wall"])))
+                    elif not r["aborted"]:
+                        failures.append(r)
+                        live.stop()
+                if not live.stopped:
+                    pending |= {pool.submit(one, c) for c in itertools.islice(cases, len(finished))}
+        elapsed = time.perf_counter() - t0
+
+        if results:
+            tc = [r["time"][0] for r in results]
+            tr = [r["time"][1] for r in results]
+            slow = max(results, key=lambda r: r["time"][0])
+            print("passed %d/%d cases in %.2f s (%d workers) | cpu: candidate mean %.2f ms max %.2f ms (case %d)"
+                  " | reference mean %.2f ms max %.2f ms"
+                  % (len(results), args.cases, elapsed, args.workers, _ms(sum(tc) / len(tc)), _ms(max(tc)),
+                     slow["case"], _ms(sum(tr) / len(tr)), _ms(max(tr))))
+        if not failures:
+            return 0
+
+        bad = min(failures, key=lambda r: r["case"])
+        print("FAILED case %d (seed %d): %s" % (bad["case"], bad["seed"], bad["reason"]))
+        data = bad["data"]
+        if bad["vals"] is not None and bad["reason"] == "wrong answer" and not args.no_shrink:
+            reason = bad["reason"]
+
+            def still_fails(vals):
+                return not run_pair(cand, ref, format_case(vals), args.timeout)["ok"]
+
+            small = shrink_case(bad["vals"], args.lo, still_fails)
+            data = format_case(small)
+            bad = run_pair(cand, ref, data, args.timeout)
+            bad["reason"] = bad["reason"] or reason
+            print("shrunk to %d elements" % len(small))
+        print("--- input ---\n%s" % _show(data))
+        if bad.get("index", -1) >= 0:
+            print("--- token #%d: candidate %r, reference %r" % (bad["index"], bad["got"], bad["expected"]))
+        for name, err in zip(("candidate", "reference"), bad.get("stderr", [])):
+            if err:
+                print("--- %s stderr (tail) ---\n%s" % (name, _show(err)))
+        if args.save:
+            with open(args.save, "wb") as f:
+                f.write(data)
+            print("failing input saved to %s" % args.save)
+        return 1
+
+
+def add_stress_args(p):
+    p.add_argument("candidate", help="待测解 (.c/.cpp/.py 或可执行文件)")
+    p.add_argument("reference", help="暴力 / 参考解")
+    p.add_argument("--cases", type=int, default=1000)
+    p.add_argument("--workers", type=int, default=os.cpu_count() or 1)
+    p.add_argument("--seed", type=int, default=None, help="第 i 个用例的种子为 seed + i")
+    p.add_argument("-n", type=int, default=20, help="内置用例的最大长度")
+    p.add_argument("--dist", choices=DISTS, default="random")
+    p.add_argument("--lo", type=int, default=0)
+    p.add_argument("--hi", type=int, default=100)
+    p.add_argument("--zipf-a", type=float, default=1.2)
+    p.add_argument("--gen-cmd", default=None, help="自定义生成器命令, {seed} 替换为用例种子")
+    p.add_argument("--timeout", type=float, default=5.0, help="单个用例超时 (s)")
+    p.add_argument("--cflags", default="", help="附加编译选项")
+    p.add_argument("--no-shrink", action="store_true")
+    p.add_argument("--save", default="failed_input.txt", help="保存失败输入的文件, 空串表示不保存")
+    p.add_argument("-v", "--verbose", action="store_true", help="打印每个用例的耗时")
+
+
+def add_gen_args(p):
+    p.add_argument("-n", type=int, default=10, help="元素个数")
+    p.add_argument("--dist", choices=DISTS, default="random")
+    p.add_argument("--lo", type=int, default=0)
+    p.add_argument("--hi", type=int, default=100)
+    p.add_argument("--seed", type=int, default=None, help="默认随机, 指定后结果可复现")
+    p.add_argument("--workers", type=int, default=os.cpu_count() or 1)
+    p.add_argument("--chunk", type=int, default=DEFAULT_CHUNK, help="每块元素个数")
+    p.add_argument("--zipf-a", type=float, default=1.2, help="Zipf 指数 a (> 0)")
+    p.add_argument("--count", action="store_true", help="第一行先写元素个数")
+    p.add_argument("-o", "--output", default="input.txt", help="输出文件, '-' 表示 stdout")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd")
+    gen = sub.add_parser("gen", help="生成测试数据")
+    add_gen_args(gen)
+    gen.set_defaults(func=cmd_gen)
+    stress = sub.add_parser("stress", help="并行对拍")
+    add_stress_args(stress)
+    stress.set_defaults(func=cmd_stress)
+    argv = sys.argv[1:] if argv is None else argv
+    args = parser.parse_args(argv or ["gen"])
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+# 测试程序注册与 bench / bench_matrix 目标
+#
+# gym_add_bench(<name> SOURCES <src>... [LIBS <lib>...] [SIZES <n>...] [DEFINES <def>...]
+#               [HOSTED] [STANDALONE])
+#   生成可执行文件 <name>, 链接 benchmark 库; SIZES 通过 --sizes= 传给测试程序 (不给则用其默认值),
+#   HOSTED 表示需要操作系统 (线程 / mmap), 裸机工具链下不生成;
+#   STANDALONE 表示源文件里已经带了测试框架 (benchmark.c 的示例 main), 不再链接 benchmark 库.
+#   GYM_FOOTPRINT=ON 时每个测试程序另外链接堆用量探针 (Templates/heap_probe.c) 并输出 <exe>.map,
+#   bench / footprint 目标据此与 .su / .ci 文件一起生成内存占用报告 (cmake/footprint.py).
+
+include_guard(GLOBAL)
+include(CheckCCompilerFlag)
+
+# -march=native 只对本机编译有意义; 交叉编译时 Native 配置只是 -O3 (目标 CPU 由工具链文件给出)
+function(gym_native_flags out)
+  set(flags "")
+  if(NOT CMAKE_CROSSCOMPILING)
+    check_c_compiler_flag(-march=native GYM_HAS_MARCH_NATIVE)
+    if(GYM_HAS_MARCH_NATIVE)
+      set(flags "-march=native")
+    endif()
+  endif()
+  set(${out} "${flags}" PARENT_SCOPE)
+endfunction()
+
+function(gym_add_bench name)
+  cmake_parse_arguments(ARG "HOSTED;STANDALONE" "" "SOURCES;LIBS;SIZES;DEFINES" ${ARGN})
+  if(ARG_HOSTED AND NOT GYM_HOSTED)
+    message(STATUS "Skipping ${name}: needs a hosted target")
+    return()
+  endif()
+  add_executable(${name} ${ARG_SOURCES} ${GYM_STARTUP_SOURCES})
+  if(NOT ARG_STANDALONE)
+    target_link_libraries(${name} PRIVATE benchmark)
+  endif()
+  target_link_libraries(${name} PRIVATE ${ARG_LIBS})
+  if(ARG_DEFINES)
+    target_compile_definitions(${name} PRIVATE ${ARG_DEFINES})
+  endif()
+  if(GYM_FOOTPRINT)
+    # --wrap 只改写本程序与静态库里的引用; C++ 程序再替换全局 operator new, 见 heap_probe_new.cpp
+    target_link_libraries(${name} PRIVATE heap_probe)
+    if(ARG_SOURCES MATCHES "\\.(cpp|cc|cxx)(;|$)")
+      target_link_libraries(${name} PRIVATE heap_probe_new)
+    endif()
+    target_link_options(${name} PRIVATE
+      "LINKER:--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc,--wrap=aligned_alloc,--wrap=posix_memalign"
+      "LINKER:-Map=$<TARGET_FILE:${name}>.map")
+  endif()
+  set_property(GLOBAL APPEND PROPERTY GYM_BENCHES ${name})
+  string(REPLACE ";" "," sizes "${ARG_SIZES}")
+  set_property(GLOBAL PROPERTY GYM_BENCH_SIZES_${name} "${sizes}")
+endfunction()
+
+# 目标本身及其链接的全部 (传递) 静态库 / 对象库的目标文件, 以 JSON 数组元素的形式追加到 out.
+# 内存占用报告只在这些目标文件的 .su / .ci 里找调用图, 不会把别的测试程序的 main 混进来.
+function(gym_collect_objects tgt out visited)
+  if(NOT TARGET ${tgt} OR "${tgt}" IN_LIST ${visited})
+    return()
+  endif()
+  list(APPEND ${visited} ${tgt})
+  get_target_property(imported ${tgt} IMPORTED)
+  if(imported)
+    set(${visited} "${${visited}}" PARENT_SCOPE)
+    return()
+  endif()
+  get_target_property(type ${tgt} TYPE)
+  set(result "${${out}}")
+  set(deps "")
+  if(NOT type STREQUAL "INTERFACE_LIBRARY")
+    list(APPEND result "\"$<JOIN:$<TARGET_OBJECTS:${tgt}>,\",\">\"")
+    get_target_property(deps ${tgt} LINK_LIBRARIES)
+  endif()
+  get_target_property(ideps ${tgt} INTERFACE_LINK_LIBRARIES)
+  foreach(dep IN LISTS deps ideps)
+    string(REGEX REPLACE "^\\$<LINK_ONLY:(.*)>$" "\\1" dep "${dep}")
+    set(${out} "${result}")
+    gym_collect_objects("${dep}" ${out} ${visited})
+    set(result "${${out}}")
+  endforeach()
+  set(${out} "${result}" PARENT_SCOPE)
+  set(${visited} "${${visited}}" PARENT_SCOPE)
+endfunction()
+
+# 在所有 add_subdirectory 之后调用. 生成清单 bench_manifest.cmake (名字 / 可执行文件 / 规模),
+# bench 目标按清单依次串行运行全部测试程序 (并行会互相抢 CPU), run_<name> 只运行一个.
+# GYM_FOOTPRINT=ON 时另外生成 footprint_manifest.json (可执行文件 + 目标文件列表) 给 footprint.py.
+function(gym_finalize_bench_targets)
+  get_property(benches GLOBAL PROPERTY GYM_BENCHES)
+  set(manifest "")
+  set(fp_entries "")
+  foreach(name IN LISTS benches)
+    get_property(sizes GLOBAL PROPERTY GYM_BENCH_SIZES_${name})
+    string(APPEND manifest "list(APPEND GYM_BENCHES ${name})\n"
+                           "set(GYM_EXE_${name} \"$<TARGET_FILE:${name}>\")\n"
+                           "set(GYM_SIZES_${name} \"${sizes}\")\n")
+    if(GYM_FOOTPRINT)
+      set(objs "")
+      set(seen "")
+      gym_collect_objects(${name} objs seen)
+      list(JOIN objs ", " objs)
+      list(APPEND fp_entries "    {\"name\": \"${name}\", \"exe\": \"$<TARGET_FILE:${name}>\", \"objects\": [${objs}]}")
+    endif()
+  endforeach()
+  set(manifest_file "${CMAKE_BINARY_DIR}/bench_manifest.cmake")
+  file(GENERATE OUTPUT "${manifest_file}" CONTENT "${manifest}")
+
+  set(fp_args "")
+  if(GYM_FOOTPRINT)
+    find_package(Python3 COMPONENTS Interpreter)
+    if(NOT CMAKE_SIZE)
+      find_program(CMAKE_SIZE NAMES size)
+    endif()
+    list(JOIN fp_entries ",\n" fp_entries)
+    set(fp_manifest "${CMAKE_BINARY_DIR}/footprint_manifest.json")
+    file(GENERATE OUTPUT "${fp_manifest}" CONTENT
+         "{\n  \"nm\": \"${CMAKE_NM}\",\n  \"size\": \"${CMAKE_SIZE}\",\n  \"benches\": [\n${fp_entries}\n  ]\n}\n")
+    if(Python3_FOUND)
+      set(fp_cmd ${Python3_EXECUTABLE} ${PROJECT_SOURCE_DIR}/cmake/footprint.py
+          --manifest ${fp_manifest} --out-dir ${GYM_BENCH_OUT_DIR})
+      set(fp_args -DPYTHON=${Python3_EXECUTABLE} -DFOOTPRINT=${fp_manifest}
+          -DFOOTPRINT_SCRIPT=${PROJECT_SOURCE_DIR}/cmake/footprint.py)
+      # 只做静态分析 (栈 / 段大小), 不运行测试程序; 之前 bench 留下的堆峰值照样合并进报告
+      add_custom_target(footprint COMMAND ${fp_cmd} DEPENDS ${benches} USES_TERMINAL
+                        COMMENT "Writing the memory footprint report to ${GYM_BENCH_OUT_DIR}")
+    else()
+      message(WARNING "GYM_FOOTPRINT: Python 3 not found, only .su / .map files are produced")
+    endif()
+  endif()
+
+  set(run ${CMAKE_COMMAND}
+      -DMANIFEST=${manifest_file}
+      -DFORMAT=${GYM_BENCH_FORMAT}
+      -DOUT_DIR=${GYM_BENCH_OUT_DIR}
+      -DBASELINE_DIR=${GYM_BENCH_BASELINE_DIR}
+      -DTHRESHOLD=${GYM_BENCH_THRESHOLD}
+      -DCOUNTERS=${GYM_BENCH_COUNTERS}
+      "-DEMULATOR=${CMAKE_CROSSCOMPILING_EMULATOR}"
+      ${fp_args})
+  set(script ${PROJECT_SOURCE_DIR}/cmake/run_bench.cmake)
+  foreach(name IN LISTS benches)
+    add_custom_target(run_${name} COMMAND ${run} -DONLY=${name} -P ${script}
+                      DEPENDS ${name} USES_TERMINAL COMMENT "Running ${name}")
+  endforeach()
+  add_custom_target(bench COMMAND ${run} -P ${script}
+                    DEPENDS ${benches} USES_TERMINAL COMMENT "Running the bench suite (${CMAKE_BUILD_TYPE})")
+
+  add_custom_target(bench_matrix
+    COMMAND ${CMAKE_COMMAND}
+            -DSOURCE_DIR=${PROJECT_SOURCE_DIR}
+            -DBINARY_DIR=${CMAKE_BINARY_DIR}
+            "-DTOOLCHAIN=${CMAKE_TOOLCHAIN_FILE}"
+            "-DGENERATOR=${CMAKE_GENERATOR}"
+            "-DCONFIGS=Release\;Native\;MinSizeRel"
+            "-DEXTRA_ARGS=-DGYM_BENCH_FORMAT=${GYM_BENCH_FORMAT}\;-DGYM_BENCH_TIMER=${GYM_BENCH_TIMER}\;-DGYM_CPU_HZ=${GYM_CPU_HZ}\;-DGYM_BENCH_COUNTERS=${GYM_BENCH_COUNTERS}\;-DGYM_FOOTPRINT=${GYM_FOOTPRINT}"
+            "-DBASELINE_ROOT=${GYM_BENCH_BASELINE_DIR}"
+            -P ${PROJECT_SOURCE_DIR}/cmake/bench_matrix.cmake
+    USES_TERMINAL
+    COMMENT "Building and running the bench suite in Release, Native and MinSizeRel")
+endfunction()
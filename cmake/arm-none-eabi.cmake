@@ -0,0 +1,53 @@
+# Cortex-M 交叉编译工具链 (GNU Arm Embedded / arm-none-eabi-gcc)
+#
+#   cmake -S . -B build-m4 -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake \
+#         -DGYM_ARM_CPU=cortex-m4 -DGYM_CPU_HZ=168000000 [-DGYM_LINKER_SCRIPT=board.ld]
+#   cmake --build build-m4 -j
+#
+# 生成与宿主机相同的一套测试程序 (需要线程/mmap 的 HOSTED 程序除外), 计时后端自动选 DWT->CYCCNT;
+# 给出 GYM_CPU_HZ 后结果同时有 ns 与 cycles. 链接 newlib-nano + nosys 桩函数, printf 通过
+# 板级 _write (如重定向到 ITM/UART 或半主机) 输出. 不给链接脚本时用工具链默认脚本, 只能保证链接通过;
+# 上板运行需要板子的链接脚本与启动文件 (GYM_LINKER_SCRIPT / GYM_STARTUP_SOURCES).
+# 设置 CMAKE_CROSSCOMPILING_EMULATOR (如 qemu-system-arm 半主机包装脚本) 后 bench 目标可以直接运行.
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(GYM_ARM_PREFIX "arm-none-eabi-" CACHE STRING "Toolchain prefix (may include a path)")
+set(CMAKE_C_COMPILER ${GYM_ARM_PREFIX}gcc)
+set(CMAKE_CXX_COMPILER ${GYM_ARM_PREFIX}g++)
+set(CMAKE_ASM_COMPILER ${GYM_ARM_PREFIX}gcc)
+set(CMAKE_OBJCOPY ${GYM_ARM_PREFIX}objcopy CACHE FILEPATH "")
+set(CMAKE_SIZE ${GYM_ARM_PREFIX}size CACHE FILEPATH "")
+
+# 试编译只生成静态库: 没有链接脚本时试链接可执行文件会失败
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(GYM_ARM_CPU "cortex-m4" CACHE STRING "Target core: cortex-m0plus, cortex-m3, cortex-m4, cortex-m7, cortex-m33")
+set(GYM_LINKER_SCRIPT "" CACHE FILEPATH "Board linker script (optional)")
+set(GYM_STARTUP_SOURCES "" CACHE STRING "Startup / retarget sources linked into every executable (optional)")
+
+set(gym_arch_flags "-mcpu=${GYM_ARM_CPU} -mthumb")
+if(GYM_ARM_CPU STREQUAL "cortex-m4")
+  string(APPEND gym_arch_flags " -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+elseif(GYM_ARM_CPU STREQUAL "cortex-m7")
+  string(APPEND gym_arch_flags " -mfpu=fpv5-d16 -mfloat-abi=hard")
+elseif(GYM_ARM_CPU STREQUAL "cortex-m33")
+  string(APPEND gym_arch_flags " -mfpu=fpv5-sp-d16 -mfloat-abi=hard")
+endif()
+
+# 段级垃圾回收: 每个函数/数据独立成段, 链接时去掉没用到的
+set(CMAKE_C_FLAGS_INIT "${gym_arch_flags} -ffunction-sections -fdata-sections")
+set(CMAKE_CXX_FLAGS_INIT "${gym_arch_flags} -ffunction-sections -fdata-sections -fno-exceptions -fno-rtti")
+set(CMAKE_ASM_FLAGS_INIT "${gym_arch_flags}")
+# -u _printf_float: newlib-nano 的 printf 默认不支持 %f, 测试报告需要
+set(CMAKE_EXE_LINKER_FLAGS_INIT
+    "${gym_arch_flags} --specs=nano.specs --specs=nosys.specs -u _printf_float -Wl,--gc-sections")
+if(GYM_LINKER_SCRIPT)
+  string(APPEND CMAKE_EXE_LINKER_FLAGS_INIT " -T${GYM_LINKER_SCRIPT}")
+endif()
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE ONLY)
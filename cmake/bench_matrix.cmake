@@ -0,0 +1,27 @@
+# 依次用每个构建配置重新配置 + 编译 + 运行 bench (由 bench_matrix 目标调用).
+# 每个配置一棵独立的构建树 BINARY_DIR/matrix/<config>, 结果在 BINARY_DIR/bench_results/<config>/.
+# BASELINE_ROOT 与 bench_results 布局相同 (每个配置一个子目录), 可以直接是上一次的 bench_results 拷贝.
+
+foreach(cfg IN LISTS CONFIGS)
+  set(tree "${BINARY_DIR}/matrix/${cfg}")
+  set(args -S "${SOURCE_DIR}" -B "${tree}" -G "${GENERATOR}"
+      -DCMAKE_BUILD_TYPE=${cfg}
+      -DGYM_BENCH_RESULTS_DIR=${BINARY_DIR}/bench_results/${cfg})
+  if(TOOLCHAIN)
+    list(APPEND args -DCMAKE_TOOLCHAIN_FILE=${TOOLCHAIN})
+  endif()
+  if(BASELINE_ROOT)
+    list(APPEND args -DGYM_BENCH_BASELINE_DIR=${BASELINE_ROOT}/${cfg})
+  endif()
+  list(APPEND args ${EXTRA_ARGS})
+  message(STATUS "==== ${cfg} ====")
+  execute_process(COMMAND ${CMAKE_COMMAND} ${args} RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "configure ${cfg} failed")
+  endif()
+  execute_process(COMMAND ${CMAKE_COMMAND} --build "${tree}" --target bench RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "bench ${cfg} failed")
+  endif()
+endforeach()
+message(STATUS "results: ${BINARY_DIR}/bench_results/")
@@ -0,0 +1,273 @@
+"""内存占用报告: 每个测试程序的 .text / .data / .bss, 最坏情况栈深度与堆峰值 (由 bench / footprint 目标调用).
+
+    python footprint.py --manifest build/footprint_manifest.json --out-dir build/bench_results/Release [--only=bench_crc]
+
+输入 (都由 -DGYM_FOOTPRINT=ON 的构建产生):
+  - footprint_manifest.json: 每个测试程序的可执行文件与它链接的全部目标文件 (cmake/GymBench.cmake 生成)
+  - 目标文件旁边的 .su (-fstack-usage, 每个函数的栈帧) 与 .ci (GCC -fcallgraph-info=su, 调用图)
+  - 可执行文件: nm -S 给出每个符号的大小与所在段, size 给出整个程序的 text / data / bss
+  - OUT_DIR/<name>.heap.csv: Templates/heap_probe.c 在程序退出时写下的堆峰值 (只有运行过 bench 才有)
+
+输出:
+  - OUT_DIR/footprint.csv: 每个测试程序一行; 只更新 --only 指定的行, 其余行保留
+  - OUT_DIR/<name>.symbols.csv: 每个符号一行 (段, 字节数, 栈帧), 按字节数从大到小
+
+最坏栈深度 = 从 main 出发沿调用图取栈帧之和的最大值. 以下情况算不出真实上界, 在 stack_notes 里标出:
+  recursion (调用图有环, 环只算一圈), indirect (函数指针调用), extern (调用了没有 .su 的库函数,
+  按 0 字节计), dynamic (alloca / VLA, 栈帧大小没有上界). 没有 .ci 时 (clang) 只给出最大的单个栈帧.
+"""
+import argparse
+import csv
+import json
+import os
+import re
+import subprocess
+import sys
+
+SUMMARY_FIELDS = ("bench", "text", "data", "bss", "stack_worst", "stack_max_frame", "stack_notes",
+                  "heap_peak", "heap_allocs", "stack_path")
+SYMBOL_FIELDS = ("symbol", "section", "bytes", "stack_frame", "stack_kind")
+
+# nm 的符号类型 -> 段; 大小写只区分全局 / 局部
+NM_SECTIONS = {"t": ".text", "w": ".text", "r": ".rodata", "d": ".data", "g": ".data", "v": ".data",
+               "u": ".data", "b": ".bss", "s": ".bss", "c": ".bss"}
+
+NODE_RE = re.compile(r'node:\s*\{\s*title:\s*"([^"]*)"\s*label:\s*"([^"]*)"')
+EDGE_RE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]*)"\s*targetname:\s*"([^"]*)"')
+FRAME_RE = re.compile(r"(\d+) bytes \(([a-z,]+)\)")
+INDIRECT = "__indirect_call"
+
+
+def aux_file(obj, ext):
+    """dir/x.c.o -> dir/x.c.su: GCC 把 .su / .ci 放在 -o 指定的位置, 去掉目标文件扩展名"""
+    base, oext = os.path.splitext(obj)
+    return (base if oext in (".o", ".obj") else obj) + ext
+
+
+def bare(title):
+    """.ci 里静态函数的 title 是 "源文件:符号", 全局函数只有符号本身; 符号 (修饰名) 里没有冒号"""
+    return title.rsplit(":", 1)[-1]
+
+
+class CallGraph:
+    def __init__(self):
+        self.frame = {}   # title -> (字节数, static / dynamic / dynamic,bounded, 可读名)
+        self.calls = {}   # title -> [callee title]
+        self.su_only = []  # 没有 .ci 的目标文件里的 (可读名, 字节数, 种类)
+
+    def add_ci(self, path):
+        with open(path, encoding="utf-8", errors="replace") as f:
+            text = f.read()
+        for title, label in NODE_RE.findall(text):
+            m = FRAME_RE.search(label)
+            if m is None:
+                continue  # 外部函数, 定义在别的目标文件 (或库) 里
+            size, kind = int(m.group(1)), m.group(2)
+            old = self.frame.get(title)
+            # 内联函数 / 模板实例在每个用到它的目标文件里都有一份 (comdat), 取最大的
+            if old is None or size > old[0]:
+                self.frame[title] = (size, kind, label.split("\\n", 1)[0])
+        for src, dst in EDGE_RE.findall(text):
+            self.calls.setdefault(src, []).append(dst)
+
+    def add_su(self, path):
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                parts = line.rstrip("\n").split("\t")
+                if len(parts) == 3 and parts[1].isdigit():
+                    name = parts[0].split(":", 3)[-1]
+                    self.su_only.append((name, int(parts[1]), parts[2]))
+
+    def max_frame(self):
+        frames = [v[0] for v in self.frame.values()] + [v[1] for v in self.su_only]
+        return max(frames, default=0)
+
+    def worst_from(self, root):
+        """返回 (最坏栈深度, 路径, 标记集合); root 不在图里时返回 None"""
+        if root not in self.frame:
+            return None
+        notes = set()
+        memo = {}
+        on_path = set()
+
+        def visit(node):
+            if node in memo:
+                return memo[node]
+            if node == INDIRECT:
+                notes.add("indirect")
+                return 0, []
+            if node not in self.frame:
+                notes.add("extern")
+                return 0, []
+            size, kind, _ = self.frame[node]
+            if kind == "dynamic":  # dynamic,bounded 的字节数已经是上界
+                notes.add("dynamic")
+            on_path.add(node)
+            best, best_path = 0, []
+            for callee in self.calls.get(node, ()):
+                if callee in on_path:
+                    notes.add("recursion")
+                    continue
+                depth, path = visit(callee)
+                if depth > best:
+                    best, best_path = depth, path
+            on_path.discard(node)
+            memo[node] = (size + best, [node] + best_path)
+            return memo[node]
+
+        sys.setrecursionlimit(max(sys.getrecursionlimit(), 10000))
+        depth, path = visit(root)
+        return depth, path, notes
+
+
+def run(cmd):
+    try:
+        return subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def demangler(nm):
+    """与 nm 同一前缀的 c++filt (arm-none-eabi-nm -> arm-none-eabi-c++filt)"""
+    if not nm:
+        return None
+    d, b = os.path.split(nm)
+    return os.path.join(d, b[:-2] + "c++filt") if b.endswith("nm") else None
+
+
+def demangle(nm, names, *flags):
+    """c++filt 逐行还原修饰名; 没有 c++filt (或全是 C 符号) 时原样返回"""
+    cxxfilt = demangler(nm)
+    if cxxfilt and any(n.startswith("_Z") for n in names):
+        try:
+            out = subprocess.run([cxxfilt, *flags], input="\n".join(names), check=True,
+                                 capture_output=True, text=True).stdout.splitlines()
+            if len(out) == len(names):
+                return out
+        except (OSError, subprocess.CalledProcessError):
+            pass
+    return list(names)
+
+
+def symbols(nm, exe):
+    """[(修饰名, 可读名, 段, 字节数)]; nm -S 只列出带大小的定义"""
+    out = run([nm, "-S", "--defined-only", exe]) if nm else None
+    if out is None:
+        return []
+    rows = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) < 4:
+            continue
+        section = NM_SECTIONS.get(parts[2].lower())
+        if section is None:
+            continue
+        rows.append([parts[3], parts[3], section, int(parts[1], 16)])
+    for r, name in zip(rows, demangle(nm, [r[0] for r in rows])):
+        r[1] = name
+    return [tuple(r) for r in rows]
+
+
+def section_totals(size, exe, syms):
+    """berkeley 格式的 size: text (含 .rodata) / data / bss; 没有 size 时用 nm 的符号大小累加"""
+    out = run([size, exe]) if size else None
+    if out:
+        lines = out.splitlines()
+        if len(lines) >= 2:
+            fields = lines[1].split()
+            if len(fields) >= 3 and all(x.isdigit() for x in fields[:3]):
+                return tuple(int(x) for x in fields[:3])
+    total = {".text": 0, ".rodata": 0, ".data": 0, ".bss": 0}
+    for _, _, section, n in syms:
+        total[section] += n
+    return total[".text"] + total[".rodata"], total[".data"], total[".bss"]
+
+
+def read_heap(out_dir, name):
+    path = os.path.join(out_dir, name + ".heap.csv")
+    if not os.path.isfile(path):
+        return "", ""
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            return row.get("heap_peak", ""), row.get("heap_allocs", "")
+    return "", ""
+
+
+def analyse(bench, tools, out_dir):
+    graph = CallGraph()
+    for obj in bench["objects"]:
+        ci, su = aux_file(obj, ".ci"), aux_file(obj, ".su")
+        if os.path.isfile(ci):
+            graph.add_ci(ci)
+        elif os.path.isfile(su):
+            graph.add_su(su)
+
+    result = graph.worst_from("main")
+    if result is not None:
+        worst, path, notes = result
+        path = " > ".join(demangle(tools.get("nm"), [bare(t) for t in path], "-p"))  # -p: 不带参数表
+    else:
+        worst, path, notes = graph.max_frame(), "", {"no-callgraph"}
+        if any(kind == "dynamic" for _, _, kind in graph.su_only):
+            notes.add("dynamic")
+
+    syms = symbols(tools.get("nm"), bench["exe"])
+    text, data, bss = section_totals(tools.get("size"), bench["exe"], syms)
+    heap_peak, heap_allocs = read_heap(out_dir, bench["name"])
+
+    frames = {}
+    for title, (size, kind, _) in graph.frame.items():
+        key = bare(title)
+        if key not in frames or size > frames[key][0]:
+            frames[key] = (size, kind)
+    with open(os.path.join(out_dir, bench["name"] + ".symbols.csv"), "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(SYMBOL_FIELDS)
+        for mangled, name, section, n in sorted(syms, key=lambda s: (-s[3], s[1])):
+            size, kind = frames.get(mangled, ("", ""))
+            w.writerow((name, section, n, size, kind))
+
+    return {"bench": bench["name"], "text": text, "data": data, "bss": bss, "stack_worst": worst,
+            "stack_max_frame": graph.max_frame(), "stack_notes": " ".join(sorted(notes)),
+            "heap_peak": heap_peak, "heap_allocs": heap_allocs, "stack_path": path}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n", 1)[0])
+    ap.add_argument("--manifest", required=True)
+    ap.add_argument("--out-dir", required=True)
+    ap.add_argument("--only", help="只分析这一个测试程序")
+    args = ap.parse_args()
+
+    with open(args.manifest) as f:
+        manifest = json.load(f)
+    benches = [b for b in manifest["benches"] if not args.only or b["name"] == args.only]
+    if not benches:
+        print(f"footprint: no bench named {args.only}", file=sys.stderr)
+        return 1
+    os.makedirs(args.out_dir, exist_ok=True)
+
+    summary_path = os.path.join(args.out_dir, "footprint.csv")
+    rows = {}
+    if os.path.isfile(summary_path):
+        with open(summary_path, newline="") as f:
+            rows = {r["bench"]: r for r in csv.DictReader(f)}
+    fresh = [analyse(b, manifest, args.out_dir) for b in benches]
+    rows.update((r["bench"], r) for r in fresh)
+    order = [b["name"] for b in manifest["benches"]]
+    with open(summary_path, "w", newline="") as f:
+        w = csv.DictWriter(f, fieldnames=SUMMARY_FIELDS, extrasaction="ignore")
+        w.writeheader()
+        for name in sorted(rows, key=lambda n: order.index(n) if n in order else len(order)):
+            w.writerow(rows[name])
+
+    print(f"{'bench':<28}{'text':>9}{'data':>7}{'bss':>9}{'stack':>8}{'heap':>10}  notes")
+    for r in fresh:
+        print(f"{r['bench']:<28}{r['text']:>9}{r['data']:>7}{r['bss']:>9}{r['stack_worst']:>8}"
+              f"{r['heap_peak'] or '-':>10}  {r['stack_notes']}")
+    print(f"# footprint in {summary_path}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,64 @@
+# 运行清单里的测试程序 (由 bench / run_<name> 目标调用):
+#   cmake -DMANIFEST=bench_manifest.cmake [-DONLY=<name>] [-DFORMAT=csv] [-DOUT_DIR=...]
+#         [-DBASELINE_DIR=...] [-DTHRESHOLD=10] [-DCOUNTERS=ON] [-DEMULATOR=...]
+#         [-DFOOTPRINT=footprint_manifest.json -DPYTHON=... -DFOOTPRINT_SCRIPT=footprint.py] -P run_bench.cmake
+# 每个测试程序的结果写到 OUT_DIR/<name>.<format>, stderr (环境信息, 跳过的规模) 照常显示.
+# BASELINE_DIR 下有同名 CSV 时一并做回退对比 (基线按配置区分, 所以是 BASELINE_DIR/<name>.csv).
+# FOOTPRINT 给出时 (GYM_FOOTPRINT=ON) 堆峰值写到 OUT_DIR/<name>.heap.csv, 跑完后由 footprint.py 汇总成
+# OUT_DIR/footprint.csv (每个程序一行) 与 OUT_DIR/<name>.symbols.csv (每个符号一行).
+# 某个程序失败 (自检不通过或有回退) 时继续跑完其余的, 最后以非 0 退出.
+
+include("${MANIFEST}")
+if(NOT FORMAT)
+  set(FORMAT csv)
+endif()
+set(ext ${FORMAT})
+if(FORMAT STREQUAL "text")
+  set(ext txt)
+endif()
+file(MAKE_DIRECTORY "${OUT_DIR}")
+
+if(ONLY)
+  set(GYM_BENCHES ${ONLY})
+endif()
+
+set(failed "")
+foreach(name IN LISTS GYM_BENCHES)
+  set(out "${OUT_DIR}/${name}.${ext}")
+  set(args --format=${FORMAT} --out=${out})
+  if(GYM_SIZES_${name})
+    list(APPEND args --sizes=${GYM_SIZES_${name}})
+  endif()
+  if(COUNTERS)
+    list(APPEND args --counters)
+  endif()
+  if(BASELINE_DIR AND EXISTS "${BASELINE_DIR}/${name}.csv")
+    list(APPEND args --baseline=${BASELINE_DIR}/${name}.csv --threshold=${THRESHOLD})
+  endif()
+  string(REPLACE ";" " " shown "${args}")
+  message(STATUS "${name} ${shown}")
+  if(FOOTPRINT)
+    set(ENV{GYM_HEAP_OUT} "${OUT_DIR}/${name}.heap.csv")
+  endif()
+  execute_process(COMMAND ${EMULATOR} ${GYM_EXE_${name}} ${args} RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    list(APPEND failed "${name} (${rc})")
+  endif()
+endforeach()
+
+if(FOOTPRINT)
+  set(only "")
+  if(ONLY)
+    set(only --only=${ONLY})
+  endif()
+  execute_process(COMMAND ${PYTHON} ${FOOTPRINT_SCRIPT} --manifest=${FOOTPRINT} --out-dir=${OUT_DIR} ${only}
+                  RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    list(APPEND failed "footprint (${rc})")
+  endif()
+endif()
+
+message(STATUS "results in ${OUT_DIR}")
+if(failed)
+  message(FATAL_ERROR "failed: ${failed}")
+endif()
@@ -1,4 +1,10 @@
 #!/bin/bash
+# 初始化工作区: 只创建目录, 不覆盖已有文件. 模板本身由 git 管理 (Templates/),
+# 被误删时用 git checkout -- Templates 恢复. 传入 --configure 时顺带生成 CMake 构建目录,
+# --footprint 同样生成, 并打开 GYM_FOOTPRINT (栈 / 段大小 / 堆峰值报告, 见 README).
+
+set -e
+cd "$(dirname "$0")"
 
 echo "正在执行初始化..."
 
@@ -8,48 +14,24 @@ mkdir -p CPP_Solutions
 mkdir -p Python_Scripts
 mkdir -p Templates
 
-# 2. 生成 Templates/baremetal.c (裸机/手撕代码模板)
-cat <<EOT > Templates/baremetal.c
-/* 裸机/手撕代码模板 - 模拟无标准库环境 */
-#define NULL ((void *)0)
-typedef unsigned long size_t;
-
-// 手动实现 memcpy
-void* my_memcpy(void* dest, const void* src, size_t n) {
-    char* d = (char*)dest;
-    const char* s = (const char*)src;
-    while (n--) *d++ = *s++;
-    return dest;
-}
-EOT
-
-# 3. 生成 Templates/benchmark.c (性能测试模板)
-cat <<EOT > Templates/benchmark.c
-#include <stdio.h>
-#include <time.h>
-#define TIME_IT(func) do { clock_t s = clock(); func; clock_t e = clock(); printf("Time: %f s\n", (double)(e-s)/CLOCKS_PER_SEC); } while(0)
-void test_func() { for(volatile int i=0; i<1000000; i++); }
-int main() { TIME_IT(test_func()); return 0; }
-EOT
-
-# 4. 生成 Templates/acm_io.cpp (刷题 IO 模板)
-cat <<EOT > Templates/acm_io.cpp
-#include <iostream>
-using namespace std;
-int main() {
-    ios::sync_with_stdio(0); cin.tie(0);
-    int n;
-    if(cin >> n) cout << "Input: " << n << endl;
-    return 0;
-}
-EOT
-
-# 5. 生成 Templates/verifier.py (Python 对拍模板)
-cat <<EOT > Templates/verifier.py
-import random
-with open("input.txt", "w") as f:
-    f.write(" ".join([str(random.randint(0,100)) for _ in range(10)]))
-print("Data generated.")
-EOT
-
-echo "✅ 初始化完成！"
\ No newline at end of file
+# 2. 检查模板是否齐全
+missing=0
+for f in Templates/baremetal.c Templates/benchmark.c Templates/benchmark.h Templates/bitops.h \
+         Templates/acm_io.cpp Templates/acm_io.hpp Templates/verifier.py Templates/CMakeLists.txt \
+         Templates/heap_probe.c Templates/heap_probe_new.cpp; do
+    if [ ! -f "$f" ]; then
+        echo "⚠️  缺少 $f"
+        missing=1
+    fi
+done
+if [ "$missing" -ne 0 ]; then
+    echo "   运行 git checkout -- Templates 恢复模板"
+fi
+
+# 3. 可选: 配置 CMake (之后 cmake --build build --target bench 跑全部测试)
+case "${1:-}" in
+    --configure) cmake -S . -B build ;;
+    --footprint) cmake -S . -B build -DGYM_FOOTPRINT=ON ;;
+esac
+
+echo "✅ 初始化完成！"